@@ -347,6 +347,8 @@ private:
     void parseMappingFile_(const StringList&);
     void parseStructMappingFile_(const StringList&);
     void parseAdductsFile_(const String& filename, std::vector<AdductInfo>& result);
+    /// parses the formula of each mapping entry once and records which adducts it is compatible with
+    void computeAdductCompatibility_();
     void searchMass_(double neutral_query_mass, double diff_mass, std::pair<Size, Size>& hit_indices) const;
 
     /// add search results to a Consensus/Feature
@@ -371,6 +373,8 @@ private:
       double mass;
       std::vector<String> massIDs;
       String formula;
+      std::vector<bool> pos_adduct_compatible; ///< AdductInfo::isCompatible() for each of pos_adducts_ (precomputed by init())
+      std::vector<bool> neg_adduct_compatible; ///< AdductInfo::isCompatible() for each of neg_adducts_ (precomputed by init())
     };
     std::vector<MappingEntry_> mass_mappings_;
 
@@ -207,6 +207,40 @@ private:
     /// @note Formula used depends on Param "conservative": false -> (D+1)/T, true (e.g. used in Fido) -> (D+1)/(T+D)
     void calculateFDRBasic_(std::map<double,double>& scores_to_FDR, ScoreToTgtDecLabelPairs& scores_labels, bool qvalue, bool higher_score_better) const;
 
+    /**
+      @brief Flat-array version of calculateFDRBasic_ (same formulas), used for large peptide-level inputs
+
+      Sorts an index permutation of @p scores (in parallel, if OpenMP is enabled) and computes the FDRs in one linear sweep.
+
+      @param scores The scores of all hits considered
+      @param is_target Target (1) or decoy (0) label of each entry of @p scores
+      @param fdrs Receives the FDR/q-value of each entry of @p scores (same order)
+      @param unique_scores Receives the distinct scores in ascending order
+      @param unique_fdrs Receives the FDR/q-value of each entry of @p unique_scores
+    */
+    void calculateFDRBasicFlat_(const std::vector<double>& scores, const std::vector<char>& is_target, bool qvalue, bool higher_score_better,
+                                std::vector<double>& fdrs, std::vector<double>& unique_scores, std::vector<double>& unique_fdrs) const;
+
+    /**
+      @brief Computes and annotates peptide-level FDRs/q-values for a set of peptide identifications
+
+      Scores, target/decoy labels and hit positions are extracted into flat arrays once. The results are written back
+      directly by position; only hits that did not take part in the calculation (e.g. non-top hits if @p all_hits is false)
+      are looked up by score.
+
+      @param ids The peptide identifications (e.g. collected from a ConsensusMap)
+      @param all_hits Use all hits instead of only the first hit of each identification
+      @param charge Only consider (and annotate) hits with this charge (0: all charges)
+      @param identifier Only consider (and annotate) identifications of this run (empty: all runs)
+      @param keep_decoy Keep decoy hits (otherwise they are removed)
+      @param q_value Compute q-values instead of FDRs
+      @param higher_score_better Orientation of the original scores
+
+      @return False if no scores could be extracted (nothing is annotated in this case)
+    */
+    bool applyBasicFlat_(const std::vector<PeptideIdentification*>& ids, bool all_hits, int charge, const String& identifier,
+                         bool keep_decoy, bool q_value, bool higher_score_better) const;
+
     /// calculates the error area around the x=x line between two consecutive values of expected and actual
     /// i.e. it assumes exp2 > exp1
     double trapezoidal_area_xEqy(double exp1, double exp2, double act1, double act2) const;
@@ -127,6 +127,17 @@ namespace OpenMS
     typedef std::set<IDBoostGraph::vertex_t> ProteinNodeSet;
     typedef std::set<IDBoostGraph::vertex_t> PeptideNodeSet;
 
+    /// Diagnostics of the last functor run on one connected component
+    struct ComponentStatistics
+    {
+      Size nr_vertices = 0;
+      Size nr_edges = 0;
+      /// what the functor returned (e.g. the number of messages passed)
+      unsigned long functor_result = 0;
+      /// wall clock time of the functor on this component
+      double seconds = 0.0;
+    };
+
 
     /// A boost dfs visitor that copies connected components into a vector of graphs
     class dfs_ccsplit_visitor:
@@ -348,10 +359,17 @@ namespace OpenMS
     // although we usually do long-running tasks per CC such that the extra virtual call does not matter much
     // Instead we gain type erasure.
     /// Do sth on connected components (your functor object has to inherit from std::function or be a lambda)
+    /// Components are scheduled largest first (by number of vertices and edges), so a big component
+    /// does not start last and dominate the wall time. Only the order changes: every component is still
+    /// processed by a single thread. The functor receives the original component index.
     void applyFunctorOnCCs(const std::function<unsigned long(Graph&, unsigned int)>& functor);
     /// Do sth on connected components single threaded (your functor object has to inherit from std::function or be a lambda)
     void applyFunctorOnCCsST(const std::function<void(Graph&)>& functor);
 
+    /// Size, functor result and run time per connected component (same indices as the components)
+    /// of the last call to applyFunctorOnCCs or applyFunctorOnCCsST
+    const std::vector<ComponentStatistics>& getComponentStatistics() const;
+
     /// Add intermediate nodes to the graph that represent indist. protein groups and peptides with the same parents
     /// this will save computation time and oscillations later on.
     void clusterIndistProteinsAndPeptides();
@@ -375,6 +393,9 @@ namespace OpenMS
     void calculateAndAnnotateIndistProteins(bool addSingletons = true);
 
     /// Splits the initialized graph into connected components and clears it.
+    /// Components are found on a compressed (CSR) copy of the adjacency structure; the
+    /// component graphs are then filled in parallel, largest first. Component order and
+    /// vertex numbering inside a component are the same as for a depth-first split.
     void computeConnectedComponents();
 
     /// @todo untested
@@ -472,9 +493,12 @@ namespace OpenMS
     Graphs ccs_;
     /* ---------------------------------------------------------------------------- */
 
+    /// nr. of nodes, nr. of edges, functor result and time of the last functor execution per connected component
+    std::vector<ComponentStatistics> cc_stats_;
+
     #ifdef INFERENCE_BENCH
-    /// nrnodes, nredges, nrmessages and times of last functor execution per connected component
-    std::vector<std::tuple<vertex_t, vertex_t, unsigned long, double>> sizes_and_times_{1};
+    /// dumps cc_stats_ to a time-stamped TSV file in the working directory
+    void writeComponentStatistics_() const;
     #endif
 
 
@@ -527,21 +551,36 @@ namespace OpenMS
                     bool use_unassigned_ids,
                     bool best_psms_annotated = false);
 
-    /// Used during building
-    void addPeptideIDWithAssociatedProteins_(
+    /// PSMs of one spectrum that enter the graph, each with the protein hits it maps to
+    typedef std::vector<std::pair<PeptideHit*, std::vector<ProteinHit*>>> PSMProteinLinks;
+
+    /// Used during building: resolves the protein accessions of the (top) PSMs of a spectrum.
+    /// Does not touch the graph and is therefore safe to call concurrently.
+    /// @return the number of accessions that could not be found in @p accession_map
+    static Size resolvePSMProteinLinks_(
         PeptideIdentification& spectrum,
-        std::unordered_map<IDPointer, vertex_t, boost::hash<IDPointer>>& vertex_map,
         const std::unordered_map<std::string, ProteinHit*>& accession_map,
         Size use_top_psms,
-        bool best_psms_annotated);
-
-    void addPeptideAndAssociatedProteinsWithRunInfo_(
-        PeptideIdentification& spectrum,
-        std::unordered_map<unsigned, unsigned>& indexToPrefractionationGroup,
+        bool best_psms_annotated,
+        PSMProteinLinks& links);
+
+    /// Used during building: looks up the prefractionation group (0-based) of a spectrum via its id_merge_index
+    /// @throw Exception::MissingInformation if the index is missing or does not point to a known run
+    static Size getPrefractionationGroup_(
+        const PeptideIdentification& spectrum,
+        const std::unordered_map<unsigned, unsigned>& indexToPrefractionationGroup);
+
+    /// Used during building: resolves the PSM-protein links of all @p spectra in parallel and
+    /// then inserts them into the graph sequentially (in input order, so vertex IDs stay deterministic).
+    /// If @p indexToPrefractionationGroup is given, the run of every PSM vertex is stored as well.
+    void addPeptideIDsWithAssociatedProteins_(
+        const std::vector<PeptideIdentification*>& spectra,
         std::unordered_map<IDPointer, vertex_t, boost::hash<IDPointer>>& vertex_map,
-        std::unordered_map<std::string, ProteinHit*>& accession_map,
-        Size use_top_psms
-        );
+        const std::unordered_map<std::string, ProteinHit*>& accession_map,
+        Size use_top_psms,
+        bool best_psms_annotated,
+        const std::unordered_map<unsigned, unsigned>* indexToPrefractionationGroup,
+        const String& progress_label);
 
     /// Initialize and store the graph. Also stores run information to later group
     /// peptides more efficiently.
@@ -256,6 +256,9 @@ protected:
     /// check if distance constraint is fulfilled (using @p rt_tolerance_, @p mz_tolerance_ and @p measure_)
     bool isMatch_(const double rt_distance, const double mz_theoretical, const double mz_observed) const;
 
+    /// indices (ascending, unique) of all elements in @p rt_index (pairs of RT and element index, sorted by RT) within @p rt_tolerance_ of @p rt
+    void getRTCandidates_(const std::vector<std::pair<double, Size> >& rt_index, const double rt, std::vector<Size>& candidates) const;
+
     /// helper function that checks if all peptide hits are annotated with RT and MZ meta values
     void checkHits_(const std::vector<PeptideIdentification>& ids) const;
 
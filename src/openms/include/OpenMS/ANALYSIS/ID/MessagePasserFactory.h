@@ -47,6 +47,7 @@ namespace OpenMS
   /// based on a parameterization of the Protein-Peptide Bayesian network.
   /// Those MessagePassers can be tables or convolution trees. Labels are used to associate the variables they are
   /// working on. They can be integers (for speed) or strings (for readability/debug)
+  /// All const create functions only read the model parameters and can be called concurrently.
   template <typename Label>
   class MessagePasserFactory {
   private:
@@ -62,7 +63,7 @@ namespace OpenMS
     /// to fill the noisy-OR table for a peptide given parent proteins
     /// TODO precompute for like a hundred parent proteins
     /// TODO introduce special case for alpha or beta = 1. The log formula does not work otherwise.
-    inline double notConditionalGivenSum(unsigned long summ) {
+    inline double notConditionalGivenSum(unsigned long summ) const {
       // use log for better precision
       return std::pow(2., log2(1. - beta_) + summ * log2(1. - alpha_));
       //return std::pow((1.0 - alpha_), summ) * (1.0 - beta_); // standard way
@@ -70,34 +71,34 @@ namespace OpenMS
 
   public:
     /// Protein Factor initialized with model prior (missing peps are experimental)
-    evergreen::TableDependency<Label> createProteinFactor(Label id, int nrMissingPeps = 0);
+    evergreen::TableDependency<Label> createProteinFactor(Label id, int nrMissingPeps = 0) const;
     /// Protein Factor initialized with user prior (missing peps are experimental)
-    evergreen::TableDependency<Label> createProteinFactor(Label id, double prior, int nrMissingPeps = 0);
+    evergreen::TableDependency<Label> createProteinFactor(Label id, double prior, int nrMissingPeps = 0) const;
 
     /// Peptide Factor initialized with:
     /// @param prob peptide evidence probability
-    evergreen::TableDependency<Label> createPeptideEvidenceFactor(Label id, double prob);
+    evergreen::TableDependency<Label> createPeptideEvidenceFactor(Label id, double prob) const;
 
     /// Conditional probability table of peptide given number of parent proteins, based on model params.
     /// Additionally regularizes on the amount of parent proteins.
     /// @param nrParents (maximum) number of parent proteins
-    evergreen::TableDependency<Label> createRegularizingSumEvidenceFactor(size_t nrParents, Label nId, Label pepId);
+    evergreen::TableDependency<Label> createRegularizingSumEvidenceFactor(size_t nrParents, Label nId, Label pepId) const;
 
     /// Conditional probability table of peptide given number of parent proteins, based on model params.
     /// @param nrParents (maximum) number of parent proteins
-    evergreen::TableDependency<Label> createSumEvidenceFactor(size_t nrParents, Label nId, Label pepId);
+    evergreen::TableDependency<Label> createSumEvidenceFactor(size_t nrParents, Label nId, Label pepId) const;
 
     //For extended model. @todo currently unused
-    evergreen::TableDependency<Label> createSumFactor(size_t nrParents, Label nId);
-    evergreen::TableDependency<Label> createReplicateFactor(Label seqId, Label repId);
+    evergreen::TableDependency<Label> createSumFactor(size_t nrParents, Label nId) const;
+    evergreen::TableDependency<Label> createReplicateFactor(Label seqId, Label repId) const;
     evergreen::TableDependency<Label> createChargeFactor(Label repId, Label chargeId, int chg);
 
     /// To sum up distributions for the number of parent proteins of a peptide with convolution trees
-    evergreen::AdditiveDependency<Label> createPeptideProbabilisticAdderFactor(const std::set<Label> & parentProteinIDs, Label nId);
+    evergreen::AdditiveDependency<Label> createPeptideProbabilisticAdderFactor(const std::set<Label> & parentProteinIDs, Label nId) const;
     /// To sum up distributions for the number of parent proteins of a peptide with convolution trees
-    evergreen::AdditiveDependency<Label> createPeptideProbabilisticAdderFactor(const std::vector<Label> & parentProteinIDs, Label nId);
+    evergreen::AdditiveDependency<Label> createPeptideProbabilisticAdderFactor(const std::vector<Label> & parentProteinIDs, Label nId) const;
     /// To sum up distributions for the number of parent proteins of a peptide brute-force
-    evergreen::PseudoAdditiveDependency<Label> createBFPeptideProbabilisticAdderFactor(const std::set<Label> & parentProteinIDs, Label nId, const std::vector<evergreen::TableDependency <Label> > & deps);
+    evergreen::PseudoAdditiveDependency<Label> createBFPeptideProbabilisticAdderFactor(const std::set<Label> & parentProteinIDs, Label nId, const std::vector<evergreen::TableDependency <Label> > & deps) const;
 
     /**
      * @brief Constructor
@@ -142,7 +143,7 @@ namespace OpenMS
   }
 
   template <typename Label>
-  evergreen::TableDependency<Label> MessagePasserFactory<Label>::createProteinFactor(Label id, int nrMissingPeps) {
+  evergreen::TableDependency<Label> MessagePasserFactory<Label>::createProteinFactor(Label id, int nrMissingPeps) const {
     double prior = gamma_;
     if (nrMissingPeps > 0)
     {
@@ -155,7 +156,7 @@ namespace OpenMS
   }
 
   template <typename Label>
-  evergreen::TableDependency<Label> MessagePasserFactory<Label>::createProteinFactor(Label id, double prior, int nrMissingPeps) {
+  evergreen::TableDependency<Label> MessagePasserFactory<Label>::createProteinFactor(Label id, double prior, int nrMissingPeps) const {
     if (nrMissingPeps > 0)
     {
       double powFactor = std::pow(1.0 - alpha_, -nrMissingPeps);
@@ -167,7 +168,7 @@ namespace OpenMS
   }
 
   template <typename Label>
-  evergreen::TableDependency<Label> MessagePasserFactory<Label>::createPeptideEvidenceFactor(Label id, double prob) {
+  evergreen::TableDependency<Label> MessagePasserFactory<Label>::createPeptideEvidenceFactor(Label id, double prob) const {
     double table[] = {(1 - prob) * (1 - pepPrior_), prob * pepPrior_};
     evergreen::LabeledPMF<Label> lpmf({id}, evergreen::PMF({0L}, evergreen::Tensor<double>::from_array(table)));
     return evergreen::TableDependency<Label>(lpmf,p_);
@@ -175,7 +176,7 @@ namespace OpenMS
 
 
   template <typename Label>
-  evergreen::TableDependency<Label> MessagePasserFactory<Label>::createSumEvidenceFactor(size_t nrParents, Label nId, Label pepId) {
+  evergreen::TableDependency<Label> MessagePasserFactory<Label>::createSumEvidenceFactor(size_t nrParents, Label nId, Label pepId) const {
     evergreen::Tensor<double> table({static_cast<unsigned long>(nrParents + 1) , 2});
     for (unsigned long i=0; i <= nrParents; ++i) {
       double notConditional = notConditionalGivenSum(i);
@@ -191,7 +192,7 @@ namespace OpenMS
   }
 
   template <typename Label>
-  evergreen::TableDependency<Label> MessagePasserFactory<Label>::createRegularizingSumEvidenceFactor(size_t nrParents, Label nId, Label pepId) {
+  evergreen::TableDependency<Label> MessagePasserFactory<Label>::createRegularizingSumEvidenceFactor(size_t nrParents, Label nId, Label pepId) const {
     evergreen::Tensor<double> table({static_cast<unsigned long>(nrParents + 1) , 2});
     unsigned long z[2]{0ul,0ul};
     unsigned long z1[2]{0ul,1ul};
@@ -211,7 +212,7 @@ namespace OpenMS
   }
 
   template <typename Label>
-  evergreen::TableDependency<Label> MessagePasserFactory<Label>::createSumFactor(size_t nrParents, Label nId) {
+  evergreen::TableDependency<Label> MessagePasserFactory<Label>::createSumFactor(size_t nrParents, Label nId) const {
     evergreen::Tensor<double> table({nrParents+1});
     for (unsigned long i=0; i <= nrParents; ++i) {
       table[i] = 1.0/(nrParents+1.);
@@ -223,7 +224,7 @@ namespace OpenMS
   }
 
   template <typename Label>
-  evergreen::TableDependency<Label> MessagePasserFactory<Label>::createReplicateFactor(Label seqId, Label repId) {
+  evergreen::TableDependency<Label> MessagePasserFactory<Label>::createReplicateFactor(Label seqId, Label repId) const {
     using arr = unsigned long[2];
     evergreen::Tensor<double> table({2,2});
     table[arr{0,0}] = 0.999;
@@ -252,21 +253,21 @@ namespace OpenMS
   }
 
   template <typename Label>
-  evergreen::AdditiveDependency<Label> MessagePasserFactory<Label>::createPeptideProbabilisticAdderFactor(const std::set<Label> & parentProteinIDs, Label nId) {
+  evergreen::AdditiveDependency<Label> MessagePasserFactory<Label>::createPeptideProbabilisticAdderFactor(const std::set<Label> & parentProteinIDs, Label nId) const {
     std::vector<std::vector<Label>> parents;
     std::transform(parentProteinIDs.begin(), parentProteinIDs.end(), std::back_inserter(parents), [](const Label& l){return std::vector<Label>{l};});
     return evergreen::AdditiveDependency<Label>(parents, {nId}, p_);
   }
 
   template <typename Label>
-  evergreen::AdditiveDependency<Label> MessagePasserFactory<Label>::createPeptideProbabilisticAdderFactor(const std::vector<Label> & parentProteinIDs, Label nId) {
+  evergreen::AdditiveDependency<Label> MessagePasserFactory<Label>::createPeptideProbabilisticAdderFactor(const std::vector<Label> & parentProteinIDs, Label nId) const {
     std::vector<std::vector<Label>> parents;
     std::transform(parentProteinIDs.begin(), parentProteinIDs.end(), std::back_inserter(parents), [](const Label& l){return std::vector<Label>{l};});
     return evergreen::AdditiveDependency<Label>(parents, {nId}, p_);
   }
 
   template <typename Label>
-  evergreen::PseudoAdditiveDependency<Label> MessagePasserFactory<Label>::createBFPeptideProbabilisticAdderFactor(const std::set<Label> & parentProteinIDs, Label nId, const std::vector<evergreen::TableDependency<Label>> & deps) {
+  evergreen::PseudoAdditiveDependency<Label> MessagePasserFactory<Label>::createBFPeptideProbabilisticAdderFactor(const std::set<Label> & parentProteinIDs, Label nId, const std::vector<evergreen::TableDependency<Label>> & deps) const {
     std::vector<std::vector<Label>> parents;
     std::transform(parentProteinIDs.begin(), parentProteinIDs.end(), std::back_inserter(parents), [](const Label& l){return std::vector<Label>{l};});
     return evergreen::PseudoAdditiveDependency<Label>(parents, {nId}, deps, p_);
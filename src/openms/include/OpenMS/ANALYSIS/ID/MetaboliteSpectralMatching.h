@@ -34,6 +34,7 @@
 
 #pragma once
 
+#include <OpenMS/ANALYSIS/ID/SpectralLibraryIndex.h>
 #include <OpenMS/KERNEL/MassTrace.h>
 #include <OpenMS/KERNEL/Feature.h>
 #include <OpenMS/KERNEL/FeatureMap.h>
@@ -175,9 +176,21 @@ namespace OpenMS
       std::vector<PeptideHit::PeakAnnotation>& annotations,
       double mz_lower_bound = 0.0);
 
-    /// main method of MetaboliteSpectralMatching
+    /// main method of MetaboliteSpectralMatching (sorts the library by precursor m/z and indexes it)
     void run(PeakMap &, PeakMap &, MzTab &);
 
+    /**
+      @brief Matches the spectra in @p msexp against an indexed spectral library
+
+      Spectra are matched in parallel (if OpenMP is enabled). Library spectra that share fewer than three
+      fragment bins with a query spectrum cannot score above zero and are skipped.
+
+      @param msexp The query spectra (noise-filtered and merged in place)
+      @param library The indexed spectral library
+      @param mztab_out The results
+    */
+    void run(PeakMap& msexp, const SpectralLibraryIndex& library, MzTab& mztab_out);
+
   protected:
     void updateMembers_() override;
 
@@ -0,0 +1,168 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+
+#include <utility>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Precursor- and fragment-indexed spectral library for fast spectral matching
+
+    Library spectra are kept sorted by precursor m/z, so candidates for a query precursor are found by binary search.
+    In addition, the fragment m/z values of all spectra are stored as bin numbers in one flat array. Before a candidate
+    is scored, countMatchingPeaks() tells how many of its peaks can possibly match the query peaks; candidates with too
+    few such peaks can be skipped without changing any score.
+
+    The index can be built from a PeakMap (e.g. loaded from mzML) or from an MSP file (see MSPGenericFile). For large
+    libraries, it can be stored in and loaded from a binary cache file, which is much faster than parsing the library.
+    Besides peaks and precursor, the cache only keeps the spectrum name and the meta values used for reporting matches
+    (see MetaboliteSpectralMatching).
+
+    @ingroup Analysis_ID
+  */
+  class OPENMS_DLLAPI SpectralLibraryIndex
+  {
+  public:
+    /// Constructor (@p bin_width is the width of the fragment m/z bins in Da)
+    explicit SpectralLibraryIndex(double bin_width = 0.5);
+
+    /// Builds the index from the spectra in @p library (spectra without precursor m/z are skipped)
+    void build(const PeakMap& library);
+
+    /**
+      @brief Builds the index from an MSP library file
+
+      Precursor m/z and charge are taken from the "PrecursorMZ" and "Ion_mode"/"Precursor_type" entries, if the
+      spectra have no precursor. Common MSP fields ("Name", "Formula", "InChI", "SMILES", "DB#") are mapped to the
+      meta values used by MetaboliteSpectralMatching.
+
+      If @p cache_filename is given and the cache was built from the current version of @p filename (same size and
+      modification time), the cache is loaded instead. Otherwise, the cache is (re-)created after parsing the file.
+
+      @throw Exception::FileNotFound if @p filename does not exist
+    */
+    void loadMSP(const String& filename, const String& cache_filename = "");
+
+    /**
+      @brief Stores the index in a binary cache file
+
+      @throw Exception::UnableToCreateFile if the file cannot be written
+    */
+    void store(const String& filename) const;
+
+    /**
+      @brief Loads the index from a binary cache file
+
+      @throw Exception::FileNotFound if the file does not exist
+      @throw Exception::ParseError if the file is not a valid cache file of this version
+    */
+    void load(const String& filename);
+
+    /// Returns the number of library spectra
+    Size size() const;
+
+    /// Returns true if the index contains no spectra
+    bool empty() const;
+
+    /// Returns the width of the fragment m/z bins
+    double getBinWidth() const;
+
+    /// Returns the library spectrum at @p index (spectra are sorted by precursor m/z)
+    const MSSpectrum& getSpectrum(Size index) const;
+
+    /// Returns the precursor m/z of the spectrum at @p index
+    double getPrecursorMZ(Size index) const;
+
+    /// Returns the precursor charge of the spectrum at @p index
+    Int getPrecursorCharge(Size index) const;
+
+    /// Returns the index range [first, last) of spectra with a precursor m/z in [@p mz_lower, @p mz_upper]
+    std::pair<Size, Size> getPrecursorRange(double mz_lower, double mz_upper) const;
+
+    /**
+      @brief Computes the fragment bins that peaks of @p spectrum can match within the given tolerance
+
+      @param spectrum The query spectrum (sorted by m/z)
+      @param fragment_mass_error The fragment tolerance
+      @param fragment_mass_tolerance_unit_ppm Is @p fragment_mass_error in ppm (otherwise Da)?
+      @param bins Receives the sorted, distinct bins (the buffer can be reused for many queries)
+    */
+    void getQueryBins(const MSSpectrum& spectrum, double fragment_mass_error, bool fragment_mass_tolerance_unit_ppm, std::vector<UInt32>& bins) const;
+
+    /**
+      @brief Counts the peaks of library spectrum @p index that fall into one of the @p query_bins
+
+      This is an upper bound of the number of peaks that match a query peak within the tolerance used for
+      getQueryBins().
+    */
+    Size countMatchingPeaks(Size index, const std::vector<UInt32>& query_bins) const;
+
+  protected:
+    /// Returns the bin of an m/z value
+    UInt32 getBin_(double mz) const;
+
+    /// Sorts the spectra by precursor m/z and computes the lookup arrays
+    void buildIndex_();
+
+    /// Loads a cache file; returns false if it does not exist or was created from a different source file
+    bool load_(const String& filename, UInt64 source_size, Int64 source_time, bool check_source);
+
+    /// Writes a cache file, including the size and modification time of the source file
+    void store_(const String& filename, UInt64 source_size, Int64 source_time) const;
+
+    double bin_width_;
+
+    /// library spectra, sorted by precursor m/z
+    std::vector<MSSpectrum> spectra_;
+
+    /// precursor m/z of each spectrum (for binary search)
+    std::vector<double> precursor_mz_;
+
+    /// precursor charge of each spectrum
+    std::vector<Int> precursor_charge_;
+
+    /// fragment bins of spectrum i are bins_[bin_offsets_[i]] to bins_[bin_offsets_[i + 1] - 1] (one per peak, ascending)
+    std::vector<Size> bin_offsets_;
+
+    /// fragment bins of all spectra
+    std::vector<UInt32> bins_;
+  };
+
+} // namespace OpenMS
@@ -40,6 +40,7 @@ PercolatorFeatureSetHelper.h
 SimpleSearchEngineAlgorithm.h
 SiriusAdapterAlgorithm.h
 SiriusMSConverter.h
+SpectralLibraryIndex.h
 )
 
 ### add path to the filenames
@@ -49,6 +49,7 @@ namespace OpenMS
     Only the best PSM per spectrum is considered as the correct identification.
 
     For each pair of maps, the similarity is determined based on the intersection of the contained identifications using Pearson correlation. For small intersections, the Pearson value is reduced by multiplying the ratio of the intersection size to the union size: \f$\texttt{PearsonValue(map1}\cap \texttt{map2)}*\Bigl(\frac{\texttt{N(map1 }\cap\texttt{ map2})}{\texttt{N(map1 }\cup\texttt{ map2})}\Bigr)\f$
+    The pairwise similarities are computed in parallel from a compact index that holds the median RT of each peptide sequence per map, sorted by an integer sequence index.
     Using hierarchical clustering together with average linkage a binary tree is produced.
     Following the tree, the maps are aligned, resulting in a transformed feature map that contains both the original and the transformed retention times.
     As long as there are at least two clusters, the alignment is done as follows:
@@ -58,6 +59,7 @@ namespace OpenMS
     Retention times in the second cluster are transformed to the reference scale by applying this function.
     Additionally, the original retention times are stored in the meta information of each feature.
     The reference is combined with the transformed cluster.
+    Merge steps of the tree that do not depend on each other (i.e. independent subtrees) are aligned concurrently.
 
     The resulting map is used to extract transformation descriptions for each input map.
     For each map cubic spline smoothing is used to convert the mapping to a smooth function.
@@ -127,8 +129,11 @@ public:
     static void computeTransformedFeatureMaps(std::vector<FeatureMap>& feature_maps, const std::vector<TransformationDescription>& transformations);
 
 protected:
-    /// Type to store feature retention times given for individual peptide sequence
-    typedef std::map<String, DoubleList> SeqAndRTList;
+    /// Type to store feature retention times given for individual peptide sequences (pairs of sequence and feature RT in order of extraction)
+    typedef std::vector<std::pair<String, double>> SeqAndRTList;
+
+    /// Type to store the median feature retention time of each peptide sequence, sorted by a sequence index that is shared by all maps
+    typedef std::vector<std::pair<Size, double>> SeqIndexAndMedianRT;
 
     // Update defaults model_type_, model_param_ and align_algorithm_
     void updateMembers_() override;
@@ -143,8 +148,8 @@ protected:
     MapAlignmentAlgorithmIdentification align_algorithm_;
 
     /**
-     * @brief Similarity functor that provides similarity calculations with the ()-operator for protected type SeqAndRTList.
-     * SeqAndRTList stores retention times given for individual peptide sequences of a feature map.
+     * @brief Similarity functor that provides similarity calculations with the ()-operator for protected type SeqIndexAndMedianRT.
+     * SeqIndexAndMedianRT stores the median retention time of each peptide sequence of a feature map.
 
       Using pearson correlation, calculate the retention time similarity of two maps from their intersection of the peptide identifications.
       Small intersections are penalized by multiplication with the quotient of intersection to union.
@@ -155,7 +160,7 @@ protected:
      * @brief For given peptide identifications extract sequences and store with associated feature RT.
      *
      * @param peptides Vector of peptide identifications to extract sequences.
-     * @param peptide_rts Map to store a list of feature RTs for each peptide sequence as key.
+     * @param peptide_rts Vector to append pairs of peptide sequence and feature RT to.
      * @param map_range Vector in which all feature RTs are stored for given peptide identifications.
      * @param feature_rt RT value of the feature to which the peptide identifications to be analysed belong.
      */
@@ -166,12 +171,36 @@ protected:
      * @brief For each input map, extract peptide identifications (sequences) of existing features with associated feature RT.
      *
      * @param feature_maps Vector of original maps containing peptide identifications.
-     * @param maps_seq_and_rt Vector of maps to store feature RTs given for individual peptide sequences for each feature map.
+     * @param maps_seq_and_rt Vector to store pairs of peptide sequence and feature RT for each feature map.
      * @param maps_ranges Vector to store all feature RTs of extracted identifications for each map; needed to determine the 10/90 percentiles.
      */
     static void extractSeqAndRt_(const std::vector<FeatureMap>& feature_maps, std::vector<SeqAndRTList>& maps_seq_and_rt,
             std::vector<std::vector<double>>& maps_ranges);
 
+    /**
+     * @brief Build the compact peptide-RT index used for the pairwise map distances.
+     *
+     * Sequences of all maps are mapped to a common integer index (in lexicographical order), and for each map the median feature RT per sequence is stored sorted by that index.
+     *
+     * @param maps_seq_and_rt Pairs of peptide sequence and feature RT for each feature map (as extracted by extractSeqAndRt_()); sorted by sequence on return.
+     * @param maps_index Vector to store the median RT per sequence index for each feature map.
+     */
+    static void buildSeqIndex_(std::vector<SeqAndRTList>& maps_seq_and_rt, std::vector<SeqIndexAndMedianRT>& maps_index);
+
+    /**
+     * @brief Align the two clusters of one tree node and combine them at the smaller cluster index.
+     *
+     * Only the clusters referenced by @p node are modified, so nodes of independent subtrees can be aligned concurrently.
+     *
+     * @param node BinaryTreeNode whose children are aligned.
+     * @param align_param Parameters for the alignment algorithm (@ref OpenMS::MapAlignmentAlgorithmIdentification).
+     * @param feature_maps_transformed Vector with (combined) maps of all clusters.
+     * @param maps_ranges Vector that contains all sorted RTs of extracted identifications for each map.
+     * @param map_sets Vector with the indices of the maps contained in each cluster, in order of alignment.
+     */
+    void alignNode_(const BinaryTreeNode& node, const Param& align_param, std::vector<FeatureMap>& feature_maps_transformed,
+                    const std::vector<std::vector<double>>& maps_ranges, std::vector<std::vector<Size>>& map_sets) const;
+
 private:
     /// Copy constructor intentionally not implemented -> private
     MapAlignmentAlgorithmTreeGuided(const MapAlignmentAlgorithmTreeGuided&);
@@ -42,6 +42,8 @@
 
 #include <OpenMS/CONCEPT/Types.h>
 
+#include <boost/container/flat_map.hpp>
+
 namespace OpenMS
 {
   class String;
@@ -83,8 +85,8 @@ namespace OpenMS
   {
 
 protected:
-	  /// Internal typedef for the used map type
-	  typedef std::map<const Element*, SignedSize> MapType_;
+	  /// Internal typedef for the used map type (a sorted vector: formulas have few elements, so this avoids per-element allocations)
+	  typedef boost::container::flat_map<const Element*, SignedSize> MapType_;
 
 public:
     /** @name Typedefs
@@ -283,11 +285,17 @@ protected:
     /// remove elements with count 0
     void removeZeroedElements_();
 
+    /// computes @p lhs + @p sign * @p rhs in a single pass over both (sorted) compositions, dropping zero counts
+    static MapType_ merge_(const MapType_& lhs, const MapType_& rhs, SignedSize sign);
+
+    /// adds @p sign * @p rhs to the counts without reallocating, if all elements of @p rhs are present already; returns false otherwise (nothing changed)
+    bool updateInPlace_(const MapType_& rhs, SignedSize sign);
+
     MapType_ formula_;
 
     Int charge_;
 
-    Int parseFormula_(std::map<const Element*, SignedSize>& ef, const String& formula) const;
+    Int parseFormula_(MapType_& ef, const String& formula) const;
 
   };
 
@@ -40,6 +40,7 @@
 
 #include <set>
 #include <memory>  // unique_ptr
+#include <shared_mutex>
 #include <unordered_map>
 
 namespace OpenMS
@@ -71,6 +72,13 @@ namespace OpenMS
       databases. This can be done by providing a path through
       initializeModificationsDB(), however it is important that this is done
       *before* the first call to getInstance().
+
+      Parsing the modification files is a large part of the startup time of
+      short tool runs. If the environment variable
+      OPENMS_MODIFICATIONSDB_SNAPSHOT is set to a file name, the parsed
+      modifications are cached in that file as a binary snapshot (see
+      storeSnapshot()) and loaded from there as long as the modification files
+      do not change. Without the variable, no file is written.
   */
   class OPENMS_DLLAPI ModificationsDB
   {
@@ -90,6 +98,33 @@ public:
     /// Returns the number of modifications read from the unimod.xml file
     Size getNumberOfModifications() const;
 
+    /**
+       @brief Stores all modifications as a binary snapshot
+
+       The data is written to a temporary file that is then renamed to @p filename, so concurrent readers never see a partial snapshot.
+
+       @param filename The snapshot file (its directory is created if necessary)
+       @param checksum Checksum of the modification files the data was read from (see computeSnapshotChecksum())
+       @return false if the snapshot could not be written
+    */
+    bool storeSnapshot(const String& filename, UInt32 checksum) const;
+
+    /**
+       @brief Loads modifications from a binary snapshot written by storeSnapshot()
+
+       @param filename The snapshot file
+       @param checksum Checksum of the current modification files; snapshots written for other files are rejected
+       @param mods The modifications
+       @param names The modifications for each name (pointing into @p mods)
+       @return false (with @p mods and @p names empty) if the file is missing, outdated, truncated or corrupt
+    */
+    static bool loadSnapshot(const String& filename, UInt32 checksum,
+                             std::vector<std::unique_ptr<ResidueModification> >& mods,
+                             std::unordered_map<String, std::set<const ResidueModification*> >& names);
+
+    /// Checksum over the names and content of modification files (empty names are skipped; 0 if a file cannot be read)
+    static UInt32 computeSnapshotChecksum(const std::vector<String>& files);
+
     /**
        @brief Returns the modification with the given index.
        note: out-of-bounds check is only performed in debug mode.
@@ -223,6 +258,9 @@ public:
     /// Stores the mappings of (unique) names to the modifications
     std::unordered_map<String, std::set<const ResidueModification*> > modification_names_;
 
+    /// Guards mods_ and modification_names_: lookups take a shared lock, additions an exclusive one
+    mutable std::shared_mutex mutex_;
+
     /** @brief Helper function to check if a residue matches the origin for a modification
      *
      * Special cases are handled as follows:
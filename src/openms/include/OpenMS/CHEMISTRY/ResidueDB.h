@@ -40,6 +40,7 @@
 
 #include <map>
 #include <set>
+#include <shared_mutex>
 
 namespace OpenMS
 {
@@ -183,6 +184,9 @@ protected:
     /// fast lookup table for residues  
     std::array<const Residue*, 256> residue_by_one_letter_code_ = {{nullptr}};
 
-    std::map<String, std::set<const Residue*> > residues_by_set_;    
+    std::map<String, std::set<const Residue*> > residues_by_set_;
+
+    /// guards the lookup tables: lookups take a shared lock, adding modified residues an exclusive one
+    mutable std::shared_mutex mutex_;
   };
 }
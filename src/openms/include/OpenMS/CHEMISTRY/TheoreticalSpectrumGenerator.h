@@ -101,6 +101,22 @@ namespace OpenMS
     /// @throw Exception::InvalidParameter   If fragmentation method is anything else than 'CID', 'HCID', 'ECD' or 'ETD'.
     static MSSpectrum generateSpectrum(const Precursor::ActivationMethod& fm, const AASequence& seq, int precursor_charge);
 
+    /**
+      @brief Computes only the sorted fragment ion m/z values of a peptide (fast path for search engines)
+
+      The prefix and suffix residue mass ladders are computed once per call and combined with the ion types
+      enabled in the parameters (a/b/c/x/y/z ions and "add_first_prefix_ion") for all charges from
+      @p min_charge to @p max_charge. The m/z values are the ones getSpectrum() generates for these ions.
+
+      Neither ion names, charges nor intensities are generated; losses, isotopes, precursor peaks and
+      immonium ions are ignored. @p mzs is cleared first, but its capacity is reused (no allocations if the
+      same buffer is passed for many peptides).
+
+      @param mzs Receives the fragment m/z values in ascending order
+      @throw Exception::InvalidSize if c- or x-ions are enabled and the peptide has only one residue
+    */
+    void getFragmentMZs(std::vector<double>& mzs, const AASequence& peptide, Int min_charge, Int max_charge) const;
+
     /// overwrite
     void updateMembers_() override;
     //@}
@@ -199,8 +199,8 @@ public:
     template <typename InputIterator, typename OutputIterator>
     void filterRange(InputIterator input_begin, InputIterator input_end, OutputIterator output_begin)
     {
-      // the buffer is static only to avoid reallocation
-      static std::vector<typename InputIterator::value_type> buffer;
+      // not static, so that filters can run concurrently (one instance per thread)
+      std::vector<typename InputIterator::value_type> buffer;
       const UInt size = input_end - input_begin;
 
       //determine the struct size in data points if not already set
@@ -351,8 +351,7 @@ protected:
       const Int size = input_end - input;
       const Int struc_size_half = struc_size / 2;           // yes, integer division
 
-      static std::vector<ValueType> buffer;
-      if (Int(buffer.size()) < struc_size) buffer.resize(struc_size);
+      std::vector<ValueType> buffer(struc_size);
 
       Int anchor;           // anchoring position of the current block
       Int i;                // index relative to anchor, used for 'for' loops
@@ -451,8 +450,7 @@ protected:
       const Int size = input_end - input;
       const Int struc_size_half = struc_size / 2;           // yes, integer division
 
-      static std::vector<ValueType> buffer;
-      if (Int(buffer.size()) < struc_size) buffer.resize(struc_size);
+      std::vector<ValueType> buffer(struc_size);
 
       Int anchor;           // anchoring position of the current block
       Int i;                // index relative to anchor, used for 'for' loops
@@ -851,8 +851,8 @@ public:
                                   double threshold_score)
     {
         struct HasGoodScore<typename IdentificationType::HitType> score_filter(
-            threshold_score, id->isHigherScoreBetter());
-        keepMatchingItems(id->getHits(), score_filter);
+            threshold_score, id.isHigherScoreBetter());
+        keepMatchingItems(id.getHits(), score_filter);
     }
 
     /**
@@ -42,6 +42,11 @@
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 #include <vector>
 #include <algorithm> //for std::max_element
+#include <exception>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace OpenMS
 {
@@ -177,8 +182,95 @@ public:
       return histogram_oob_percent_;
     }
 
+    /**
+      @brief Estimates the S/N of all data points of several containers (e.g. all spectra of an MSExperiment) in parallel
+
+      Each thread works on its own copy of this estimator (with the current parameters), the state of this object
+      is not changed. Progress of the individual estimations is not logged.
+
+      @param containers The data, e.g. MSExperiment::getSpectra()
+      @return For each container, the S/N of each data point (same as getSignalToNoise() after init())
+
+      @exception Throws Exception::InvalidValue (see init())
+    */
+    std::vector<std::vector<double> > estimateBatch(const std::vector<Container>& containers) const
+    {
+      std::vector<std::vector<double> > result(containers.size());
+      std::exception_ptr error;
+
+#pragma omp parallel
+      {
+        SignalToNoiseEstimatorMedian estimator(*this);
+        estimator.setLogType(ProgressLogger::NONE);
+
+#pragma omp for schedule(dynamic)
+        for (SignedSize i = 0; i < (SignedSize)containers.size(); ++i)
+        {
+          try
+          {
+            if (containers[i].empty()) continue;
+            estimator.init(containers[i]);
+            result[i].swap(estimator.stn_estimates_);
+          }
+          catch (...)
+          {
+#pragma omp critical (SignalToNoiseEstimatorMedian_error)
+            if (!error) error = std::current_exception();
+          }
+        }
+      }
+      if (error) std::rethrow_exception(error);
+
+      return result;
+    }
+
 protected:
 
+    /**
+      @brief Histogram of the intensities in the current window, stored as a Fenwick tree (binary indexed tree)
+
+      Adding/removing a data point and finding the bin which contains the k-th smallest intensity are both
+      logarithmic in the number of bins.
+    */
+    class WindowHistogram_
+    {
+public:
+      explicit WindowHistogram_(int bin_count) :
+        tree_(bin_count + 1, 0),
+        top_step_(1)
+      {
+        while (top_step_ * 2 <= bin_count) top_step_ *= 2;
+      }
+
+      /// changes the number of elements in @p bin by @p delta
+      void add(int bin, int delta)
+      {
+        for (Size i = bin + 1; i < tree_.size(); i += i & (~i + 1))
+        {
+          tree_[i] += delta;
+        }
+      }
+
+      /// smallest bin b with at least @p k elements in bins [0, b]; the number of bins if there are fewer elements
+      int findKth(int k) const
+      {
+        Size pos = 0;
+        for (Size step = top_step_; step > 0; step /= 2)
+        {
+          if (pos + step < tree_.size() && tree_[pos + step] < k)
+          {
+            pos += step;
+            k -= tree_[pos];
+          }
+        }
+        return (int)pos;
+      }
+
+private:
+      std::vector<int> tree_;
+      Size top_step_;
+    };
+
 
     /** Calculate signal-to-noise values for all data points given, by using a sliding window approach
      
@@ -278,12 +370,11 @@ protected:
       double bin_size = std::max(1.0, max_intensity_ / bin_count_); // at least size of 1 for intensity bins
       int bin_count_minus_1 = bin_count_ - 1;
 
-      std::vector<int> histogram(bin_count_, 0);
+      WindowHistogram_ histogram(bin_count_);
       std::vector<double> bin_value(bin_count_, 0);
       // calculate average intensity that is represented by a bin
       for (int bin = 0; bin < bin_count_; bin++)
       {
-        histogram[bin] = 0;
         bin_value[bin] = (bin + 0.5) * bin_size;
       }
       // bin in which a datapoint would fall
@@ -291,8 +382,6 @@ protected:
 
       // index of bin where the median is located
       int median_bin = 0;
-      // additive number of elements from left to x in histogram
-      int element_inc_count = 0;
 
       // tracks elements in current window, which may vary because of unevenly spaced data
       int elements_in_window = 0;
@@ -315,7 +404,7 @@ protected:
         while ((*window_pos_borderleft).getMZ() <  (*window_pos_center).getMZ() - window_half_size)
         {
           to_bin = std::max(std::min<int>((int)((*window_pos_borderleft).getIntensity() / bin_size), bin_count_minus_1), 0);
-          --histogram[to_bin];
+          histogram.add(to_bin, -1);
           --elements_in_window;
           ++window_pos_borderleft;
         }
@@ -326,7 +415,7 @@ protected:
         {
           //std::cerr << (*window_pos_borderright).getIntensity() << " " << bin_size << " " << bin_count_minus_1 << std::endl;
           to_bin = std::max(std::min<int>((int)((*window_pos_borderright).getIntensity() / bin_size), bin_count_minus_1), 0);
-          ++histogram[to_bin];
+          histogram.add(to_bin, 1);
           ++elements_in_window;
           ++window_pos_borderright;
         }
@@ -339,14 +428,8 @@ protected:
         else
         {
           // find bin i where ceil[elements_in_window/2] <= sum_c(0..i){ histogram[c] }
-          median_bin = -1;
-          element_inc_count = 0;
           element_in_window_half = (elements_in_window + 1) / 2;
-          while (median_bin < bin_count_minus_1 && element_inc_count < element_in_window_half)
-          {
-            ++median_bin;
-            element_inc_count += histogram[median_bin];
-          }
+          median_bin = std::min(histogram.findKth(element_in_window_half), bin_count_minus_1);
 
           // increase the error count
           if (median_bin == bin_count_minus_1) {++histogram_oob_percent_; }
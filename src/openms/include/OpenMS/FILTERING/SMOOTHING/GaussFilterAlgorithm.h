@@ -37,7 +37,9 @@
 #include <OpenMS/CONCEPT/Types.h>
 #include <OpenMS/CONCEPT/Constants.h>
 #include <OpenMS/INTERFACES/DataStructures.h>
+#include <algorithm>
 #include <cmath>
+#include <iterator>
 #include <vector>
 
 namespace OpenMS
@@ -61,6 +63,11 @@ namespace OpenMS
 
     @note The data must be sorted according to ascending m/z!
 
+    @note Equidistant data is convolved with a precomputed discrete kernel (see filter()). This loop is written for
+          auto-vectorization, there is no hand-written SIMD code and no dispatch at runtime, so its speed depends on
+          the instruction set the library is compiled for (SSE2 for a default x86-64 build, AVX2 only when building
+          with e.g. -march=haswell).
+
     @ingroup SignalProcessing
   */
 
@@ -127,6 +134,10 @@ public:
       @brief Smoothes an two data arrays containing data.
 
       Convolutes the filter and the profile data and writes the results into the output iterators mz_out and int_out. 
+
+      If the data points are equidistant (e.g. chromatograms or resampled spectra) and no ppm tolerance is used,
+      the interpolated kernel is the same for every data point and the convolution is carried out with a
+      precomputed discrete kernel (see filterEquidistant_()).
     */
     template <typename ConstIterT, typename IterT>
     bool filter(
@@ -136,6 +147,17 @@ public:
         IterT mz_out,
         IterT int_out)
     {
+      double data_spacing(0);
+      if (!use_ppm_tolerance_ && isEquidistant_(mz_in_start, mz_in_end, data_spacing))
+      {
+        std::vector<double> intensities(int_in_start, int_in_start + std::distance(mz_in_start, mz_in_end));
+        std::vector<double> smoothed;
+        bool found_signal = filterEquidistant_(intensities, data_spacing, smoothed);
+        std::copy(mz_in_start, mz_in_end, mz_out);
+        std::copy(smoothed.begin(), smoothed.end(), int_out);
+        return found_signal;
+      }
+
       bool found_signal = false;
 
       ConstIterT mz_it = mz_in_start;
@@ -176,6 +198,44 @@ protected:
     bool use_ppm_tolerance_;
     double ppm_tolerance_;
 
+    /**
+      @brief Checks whether the positions in [first, last) lie on a regular grid
+
+      Every position has to deviate less than 1e-8 * @p data_spacing from its grid position, which only allows for
+      rounding errors. At least three data points are required.
+    */
+    template <typename ConstIterT>
+    static bool isEquidistant_(ConstIterT first, ConstIterT last, double& data_spacing)
+    {
+      const SignedSize n = std::distance(first, last);
+      if (n < 3) return false;
+
+      data_spacing = (*(last - 1) - *first) / (n - 1);
+      if (!(data_spacing > 0)) return false;
+
+      const double tolerance = data_spacing * 1e-8;
+      SignedSize i = 0;
+      for (ConstIterT it = first; it != last; ++it, ++i)
+      {
+        if (fabs(*it - (*first + i * data_spacing)) > tolerance) return false;
+      }
+      return true;
+    }
+
+    /**
+      @brief Convolutes equidistant data with the gaussian kernel
+
+      Gives the same result as integrate_() for every data point (up to rounding): the trapezoidal integration
+      reduces to a discrete convolution with a fixed kernel for all points whose window is not truncated by the
+      ends of the data, and to a truncated kernel with its own normalization close to the ends.
+
+      @return true if any smoothed intensity is non-zero
+    */
+    bool filterEquidistant_(const std::vector<double>& intensities, double data_spacing, std::vector<double>& smoothed) const;
+
+    /// Linear interpolation of the pre-tabulated coefficients at the given distance from the center
+    double interpolateCoefficient_(double distance) const;
+
     /// Computes the convolution of the raw data at position x and the gaussian kernel
     template <typename InputPeakIterator>
     double integrate_(InputPeakIterator x /* mz */, InputPeakIterator y /* int */, InputPeakIterator first, InputPeakIterator last)
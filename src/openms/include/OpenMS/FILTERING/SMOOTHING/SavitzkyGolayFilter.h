@@ -39,6 +39,8 @@
 #include <OpenMS/KERNEL/StandardTypes.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 
+#include <vector>
+
 namespace OpenMS
 {
   /**
@@ -94,6 +96,11 @@ namespace OpenMS
 
         @note The data must be sorted according to ascending m/z!
 
+        @note The smoothing loop of filterIntensities() (used by filter() for spectra and chromatograms) is written for
+              auto-vectorization, there is no hand-written SIMD code and no dispatch at runtime. Its speed therefore
+              depends on the instruction set the library is compiled for (SSE2 for a default x86-64 build, AVX2 only
+              when building with e.g. -march=haswell).
+
         @htmlinclude OpenMS_SavitzkyGolayFilter.parameters
 
     @ingroup SignalProcessing
@@ -184,15 +191,13 @@ public:
 
     /**
       @brief Removed the noise from an MSSpectrum containing profile data.
+
+      The intensities are smoothed in place on a contiguous copy (see filterIntensities()), the result is
+      identical to the iterator version above.
     */
     void filter(MSSpectrum & spectrum)
     {
-      // copy the data AND META DATA to the output container
-      MSSpectrum output = spectrum;
-      // filter
-      filter(spectrum.begin(), spectrum.end(), output.begin());
-      // swap back
-      std::swap(spectrum, output);
+      filterContainer_(spectrum);
     }
 
     /**
@@ -200,14 +205,21 @@ public:
     */
     void filter(MSChromatogram & chromatogram)
     {
-      // copy the data AND META DATA to the output container
-      MSChromatogram output = chromatogram;
-      // filter
-      filter(chromatogram.begin(), chromatogram.end(), output.begin());
-      // swap back
-      std::swap(chromatogram, output);
+      filterContainer_(chromatogram);
     }
 
+    /**
+      @brief Smoothes a contiguous array of intensities.
+
+      Equivalent to the iterator version of filter() (including the clamping of negative values to zero), but
+      the steady state is computed as a sequence of scaled vector additions over contiguous memory which the
+      compiler can vectorize (SSE2/AVX, depending on the target architecture the library is built for).
+      Each output value accumulates its products in the same order as the iterator version.
+
+      If the input is shorter than the frame length, @p output is a copy of @p input.
+    */
+    void filterIntensities(const std::vector<double>& input, std::vector<double>& output) const;
+
     /**
       @brief Removed the noise from an MSExperiment containing profile data.
     */
@@ -240,6 +252,25 @@ protected:
 
     // Docu in base class
     void updateMembers_() override;
+
+    /// Smoothes the intensities of a spectrum or chromatogram in place
+    template <typename ContainerT>
+    void filterContainer_(ContainerT & container) const
+    {
+      if (frame_size_ > container.size()) { return; }
+
+      std::vector<double> intensities(container.size());
+      for (Size i = 0; i < container.size(); ++i)
+      {
+        intensities[i] = container[i].getIntensity();
+      }
+      std::vector<double> smoothed;
+      filterIntensities(intensities, smoothed);
+      for (Size i = 0; i < container.size(); ++i)
+      {
+        container[i].setIntensity(smoothed[i]);
+      }
+    }
   };
 
 } // namespace OpenMS
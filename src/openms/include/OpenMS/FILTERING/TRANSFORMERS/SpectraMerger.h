@@ -199,95 +199,56 @@ public:
       exp.sortSpectra();
     }
 
-    /// merges spectra with similar precursors (must have MS2 level)
+    /**
+      @brief merges spectra with similar precursors (must have MS2 level)
+
+      Two spectra are linked if their precursors are within both precursor_method:mz_tolerance and
+      precursor_method:rt_tolerance, and all spectra connected by such links are merged (single linkage).
+      Each block is merged into the spectrum with the lowest index.
+    */
     template <typename MapType>
     void mergeSpectraPrecursors(MapType& exp)
     {
-
       // convert spectra's precursors to clusterizable data
-      Size data_size;
-      std::vector<BinaryTreeNode> tree;
-      Map<Size, Size> index_mapping;
-      // local scope to save memory - we do not need the clustering stuff later
+      std::vector<BaseFeature> data;
+      std::vector<Size> index_mapping; // index in data ==> experiment index
+      for (Size i = 0; i < exp.size(); ++i)
       {
-        std::vector<BaseFeature> data;
-
-        for (Size i = 0; i < exp.size(); ++i)
+        if (exp[i].getMSLevel() != 2)
         {
-          if (exp[i].getMSLevel() != 2)
-          {
-            continue;
-          }
-
-          // remember which index in distance data ==> experiment index
-          index_mapping[data.size()] = i;
-
-          // make cluster element
-          BaseFeature bf;
-          bf.setRT(exp[i].getRT());
-          std::vector<Precursor> pcs = exp[i].getPrecursors();
-          if (pcs.empty())
-          {
-            throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Scan #") + String(i) + " does not contain any precursor information! Unable to cluster!");
-          }
-          if (pcs.size() > 1)
-          {
-            OPENMS_LOG_WARN << "More than one precursor found. Using first one!" << std::endl;
-          }
-          bf.setMZ(pcs[0].getMZ());
-          data.push_back(bf);
+          continue;
         }
-        data_size = data.size();
-
-        SpectraDistance_ llc;
-        llc.setParameters(param_.copy("precursor_method:", true));
-        SingleLinkage sl;
-        DistanceMatrix<float> dist; // will be filled
-        ClusterHierarchical ch;
 
-        //ch.setThreshold(0.99);
-        // clustering ; threshold is implicitly at 1.0, i.e. distances of 1.0 (== similarity 0) will not be clustered
-        ch.cluster<BaseFeature, SpectraDistance_>(data, llc, sl, tree, dist);
-      }
+        // remember which index in distance data ==> experiment index
+        index_mapping.push_back(i);
 
-      // extract the clusters
-      ClusterAnalyzer ca;
-      std::vector<std::vector<Size> > clusters;
-      // count number of real tree nodes (not the -1 ones):
-      Size node_count = 0;
-      for (Size ii = 0; ii < tree.size(); ++ii)
-      {
-        if (tree[ii].distance >= 1)
+        // make cluster element
+        BaseFeature bf;
+        bf.setRT(exp[i].getRT());
+        const std::vector<Precursor>& pcs = exp[i].getPrecursors();
+        if (pcs.empty())
         {
-          tree[ii].distance = -1;  // manually set to disconnect, as SingleLinkage does not support it
+          throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Scan #") + String(i) + " does not contain any precursor information! Unable to cluster!");
         }
-        if (tree[ii].distance != -1)
+        if (pcs.size() > 1)
         {
-          ++node_count;
+          OPENMS_LOG_WARN << "More than one precursor found. Using first one!" << std::endl;
         }
+        bf.setMZ(pcs[0].getMZ());
+        data.push_back(bf);
       }
-      ca.cut(data_size - node_count, tree, clusters);
 
-      //std::cerr << "Treesize: " << (tree.size()+1) << "   #clusters: " << clusters.size() << std::endl;
-      //std::cerr << "tree:\n" << ca.newickTree(tree, true) << "\n";
+      std::vector<std::vector<Size> > clusters = clusterPrecursors_(data);
 
       // convert to blocks
       MergeBlocks spectra_to_merge;
-
       for (Size i_outer = 0; i_outer < clusters.size(); ++i_outer)
       {
-        if (clusters[i_outer].size() <= 1)
-        {
-          continue;
-        }
-        // init block with first cluster element
-        Size cl_index0 = clusters[i_outer][0];
-        spectra_to_merge[index_mapping[cl_index0]] = std::vector<Size>();
-        // add all other elements
+        // init block with first cluster element and add all other elements
+        std::vector<Size>& block = spectra_to_merge[index_mapping[clusters[i_outer][0]]];
         for (Size i_inner = 1; i_inner < clusters[i_outer].size(); ++i_inner)
         {
-          Size cl_index = clusters[i_outer][i_inner];
-          spectra_to_merge[index_mapping[cl_index0]].push_back(index_mapping[cl_index]);
+          block.push_back(index_mapping[clusters[i_outer][i_inner]]);
         }
       }
 
@@ -479,6 +440,17 @@ public:
 
 protected:
 
+    /**
+        @brief single linkage clustering of precursors, as done by ClusterHierarchical with SingleLinkage and SpectraDistance_
+
+        Only pairs within precursor_method:mz_tolerance of each other are compared (sweep over the precursors
+        sorted by m/z, in parallel), and clusters are the connected components of all pairs with a similarity
+        above zero. Memory and time therefore scale with the number of candidate pairs instead of quadratically.
+
+        @return clusters with at least two elements, each sorted by index
+    */
+    std::vector<std::vector<Size> > clusterPrecursors_(const std::vector<BaseFeature>& data) const;
+
     /**
         @brief merges blocks of spectra of a certain level
 
@@ -0,0 +1,144 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/INTERFACES/IIdentificationConsumer.h>
+
+#include <OpenMS/METADATA/PeptideIdentification.h>
+#include <OpenMS/METADATA/ProteinIdentification.h>
+
+#include <functional>
+#include <vector>
+
+namespace OpenMS
+{
+
+  /**
+    @brief Consumer class that filters identifications before passing them on
+
+    Filters are applied to every identification as it is consumed ("push-down"
+    into the reader), so that identifications that are removed anyway never
+    need to be held in memory. Filtered identifications are either forwarded
+    to another consumer or stored in vectors provided by the caller.
+
+    Filters are applied in the order in which they were added. Only filters
+    that can be decided for one identification at a time are supported
+    here; filters that need to see all identifications (e.g. "best n
+    spectra", FDR calculation) have to be applied afterwards.
+
+    Example: load only the best hit of each spectrum, without decoys:
+    @code
+    IdentificationFilteringConsumer consumer(proteins, peptides);
+    consumer.removeDecoyHits();
+    consumer.keepNBestPeptideHits(1);
+    consumer.removeEmptyIdentifications();
+    IdXMLFile().load(filename, &consumer);
+    @endcode
+  */
+  class OPENMS_DLLAPI IdentificationFilteringConsumer :
+    public Interfaces::IIdentificationConsumer
+  {
+  public:
+
+    /// Filter function for peptide identifications; may modify the argument and returns whether to keep it
+    typedef std::function<bool(PeptideIdentification&)> PeptideFilter;
+
+    /// Filter function for protein identifications; may modify the argument (protein identifications are never discarded)
+    typedef std::function<void(ProteinIdentification&)> ProteinFilter;
+
+    /// Constructor - forward filtered identifications to @p next_consumer
+    explicit IdentificationFilteringConsumer(Interfaces::IIdentificationConsumer* next_consumer);
+
+    /// Constructor - store filtered identifications in @p protein_ids and @p peptide_ids
+    IdentificationFilteringConsumer(std::vector<ProteinIdentification>& protein_ids,
+                                    std::vector<PeptideIdentification>& peptide_ids);
+
+    void consumeProteinIdentification(ProteinIdentification& protein_id) override;
+
+    void consumePeptideIdentification(PeptideIdentification& peptide_id) override;
+
+    /// Add a custom filter for peptide identifications
+    void addPeptideFilter(const PeptideFilter& filter);
+
+    /// Add a custom filter for protein identifications
+    void addProteinFilter(const ProteinFilter& filter);
+
+    /// Keep only peptide identifications with precursor RT in the given range (see IDFilter::filterPeptidesByRT)
+    void filterPeptidesByRT(double min_rt, double max_rt);
+
+    /// Keep only peptide identifications with precursor m/z in the given range (see IDFilter::filterPeptidesByMZ)
+    void filterPeptidesByMZ(double min_mz, double max_mz);
+
+    /// Keep only peptide hits with a charge in the given range (see IDFilter::filterPeptidesByCharge)
+    void filterPeptidesByCharge(Int min_charge, Int max_charge);
+
+    /// Keep only peptide hits that are at least as good as @p threshold_score (see IDFilter::filterHitsByScore)
+    void filterPeptideHitsByScore(double threshold_score);
+
+    /// Keep only protein hits that are at least as good as @p threshold_score (see IDFilter::filterHitsByScore)
+    void filterProteinHitsByScore(double threshold_score);
+
+    /// Keep only the @p n best hits of every peptide identification (see IDFilter::keepNBestHits)
+    void keepNBestPeptideHits(Size n);
+
+    /// Remove peptide and protein hits annotated as decoys (see IDFilter::removeDecoyHits)
+    void removeDecoyHits();
+
+    /// Discard peptide identifications without hits (after all other filters were applied)
+    void removeEmptyIdentifications();
+
+    /// Return the number of peptide identifications consumed so far
+    Size getNumberOfConsumedPeptideIdentifications() const;
+
+    /// Return the number of peptide identifications passed on so far
+    Size getNumberOfAcceptedPeptideIdentifications() const;
+
+  protected:
+
+    /// Next consumer (may be null if identifications are stored)
+    Interfaces::IIdentificationConsumer* next_consumer_;
+
+    /// Target vectors for storing (may be null if identifications are forwarded)
+    std::vector<ProteinIdentification>* protein_ids_;
+    std::vector<PeptideIdentification>* peptide_ids_;
+
+    std::vector<PeptideFilter> peptide_filters_;
+    std::vector<ProteinFilter> protein_filters_;
+
+    Size n_consumed_;
+    Size n_accepted_;
+  };
+
+} //end namespace OpenMS
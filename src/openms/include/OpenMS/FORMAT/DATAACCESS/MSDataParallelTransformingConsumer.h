@@ -0,0 +1,197 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
+
+#include <OpenMS/KERNEL/StandardTypes.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+#include <OpenMS/KERNEL/MSChromatogram.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace OpenMS
+{
+
+    /**
+      @brief Transforming consumer of MS data which processes spectra and chromatograms in parallel
+
+      Spectra (and chromatograms) are collected into blocks. Once a block is full, all of its
+      entries are processed in parallel and then passed on to the next consumer in their
+      original order. Memory use is therefore bounded by the block size, independent of the
+      size of the input file.
+
+      Each thread works on its own processing function, created by a user-provided factory.
+      This allows to use filters which are not thread-safe (e.g. because they keep internal
+      buffers) by giving every thread its own copy of the filter.
+
+      Spectra and chromatograms are never reordered relative to each other: pending spectra
+      are processed and passed on before the first chromatogram is collected (and vice versa).
+      Call flush() after the last spectrum/chromatogram was consumed. The destructor flushes
+      as well, but cannot report errors.
+
+      The same functions can be applied to a map in memory using processExperiment().
+
+      Usage:
+
+      @code
+      SavitzkyGolayFilter sgolay;
+      MSDataWritingConsumer writing_consumer(out_file);
+      MSDataParallelTransformingConsumer parallel_consumer(&writing_consumer);
+      parallel_consumer.setSpectraProcessingFactory([&sgolay]()
+      {
+        auto filter = std::make_shared<SavitzkyGolayFilter>(sgolay); // one copy per thread
+        return [filter](MSSpectrum& s) { filter->filter(s); };
+      });
+      MzMLFile().transform(in_file, &parallel_consumer);
+      parallel_consumer.flush();
+      @endcode
+
+      @note The data of a consumed spectrum/chromatogram is moved into the internal buffer, i.e. the
+      passed object is left empty. Do not combine with options that keep the consumed data
+      (e.g. PeakFileOptions::setAlwaysAppendData).
+    */
+    class OPENMS_DLLAPI MSDataParallelTransformingConsumer :
+      public Interfaces::IMSDataConsumer
+    {
+
+    public:
+
+      typedef std::function<void (SpectrumType&)> SpectrumProcessingFunc;
+      typedef std::function<void (ChromatogramType&)> ChromatogramProcessingFunc;
+      /// Creates the processing function of one thread (called once per thread, not concurrently)
+      typedef std::function<SpectrumProcessingFunc ()> SpectrumProcessingFactory;
+      /// Creates the processing function of one thread (called once per thread, not concurrently)
+      typedef std::function<ChromatogramProcessingFunc ()> ChromatogramProcessingFactory;
+
+      /**
+        @brief Constructor
+
+        @param next_consumer Receives the processed data in input order (not owned, may be nullptr if only processExperiment() is used)
+        @param block_size Number of spectra (chromatograms) processed together (0 = 32 per available thread)
+      */
+      explicit MSDataParallelTransformingConsumer(Interfaces::IMSDataConsumer* next_consumer, Size block_size = 0);
+
+      /// Destructor (flushes pending data)
+      ~MSDataParallelTransformingConsumer() override;
+
+      /// Passed on to the next consumer
+      void setExpectedSize(Size expectedSpectra, Size expectedChromatograms) override;
+
+      /// Passed on to the next consumer
+      void setExperimentalSettings(const ExperimentalSettings& exp) override;
+
+      void consumeSpectrum(SpectrumType& s) override;
+
+      void consumeChromatogram(ChromatogramType& c) override;
+
+      /**
+        @brief Sets the factory for the per-thread spectrum processing functions
+
+        Pass a nullptr if spectra should be passed on unchanged.
+      */
+      void setSpectraProcessingFactory(SpectrumProcessingFactory factory);
+
+      /**
+        @brief Sets the factory for the per-thread chromatogram processing functions
+
+        Pass a nullptr if chromatograms should be passed on unchanged.
+      */
+      void setChromatogramProcessingFactory(ChromatogramProcessingFactory factory);
+
+      /**
+        @brief Processes and passes on all pending spectra and chromatograms
+
+        @throw Exceptions thrown by the processing functions are rethrown here (or in consumeSpectrum/consumeChromatogram)
+      */
+      void flush();
+
+      /**
+        @brief Applies the processing functions to all spectra and chromatograms of @p exp in place (in parallel)
+
+        Nothing is passed on to the next consumer.
+      */
+      void processExperiment(PeakMap& exp);
+
+      /// Number of spectra (chromatograms) processed together
+      Size getBlockSize() const;
+
+      /**
+        @brief Creates a factory which gives every thread its own copy of @p filter and calls @p method on it
+
+        Example: @code consumer.setSpectraProcessingFactory(MSDataParallelTransformingConsumer::copyPerThread(nlargest, &NLargest::filterPeakSpectrum)); @endcode
+        For overloaded methods, specify the template arguments, e.g. <tt>copyPerThread<SavitzkyGolayFilter, MSSpectrum>(sgolay, &SavitzkyGolayFilter::filter)</tt>.
+      */
+      template <typename FilterType, typename DataType>
+      static std::function<std::function<void (DataType&)> ()> copyPerThread(const FilterType& filter, void (FilterType::*method)(DataType&))
+      {
+        return [filter, method]()
+        {
+          auto thread_filter = std::make_shared<FilterType>(filter);
+          return std::function<void (DataType&)>([thread_filter, method](DataType& d) { ((*thread_filter).*method)(d); });
+        };
+      }
+
+      /// Overload for const methods
+      template <typename FilterType, typename DataType>
+      static std::function<std::function<void (DataType&)> ()> copyPerThread(const FilterType& filter, void (FilterType::*method)(DataType&) const)
+      {
+        return [filter, method]()
+        {
+          auto thread_filter = std::make_shared<const FilterType>(filter);
+          return std::function<void (DataType&)>([thread_filter, method](DataType& d) { ((*thread_filter).*method)(d); });
+        };
+      }
+
+    protected:
+      void flushSpectra_();
+      void flushChromatograms_();
+
+      Interfaces::IMSDataConsumer* next_consumer_;
+      Size block_size_;
+
+      SpectrumProcessingFactory spectra_factory_;
+      ChromatogramProcessingFactory chrom_factory_;
+      /// one processing function per thread, created on first use
+      std::vector<SpectrumProcessingFunc> spectra_funcs_;
+      std::vector<ChromatogramProcessingFunc> chrom_funcs_;
+
+      std::vector<SpectrumType> spectra_;
+      std::vector<ChromatogramType> chromatograms_;
+    };
+
+} //end namespace OpenMS
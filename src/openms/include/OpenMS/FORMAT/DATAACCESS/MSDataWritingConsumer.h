@@ -76,6 +76,10 @@ namespace OpenMS
       @note The first usage of consumeChromatogram or consumeSpectrum will start
       writing of the mzML header to disk (and the first element).
 
+      @note Spectra and chromatograms are buffered in small batches whose binary
+      data arrays are encoded in parallel; the batches are written to disk in the
+      order in which the data was consumed.
+
       @note Currently it is not possible to add spectra after having already added
       chromatograms since this could lead to a situation with multiple
       @a spectrumList tags appear in an mzML file.
@@ -195,6 +199,12 @@ namespace OpenMS
       */
       virtual void doCleanup_();
 
+      /// Encode and write all buffered spectra
+      void flushSpectra_();
+
+      /// Encode and write all buffered chromatograms
+      void flushChromatograms_();
+
     protected:
 
       /// File stream (to write mzML)
@@ -226,6 +236,10 @@ namespace OpenMS
       std::vector<std::vector< ConstDataProcessingPtr > > dps_;
       /// The dataprocessing to be added to each spectrum/chromatogram
       DataProcessingPtr additional_dataprocessing_;
+      /// Processed spectra which are not yet written to disk
+      std::vector<SpectrumType> spectra_buffer_;
+      /// Processed chromatograms which are not yet written to disk
+      std::vector<ChromatogramType> chromatograms_buffer_;
     };
 
     /**
@@ -4,9 +4,11 @@ set(directory include/OpenMS/FORMAT/DATAACCESS)
 ### list all header files of the directory here
 set(sources_list_h
   CsiFingerIdMzTabWriter.h
+  IdentificationFilteringConsumer.h
   MSDataAggregatingConsumer.h
   MSDataCachedConsumer.h
   MSDataChainingConsumer.h
+  MSDataParallelTransformingConsumer.h
   MSDataStoringConsumer.h
   MSDataSqlConsumer.h
   MSDataTransformingConsumer.h
@@ -39,12 +39,17 @@
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/FORMAT/OPTIONS/PeakFileOptions.h>
 
+#include <vector>
+
 namespace OpenMS
 {
   class PeakFileOptions;
   class MSSpectrum;
   class MSExperiment;
   class FeatureMap;
+  class ConsensusMap;
+  class PeptideIdentification;
+  class ProteinIdentification;
 
   /**
     @brief Facilitates file handling by file type recognition.
@@ -182,6 +187,72 @@ public:
     */
     bool loadFeatures(const String& filename, FeatureMap& map, FileTypes::Type force_type = FileTypes::UNKNOWN);
 
+    /**
+      @brief Stores a FeatureMap to a file
+
+      The file type to store the data in is determined by the file name. Supported formats for storing are featureXML and featureBin. If the file format cannot be determined from the file name, the featureXML format is used.
+
+      @param filename The name of the file to store the data in.
+      @param map The FeatureMap to store.
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be written
+    */
+    void storeFeatures(const String& filename, const FeatureMap& map);
+
+    /**
+      @brief Loads a file into a ConsensusMap
+
+      @param filename the file name of the file to load.
+      @param map The ConsensusMap to load the data into.
+      @param force_type Forces to load the file with that file type. If no type is forced, it is determined from the extension (or from the content if that fails).
+
+      @return true if the file could be loaded, false otherwise
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if an error occurs during parsing
+    */
+    bool loadConsensusFeatures(const String& filename, ConsensusMap& map, FileTypes::Type force_type = FileTypes::UNKNOWN);
+
+    /**
+      @brief Stores a ConsensusMap to a file
+
+      The file type to store the data in is determined by the file name. Supported formats for storing are consensusXML and consensusBin. If the file format cannot be determined from the file name, the consensusXML format is used.
+
+      @param filename The name of the file to store the data in.
+      @param map The ConsensusMap to store.
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be written
+    */
+    void storeConsensusFeatures(const String& filename, const ConsensusMap& map);
+
+    /**
+      @brief Loads protein and peptide identifications from a file
+
+      @param filename the file name of the file to load.
+      @param protein_ids The protein identifications.
+      @param peptide_ids The peptide identifications.
+      @param force_type Forces to load the file with that file type. If no type is forced, it is determined from the extension (or from the content if that fails).
+
+      @return true if the file could be loaded, false otherwise
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if an error occurs during parsing
+    */
+    bool loadIdentifications(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids, FileTypes::Type force_type = FileTypes::UNKNOWN);
+
+    /**
+      @brief Stores protein and peptide identifications to a file
+
+      The file type to store the data in is determined by the file name. Supported formats for storing are idXML and idBin. If the file format cannot be determined from the file name, the idXML format is used.
+
+      @param filename The name of the file to store the data in.
+      @param protein_ids The protein identifications.
+      @param peptide_ids The peptide identifications.
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be written
+    */
+    void storeIdentifications(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids);
+
     /**
       @brief Computes a SHA-1 hash value for the content of the given file.
 
@@ -116,6 +116,9 @@ namespace OpenMS
       XML,                ///< any XML format
       BZ2,                ///< any BZ2 compressed file
       GZ,                 ///< any Gzipped file
+      FEATUREBIN,         ///< %OpenMS binary feature map format (.featureBin)
+      CONSENSUSBIN,       ///< %OpenMS binary consensus map format (.consensusBin)
+      IDBIN,              ///< %OpenMS binary identification format (.idBin)
       SIZE_OF_TYPE        ///< No file type. Simply stores the number of types
     };
 
@@ -317,12 +317,61 @@ protected:
                           bool renew_native_ids,
                           std::vector<std::vector< ConstDataProcessingPtr > >& dps);
 
+      /**
+        @brief Write out the spectra in the range [@p begin, @p end) of @p spectra
+
+        The spectra are encoded (Base64, zlib, numpress) in parallel into separate
+        buffers which are then written to @p os in their original order, recording
+        the offsets required for the indexedmzML footer.
+
+        @param spec_idx Index (in the spectrumList) of the spectrum at position @p begin
+      */
+      void writeSpectra_(std::ostream& os,
+                         const std::vector<SpectrumType>& spectra,
+                         Size begin,
+                         Size end,
+                         Size spec_idx,
+                         const Internal::MzMLValidator& validator,
+                         bool renew_native_ids,
+                         std::vector<std::vector< ConstDataProcessingPtr > >& dps);
+
+      /// Write out the \<spectrum\> element without recording its offset (may be called concurrently)
+      void writeSpectrumContent_(std::ostream& os,
+                                 const SpectrumType& spec,
+                                 Size spec_idx,
+                                 const String& native_id,
+                                 const Internal::MzMLValidator& validator,
+                                 const std::vector<std::vector< ConstDataProcessingPtr > >& dps);
+
       /// Write out a single chromatogram
       void writeChromatogram_(std::ostream& os,
                               const ChromatogramType& chromatogram,
                               Size chrom_idx,
                               const Internal::MzMLValidator& validator);
 
+      /**
+        @brief Write out the chromatograms in the range [@p begin, @p end) of @p chromatograms
+
+        Like writeSpectra_(), chromatograms are encoded in parallel and written in order.
+
+        @param chrom_idx Index (in the chromatogramList) of the chromatogram at position @p begin
+      */
+      void writeChromatograms_(std::ostream& os,
+                               const std::vector<ChromatogramType>& chromatograms,
+                               Size begin,
+                               Size end,
+                               Size chrom_idx,
+                               const Internal::MzMLValidator& validator);
+
+      /// Write out the \<chromatogram\> element without recording its offset (may be called concurrently)
+      void writeChromatogramContent_(std::ostream& os,
+                                     const ChromatogramType& chromatogram,
+                                     Size chrom_idx,
+                                     const Internal::MzMLValidator& validator);
+
+      /// Number of spectra/chromatograms encoded together by writeSpectra_() / writeChromatograms_() (depends on the number of threads)
+      static Size getWriteBatchSize_();
+
       template <typename ContainerT>
       void writeContainerData_(std::ostream& os, const PeakFileOptions& pf_options_, const ContainerT& container, String array_type);
 
@@ -411,6 +460,8 @@ protected:
       //@{
       /// The current spectrum
       SpectrumType spec_;
+      /// Instrument settings and source files shared by the loaded spectra
+      SpectrumSettings::SharedSettingsPool shared_settings_;
       /// The current chromatogram
       ChromatogramType chromatogram_;
       /// The spectrum data (or chromatogram data)
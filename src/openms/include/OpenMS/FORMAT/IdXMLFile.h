@@ -39,6 +39,7 @@
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/FORMAT/HANDLERS/XMLHandler.h>
 #include <OpenMS/FORMAT/XMLFile.h>
+#include <OpenMS/INTERFACES/IIdentificationConsumer.h>
 
 #include <vector>
 
@@ -95,6 +96,22 @@ public:
     */
     void load(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids, String& document_id);
 
+    /**
+        @brief Loads the identifications of an idXML file and passes them to a consumer one at a time
+
+        Every protein identification (identification run) is passed to @p consumer before the
+        peptide identifications belonging to it. Apart from the current peptide identification,
+        only the identifier of the current run is kept in memory, so arbitrarily large files can
+        be processed, e.g. using an IdentificationFilteringConsumer to apply filters while loading.
+
+        @note Protein groups are passed on as part of the protein identifications, but no
+        consistency checks between peptide and protein hits are performed.
+
+        @exception Exception::FileNotFound is thrown if the file could not be opened
+        @exception Exception::ParseError is thrown if an error occurs during parsing
+    */
+    void load(const String& filename, Interfaces::IIdentificationConsumer* consumer);
+
     /**
         @brief Stores the data in an idXML file
 
@@ -119,6 +136,12 @@ protected:
     void addProteinGroups_(MetaInfoInterface& meta, const std::vector<ProteinIdentification::ProteinGroup>& groups,
                            const String& group_name, const std::unordered_map<std::string, UInt>& accession_to_id, XMLHandler::ActionMode mode);
 
+    /// Store a completed protein identification (or pass it to the consumer, if streaming)
+    void addProteinIdentification_(const ProteinIdentification& prot_id);
+
+    /// Reset the members used for loading
+    void resetMembers_();
+
     /// Read and store ProteinGroup data
     void getProteinGroups_(std::vector<ProteinIdentification::ProteinGroup>& groups, const String& group_name);
 
@@ -179,6 +202,8 @@ protected:
     String* document_id_;
     /// true if a prot id is contained in the current run
     bool prot_id_in_run_;
+    /// Consumer for streaming (if not null, identifications are passed on instead of stored)
+    Interfaces::IIdentificationConsumer* consumer_;
     //@}
   };
 
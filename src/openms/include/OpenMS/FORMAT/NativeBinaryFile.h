@@ -0,0 +1,157 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/FORMAT/FileTypes.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  class ConsensusMap;
+  class FeatureMap;
+  class PeptideIdentification;
+  class ProteinIdentification;
+
+  /**
+    @brief Compact binary storage of feature maps, consensus maps and identifications
+
+    A fast alternative to featureXML, consensusXML and idXML for intermediate files that are only
+    passed between tools. Loading and storing avoids XML parsing and number formatting altogether.
+
+    Layout of a file (all numbers in host byte order, like CachedMzML):
+    - header: magic bytes, format version, content tag (feature map, consensus map or identifications; fixed values
+      that do not depend on FileTypes::Type) and compression flag
+    - string block: every distinct string (meta value names, sequences, accessions, identifiers, ...) stored once
+    - data block: the objects, referring to strings by their index in the string block
+
+    Both blocks are zlib-compressed if compression is enabled (see setCompression()), in chunks of at most 64 MiB
+    (zlib cannot process more than 4 GiB at once on all platforms).
+    Sizes, counts and string references are stored as variable-length integers.
+
+    The format is versioned; files written by another version are rejected. It is not meant for archiving,
+    use the XML formats for that.
+
+    @note Not stored (as in featureXML/consensusXML/idXML): convex hull point maps (only the hull points are kept),
+    CV terms of data processing software and modifications of protein hits.
+
+    @ingroup FileIO
+  */
+  class OPENMS_DLLAPI NativeBinaryFile :
+    public ProgressLogger
+  {
+public:
+    /// Current version of the format
+    static const UInt32 VERSION;
+
+    /// Default constructor
+    NativeBinaryFile();
+
+    /// Destructor
+    ~NativeBinaryFile() override;
+
+    /// Enables or disables zlib compression when storing (default: disabled)
+    void setCompression(bool compress);
+
+    /// Returns whether data is compressed when storing
+    bool getCompression() const;
+
+    /**
+      @brief Returns the content type of a file in this format (FileTypes::FEATUREBIN, FileTypes::CONSENSUSBIN or FileTypes::IDBIN)
+
+      @return FileTypes::UNKNOWN if the file is not in this format (or cannot be read)
+    */
+    static FileTypes::Type getContentType(const String& filename);
+
+    /**
+      @brief Loads a feature map
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is not a feature map in this format or is truncated
+    */
+    void load(const String& filename, FeatureMap& map);
+
+    /**
+      @brief Stores a feature map
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void store(const String& filename, const FeatureMap& map);
+
+    /**
+      @brief Loads a consensus map
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is not a consensus map in this format or is truncated
+    */
+    void load(const String& filename, ConsensusMap& map);
+
+    /**
+      @brief Stores a consensus map
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void store(const String& filename, const ConsensusMap& map);
+
+    /**
+      @brief Loads protein and peptide identifications
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file does not contain identifications in this format or is truncated
+    */
+    void load(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids);
+
+    /**
+      @brief Stores protein and peptide identifications
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids);
+
+protected:
+    /// Writes the header and both blocks of @p content_type to @p filename
+    void write_(const String& filename, FileTypes::Type content_type, const std::string& strings, const std::string& data) const;
+
+    /// Reads both blocks of a file, checking that it holds @p content_type
+    void read_(const String& filename, FileTypes::Type content_type, std::string& strings, std::string& data) const;
+
+    /// Compress data when storing?
+    bool compress_;
+  };
+
+} // namespace OpenMS
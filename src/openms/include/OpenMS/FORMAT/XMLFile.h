@@ -38,6 +38,8 @@
 #include <OpenMS/CONCEPT/Types.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 
+#include <vector>
+
 namespace OpenMS
 {
   namespace Internal
@@ -91,6 +93,52 @@ protected:
       */
       void parseBuffer_(const std::string & buffer, XMLHandler * handler);
 
+      /**
+        @brief Location of a list element and its trailing run of equally named children in a raw XML document
+
+        Filled by scanElementLists_() and used by splitDocument_().
+      */
+      struct ElementList
+      {
+        Size content_begin = 0; ///< offset directly after the start tag of the list
+        Size content_end = 0; ///< offset of the end tag of the list
+        std::vector<String> head_tags; ///< names of the children preceding the first element in @p element_begin
+        std::vector<Size> element_begin; ///< offsets of the start tags of the trailing children with the requested name
+      };
+
+      /**
+        @brief Scans the raw, uncompressed XML document @p data for elements called @p list_tag
+
+        For each list, the children called @p element_tag are reported if they form the tail of the list, i.e.
+        no child with a different name follows the first of them. Nested lists are not reported.
+
+        @return false if the document cannot be split reliably (e.g. it is not ASCII-compatible, contains a
+        document type declaration, is malformed or a list has other children after the first @p element_tag child)
+      */
+      static bool scanElementLists_(const char* data, Size size, const String& list_tag, const String& element_tag, std::vector<ElementList>& lists);
+
+      /**
+        @brief Splits an uncompressed XML file into a skeleton and chunks of list elements for parallel parsing
+
+        The skeleton is the document without the trailing @p element_tag children of all lists (see scanElementLists_()).
+        Each chunk is a self-contained document, i.e. the XML declaration of the file and a neutral root element, around
+        consecutive @p element_tag children of a single list. Handlers therefore have to be set up with the state that
+        these children depend on (e.g. identification run references) from the skeleton before parsing a chunk.
+
+        @param filename The file to split
+        @param list_tag The name of the list elements
+        @param element_tag The name of the list children to distribute over the chunks
+        @param skeleton The document without the chunk content
+        @param chunks The chunk documents (in document order)
+        @param chunk_list The index of the list (in @p lists) each chunk belongs to
+        @param lists The lists found in the document
+
+        @return false (leaving the output empty) if splitting is not possible or not worthwhile, i.e. only one thread
+        is available, the file is small, compressed or cannot be scanned. The file has to be parsed with parse_() then.
+      */
+      static bool splitDocument_(const String& filename, const String& list_tag, const String& element_tag, String& skeleton,
+                                 std::vector<std::string>& chunks, std::vector<Size>& chunk_list, std::vector<ElementList>& lists);
+
       /**
         @brief Stores the contents of the XML handler given by @p handler in the file given by @p filename.
 
@@ -64,6 +64,7 @@ MzQCFile.h
 MzTab.h
 MzTabFile.h
 MzXMLFile.h
+NativeBinaryFile.h
 OMSSACSVFile.h
 OMSSAXMLFile.h
 OSWFile.h
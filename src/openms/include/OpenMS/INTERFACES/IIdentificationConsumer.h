@@ -0,0 +1,88 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/config.h>
+
+namespace OpenMS
+{
+  class ProteinIdentification;
+  class PeptideIdentification;
+
+namespace Interfaces
+{
+
+    /**
+      @brief The interface of a consumer of protein and peptide identifications
+
+      This is the identification counterpart of IMSDataConsumer: a reader
+      (e.g. IdXMLFile) passes identifications to the consumer one at a time
+      as soon as they are parsed, so that large identification files can be
+      processed (e.g. filtered or exported) without ever holding all of them
+      in memory.
+
+      A protein identification (i.e. an identification run) is passed to the
+      consumer before the peptide identifications that refer to it via their
+      identifier.
+
+      Implementations in OpenMS can be found in OpenMS/FORMAT/DATAACCESS
+    */
+    class OPENMS_DLLAPI IIdentificationConsumer
+    {
+    public:
+
+      virtual ~IIdentificationConsumer() {}
+
+      /**
+        @brief Consume a protein identification (identification run)
+
+        The object will be consumed by the implementation and possibly modified.
+
+        @param protein_id The protein identification to be consumed
+      */
+      virtual void consumeProteinIdentification(ProteinIdentification& protein_id) = 0;
+
+      /**
+        @brief Consume a peptide identification
+
+        The object will be consumed by the implementation and possibly modified.
+
+        @param peptide_id The peptide identification to be consumed
+      */
+      virtual void consumePeptideIdentification(PeptideIdentification& peptide_id) = 0;
+    };
+
+} //end namespace Interfaces
+} //end namespace OpenMS
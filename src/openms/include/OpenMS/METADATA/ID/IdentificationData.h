@@ -435,6 +435,14 @@ namespace OpenMS
                  bool require_parent_group = false,
                  bool require_match_group = false);
 
+    /*!
+      @brief Remove all data queries, identified molecules and molecule-query matches (incl. match groups)
+
+      Meta data (input files, processing steps, score types etc.) and parent molecules (incl. groupings) are kept.
+      This is used to release memory after the data was moved into an IdentificationDataArena.
+    */
+    void clearMatchData();
+
     /// Helper function to compare two scores
     static bool isBetterScore(double first, double second, bool higher_better)
     {
@@ -0,0 +1,341 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hendrik Weisser $
+// $Authors: Hendrik Weisser $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/METADATA/ID/IdentificationData.h>
+
+#include <functional>
+#include <unordered_map>
+
+namespace OpenMS
+{
+  /*!
+    @brief Compact, column-oriented storage for the bulk of identification data (data queries, identified molecules, molecule-query matches).
+
+    IdentificationData stores every query match as a node of a multi-index container, with scores in per-element maps and processing steps in per-element lists.
+    For large data sets (millions of PSMs) this amounts to several hundred bytes per match.
+    This class stores the same information in flat tables:
+    - Strings (spectrum identifiers, file names, sequences) are interned and referred to by integer handles.
+    - Data queries, identified molecules and query matches are rows in contiguous tables and are referred to by their row index ("handle").
+    - Scores are stored in one column per combination of processing step and score type (NaN marks a missing value).
+
+    The small "meta data" tables (input files, processing software and steps, search parameters, score types, parent molecules) stay in an associated IdentificationData object, which is passed to the constructor and must outlive the arena.
+    Score columns, parent matches and peak annotations refer to elements of this object via the usual references.
+
+    There are two ways of populating an arena:
+    - Bulk insertion, using the "add..." functions and @ref setScores() (meta data has to be registered in the associated IdentificationData first).
+    - Import from the associated IdentificationData via @ref importFrom().
+
+    @ref exportTo() registers the arena content in the associated IdentificationData, e.g. for use with IdentificationDataConverter.
+    An import/export round-trip preserves all information, with the following exceptions:
+    - Query match groups are not stored in the arena.
+    - Processing steps of an element are exported in the order in which the steps were first encountered in the arena (instead of in the per-element order).
+    - NaN scores are considered missing.
+
+    @ingroup Metadata
+  */
+  class OPENMS_DLLAPI IdentificationDataArena
+  {
+  public:
+
+    /// Integer handle of a string, data query, identified molecule or query match
+    typedef UInt32 Handle;
+
+    /// Value representing "no handle"
+    static constexpr Handle NO_HANDLE = Handle(-1);
+
+    using MoleculeType = IdentificationData::MoleculeType;
+    using ScoreTypeRef = IdentificationData::ScoreTypeRef;
+    using ProcessingStepRef = IdentificationData::ProcessingStepRef;
+    using StepOpt = boost::optional<ProcessingStepRef>;
+
+    /// Constructor - @p id_data holds the meta data and is the target of import/export
+    explicit IdentificationDataArena(IdentificationData& id_data);
+
+    /// Return the associated IdentificationData
+    IdentificationData& getIdentificationData();
+
+    /// Remove all content (the associated IdentificationData is not affected)
+    void clear();
+
+    /// Reserve memory for the given numbers of elements
+    void reserve(Size n_queries, Size n_molecules, Size n_matches);
+
+    /*!
+      @brief Copy data queries, identified molecules and query matches from the associated IdentificationData into the arena
+
+      Previous content of the arena is removed.
+      If @p clear_source is set, the imported elements (and query match groups) are removed from the associated IdentificationData afterwards (see IdentificationData::clearMatchData()).
+    */
+    void importFrom(bool clear_source = false);
+
+    /*!
+      @brief Register the content of the arena in the associated IdentificationData
+
+      If elements already exist there, information is merged as usual for IdentificationData.
+      A current processing step set in the associated IdentificationData is not applied to the exported elements.
+    */
+    void exportTo() const;
+
+    /// @name String pool
+    //@{
+    /// Intern a string and return its handle (strings are stored only once)
+    Handle internString(const String& str);
+
+    /// Return the string for a handle
+    const String& getString(Handle handle) const;
+
+    /// Return the number of distinct strings
+    Size getNumberOfStrings() const;
+    //@}
+
+    /// @name Data queries
+    //@{
+    /// Add a data query (or return the handle of an existing query with the same identifier and input file)
+    Handle addDataQuery(const String& data_id,
+                        const boost::optional<IdentificationData::InputFileRef>&
+                        input_file_opt = boost::none,
+                        double rt = std::numeric_limits<double>::quiet_NaN(),
+                        double mz = std::numeric_limits<double>::quiet_NaN());
+
+    /// Return the number of data queries
+    Size getNumberOfDataQueries() const;
+
+    /// Return the identifier of a data query
+    const String& getDataQueryID(Handle query) const;
+
+    /// Return the retention time of a data query
+    double getDataQueryRT(Handle query) const;
+
+    /// Return the m/z of a data query
+    double getDataQueryMZ(Handle query) const;
+
+    /// Return the meta info of a data query
+    MetaInfoInterface& getDataQueryMetaInfo(Handle query);
+    //@}
+
+    /// @name Identified molecules
+    //@{
+    /// Add an identified peptide (or return the handle of an existing one with the same sequence)
+    Handle addIdentifiedPeptide(const AASequence& sequence);
+
+    /// Add an identified oligonucleotide (or return the handle of an existing one with the same sequence)
+    Handle addIdentifiedOligo(const NASequence& sequence);
+
+    /// Add an identified compound (or return the handle of an existing one with the same identifier); scores and meta info of @p compound are ignored
+    Handle addIdentifiedCompound(const IdentificationData::IdentifiedCompound&
+                                 compound);
+
+    /// Return the number of identified molecules (of all types)
+    Size getNumberOfIdentifiedMolecules() const;
+
+    /// Return the type of an identified molecule
+    MoleculeType getMoleculeType(Handle molecule) const;
+
+    /// Return the sequence (peptide/oligonucleotide) or identifier (compound) of an identified molecule
+    const String& getMoleculeKey(Handle molecule) const;
+
+    /// Add a match to a parent molecule (protein/RNA) to an identified peptide/oligonucleotide
+    void addParentMatch(Handle molecule,
+                        IdentificationData::ParentMoleculeRef parent_ref,
+                        const IdentificationData::MoleculeParentMatch& match);
+
+    /// Set a score of an identified molecule
+    void setMoleculeScore(Handle molecule, ScoreTypeRef score_ref, double value,
+                          const StepOpt& step_opt = boost::none);
+
+    /// Look up a score of an identified molecule (most recent processing step first), see ScoredProcessingResult::getScore()
+    std::pair<double, bool> getMoleculeScore(Handle molecule,
+                                             ScoreTypeRef score_ref) const;
+
+    /// Return the meta info of an identified molecule
+    MetaInfoInterface& getMoleculeMetaInfo(Handle molecule);
+    //@}
+
+    /// @name Molecule-query matches
+    //@{
+    /// Add a match between a data query and an identified molecule
+    Handle addQueryMatch(Handle query, Handle molecule, Int charge = 0);
+
+    /*!
+      @brief Add many query matches at once
+
+      The three vectors must have the same size.
+      @return Handle of the first new match (further matches follow consecutively)
+    */
+    Handle addQueryMatches(const std::vector<Handle>& queries,
+                           const std::vector<Handle>& molecules,
+                           const std::vector<Int>& charges);
+
+    /// Return the number of query matches
+    Size getNumberOfQueryMatches() const;
+
+    /// Return the data query of a match
+    Handle getMatchQuery(Handle match) const;
+
+    /// Return the identified molecule of a match
+    Handle getMatchMolecule(Handle match) const;
+
+    /// Return the charge of a match
+    Int getMatchCharge(Handle match) const;
+
+    /// Return the meta info of a match
+    MetaInfoInterface& getMatchMetaInfo(Handle match);
+
+    /// Record that a processing step was applied to a match (without adding scores)
+    void addProcessingStep(Handle match, ProcessingStepRef step_ref);
+
+    /// Set a score of a match
+    void setScore(Handle match, ScoreTypeRef score_ref, double value,
+                  const StepOpt& step_opt = boost::none);
+
+    /*!
+      @brief Set scores of consecutive matches at once
+
+      Value @p values[i] is assigned to match @p first_match + i.
+    */
+    void setScores(ScoreTypeRef score_ref, const std::vector<double>& values,
+                   const StepOpt& step_opt = boost::none,
+                   Handle first_match = 0);
+
+    /// Look up a score of a match (most recent processing step first), see ScoredProcessingResult::getScore()
+    std::pair<double, bool> getScore(Handle match, ScoreTypeRef score_ref) const;
+
+    /*!
+      @brief Return the column of scores of a given type and processing step, indexed by match handle (NaN for missing values)
+
+      @throw Exception::ElementNotFound if there is no such column
+    */
+    const std::vector<double>& getScoreColumn(ScoreTypeRef score_ref,
+                                              const StepOpt& step_opt =
+                                              boost::none) const;
+
+    /*!
+      @brief Compute new scores from existing ones for all matches (in parallel)
+
+      For every match that has a score of type @p source_ref (looked up as in @ref getScore()), @p transform is applied to that score and the result is stored as a score of type @p target_ref for processing step @p step_opt.
+      Source and target may be the same (in-place transformation).
+      @p transform is called concurrently from multiple threads.
+    */
+    void transformScores(ScoreTypeRef source_ref, ScoreTypeRef target_ref,
+                         const std::function<double(double)>& transform,
+                         const StepOpt& step_opt = boost::none);
+    //@}
+
+  protected:
+
+    /// Score columns of one processing step
+    struct StepColumns_
+    {
+      StepOpt step_opt;
+
+      /// Per row: was this step applied? ("char" instead of "bool" to allow concurrent writes)
+      std::vector<char> applied;
+
+      /// Per score type: values (NaN if missing)
+      std::vector<std::pair<ScoreTypeRef, std::vector<double>>> scores;
+    };
+
+    /// Processing steps and scores for the rows of a table
+    struct ScoreTable_
+    {
+      /// Processing steps in order of first occurrence
+      std::vector<StepColumns_> steps;
+
+      Size rows = 0;
+
+      void resize(Size n_rows);
+
+      StepColumns_& getStep(const StepOpt& step_opt);
+
+      std::vector<double>& getColumn(StepColumns_& step, ScoreTypeRef score_ref);
+
+      const std::vector<double>* findColumn(ScoreTypeRef score_ref,
+                                            const StepOpt& step_opt) const;
+
+      void setScore(Size row, ScoreTypeRef score_ref, double value,
+                    const StepOpt& step_opt);
+
+      std::pair<double, bool> getScore(Size row, ScoreTypeRef score_ref) const;
+
+      void importSteps(Size row, const IdentificationData::AppliedProcessingSteps&
+                       steps_and_scores);
+
+      void exportSteps(Size row, IdentificationDataInternal::ScoredProcessingResult&
+                       result) const;
+    };
+
+    /// Check that a handle is valid for a table of size @p size
+    static void checkHandle_(Size handle, Size size);
+
+    /// Add an identified molecule given its type and key string
+    Handle addMolecule_(MoleculeType type, const String& key);
+
+    /// Associated IdentificationData
+    IdentificationData& id_data_;
+
+    /// String pool (the map owns the strings, the vector points to them)
+    std::unordered_map<String, Handle> string_lookup_;
+    std::vector<const String*> strings_;
+
+    /// Data query table
+    std::vector<Handle> query_ids_;
+    std::vector<Handle> query_files_; // NO_HANDLE if missing
+    std::vector<double> query_rts_;
+    std::vector<double> query_mzs_;
+    std::vector<MetaInfoInterface> query_meta_;
+    std::unordered_map<UInt64, Handle> query_lookup_; // (file, ID) -> query
+
+    /// Identified molecule table
+    std::vector<std::uint8_t> molecule_types_;
+    std::vector<Handle> molecule_keys_;
+    std::vector<MetaInfoInterface> molecule_meta_;
+    ScoreTable_ molecule_scores_;
+    std::unordered_map<UInt64, Handle> molecule_lookup_; // (type, key) -> molecule
+    /// Sparse data: only few molecules have parent matches/compound details
+    std::unordered_map<Handle, IdentificationData::ParentMatches> parent_matches_;
+    std::unordered_map<Handle, IdentificationData::IdentifiedCompound> compounds_;
+
+    /// Query match table
+    std::vector<Handle> match_queries_;
+    std::vector<Handle> match_molecules_;
+    std::vector<Int> match_charges_;
+    std::vector<MetaInfoInterface> match_meta_;
+    ScoreTable_ match_scores_;
+    /// Sparse data: peak annotations
+    std::unordered_map<Handle, IdentificationDataInternal::PeakAnnotationSteps>
+    peak_annotations_;
+  };
+}
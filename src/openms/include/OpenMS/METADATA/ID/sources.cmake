@@ -9,6 +9,7 @@ DataProcessingSoftware.h
 DataProcessingStep.h
 DataQuery.h
 IdentificationData.h
+IdentificationDataArena.h
 IdentificationDataConverter.h
 IdentifiedCompound.h
 IdentifiedSequence.h
@@ -58,6 +58,11 @@ namespace OpenMS
       The precursor spectrum is the first spectrum before this spectrum, that has a lower MS-level than
       the current spectrum.
 
+      The instrument settings and the source file are usually the same for many spectra of a run. They are
+      stored copy-on-write, so copies of a spectrum and spectra passed through shareSettings() use the same
+      instance until one of them is modified. Hence, a mutable reference obtained from getInstrumentSettings()
+      or getSourceFile() must not be kept across copies of the spectrum (it would modify the copy as well).
+
       @ingroup Metadata
   */
   class OPENMS_DLLAPI SpectrumSettings :
@@ -81,15 +86,35 @@ public:
     SpectrumSettings();
     /// Copy constructor
     SpectrumSettings(const SpectrumSettings &) = default;
-    /// Move constructor
-    SpectrumSettings(SpectrumSettings&&) = default;
+    /// Move constructor (the shared instrument settings and source file are copied, so @p rhs stays usable)
+    SpectrumSettings(SpectrumSettings&& rhs) noexcept;
     /// Destructor
     ~SpectrumSettings();
 
     // Assignment operator
     SpectrumSettings & operator=(const SpectrumSettings &) = default;
     /// Move assignment operator
-    SpectrumSettings& operator=(SpectrumSettings&&) & = default;
+    SpectrumSettings& operator=(SpectrumSettings&& rhs) & noexcept;
+
+    /**
+      @brief Pool of instrument settings and source files to be shared between spectra (see shareSettings())
+
+      Only the most recently added distinct values are kept (up to @p capacity of each kind), which suffices for
+      the few different settings within a run.
+    */
+    class OPENMS_DLLAPI SharedSettingsPool
+    {
+public:
+      /// Constructor
+      explicit SharedSettingsPool(Size capacity = 32);
+
+private:
+      friend class SpectrumSettings;
+
+      Size capacity_;
+      std::vector<boost::shared_ptr<InstrumentSettings> > instrument_settings_;
+      std::vector<boost::shared_ptr<SourceFile> > source_files_;
+    };
 
     /// Equality operator
     bool operator==(const SpectrumSettings & rhs) const;
@@ -165,13 +190,21 @@ public:
     /// returns a const reference to the description of the applied processing
     const std::vector< boost::shared_ptr<const DataProcessing > > getDataProcessing() const;
 
+    /**
+      @brief Shares the instrument settings and the source file with equal ones of other spectra (flyweight)
+
+      Replaces them by the equal instances from @p pool, or adds them to @p pool if there are none.
+      This saves a lot of memory for runs with many spectra (e.g. when loading only meta data).
+    */
+    void shareSettings(SharedSettingsPool& pool);
+
 protected:
 
     SpectrumType type_;
     String native_id_;
     String comment_;
-    InstrumentSettings instrument_settings_;
-    SourceFile source_file_;
+    boost::shared_ptr<InstrumentSettings> instrument_settings_; ///< copy-on-write, never null
+    boost::shared_ptr<SourceFile> source_file_; ///< copy-on-write, never null
     AcquisitionInfo acquisition_info_;
     std::vector<Precursor> precursors_;
     std::vector<Product> products_;
@@ -158,6 +158,17 @@ protected:
    */
   void generateMapsProfile_(const std::vector<MultiplexIsotopicPeakPattern>& patterns, const std::vector<MultiplexFilteredMSExperiment>& filter_results, const std::vector<std::map<int, GridBasedCluster> >& cluster_results);
 
+  /**
+   * @brief appends the per-pattern results to the feature and consensus maps
+   *
+   * Results are merged in pattern order, so the maps do not depend on the order in which the patterns were processed.
+   *
+   * @param features_pattern    features found for each pattern (moved from)
+   * @param consensus_pattern    consensus features found for each pattern (moved from)
+   * @param column_sizes_pattern    number of feature handles added to each column for each pattern
+   */
+  void mergePatternResults_(std::vector<std::vector<Feature> >& features_pattern, std::vector<std::vector<ConsensusFeature> >& consensus_pattern, const std::vector<std::vector<Size> >& column_sizes_pattern);
+
 };
 
 }
@@ -45,6 +45,7 @@
 #include <vector>
 #include <algorithm>
 #include <iostream>
+#include <map>
 
 namespace OpenMS
 {
@@ -136,6 +137,33 @@ namespace OpenMS
         };
 
         private:
+        /**
+         * @brief splits the points of a filter result into blocks which can be clustered independently
+         *
+         * Grid-based clustering only compares clusters in neighbouring grid cells, and merged cluster
+         * centres never leave the range spanned by their points. Two groups of points separated by at
+         * least one empty row of RT cells can therefore never end up in the same cluster.
+         *
+         * @param rt    RT coordinates of the points
+         *
+         * @return point indices of each block (in ascending order)
+         */
+        std::vector<std::vector<int> > splitIntoBlocks_(const std::vector<double>& rt) const;
+
+        /**
+         * @brief clusters a single block of points
+         *
+         * The grid is restricted to the cells covered by the block. Cluster and point indices of
+         * the result refer to the complete filter result.
+         *
+         * @param mz    m/z coordinates of all points of the filter result
+         * @param rt    RT coordinates of all points of the filter result
+         * @param block    indices of the points in this block (ascending)
+         *
+         * @return cluster results of the block
+         */
+        std::map<int, GridBasedCluster> clusterBlock_(const std::vector<double>& mz, const std::vector<double>& rt, const std::vector<int>& block) const;
+
         /**
          * @brief grid spacing for clustering
          */
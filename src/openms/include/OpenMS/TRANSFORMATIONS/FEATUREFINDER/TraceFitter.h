@@ -168,6 +168,18 @@ protected:
     {
       FeatureFinderAlgorithmPickedHelperStructs::MassTraces* traces_ptr;
       bool weighted;
+
+      /// @name Peaks of all traces in contiguous arrays (one entry per peak, in trace order)
+      //@{
+      std::vector<double> rt;
+      std::vector<double> intensity;
+      std::vector<double> theoretical_int;
+      /// residual weight (theoretical intensity of the trace if weighted, 1 otherwise)
+      std::vector<double> weight;
+      //@}
+
+      /// Sets the traces to fit and fills the flat peak arrays (reusing their capacity)
+      void setTraces(FeatureFinderAlgorithmPickedHelperStructs::MassTraces& traces, bool weighted_fit);
     };
 
     void updateMembers_() override;
@@ -187,6 +199,8 @@ protected:
     SignedSize max_iterations_;
     /// Whether to weight mass traces by theoretical intensity during the optimization
     bool weighted_;
+    /// Data of the current fit; kept as a member so its buffers are reused across fits
+    ModelData model_data_;
 
   };
 
@@ -42,8 +42,13 @@
 #include <OpenMS/METADATA/ProteinIdentification.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
 
+#include <exception>
 #include <numeric>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace OpenMS
 {
 
@@ -591,9 +596,11 @@ namespace OpenMS
       throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Ion mode cannot be set to '") + ion_mode + "'. Must be 'positive' or 'negative'!");
     }
 
+    const bool positive = (ion_mode == "positive");
     std::pair<Size, Size> hit_idx;
     for (std::vector<AdductInfo>::const_iterator it = it_s; it != it_e; ++it)
     {
+      const Size adduct_index = it - it_s;
       if (observed_charge != 0 && (std::abs(observed_charge) != std::abs(it->getCharge())))
       { // charge of evidence and adduct must match in absolute terms (absolute, since any FeatureFinder gives only positive charges, even for negative-mode spectra)
         // observed_charge==0 will pass, since we basically do not know its real charge (apparently, no isotopes were found)
@@ -643,7 +650,8 @@ namespace OpenMS
       for (Size i = hit_idx.first; i < hit_idx.second; ++i)
       {
         // check if DB entry is compatible to the adduct
-        if (!it->isCompatible(EmpiricalFormula(mass_mappings_[i].formula)))
+        const std::vector<bool>& compatible = positive ? mass_mappings_[i].pos_adduct_compatible : mass_mappings_[i].neg_adduct_compatible;
+        if (!compatible[adduct_index])
         {
           // only written if TOPP tool has --debug
           OPENMS_LOG_DEBUG << "'" << mass_mappings_[i].formula << "' cannot have adduct '" << it->getName() << "'. Omitting.\n";
@@ -785,6 +793,8 @@ namespace OpenMS
     parseAdductsFile_(pos_adducts_fname_, pos_adducts_);
     parseAdductsFile_(neg_adducts_fname_, neg_adducts_);
 
+    computeAdductCompatibility_();
+
     is_initialized_ = true;
   }
 
@@ -801,49 +811,68 @@ namespace OpenMS
       ion_mode_internal = resolveAutoMode_(fmap);
     }
 
-    // map for storing overall results
-    QueryResultsTable overall_results;
-    Size dummy_count(0);
-    for (Size i = 0; i < fmap.size(); ++i)
+    // query all features in parallel; results are kept per feature, so the output order does not depend on scheduling
+    QueryResultsTable feature_results(fmap.size());
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize i = 0; i < (SignedSize)fmap.size(); ++i)
     {
-      std::vector<AccurateMassSearchResult> query_results;
+      try
+      {
+        std::vector<AccurateMassSearchResult>& query_results = feature_results[i];
 
-      // std::cout << i << ": " << fmap[i].getMetaValue(3) << " mass: " << fmap[i].getMZ() << " num_traces: " << fmap[i].getMetaValue("num_of_masstraces") << " charge: " << fmap[i].getCharge() << std::endl;
-      queryByFeature(fmap[i], i, ion_mode_internal, query_results);
+        // std::cout << i << ": " << fmap[i].getMetaValue(3) << " mass: " << fmap[i].getMZ() << " num_traces: " << fmap[i].getMetaValue("num_of_masstraces") << " charge: " << fmap[i].getCharge() << std::endl;
+        queryByFeature(fmap[i], i, ion_mode_internal, query_results);
 
-      if (query_results.size() == 0) continue; // cannot happen if a 'not-found' dummy was added
+        if (query_results.size() == 0) continue; // cannot happen if a 'not-found' dummy was added
 
-      bool is_dummy = (query_results[0].getMatchingIndex() == (Size)-1);
-      if (is_dummy) ++dummy_count;
+        bool is_dummy = (query_results[0].getMatchingIndex() == (Size)-1);
 
-      if (iso_similarity_ && !is_dummy)
-      {
-        if (!fmap[i].metaValueExists("num_of_masstraces"))
+        if (iso_similarity_ && !is_dummy)
         {
-          OPENMS_LOG_WARN << "Feature does not contain meta value 'num_of_masstraces'. Cannot compute isotope similarity.";
-        }
-        else if ((Size)fmap[i].getMetaValue("num_of_masstraces") > 1)
-        { // compute isotope pattern similarities (do not take the best-scoring one, since it might have really bad ppm or other properties --
-          // it is impossible to decide here which one is best
-          for (Size hit_idx = 0; hit_idx < query_results.size(); ++hit_idx)
+          if (!fmap[i].metaValueExists("num_of_masstraces"))
           {
-            String emp_formula(query_results[hit_idx].getFormulaString());
-            double iso_sim(computeIsotopePatternSimilarity_(fmap[i], EmpiricalFormula(emp_formula)));
-            query_results[hit_idx].setIsotopesSimScore(iso_sim);
+            OPENMS_LOG_WARN << "Feature does not contain meta value 'num_of_masstraces'. Cannot compute isotope similarity.";
+          }
+          else if ((Size)fmap[i].getMetaValue("num_of_masstraces") > 1)
+          { // compute isotope pattern similarities (do not take the best-scoring one, since it might have really bad ppm or other properties --
+            // it is impossible to decide here which one is best
+            for (Size hit_idx = 0; hit_idx < query_results.size(); ++hit_idx)
+            {
+              String emp_formula(query_results[hit_idx].getFormulaString());
+              double iso_sim(computeIsotopePatternSimilarity_(fmap[i], EmpiricalFormula(emp_formula)));
+              query_results[hit_idx].setIsotopesSimScore(iso_sim);
+            }
           }
         }
-      }
 
-      // debug output
-      //        for (Size hit_idx = 0; hit_idx < query_results.size(); ++hit_idx)
-      //        {
-      //            query_results[hit_idx].outputResults();
-      //        }
+        // debug output
+        //        for (Size hit_idx = 0; hit_idx < query_results.size(); ++hit_idx)
+        //        {
+        //            query_results[hit_idx].outputResults();
+        //        }
+
+        annotate_(query_results, fmap[i]);
+      }
+      catch (...)
+      {
+#pragma omp critical (AccurateMassSearchEngine_error)
+        if (!error) error = std::current_exception();
+      }
+    }
+    if (error) std::rethrow_exception(error);
 
-      // String feat_label(fmap[i].getMetaValue(3));
-      overall_results.push_back(query_results);
-      annotate_(query_results, fmap[i]);
+    // map for storing overall results
+    QueryResultsTable overall_results;
+    overall_results.reserve(fmap.size());
+    Size dummy_count(0);
+    for (std::vector<AccurateMassSearchResult>& query_results : feature_results)
+    {
+      if (query_results.empty()) continue;
+      if (query_results[0].getMatchingIndex() == (Size)-1) ++dummy_count;
+      overall_results.push_back(std::move(query_results));
     }
+
     // add dummy protein identification which is required to keep peptidehits alive during store()
     fmap.getProteinIdentifications().resize(fmap.getProteinIdentifications().size() + 1);
     fmap.getProteinIdentifications().back().setIdentifier(search_engine_identifier);
@@ -915,17 +944,26 @@ namespace OpenMS
     ConsensusMap::ColumnHeaders fd_map = cmap.getColumnHeaders();
     Size num_of_maps = fd_map.size();
 
-    // map for storing overall results
-    QueryResultsTable overall_results;
-
-    for (Size i = 0; i < cmap.size(); ++i)
+    // map for storing overall results (one entry per consensus feature, filled in parallel)
+    QueryResultsTable overall_results(cmap.size());
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize i = 0; i < (SignedSize)cmap.size(); ++i)
     {
-      std::vector<AccurateMassSearchResult> query_results;
-      // std::cout << i << ": " << cmap[i].getMetaValue(3) << " mass: " << cmap[i].getMZ() << " num_traces: " << cmap[i].getMetaValue("num_of_masstraces") << " charge: " << cmap[i].getCharge() << std::endl;
-      queryByConsensusFeature(cmap[i], i, num_of_maps, ion_mode_internal, query_results);
-      annotate_(query_results, cmap[i]);
-      overall_results.push_back(query_results);
+      try
+      {
+        std::vector<AccurateMassSearchResult>& query_results = overall_results[i];
+        // std::cout << i << ": " << cmap[i].getMetaValue(3) << " mass: " << cmap[i].getMZ() << " num_traces: " << cmap[i].getMetaValue("num_of_masstraces") << " charge: " << cmap[i].getCharge() << std::endl;
+        queryByConsensusFeature(cmap[i], i, num_of_maps, ion_mode_internal, query_results);
+        annotate_(query_results, cmap[i]);
+      }
+      catch (...)
+      {
+#pragma omp critical (AccurateMassSearchEngine_error)
+        if (!error) error = std::current_exception();
+      }
     }
+    if (error) std::rethrow_exception(error);
     // add dummy protein identification which is required to keep peptidehits alive during store()
     cmap.getProteinIdentifications().resize(cmap.getProteinIdentifications().size() + 1);
     cmap.getProteinIdentifications().back().setIdentifier(search_engine_identifier);
@@ -1399,6 +1437,73 @@ namespace OpenMS
     return;
   }
 
+  void AccurateMassSearchEngine::computeAdductCompatibility_()
+  {
+    // Only the losses of an adduct (negative amounts) can make it incompatible, so
+    // adducts without losses are compatible with every entry and need no check.
+    auto has_losses = [](const AdductInfo& adduct)
+    {
+      for (const auto& element : adduct.getEmpiricalFormula())
+      {
+        if (element.second < 0) return true;
+      }
+      return false;
+    };
+    std::vector<bool> pos_losses, neg_losses;
+    for (const AdductInfo& adduct : pos_adducts_) pos_losses.push_back(has_losses(adduct));
+    for (const AdductInfo& adduct : neg_adducts_) neg_losses.push_back(has_losses(adduct));
+
+    // entries whose formula cannot be parsed are skipped (incompatible with every adduct), not fatal
+    std::vector<char> invalid(mass_mappings_.size(), false); // not vector<bool>: written concurrently
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 256)
+    for (SignedSize i = 0; i < (SignedSize)mass_mappings_.size(); ++i)
+    {
+      try
+      {
+        MappingEntry_& entry = mass_mappings_[i];
+        // parse each DB formula only once (instead of once per query hit)
+        EmpiricalFormula formula;
+        try
+        {
+          formula = EmpiricalFormula(entry.formula);
+        }
+        catch (Exception::BaseException&)
+        {
+          entry.pos_adduct_compatible.assign(pos_adducts_.size(), false);
+          entry.neg_adduct_compatible.assign(neg_adducts_.size(), false);
+          invalid[i] = true;
+          continue;
+        }
+        entry.pos_adduct_compatible.assign(pos_adducts_.size(), true);
+        for (Size a = 0; a < pos_adducts_.size(); ++a)
+        {
+          if (pos_losses[a]) entry.pos_adduct_compatible[a] = pos_adducts_[a].isCompatible(formula);
+        }
+        entry.neg_adduct_compatible.assign(neg_adducts_.size(), true);
+        for (Size a = 0; a < neg_adducts_.size(); ++a)
+        {
+          if (neg_losses[a]) entry.neg_adduct_compatible[a] = neg_adducts_[a].isCompatible(formula);
+        }
+      }
+      catch (...)
+      {
+#pragma omp critical (AccurateMassSearchEngine_error)
+        if (!error) error = std::current_exception();
+      }
+    }
+    if (error) std::rethrow_exception(error);
+
+    for (Size i = 0; i < mass_mappings_.size(); ++i)
+    {
+      if (invalid[i])
+      {
+        OPENMS_LOG_WARN << "Warning: Cannot parse formula '" << mass_mappings_[i].formula << "' of database entry '"
+                        << ListUtils::concatenate(mass_mappings_[i].massIDs, ",") << "'. Entry is ignored.\n";
+      }
+    }
+  }
+
   void AccurateMassSearchEngine::parseStructMappingFile_(const StringList& db_struct_file)
   {
     hmdb_properties_mapping_.clear();
@@ -46,6 +46,8 @@
 #include <OpenMS/FORMAT/IdXMLFile.h>
 #include <OpenMS/CONCEPT/VersionInfo.h>
 
+#include <algorithm>
+#include <numeric>
 #include <set>
 
 using namespace std;
@@ -954,6 +956,23 @@ namespace OpenMS
       ibg.applyFunctorOnCCs(gif);
     }
 
+    if (debug_lvl_ > 0)
+    {
+      // report the components that dominated the run time
+      const auto& cc_stats = ibg.getComponentStatistics();
+      vector<Size> slowest(cc_stats.size());
+      std::iota(slowest.begin(), slowest.end(), 0);
+      Size nr_report = std::min<Size>(5, slowest.size());
+      std::partial_sort(slowest.begin(), slowest.begin() + nr_report, slowest.end(),
+          [&cc_stats](Size a, Size b) { return cc_stats[a].seconds > cc_stats[b].seconds; });
+      for (Size i = 0; i < nr_report; ++i)
+      {
+        const auto& stats = cc_stats[slowest[i]];
+        OPENMS_LOG_INFO << "CC " << slowest[i] << ": " << stats.nr_vertices << " nodes, " << stats.nr_edges << " edges, "
+                        << stats.functor_result << " messages, " << stats.seconds << " s" << std::endl;
+      }
+    }
+
     //uses the existing protein group nodes in the graph
     ibg.annotateIndistProteins(true);
   }
@@ -37,8 +37,13 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 
 #include <algorithm>
+#include <exception>
 #include <numeric>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 // #define FALSE_DISCOVERY_RATE_DEBUG
 // #undef  FALSE_DISCOVERY_RATE_DEBUG
 
@@ -46,6 +51,46 @@ using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// sorts chunks of @p v in parallel and merges them pairwise (falls back to std::sort for small inputs)
+    template <typename T, typename Compare>
+    void parallelSort(vector<T>& v, Compare comp)
+    {
+      Size chunks = 1;
+#ifdef _OPENMP
+      chunks = (Size)max(1, omp_get_max_threads());
+#endif
+      if (chunks < 2 || v.size() < 100000)
+      {
+        sort(v.begin(), v.end(), comp);
+        return;
+      }
+
+      vector<Size> bounds(chunks + 1);
+      for (Size c = 0; c <= chunks; ++c)
+      {
+        bounds[c] = v.size() * c / chunks;
+      }
+#pragma omp parallel for
+      for (SignedSize c = 0; c < (SignedSize)chunks; ++c)
+      {
+        sort(v.begin() + bounds[c], v.begin() + bounds[c + 1], comp);
+      }
+      // merge neighbouring sorted runs until a single one is left
+      for (Size width = 1; width < chunks; width *= 2)
+      {
+#pragma omp parallel for
+        for (SignedSize c = 0; c < (SignedSize)chunks; c += 2 * width)
+        {
+          Size mid = min(c + width, chunks);
+          Size end = min(c + 2 * width, chunks);
+          inplace_merge(v.begin() + bounds[c], v.begin() + bounds[mid], v.begin() + bounds[end], comp);
+        }
+      }
+    }
+  }
+
   FalseDiscoveryRate::FalseDiscoveryRate() :
     DefaultParamHandler("FalseDiscoveryRate")
   {
@@ -944,7 +989,6 @@ namespace OpenMS
   void FalseDiscoveryRate::applyBasic(ConsensusMap & cmap, bool include_unassigned_peptides)
   {
     bool q_value = !param_.getValue("no_qvalues").toBool();
-    const string& score_type = q_value ? "q-value" : "FDR";
     bool all_hits = param_.getValue("use_all_hits").toBool();
 
     bool treat_runs_separately = param_.getValue("treat_runs_separately").toBool();
@@ -955,7 +999,6 @@ namespace OpenMS
     bool higher_score_better = cmap.begin()->getPeptideIdentifications().begin()->isHigherScoreBetter();
 
     bool add_decoy_peptides = param_.getValue("add_decoy_peptides").toBool();
-    ScoreToTgtDecLabelPairs scores_labels;
 
     //Warning: this assumes that there are no dangling identifier references in the PeptideIDs
     // because this disables checking
@@ -964,6 +1007,10 @@ namespace OpenMS
       treat_runs_separately = false;
     }
 
+    // collect the peptide IDs once, scores are then extracted into flat arrays per run/charge
+    vector<PeptideIdentification*> ids;
+    cmap.applyFunctionOnPeptideIDs([&ids](PeptideIdentification& id) { ids.push_back(&id); }, include_unassigned_peptides);
+
     if (treat_runs_separately)
     {
       for (const auto& protID : cmap.getProteinIdentifications())
@@ -974,27 +1021,18 @@ namespace OpenMS
           for (int c = chargeRange.first; c <= chargeRange.second; ++c)
           {
             if (c == 0) continue;
-            IDScoreGetterSetter::getPeptideScoresFromMap_(scores_labels, cmap, include_unassigned_peptides, all_hits, c, protID.getIdentifier());
-            map<double, double> scores_to_fdr;
-            calculateFDRBasic_(scores_to_fdr, scores_labels, q_value, higher_score_better);
-            IDScoreGetterSetter::setPeptideScoresForMap_(scores_to_fdr, cmap, include_unassigned_peptides, score_type, higher_score_better, add_decoy_peptides, c,  protID.getIdentifier());
+            applyBasicFlat_(ids, all_hits, c, protID.getIdentifier(), add_decoy_peptides, q_value, higher_score_better);
           }
         }
         else
         {
-          IDScoreGetterSetter::getPeptideScoresFromMap_(scores_labels, cmap, include_unassigned_peptides, all_hits, protID.getIdentifier());
-          map<double, double> scores_to_fdr;
-          calculateFDRBasic_(scores_to_fdr, scores_labels, q_value, higher_score_better);
-          IDScoreGetterSetter::setPeptideScoresForMap_(scores_to_fdr, cmap, include_unassigned_peptides, score_type, higher_score_better, add_decoy_peptides, protID.getIdentifier());
+          applyBasicFlat_(ids, all_hits, 0, protID.getIdentifier(), add_decoy_peptides, q_value, higher_score_better);
         }
       }
     }
     else
     {
-      IDScoreGetterSetter::getPeptideScoresFromMap_(scores_labels, cmap, include_unassigned_peptides, all_hits);
-      map<double, double> scores_to_fdr;
-      calculateFDRBasic_(scores_to_fdr, scores_labels, q_value, higher_score_better);
-      IDScoreGetterSetter::setPeptideScoresForMap_(scores_to_fdr, cmap, include_unassigned_peptides, score_type, higher_score_better, add_decoy_peptides);
+      applyBasicFlat_(ids, all_hits, 0, "", add_decoy_peptides, q_value, higher_score_better);
     }
   }
 
@@ -1067,9 +1105,6 @@ namespace OpenMS
   void FalseDiscoveryRate::applyBasic(std::vector<PeptideIdentification> & ids)
   {
     bool q_value = !param_.getValue("no_qvalues").toBool();
-    //TODO Check naming conventions. Ontology?
-    const string& score_type = q_value ? "q-value" : "FDR";
-
     bool use_all_hits = param_.getValue("use_all_hits").toBool();
 
     //TODO this assumes all runs have the same ordering! Otherwise do it per identifier.
@@ -1078,29 +1113,18 @@ namespace OpenMS
     //TODO not yet implemented
     //bool treat_runs_separately = param_.getValue("treat_runs_separately").toBool();
 
-    ScoreToTgtDecLabelPairs scores_labels;
-    std::map<double,double> scores_to_FDR;
-
-    std::vector<int> charges = {0};
-    std::vector<String> identifiers = {""};
-    // if charge states or separate runs: look ahead for possible values and add them to the vecs above
+    vector<PeptideIdentification*> id_ptrs;
+    id_ptrs.reserve(ids.size());
+    for (PeptideIdentification& id : ids)
+    {
+      id_ptrs.push_back(&id);
+    }
 
-    for (const String& identifier : identifiers)
+    // all runs and charges together; decoys are kept
+    if (!applyBasicFlat_(id_ptrs, use_all_hits, 0, "", true, q_value, higher_score_better))
     {
-      for (const int& charge : charges)
-      {
-        //TODO setScores also should have a filter mechanism!!
-        IDScoreGetterSetter::getScores_(scores_labels, ids, use_all_hits, charge, identifier);
-        if (scores_labels.empty())
-        {
-         OPENMS_LOG_ERROR << "No scores for run " << identifier << " and charge " << charge << std::endl;
-          throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No scores could be extracted!");
-        }
-        calculateFDRBasic_(scores_to_FDR, scores_labels, q_value, higher_score_better);
-        if (!scores_labels.empty())
-          IDScoreGetterSetter::setScores_(scores_to_FDR, ids, score_type, false);
-        scores_to_FDR.clear();
-      }
+      OPENMS_LOG_ERROR << "No scores for peptide identifications" << std::endl;
+      throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No scores could be extracted!");
     }
   }
 
@@ -1435,4 +1459,204 @@ namespace OpenMS
     }
   }
 
+  void FalseDiscoveryRate::calculateFDRBasicFlat_(
+      const std::vector<double>& scores,
+      const std::vector<char>& is_target,
+      bool qvalue,
+      bool higher_score_better,
+      std::vector<double>& fdrs,
+      std::vector<double>& unique_scores,
+      std::vector<double>& unique_fdrs) const
+  {
+    bool conservative = param_.getValue("conservative").toBool();
+    const Size n = scores.size();
+    fdrs.assign(n, 0.0);
+    unique_scores.clear();
+    unique_fdrs.clear();
+    if (n == 0) return;
+
+    // sort positions instead of (score, label) pairs, the owner of each entry stays known
+    vector<Size> order(n);
+    iota(order.begin(), order.end(), 0);
+    if (higher_score_better)
+    { // decreasing
+      parallelSort(order, [&scores](Size a, Size b) { return scores[a] > scores[b]; });
+    }
+    else
+    { // increasing
+      parallelSort(order, [&scores](Size a, Size b) { return scores[a] < scores[b]; });
+    }
+
+    // linear sweep over the groups of equal scores (same formulas as calculateFDRBasic_)
+    vector<Size> group_begin;
+    size_t decoys = 0;
+    for (Size j = 0; j < n; ++j)
+    {
+      if (j == 0 || scores[order[j]] != scores[order[j - 1]])
+      {
+        if (j != 0)
+        {
+          unique_fdrs.push_back(conservative ? (decoys + 1.0) / (j + 1.0 - decoys) : (decoys + 1.0) / (j + 1.0));
+        }
+        group_begin.push_back(j);
+        unique_scores.push_back(scores[order[j]]);
+      }
+      if (!is_target[order[j]])
+      {
+        ++decoys;
+      }
+    }
+    unique_fdrs.push_back(conservative ? (decoys + 1.0) / (n + 1.0 - decoys) : (decoys + 1.0) / (n + 1.0));
+    group_begin.push_back(n);
+
+    if (higher_score_better) // lookup tables are in ascending score order (like the std::map in calculateFDRBasic_)
+    {
+      reverse(unique_scores.begin(), unique_scores.end());
+      reverse(unique_fdrs.begin(), unique_fdrs.end());
+    }
+
+    if (qvalue) // cumulative minimum from low to high scores
+    {
+      double cummin = 1.0;
+      for (double& fdr : unique_fdrs)
+      {
+        cummin = min(fdr, cummin);
+        fdr = cummin;
+      }
+    }
+
+    const SignedSize n_groups = (SignedSize)unique_fdrs.size();
+#pragma omp parallel for schedule(dynamic, 1024)
+    for (SignedSize g = 0; g < n_groups; ++g)
+    {
+      const double fdr = unique_fdrs[higher_score_better ? n_groups - 1 - g : g];
+      for (Size j = group_begin[g]; j < group_begin[g + 1]; ++j)
+      {
+        fdrs[order[j]] = fdr;
+      }
+    }
+  }
+
+  bool FalseDiscoveryRate::applyBasicFlat_(
+      const std::vector<PeptideIdentification*>& ids,
+      bool all_hits,
+      int charge,
+      const String& identifier,
+      bool keep_decoy,
+      bool q_value,
+      bool higher_score_better) const
+  {
+    const string& score_type = q_value ? "q-value" : "FDR";
+    const SignedSize n_ids = (SignedSize)ids.size();
+
+    auto in_run = [&identifier](const PeptideIdentification& id)
+    {
+      return identifier.empty() || id.getIdentifier() == identifier;
+    };
+    auto considered = [&charge](const PeptideHit& hit)
+    {
+      return charge == 0 || hit.getCharge() == charge;
+    };
+
+    // count the hits used per ID to get the offsets into the flat arrays
+    vector<Size> offsets(ids.size() + 1, 0);
+#pragma omp parallel for
+    for (SignedSize i = 0; i < n_ids; ++i)
+    {
+      const PeptideIdentification& id = *ids[i];
+      if (!in_run(id)) continue;
+      const vector<PeptideHit>& hits = id.getHits();
+      const Size n_hits = all_hits ? hits.size() : min<Size>(hits.size(), 1);
+      offsets[i + 1] = count_if(hits.begin(), hits.begin() + n_hits, considered);
+    }
+    partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    const Size n = offsets.back();
+    if (n == 0)
+    {
+      OPENMS_LOG_WARN << "Warning: No scores extracted for FDR calculation. Skipping. Do you have target-decoy annotated Hits?" << std::endl;
+      return false;
+    }
+
+    // extract scores, target/decoy labels and hit positions (the target_decoy meta value is read only here)
+    vector<double> scores(n);
+    vector<char> is_target(n);
+    vector<Size> hit_index(n);
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 1024)
+    for (SignedSize i = 0; i < n_ids; ++i)
+    {
+      try
+      {
+        const vector<PeptideHit>& hits = ids[i]->getHits();
+        for (Size h = 0, k = offsets[i]; k < offsets[i + 1]; ++h)
+        {
+          if (!considered(hits[h])) continue;
+          IDScoreGetterSetter::checkTDAnnotation_(hits[h]);
+          scores[k] = hits[h].getScore();
+          is_target[k] = IDScoreGetterSetter::getTDLabel_(hits[h]);
+          hit_index[k] = h;
+          ++k;
+        }
+      }
+      catch (...)
+      {
+#pragma omp critical (FalseDiscoveryRate_error)
+        if (!error) error = std::current_exception();
+      }
+    }
+    if (error) std::rethrow_exception(error);
+
+    vector<double> fdrs, unique_scores, unique_fdrs;
+    calculateFDRBasicFlat_(scores, is_target, q_value, higher_score_better, fdrs, unique_scores, unique_fdrs);
+
+    // write back by position; hits that were not part of the calculation get the value of the closest score >= theirs
+    auto lookup = [&unique_scores, &unique_fdrs](double score)
+    {
+      Size pos = lower_bound(unique_scores.begin(), unique_scores.end(), score) - unique_scores.begin();
+      return unique_fdrs[min(pos, unique_fdrs.size() - 1)];
+    };
+#pragma omp parallel for schedule(dynamic, 1024)
+    for (SignedSize i = 0; i < n_ids; ++i)
+    {
+      PeptideIdentification& id = *ids[i];
+      if (!in_run(id)) continue;
+      const String old_score_type = IDScoreGetterSetter::setScoreType_(id, score_type, false);
+
+      vector<PeptideHit>& hits = id.getHits();
+      vector<PeptideHit> new_hits;
+      if (!keep_decoy) new_hits.reserve(hits.size());
+      Size k = offsets[i];
+      for (Size h = 0; h < hits.size(); ++h)
+      {
+        PeptideHit& hit = hits[h];
+        if (!considered(hit))
+        { // different charge, stays unchanged to be processed later at the correct charge
+          if (!keep_decoy) new_hits.push_back(std::move(hit));
+          continue;
+        }
+        double fdr;
+        bool target;
+        if (k < offsets[i + 1] && hit_index[k] == h)
+        {
+          fdr = fdrs[k];
+          target = is_target[k];
+          ++k;
+        }
+        else
+        {
+          fdr = lookup(hit.getScore());
+          target = keep_decoy || IDScoreGetterSetter::getTDLabel_(hit);
+        }
+        if (!keep_decoy && !target) continue;
+
+        hit.setMetaValue(old_score_type, hit.getScore());
+        hit.setScore(fdr);
+        if (!keep_decoy) new_hits.push_back(std::move(hit));
+      }
+      if (!keep_decoy) hits.swap(new_hits);
+    }
+    return true;
+  }
+
 } // namespace OpenMS
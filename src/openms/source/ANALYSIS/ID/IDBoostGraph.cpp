@@ -45,6 +45,9 @@
 #include <boost/graph/graph_utility.hpp>
 #include <boost/graph/connected_components.hpp>
 
+#include <exception>
+#include <limits>
+#include <numeric>
 #include <ostream>
 #ifdef _OPENMP
 #include <omp.h>
@@ -207,13 +210,44 @@ namespace OpenMS
   }
 
 
-  void IDBoostGraph::addPeptideIDWithAssociatedProteins_(
+  namespace
+  {
+    /// Gathers the peptide IDs of a run in the order they are added to the graph
+    void collectPeptideIDsOfRun(vector<PeptideIdentification>& ids,
+                                const String& run,
+                                vector<PeptideIdentification*>& result)
+    {
+      result.reserve(result.size() + ids.size());
+      for (auto& id : ids)
+      {
+        if (id.getIdentifier() == run) result.push_back(&id);
+      }
+    }
+
+    void collectPeptideIDsOfRun(ConsensusMap& cmap,
+                                const String& run,
+                                bool use_unassigned_ids,
+                                vector<PeptideIdentification*>& result)
+    {
+      for (auto& feature : cmap)
+      {
+        collectPeptideIDsOfRun(feature.getPeptideIdentifications(), run, result);
+      }
+      if (use_unassigned_ids)
+      {
+        collectPeptideIDsOfRun(cmap.getUnassignedPeptideIdentifications(), run, result);
+      }
+    }
+  }
+
+  Size IDBoostGraph::resolvePSMProteinLinks_(
       PeptideIdentification& spectrum,
-      unordered_map<IDPointer, vertex_t, boost::hash<IDPointer>>& vertex_map,
       const unordered_map<string, ProteinHit*>& accession_map,
       Size use_top_psms,
-      bool best_psms_annotated)
+      bool best_psms_annotated,
+      PSMProteinLinks& links)
   {
+    Size missing(0);
     //TODO add psm regularizer nodes here optionally if using multiple psms (i.e. forcing them, so that only 1 or maybe 2 are present per spectrum)
     auto pepIt = spectrum.getHits().begin();
     //TODO sort or assume sorted
@@ -222,90 +256,114 @@ namespace OpenMS
     {
       if (!best_psms_annotated || static_cast<int>(pepIt->getMetaValue("best_per_peptide")))
       {
-        IDPointer pepPtr(&(*pepIt));
-        vertex_t pepV = addVertexWithLookup_(pepPtr, vertex_map);
-
+        links.emplace_back(&(*pepIt), vector<ProteinHit*>());
         for (auto const &proteinAcc : pepIt->extractProteinAccessionsSet())
         {
           // assumes protein is present
           auto accToPHit = accession_map.find(std::string(proteinAcc));
           if (accToPHit == accession_map.end())
           {
-            OPENMS_LOG_WARN << "Warning: Building graph: skipping pep that maps to a non existent protein accession.\n";
+            ++missing;
             continue;
           }
           //TODO consider/calculate missing digests. Probably not here though!
           //int missingTheorDigests = accToPHit->second->getMetaValue("missingTheorDigests");
           //accToPHit->second->setMetaValue("missingTheorDigests", missingTheorDigests);
-
-          IDPointer prot(accToPHit->second);
-          vertex_t protV = addVertexWithLookup_(prot, vertex_map);
-          boost::add_edge(protV, pepV, g);
+          links.back().second.push_back(accToPHit->second);
         }
       }
     }
+    return missing;
   }
 
-  void IDBoostGraph::addPeptideAndAssociatedProteinsWithRunInfo_(
-      PeptideIdentification& spectrum,
-      unordered_map<unsigned, unsigned>& indexToPrefractionationGroup,
-      unordered_map<IDPointer, vertex_t, boost::hash<IDPointer>>& vertex_map,
-      unordered_map<std::string, ProteinHit*>& accession_map,
-      Size use_top_psms)
+  Size IDBoostGraph::getPrefractionationGroup_(
+      const PeptideIdentification& spectrum,
+      const unordered_map<unsigned, unsigned>& indexToPrefractionationGroup)
   {
-    Size idx(0);
-    Size pfg(0);
+    if (!spectrum.metaValueExists("id_merge_index"))
+    {
+      throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Trying to read run information (id_merge_index) but none present at peptide ID."
+        " Did you annotate runs during merging? Aborting.");
+    }
+    Size idx = spectrum.getMetaValue("id_merge_index");
+    auto find_it = indexToPrefractionationGroup.find(idx);
+    if (find_it == indexToPrefractionationGroup.end())
+    {
+      throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Reference (id_merge_index) to non-existing run found at peptide ID."
+          " Sth went wrong during merging. Aborting.");
+    }
+    return find_it->second - 1; // Experimental design numbering starts at one
+  }
 
-    if (spectrum.metaValueExists("id_merge_index"))
+  void IDBoostGraph::addPeptideIDsWithAssociatedProteins_(
+      const vector<PeptideIdentification*>& spectra,
+      unordered_map<IDPointer, vertex_t, boost::hash<IDPointer>>& vertex_map,
+      const unordered_map<string, ProteinHit*>& accession_map,
+      Size use_top_psms,
+      bool best_psms_annotated,
+      const unordered_map<unsigned, unsigned>* indexToPrefractionationGroup,
+      const String& progress_label)
+  {
+    ProgressLogger pl;
+    pl.setLogType(ProgressLogger::CMD);
+    pl.startProgress(0, spectra.size(), progress_label);
+
+    // Resolving accessions (string extraction + hashing) is the expensive part of building
+    // and independent per spectrum. Graph insertion stays sequential.
+    vector<PSMProteinLinks> links(spectra.size());
+    vector<Size> missing(spectra.size(), 0);
+    std::exception_ptr error;
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize i = 0; i < static_cast<SignedSize>(spectra.size()); ++i)
     {
-      idx = spectrum.getMetaValue("id_merge_index");
-      auto find_it = indexToPrefractionationGroup.find(idx);
-      if (find_it == indexToPrefractionationGroup.end())
+      try
       {
-        throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-            "Reference (id_merge_index) to non-existing run found at peptide ID."
-            " Sth went wrong during merging. Aborting.");
+        missing[i] = resolvePSMProteinLinks_(*spectra[i], accession_map, use_top_psms, best_psms_annotated, links[i]);
+      }
+      catch (...)
+      {
+        #pragma omp critical (IDBoostGraph_build_error)
+        if (!error) error = std::current_exception();
       }
-      pfg = find_it->second - 1; // Experimental design numbering starts at one
     }
-    else
+    if (error)
     {
-      throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-        "Trying to read run information (id_merge_index) but none present at peptide ID."
-        " Did you annotate runs during merging? Aborting.");
+      pl.endProgress();
+      std::rethrow_exception(error);
     }
 
-    //TODO add psm regularizer nodes here optionally if using multiple psms
-    auto pepIt = spectrum.getHits().begin();
-    //TODO sort or assume sorted
-    auto pepItEnd = use_top_psms == 0 || spectrum.getHits().empty() ? spectrum.getHits().end() : spectrum.getHits().begin() + use_top_psms;
-    for (; pepIt != pepItEnd; ++pepIt)
+    vertex_map.reserve(vertex_map.size() + accession_map.size() + spectra.size());
+    for (Size i = 0; i < spectra.size(); ++i)
     {
-      IDPointer pepPtr(&(*pepIt));
-      vertex_t pepV = addVertexWithLookup_(pepPtr, vertex_map);
-
-      //------- Only difference to the function without run info -----//
-      pepHitVtx_to_run_[pepV] = pfg;
-      //------- Only difference to the function without run info -----//
-
-      for (auto const & proteinAcc : pepIt->extractProteinAccessionsSet())
+      Size pfg(0);
+      if (indexToPrefractionationGroup != nullptr)
+      {
+        pfg = getPrefractionationGroup_(*spectra[i], *indexToPrefractionationGroup);
+      }
+      for (Size m = 0; m < missing[i]; ++m)
+      {
+        OPENMS_LOG_WARN << "Warning: Building graph: skipping pep that maps to a non existent protein accession.\n";
+      }
+      for (const auto& psm_prots : links[i])
       {
-        // assumes protein is present
-        auto accToPHit = accession_map.find(std::string(proteinAcc));
-        if (accToPHit == accession_map.end())
+        vertex_t pepV = addVertexWithLookup_(IDPointer(psm_prots.first), vertex_map);
+        if (indexToPrefractionationGroup != nullptr)
         {
-         OPENMS_LOG_WARN << "Warning: Building graph: skipping pep that maps to a non existent protein accession.\n";
-          continue;
+          pepHitVtx_to_run_[pepV] = pfg;
+        }
+        for (ProteinHit* prot : psm_prots.second)
+        {
+          vertex_t protV = addVertexWithLookup_(IDPointer(prot), vertex_map);
+          boost::add_edge(protV, pepV, g);
         }
-        //TODO consider/calculate missing digests. Probably not here though!
-        //int missingTheorDigests = accToPHit->second->getMetaValue("missingTheorDigests");
-        //accToPHit->second->setMetaValue("missingTheorDigests", missingTheorDigests);
-
-        IDPointer prot(accToPHit->second);
-        vertex_t protV = addVertexWithLookup_(prot, vertex_map);
-        boost::add_edge(protV, pepV, g);
       }
+      // free the resolved links early, they can be large for big cohorts
+      PSMProteinLinks().swap(links[i]);
+      pl.nextProgress();
     }
+    pl.endProgress();
   }
 
   void IDBoostGraph::buildGraphWithRunInfo_(ProteinIdentification& proteins,
@@ -338,38 +396,11 @@ namespace OpenMS
       accession_map[prot.getAccession()] = &prot;
     }
 
-    ProgressLogger pl;
-    Size roughNrIds = cmap.size();
-    if (use_unassigned_ids) roughNrIds += cmap.getUnassignedPeptideIdentifications().size();
-    pl.setLogType(ProgressLogger::CMD);
-    pl.startProgress(0, roughNrIds, "Building graph with run information...");
     const String& protRun = proteins.getIdentifier();
-    for (auto& feat : cmap)
-    {
-      for (auto& spectrum : feat.getPeptideIdentifications())
-      {
-        if (spectrum.getIdentifier() == protRun)
-        {
-          addPeptideAndAssociatedProteinsWithRunInfo_(spectrum, indexToPrefractionationGroup,
-                                                      vertex_map, accession_map, use_top_psms);
-        }
-      }
-      pl.nextProgress();
-    }
-
-    if (use_unassigned_ids)
-    {
-      for (auto& id : cmap.getUnassignedPeptideIdentifications())
-      {
-        if (id.getIdentifier() == protRun)
-        {
-          addPeptideAndAssociatedProteinsWithRunInfo_(id, indexToPrefractionationGroup,
-                                                      vertex_map, accession_map, use_top_psms);
-        }
-        pl.nextProgress();
-      }
-    }
-    pl.endProgress();
+    vector<PeptideIdentification*> spectra;
+    collectPeptideIDsOfRun(cmap, protRun, use_unassigned_ids, spectra);
+    addPeptideIDsWithAssociatedProteins_(spectra, vertex_map, accession_map, use_top_psms, false,
+                                         &indexToPrefractionationGroup, "Building graph with run information...");
   }
 
   void IDBoostGraph::buildGraphWithRunInfo_(ProteinIdentification& proteins,
@@ -400,20 +431,11 @@ namespace OpenMS
       accession_map[prot.getAccession()] = &prot;
     }
 
-    ProgressLogger pl;
-    pl.setLogType(ProgressLogger::CMD);
-    pl.startProgress(0, idedSpectra.size(), "Building graph with run info...");
     const String& protRun = proteins.getIdentifier();
-    for (auto& spectrum : idedSpectra)
-    {
-      if (spectrum.getIdentifier() == protRun)
-      {
-        addPeptideAndAssociatedProteinsWithRunInfo_(spectrum, indexToPrefractionationGroup,
-                                                      vertex_map, accession_map, use_top_psms);
-      }
-      pl.nextProgress();
-    }
-    pl.endProgress();
+    vector<PeptideIdentification*> spectra;
+    collectPeptideIDsOfRun(idedSpectra, protRun, spectra);
+    addPeptideIDsWithAssociatedProteins_(spectra, vertex_map, accession_map, use_top_psms, false,
+                                         &indexToPrefractionationGroup, "Building graph with run info...");
   }
 
   //TODO actually to build the graph, the inputs could be passed const. But if you want to do sth
@@ -432,26 +454,18 @@ namespace OpenMS
       accession_map[prot.getAccession()] = &prot;
     }
 
-    ProgressLogger pl;
-    pl.setLogType(ProgressLogger::CMD);
-    pl.startProgress(0, idedSpectra.size(), "Building graph...");
     const String& protRun = proteins.getIdentifier();
-    for (auto& spectrum : idedSpectra)
-    {
-      if (spectrum.getIdentifier() == protRun)
-      {
-        addPeptideIDWithAssociatedProteins_(spectrum, vertex_map, accession_map, use_top_psms, best_psms_annotated);
-      }
-      pl.nextProgress();
-    }
-    pl.endProgress();
+    vector<PeptideIdentification*> spectra;
+    collectPeptideIDsOfRun(idedSpectra, protRun, spectra);
+    addPeptideIDsWithAssociatedProteins_(spectra, vertex_map, accession_map, use_top_psms, best_psms_annotated,
+                                         nullptr, "Building graph...");
   }
 
 
   void IDBoostGraph::buildGraph_(ProteinIdentification& proteins,
                                  ConsensusMap& cmap,
                                  Size use_top_psms,
-                                 bool use_unassigned_ids,
+                                bool use_unassigned_ids,
                                  bool best_psms_annotated)
   {
     StringList runs;
@@ -466,35 +480,11 @@ namespace OpenMS
       accession_map[prot.getAccession()] = &prot;
     }
 
-    ProgressLogger pl;
-    Size roughNrIds = cmap.size();
-    if (use_unassigned_ids) roughNrIds += cmap.getUnassignedPeptideIdentifications().size();
-    pl.setLogType(ProgressLogger::CMD);
-    pl.startProgress(0, roughNrIds, "Building graph...");
     const String& protRun = proteins.getIdentifier();
-    for (auto& feature : cmap)
-    {
-      for (auto& id : feature.getPeptideIdentifications())
-      {
-        if (id.getIdentifier() == protRun)
-        {
-          addPeptideIDWithAssociatedProteins_(id, vertex_map, accession_map, use_top_psms, best_psms_annotated);
-        }
-      }
-      pl.nextProgress();
-    }
-    if (use_unassigned_ids)
-    {
-      for (auto& id : cmap.getUnassignedPeptideIdentifications())
-      {
-        if (id.getIdentifier() == protRun)
-        {
-          addPeptideIDWithAssociatedProteins_(id, vertex_map, accession_map, use_top_psms, best_psms_annotated);
-        }
-        pl.nextProgress();
-      }
-    }
-    pl.endProgress();
+    vector<PeptideIdentification*> spectra;
+    collectPeptideIDsOfRun(cmap, protRun, use_unassigned_ids, spectra);
+    addPeptideIDsWithAssociatedProteins_(spectra, vertex_map, accession_map, use_top_psms, best_psms_annotated,
+                                         nullptr, "Building graph...");
   }
 
 
@@ -617,14 +607,26 @@ namespace OpenMS
       throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No connected components annotated. Run computeConnectedComponents first!");
     }
 
-    // Use dynamic schedule because big CCs take much longer!
-    #pragma omp parallel for schedule(dynamic) default(none) shared(functor)
-    for (int i = 0; i < static_cast<int>(ccs_.size()); i += 1)
+    cc_stats_.assign(ccs_.size(), ComponentStatistics());
+    for (Size i = 0; i < ccs_.size(); ++i)
+    {
+      cc_stats_[i].nr_vertices = boost::num_vertices(ccs_[i]);
+      cc_stats_[i].nr_edges = boost::num_edges(ccs_[i]);
+    }
+
+    // Largest first: with index order, one giant component that happens to come late would
+    // start when all other threads are already done.
+    vector<Size> order(ccs_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](Size a, Size b)
+      {
+        return cc_stats_[a].nr_vertices + cc_stats_[a].nr_edges > cc_stats_[b].nr_vertices + cc_stats_[b].nr_edges;
+      });
+
+    auto process_cc = [this, &functor](Size i)
     {
-      #ifdef INFERENCE_BENCH
       StopWatch sw;
       sw.start();
-      #endif
 
       Graph& curr_cc = ccs_.at(i);
 
@@ -639,30 +641,31 @@ namespace OpenMS
       OPENMS_LOG_INFO << "Printed cc " << i << "\n";
       #endif
 
-      #ifdef INFERENCE_BENCH
-      unsigned long result = functor(curr_cc);
-      #else
-      functor(curr_cc, i);
-      #endif
+      cc_stats_[i].functor_result = functor(curr_cc, static_cast<unsigned int>(i));
 
-      #ifdef INFERENCE_BENCH
       sw.stop();
-      sizes_and_times_[i] = tuple<vertex_t, vertex_t, unsigned long, double>{boost::num_vertices(curr_cc), boost::num_edges(curr_cc), result, sw.getClockTime()};
-      #endif
-    }
-
-    #ifdef INFERENCE_BENCH
-    ofstream debugfile;
-    debugfile.open("idgraph_functortimes_" + DateTime::now().getTime() + ".tsv");
+      cc_stats_[i].seconds = sw.getClockTime();
+    };
 
-    for (const auto& size_time : sizes_and_times_ )
+    std::exception_ptr error;
+    // Use dynamic schedule because big CCs take much longer!
+    #pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < static_cast<SignedSize>(order.size()); ++i)
     {
-      debugfile << std::get<0>(size_time) << "\t"
-        << std::get<1>(size_time) << "\t"
-        << std::get<2>(size_time) << "\t"
-        << std::get<3>(size_time) << "\n";
+      try
+      {
+        process_cc(order[i]);
+      }
+      catch (...)
+      {
+        #pragma omp critical (IDBoostGraph_functor_error)
+        if (!error) error = std::current_exception();
+      }
     }
-    debugfile.close();
+    if (error) std::rethrow_exception(error);
+
+    #ifdef INFERENCE_BENCH
+    writeComponentStatistics_();
     #endif
   }
 
@@ -673,12 +676,11 @@ namespace OpenMS
       throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No connected components annotated. Run computeConnectedComponents first!");
     }
 
-    for (int i = 0; i < static_cast<int>(ccs_.size()); i += 1)
+    cc_stats_.assign(ccs_.size(), ComponentStatistics());
+    for (Size i = 0; i < ccs_.size(); ++i)
     {
-      #ifdef INFERENCE_BENCH
       StopWatch sw;
       sw.start();
-      #endif
 
       Graph& curr_cc = ccs_.at(i);
 
@@ -691,23 +693,38 @@ namespace OpenMS
 
       functor(curr_cc);
 
-      #ifdef INFERENCE_BENCH
       sw.stop();
-      sizes_and_times_[i] = tuple<vertex_t, vertex_t, unsigned long, double>{boost::num_vertices(curr_cc), boost::num_edges(curr_cc), 0, sw.getClockTime()};
-      #endif
+      cc_stats_[i].nr_vertices = boost::num_vertices(curr_cc);
+      cc_stats_[i].nr_edges = boost::num_edges(curr_cc);
+      cc_stats_[i].seconds = sw.getClockTime();
     }
 
     #ifdef INFERENCE_BENCH
+    writeComponentStatistics_();
+    #endif
+  }
+
+  const std::vector<IDBoostGraph::ComponentStatistics>& IDBoostGraph::getComponentStatistics() const
+  {
+    return cc_stats_;
+  }
+
+  #ifdef INFERENCE_BENCH
+  void IDBoostGraph::writeComponentStatistics_() const
+  {
     ofstream debugfile;
     debugfile.open("idgraph_functortimes_" + DateTime::now().getTime() + ".tsv");
 
-    for (const auto& size_time : sizes_and_times_ )
+    for (const auto& stats : cc_stats_)
     {
-      debugfile << std::get<0>(size_time) << "\t" << std::get<1>(size_time) <<  "\t" << std::get<2>(size_time) << "\t" << std::get<3>(size_time) << "\n";
+      debugfile << stats.nr_vertices << "\t"
+        << stats.nr_edges << "\t"
+        << stats.functor_result << "\t"
+        << stats.seconds << "\n";
     }
     debugfile.close();
-    #endif
   }
+  #endif
 
   void IDBoostGraph::annotateIndistProteins(bool addSingletons)
   {
@@ -1465,12 +1482,93 @@ namespace OpenMS
   //TODO we should probably rename it to splitCC now. Add logging and timing?
   void IDBoostGraph::computeConnectedComponents()
   {
-    auto vis = dfs_ccsplit_visitor(ccs_);
-    boost::depth_first_search(g, visitor(vis));
+    const Size nr_vertices = boost::num_vertices(g);
+
+    // Compressed sparse row copy of the adjacency structure. Out-edges of the setS graph
+    // are sorted by target, so the CSR rows are sorted as well.
+    vector<Size> row_start(nr_vertices + 1, 0);
+    for (Size v = 0; v < nr_vertices; ++v)
+    {
+      row_start[v + 1] = row_start[v] + boost::out_degree(v, g);
+    }
+    vector<vertex_t> adjacent(row_start[nr_vertices]);
+    for (Size v = 0; v < nr_vertices; ++v)
+    {
+      Size pos = row_start[v];
+      Graph::adjacency_iterator adjIt, adjIt_end;
+      for (boost::tie(adjIt, adjIt_end) = boost::adjacent_vertices(v, g); adjIt != adjIt_end; ++adjIt)
+      {
+        adjacent[pos++] = *adjIt;
+      }
+    }
+
+    // Iterative depth-first search on the CSR. Visiting order equals the one of
+    // boost::depth_first_search, so the components (and the vertex IDs inside them)
+    // come out exactly as with the former dfs_ccsplit_visitor.
+    const Size unvisited = std::numeric_limits<Size>::max();
+    vector<Size> component(nr_vertices, unvisited);
+    vector<vertex_t> local_index(nr_vertices);
+    vector<vector<vertex_t>> members;
+    vector<pair<vertex_t, Size>> stack; // vertex and next CSR position to examine
+    for (Size start = 0; start < nr_vertices; ++start)
+    {
+      if (component[start] != unvisited) continue;
+      const Size cc = members.size();
+      members.emplace_back(1, start);
+      component[start] = cc;
+      local_index[start] = 0;
+      stack.emplace_back(start, row_start[start]);
+      while (!stack.empty())
+      {
+        auto& top = stack.back();
+        if (top.second == row_start[top.first + 1])
+        {
+          stack.pop_back();
+          continue;
+        }
+        vertex_t next = adjacent[top.second++];
+        if (component[next] == unvisited)
+        {
+          component[next] = cc;
+          local_index[next] = members[cc].size();
+          members[cc].push_back(next);
+          stack.emplace_back(next, row_start[next]);
+        }
+      }
+    }
+
+    // Filling the component graphs is independent per component. Schedule the largest
+    // ones first so a single giant component does not start last.
+    vector<Size> by_size(members.size());
+    std::iota(by_size.begin(), by_size.end(), 0);
+    std::stable_sort(by_size.begin(), by_size.end(),
+        [&members](Size a, Size b) { return members[a].size() > members[b].size(); });
+
+    ccs_.clear();
+    ccs_.resize(members.size());
+    #pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < static_cast<SignedSize>(by_size.size()); ++i)
+    {
+      const Size cc = by_size[i];
+      const vector<vertex_t>& cc_members = members[cc];
+      Graph& cc_graph = ccs_[cc];
+      for (vertex_t v : cc_members)
+      {
+        boost::add_vertex(g[v], cc_graph);
+      }
+      for (vertex_t v : cc_members)
+      {
+        const vertex_t local_v = local_index[v];
+        for (Size pos = row_start[v]; pos < row_start[v + 1]; ++pos)
+        {
+          const vertex_t local_w = local_index[adjacent[pos]];
+          // every undirected edge is stored at both ends, add it once
+          if (local_v < local_w) boost::add_edge(local_v, local_w, cc_graph);
+        }
+      }
+    }
     OPENMS_LOG_INFO << "Found " << ccs_.size() << " connected components.\n";
-    #ifdef INFERENCE_BENCH
-    sizes_and_times_.resize(ccs_.size());
-    #endif
+    cc_stats_.clear();
     g.clear();
   }
 
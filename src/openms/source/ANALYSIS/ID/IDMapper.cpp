@@ -36,8 +36,13 @@
 #include <OpenMS/MATH/MISC/MathFunctions.h>
 #include <OpenMS/METADATA/SpectrumLookup.h>
 
+#include <exception>
 #include <unordered_set>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 using namespace std;
 
@@ -271,109 +276,140 @@ namespace OpenMS
     // keep track of assigned/unassigned precursors
     std::map<Size, Size> assigned_precursors;
 
-    // store which peptides fit which feature (and avoid double entries)
-    // consensusMap -> {peptide_index}
-    vector<set<size_t>> mapping(map.size());
-
-    DoubleList mz_values;
-    double rt_pep;
-    IntList charges;
+    // index consensus features by the RT of their centroids (or sub-elements), so only
+    // features within the RT tolerance need to be checked for each identification
+    vector<pair<double, Size> > rt_index;
+    rt_index.reserve(map.size());
+    for (Size cm_index = 0; cm_index < map.size(); ++cm_index)
+    {
+      if (!measure_from_subelements)
+      {
+        rt_index.emplace_back(map[cm_index].getRT(), cm_index);
+      }
+      else
+      {
+        for (const FeatureHandle& handle : map[cm_index].getFeatures())
+        {
+          rt_index.emplace_back(handle.getRT(), cm_index);
+        }
+      }
+    }
+    sort(rt_index.begin(), rt_index.end());
 
     // for statistics
     Size id_matches_none(0), id_matches_single(0), id_matches_multiple(0);
 
-    // iterate over the peptide IDs
-    for (Size i = 0; i < ids.size(); ++i)
+    // Find the matching consensus features of all peptide IDs in parallel. Each match
+    // stores the sub-element the ID was matched to (for the "map_index" annotation).
+    // IDs are attached to the features afterwards, in their original order.
+    vector<vector<pair<Size, const FeatureHandle*> > > id_matches(ids.size());
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize i = 0; i < (SignedSize) ids.size(); ++i)
     {
-      if (ids[i].getHits().empty()) continue;
+      try
+      {
+        if (ids[i].getHits().empty()) continue;
 
-      getIDDetails_(ids[i], rt_pep, mz_values, charges);
+        DoubleList mz_values;
+        double rt_pep;
+        IntList charges;
+        getIDDetails_(ids[i], rt_pep, mz_values, charges);
 
-      bool id_mapped(false);
+        vector<Size> candidates;
+        getRTCandidates_(rt_index, rt_pep, candidates);
 
-      // iterate over the features
-      for (Size cm_index = 0; cm_index < map.size(); ++cm_index)
-      {
-        // if set to TRUE, we leave the i_mz-loop as we added the whole ID with all hits
-        bool was_added = false; // was current pep-m/z matched?!
-
-        // iterate over m/z values of pepIds
-        for (Size i_mz = 0; i_mz < mz_values.size(); ++i_mz)
+        // iterate over the features
+        for (Size cm_index : candidates)
         {
-          double mz_pep = mz_values[i_mz];
+          const ConsensusFeature& feature = map[cm_index];
 
-          // charge states to use for checking:
-          IntList current_charges;
-          if (!ignore_charge_)
+          // iterate over m/z values of pepIds
+          for (Size i_mz = 0; i_mz < mz_values.size(); ++i_mz)
           {
-            // if "mz_ref." is "precursor", we have only one m/z value to check,
-            // but still one charge state per peptide hit that could match:
-            if (mz_values.size() == 1)
-            {
-              current_charges = charges;
-            }
-            else
+            double mz_pep = mz_values[i_mz];
+
+            // charge states to use for checking:
+            IntList current_charges;
+            if (!ignore_charge_)
             {
-              current_charges.push_back(charges[i_mz]);
+              // if "mz_ref." is "precursor", we have only one m/z value to check,
+              // but still one charge state per peptide hit that could match:
+              if (mz_values.size() == 1)
+              {
+                current_charges = charges;
+              }
+              else
+              {
+                current_charges.push_back(charges[i_mz]);
+              }
+              current_charges.push_back(0); // "not specified" always matches
             }
-            current_charges.push_back(0); // "not specified" always matches
-          }
 
-          //check if we compare distance from centroid or subelements
-          if (!measure_from_subelements)
-          {
-            if (isMatch_(rt_pep - map[cm_index].getRT(), mz_pep, map[cm_index].getMZ()) && (ignore_charge_ || ListUtils::contains(current_charges, map[cm_index].getCharge())))
+            const FeatureHandle* matched_handle = nullptr;
+            bool matched = false;
+
+            //check if we compare distance from centroid or subelements
+            if (!measure_from_subelements)
             {
-              id_mapped = true;
-              was_added = true;
-              map[cm_index].getPeptideIdentifications().push_back(ids[i]);
-              ++assigned_ids[i];
+              matched = isMatch_(rt_pep - feature.getRT(), mz_pep, feature.getMZ()) && (ignore_charge_ || ListUtils::contains(current_charges, feature.getCharge()));
             }
-          }
-          else
-          {
-            for (ConsensusFeature::HandleSetType::const_iterator it_handle = map[cm_index].getFeatures().begin();
-                 it_handle != map[cm_index].getFeatures().end();
-                 ++it_handle)
+            else
             {
-              if (isMatch_(rt_pep - it_handle->getRT(), mz_pep, it_handle->getMZ())  && (ignore_charge_ || ListUtils::contains(current_charges, it_handle->getCharge())))
+              for (ConsensusFeature::HandleSetType::const_iterator it_handle = feature.getFeatures().begin();
+                   it_handle != feature.getFeatures().end();
+                   ++it_handle)
               {
-                id_mapped = true;
-                was_added = true;
-                if (mapping[cm_index].count(i) == 0)
+                if (isMatch_(rt_pep - it_handle->getRT(), mz_pep, it_handle->getMZ())  && (ignore_charge_ || ListUtils::contains(current_charges, it_handle->getCharge())))
                 {
-                  // Store the map index of the peptide feature in the id the feature was mapped to.
-                  PeptideIdentification id_pep = ids[i];
-                  if (annotate_ids_with_subelements)
-                  {
-                    id_pep.setMetaValue("map_index", it_handle->getMapIndex());
-                  }
-
-                  map[cm_index].getPeptideIdentifications().push_back(id_pep);
-                  ++assigned_ids[i];
-                  mapping[cm_index].insert(i);
+                  matched = true;
+                  matched_handle = &(*it_handle);
+                  break; // no need to check other handles
                 }
-                break; // we added this peptide already.. no need to check other handles
               }
             }
-            // continue to here
-          }
 
-          if (was_added) break;
-
-        } // m/z values to check
-
-        // break to here
+            // we added the whole ID with all hits, no need to check further m/z values
+            if (matched)
+            {
+              id_matches[i].emplace_back(cm_index, matched_handle);
+              break;
+            }
+          } // m/z values to check
+        } // features
+      }
+      catch (...)
+      {
+#pragma omp critical (IDMapper_error)
+        if (!error) error = std::current_exception();
+      }
+    } // Identifications
+    if (error) std::rethrow_exception(error);
 
-      } // features
+    for (Size i = 0; i < ids.size(); ++i)
+    {
+      if (ids[i].getHits().empty()) continue;
 
       // the id has not been mapped to any consensus feature
-      if (!id_mapped)
+      if (id_matches[i].empty())
       {
         map.getUnassignedPeptideIdentifications().push_back(ids[i]);
         ++id_matches_none;
+        continue;
       }
-    } // Identifications
+
+      for (const pair<Size, const FeatureHandle*>& match : id_matches[i])
+      {
+        vector<PeptideIdentification>& feature_ids = map[match.first].getPeptideIdentifications();
+        feature_ids.push_back(ids[i]);
+        if (match.second != nullptr && annotate_ids_with_subelements)
+        {
+          // Store the map index of the peptide feature in the id the feature was mapped to.
+          feature_ids.back().setMetaValue("map_index", match.second->getMapIndex());
+        }
+      }
+      assigned_ids[i] = id_matches[i].size();
+    }
 
     for (std::map<Size, Size>::const_iterator it = assigned_ids.begin(); it != assigned_ids.end(); ++it)
     {
@@ -453,8 +489,10 @@ namespace OpenMS
         }
         precursor_empty_id.setIdentifier(empty_protein_id.getIdentifier());
 
-        // iterate over the consensus features
-        for (Size cm_index = 0; cm_index < map.size(); ++cm_index)
+        // iterate over the consensus features (within RT tolerance)
+        vector<Size> candidates;
+        getRTCandidates_(rt_index, rt_value, candidates);
+        for (Size cm_index : candidates)
         {
           // charge states to use for checking:
           IntList current_charges;
@@ -601,12 +639,21 @@ namespace OpenMS
     // in the beginning:
     SignedSize offset(0);
 
+    // within each slice, features are sorted by the lower m/z bound of their bounding
+    // box, so candidates for a given m/z can be found by binary search:
+    vector<double> hash_max_mz_width;
+    auto box_below_mz = [&boxes](SignedSize f, double mz)
+    {
+      return boxes[f].minPosition().getY() < mz;
+    };
+
     if (map.size() > 0)
     {
       // cout << "Setting up hash table..." << endl;
       offset = SignedSize(floor(min_rt));
       // this only works if features were found
       hash_table.resize(SignedSize(floor(max_rt)) - offset + 1);
+      hash_max_mz_width.resize(hash_table.size(), 0.0);
       for (Size index = 0; index < boxes.size(); ++index)
       {
         const DBoundingBox<2> & box = boxes[index];
@@ -614,8 +661,16 @@ namespace OpenMS
              i <= SignedSize(floor(box.maxPosition().getX())); ++i)
         {
           hash_table[i - offset].push_back(index);
+          hash_max_mz_width[i - offset] = max(hash_max_mz_width[i - offset], box.maxPosition().getY() - box.minPosition().getY());
         }
       }
+      for (vector<SignedSize>& slice : hash_table)
+      {
+        stable_sort(slice.begin(), slice.end(), [&boxes](SignedSize a, SignedSize b)
+        {
+          return boxes[a].minPosition().getY() < boxes[b].minPosition().getY();
+        });
+      }
     }
     else
     {
@@ -626,95 +681,118 @@ namespace OpenMS
     Size matches_none = 0, matches_single = 0, matches_multi = 0;
 
     // cout << "Finding matches..." << endl;
-    // iterate over peptide IDs:
-    for (vector<PeptideIdentification>::const_iterator id_it =
-         ids.begin(); id_it != ids.end(); ++id_it)
+    // Find the matching features of all peptide IDs in parallel. The IDs are
+    // attached to the features afterwards, in their original order.
+    vector<vector<Size> > id_matches(ids.size());
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize id_index = 0; id_index < (SignedSize) ids.size(); ++id_index)
     {
-      // cout << "Peptide ID: " << id_it - ids.begin() << endl;
-
-      if (id_it->getHits().empty()) continue;
+      try
+      {
+        const PeptideIdentification& id = ids[id_index];
+        if (id.getHits().empty()) continue;
 
-      DoubleList mz_values;
-      double rt_value;
-      IntList charges;
-      getIDDetails_(*id_it, rt_value, mz_values, charges, use_avg_mass);
+        DoubleList mz_values;
+        double rt_value;
+        IntList charges;
+        getIDDetails_(id, rt_value, mz_values, charges, use_avg_mass);
 
-      if ((rt_value < min_rt) || (rt_value > max_rt)) // RT out of bounds
-      {
-        map.getUnassignedPeptideIdentifications().push_back(*id_it);
-        ++matches_none;
-        continue;
-      }
+        if ((rt_value < min_rt) || (rt_value > max_rt) || mz_values.empty()) continue; // RT out of bounds
 
-      // iterate over candidate features:
-      Size index = SignedSize(floor(rt_value)) - offset;
-      Size matching_features = 0;
-      for (vector<SignedSize>::iterator hash_it =
-           hash_table[index].begin(); hash_it != hash_table[index].end();
-           ++hash_it)
-      {
-        Feature & feat = map[*hash_it];
+        // candidate features: the bounding box must start below the highest and
+        // can at most extend by the widest box of the slice above the lowest m/z value
+        Size index = SignedSize(floor(rt_value)) - offset;
+        const vector<SignedSize>& slice = hash_table[index];
+        pair<DoubleList::const_iterator, DoubleList::const_iterator> mz_range = minmax_element(mz_values.begin(), mz_values.end());
+        double mz_min = *mz_range.first - hash_max_mz_width[index] - 1e-6;
+        double mz_max = *mz_range.second;
+        vector<SignedSize>::const_iterator hash_begin = lower_bound(slice.begin(), slice.end(), mz_min, box_below_mz);
 
-        // need to check the charge state?
-        bool check_charge = !ignore_charge_;
-        if (check_charge && (mz_values.size() == 1))               // check now
+        // iterate over candidate features:
+        for (vector<SignedSize>::const_iterator hash_it = hash_begin;
+             hash_it != slice.end() && boxes[*hash_it].minPosition().getY() <= mz_max;
+             ++hash_it)
         {
-          if (!ListUtils::contains(charges, feat.getCharge())) continue;
-          check_charge = false;                 // don't need to check later
-        }
+          const Feature & feat = map[*hash_it];
 
-        // iterate over m/z values (only one if "mz_ref." is "precursor"):
-        Size l_index = 0;
-        for (DoubleList::iterator mz_it = mz_values.begin();
-             mz_it != mz_values.end(); ++mz_it, ++l_index)
-        {
-          if (check_charge && (charges[l_index] != feat.getCharge()))
+          // need to check the charge state?
+          bool check_charge = !ignore_charge_;
+          if (check_charge && (mz_values.size() == 1))               // check now
           {
-            continue;                   // charge states need to match
+            if (!ListUtils::contains(charges, feat.getCharge())) continue;
+            check_charge = false;                 // don't need to check later
           }
 
-          DPosition<2> id_pos(rt_value, *mz_it);
-          if (boxes[*hash_it].encloses(id_pos))                 // potential match
+          // iterate over m/z values (only one if "mz_ref." is "precursor"):
+          Size l_index = 0;
+          for (DoubleList::const_iterator mz_it = mz_values.begin();
+               mz_it != mz_values.end(); ++mz_it, ++l_index)
           {
-            if (use_centroid_mz)
+            if (check_charge && (charges[l_index] != feat.getCharge()))
             {
-              // only one m/z value to check, which was already incorporated
-              // into the overall bounding box -> success!
-              feat.getPeptideIdentifications().push_back(*id_it);
-              ++matching_features;
-              break;                     // "mz_it" loop
+              continue;                   // charge states need to match
             }
-            // else: check all the mass traces
-            bool found_match = false;
-            for (vector<ConvexHull2D>::iterator ch_it =
-                 feat.getConvexHulls().begin(); ch_it !=
-                 feat.getConvexHulls().end(); ++ch_it)
+
+            DPosition<2> id_pos(rt_value, *mz_it);
+            if (boxes[*hash_it].encloses(id_pos))                 // potential match
             {
-              DBoundingBox<2> box = ch_it->getBoundingBox();
-              if (use_centroid_rt)
+              if (use_centroid_mz)
               {
-                box.setMinX(feat.getRT());
-                box.setMaxX(feat.getRT());
+                // only one m/z value to check, which was already incorporated
+                // into the overall bounding box -> success!
+                id_matches[id_index].push_back(*hash_it);
+                break;                     // "mz_it" loop
               }
-              increaseBoundingBox_(box);
-              if (box.encloses(id_pos)) // success!
+              // else: check all the mass traces
+              bool found_match = false;
+              for (vector<ConvexHull2D>::const_iterator ch_it =
+                   feat.getConvexHulls().begin(); ch_it !=
+                   feat.getConvexHulls().end(); ++ch_it)
               {
-                feat.getPeptideIdentifications().push_back(*id_it);
-                ++matching_features;
-                found_match = true;
-                break; // "ch_it" loop
+                DBoundingBox<2> box = ch_it->getBoundingBox();
+                if (use_centroid_rt)
+                {
+                  box.setMinX(feat.getRT());
+                  box.setMaxX(feat.getRT());
+                }
+                increaseBoundingBox_(box);
+                if (box.encloses(id_pos)) // success!
+                {
+                  id_matches[id_index].push_back(*hash_it);
+                  found_match = true;
+                  break; // "ch_it" loop
+                }
               }
+              if (found_match) break; // "mz_it" loop
             }
-            if (found_match) break; // "mz_it" loop
           }
         }
       }
-      if (matching_features == 0)
+      catch (...)
+      {
+#pragma omp critical (IDMapper_error)
+        if (!error) error = std::current_exception();
+      }
+    }
+    if (error) std::rethrow_exception(error);
+
+    for (Size id_index = 0; id_index < ids.size(); ++id_index)
+    {
+      if (ids[id_index].getHits().empty()) continue;
+
+      const vector<Size>& matching_features = id_matches[id_index];
+      for (Size f : matching_features)
+      {
+        map[f].getPeptideIdentifications().push_back(ids[id_index]);
+      }
+
+      if (matching_features.empty())
       {
-        map.getUnassignedPeptideIdentifications().push_back(*id_it);
+        map.getUnassignedPeptideIdentifications().push_back(ids[id_index]);
         ++matches_none;
       }
-      else if (matching_features == 1)
+      else if (matching_features.size() == 1)
       {
         ++matches_single;
       }
@@ -791,8 +869,19 @@ namespace OpenMS
         precursor_empty_id.setIdentifier(empty_protein_id.getIdentifier());
         //precursor_empty_id.setCharge(z_p);
 
+        // candidate features in the m/z range, checked in their original order
+        const vector<SignedSize>& slice = hash_table[index];
+        vector<SignedSize> candidates;
+        for (vector<SignedSize>::const_iterator hash_it = lower_bound(slice.begin(), slice.end(), mz_p - hash_max_mz_width[index] - 1e-6, box_below_mz);
+             hash_it != slice.end() && boxes[*hash_it].minPosition().getY() <= mz_p;
+             ++hash_it)
+        {
+          candidates.push_back(*hash_it);
+        }
+        sort(candidates.begin(), candidates.end());
+
         for (vector<SignedSize>::iterator hash_it =
-           hash_table[index].begin(); hash_it != hash_table[index].end();
+           candidates.begin(); hash_it != candidates.end();
            ++hash_it)
         {
           Feature & feat = map[*hash_it];
@@ -894,6 +983,21 @@ namespace OpenMS
     throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "IDMapper::getAbsoluteTolerance_(): illegal internal state of measure_!", String(measure_));
   }
 
+  void IDMapper::getRTCandidates_(const vector<pair<double, Size> >& rt_index, const double rt, vector<Size>& candidates) const
+  {
+    candidates.clear();
+    // widen the window slightly to be robust against rounding, isMatch_() does the exact check
+    const double rt_window = rt_tolerance_ + 1e-6;
+    vector<pair<double, Size> >::const_iterator it = lower_bound(rt_index.begin(), rt_index.end(), make_pair(rt - rt_window, Size(0)));
+    for (; it != rt_index.end() && it->first <= rt + rt_window; ++it)
+    {
+      candidates.push_back(it->second);
+    }
+    // features are checked in their original order
+    sort(candidates.begin(), candidates.end());
+    candidates.erase(unique(candidates.begin(), candidates.end()), candidates.end());
+  }
+
   void IDMapper::checkHits_(const vector<PeptideIdentification>& ids) const
   {
     for (Size i = 0; i < ids.size(); ++i)
@@ -441,14 +441,14 @@ namespace OpenMS
   {
     sort(spec_db.begin(), spec_db.end(), PrecursorMZLess);
 
-    vector<double> mz_keys;
+    SpectralLibraryIndex library;
+    library.build(spec_db);
+    run(msexp, library, mztab_out);
+  }
 
-    // copy precursor m/z values to vector for searching
-    for (Size spec_idx = 0; spec_idx < spec_db.size(); ++spec_idx)
-    {
-      mz_keys.push_back(spec_db[spec_idx].getPrecursors()[0].getMZ());
-    }
 
+  void MetaboliteSpectralMatching::run(PeakMap& msexp, const SpectralLibraryIndex& library, MzTab& mztab_out)
+  {
     // remove potential noise peaks by selecting the ten most intense peak per 100 Da window
     WindowMower wm;
     Param wm_param;
@@ -466,16 +466,23 @@ namespace OpenMS
     wm.filterPeakMap(msexp);
 
 
-    // container storing results
-    vector<SpectralMatch> matching_results;
-
     bool fragment_error_unit_ppm(true);
     if (mz_error_unit_ == "Da") { fragment_error_unit_ppm = false; }
 
-    for (Size spec_idx = 0; spec_idx < msexp.size(); ++spec_idx)
+    // results of each query spectrum (collected in parallel, reported in spectrum order)
+    vector<vector<SpectralMatch>> spectrum_results(msexp.size());
+
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize spec_idx = 0; spec_idx < (SignedSize)msexp.size(); ++spec_idx)
     {
       // cout << "merged spectrum no. " << spec_idx << " with #fragment ions: " << msexp[spec_idx].size() << endl;
 
+      // fragment bins the peaks of this spectrum can match
+      vector<UInt32> query_bins;
+      library.getQueryBins(msexp[spec_idx], fragment_mz_error_, fragment_error_unit_ppm, query_bins);
+
+      vector<SpectralMatch>& matching_results = spectrum_results[spec_idx];
+
       // iterate over all precursor masses
       for (Size prec_idx = 0; prec_idx < msexp[spec_idx].getPrecursors().size(); ++prec_idx)
       {
@@ -501,52 +508,55 @@ namespace OpenMS
         // cout << "lower mz: " << prec_mz_lowerbound << " ";
         // cout << "upper mz: " << prec_mz_upperbound << endl;
 
-        vector<double>::const_iterator lower_it = lower_bound(mz_keys.begin(), mz_keys.end(), prec_mz_lowerbound);
-        vector<double>::const_iterator upper_it = upper_bound(mz_keys.begin(), mz_keys.end(), prec_mz_upperbound);
-
-        Size start_idx(lower_it - mz_keys.begin());
-        Size end_idx(upper_it - mz_keys.begin());
+        std::pair<Size, Size> range = library.getPrecursorRange(prec_mz_lowerbound, prec_mz_upperbound);
 
         //cout << "identifying " << msexp[spec_idx].getMetaValue("Massbank_Accession_ID") << endl;
 
         vector<SpectralMatch> partial_results;
 
-        for (Size search_idx = start_idx; search_idx < end_idx; ++search_idx)
+        for (Size search_idx = range.first; search_idx < range.second; ++search_idx)
         {
           // do spectral matching
-          // cout << "scanning " << spec_db[search_idx].getPrecursors()[0].getMZ() << " " << spec_db[search_idx].getMetaValue("Metabolite_Name") << endl;
+          // cout << "scanning " << library.getPrecursorMZ(search_idx) << " " << library.getSpectrum(search_idx).getMetaValue("Metabolite_Name") << endl;
 
           // check for charge state of precursor ions: do they match?
-          if ( (ion_mode_ == "positive" && spec_db[search_idx].getPrecursors()[0].getCharge() < 0) || (ion_mode_ == "negative" && spec_db[search_idx].getPrecursors()[0].getCharge() > 0))
+          if ( (ion_mode_ == "positive" && library.getPrecursorCharge(search_idx) < 0) || (ion_mode_ == "negative" && library.getPrecursorCharge(search_idx) > 0))
+          {
+            continue;
+          }
+
+          // the hyperscore is zero for less than three matching peaks
+          if (library.countMatchingPeaks(search_idx, query_bins) < 3)
           {
             continue;
           }
 
-          double hyperscore(computeHyperScore(fragment_mz_error_, fragment_error_unit_ppm, msexp[spec_idx], spec_db[search_idx], 0.0));
+          const MSSpectrum& db_spectrum = library.getSpectrum(search_idx);
+          double hyperscore(computeHyperScore(fragment_mz_error_, fragment_error_unit_ppm, msexp[spec_idx], db_spectrum, 0.0));
 
           // cout << " scored with " << hyperScore << endl;
           if (hyperscore > 0)
           {
-            // cout << "  ** detected " << spec_db[search_idx].getMetaValue("Massbank_Accession_ID") << " " << spec_db[search_idx].getMetaValue("Metabolite_Name") << " scored with " << hyperscore << endl;
+            // cout << "  ** detected " << db_spectrum.getMetaValue("Massbank_Accession_ID") << " " << db_spectrum.getMetaValue("Metabolite_Name") << " scored with " << hyperscore << endl;
 
             // score result temporarily
             SpectralMatch tmp_match;
             tmp_match.setObservedPrecursorMass(precursor_mz);
-            tmp_match.setFoundPrecursorMass(spec_db[search_idx].getPrecursors()[0].getMZ());
+            tmp_match.setFoundPrecursorMass(library.getPrecursorMZ(search_idx));
             double obs_rt = floor(msexp[spec_idx].getRT() * 10)/10.0;
             tmp_match.setObservedPrecursorRT(obs_rt);
-            tmp_match.setFoundPrecursorCharge(spec_db[search_idx].getPrecursors()[0].getCharge());
+            tmp_match.setFoundPrecursorCharge(library.getPrecursorCharge(search_idx));
             tmp_match.setMatchingScore(hyperscore);
             tmp_match.setObservedSpectrumIndex(spec_idx);
             tmp_match.setMatchingSpectrumIndex(search_idx);
 
-            tmp_match.setPrimaryIdentifier(spec_db[search_idx].getMetaValue("Massbank_Accession_ID"));
-            tmp_match.setSecondaryIdentifier(spec_db[search_idx].getMetaValue("HMDB_ID"));
-            tmp_match.setSumFormula(spec_db[search_idx].getMetaValue("Sum_Formula"));
-            tmp_match.setCommonName(spec_db[search_idx].getMetaValue("Metabolite_Name"));
-            tmp_match.setInchiString(spec_db[search_idx].getMetaValue("Inchi_String"));
-            tmp_match.setSMILESString(spec_db[search_idx].getMetaValue("SMILES_String"));
-            tmp_match.setPrecursorAdduct(spec_db[search_idx].getMetaValue("Precursor_Ion"));
+            tmp_match.setPrimaryIdentifier(db_spectrum.getMetaValue("Massbank_Accession_ID"));
+            tmp_match.setSecondaryIdentifier(db_spectrum.getMetaValue("HMDB_ID"));
+            tmp_match.setSumFormula(db_spectrum.getMetaValue("Sum_Formula"));
+            tmp_match.setCommonName(db_spectrum.getMetaValue("Metabolite_Name"));
+            tmp_match.setInchiString(db_spectrum.getMetaValue("Inchi_String"));
+            tmp_match.setSMILESString(db_spectrum.getMetaValue("SMILES_String"));
+            tmp_match.setPrecursorAdduct(db_spectrum.getMetaValue("Precursor_Ion"));
 
             partial_results.push_back(tmp_match);
           }
@@ -580,6 +590,13 @@ namespace OpenMS
       } // end precursor loop
     } // end spectra loop
 
+    // container storing results
+    vector<SpectralMatch> matching_results;
+    for (const vector<SpectralMatch>& results : spectrum_results)
+    {
+      matching_results.insert(matching_results.end(), results.begin(), results.end());
+    }
+
     // write final results to MzTab
     exportMzTab_(matching_results, mztab_out);
   }
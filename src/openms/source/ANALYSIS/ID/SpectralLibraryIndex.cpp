@@ -0,0 +1,476 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/ANALYSIS/ID/SpectralLibraryIndex.h>
+
+#include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/FORMAT/MSPGenericFile.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFileInfo>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace
+  {
+    /// Identifies a spectral library cache file
+    const char CACHE_MAGIC[8] = {'O', 'M', 'S', 'S', 'P', 'L', 'I', 'B'};
+
+    /// Increase whenever the cache layout changes
+    const UInt32 CACHE_VERSION = 1;
+
+    /// Meta values of library spectra that are kept in the cache (the ones reported by MetaboliteSpectralMatching)
+    const char* const CACHED_META_VALUES[] = {"Massbank_Accession_ID", "HMDB_ID", "Sum_Formula", "Metabolite_Name",
+                                              "Inchi_String", "SMILES_String", "Precursor_Ion"};
+
+    /// Binary output in host byte order (the cache is local, not an exchange format)
+    class CacheWriter
+    {
+    public:
+      template <typename T>
+      void write(T value)
+      {
+        data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+      }
+
+      void write(const String& value)
+      {
+        write<UInt32>(static_cast<UInt32>(value.size()));
+        data.append(value);
+      }
+
+      std::string data;
+    };
+
+    /// Reads what CacheWriter wrote; throws on truncated data
+    class CacheReader
+    {
+    public:
+      CacheReader(const std::string& data, const String& filename) :
+        data_(data),
+        filename_(filename)
+      {
+      }
+
+      template <typename T>
+      T read()
+      {
+        check_(sizeof(T));
+        T value;
+        memcpy(&value, data_.data() + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+      }
+
+      String readString()
+      {
+        const UInt32 size = read<UInt32>();
+        check_(size);
+        String value(data_.substr(pos_, size));
+        pos_ += size;
+        return value;
+      }
+
+    private:
+      void check_(Size n) const
+      {
+        if (n > data_.size() - pos_)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_, "truncated spectral library cache");
+        }
+      }
+
+      const std::string& data_;
+      const String& filename_;
+      Size pos_ = 0;
+    };
+
+    /// Charge from an MSP "Precursor_type" (e.g. "[M+H]+", "[M-2H]2-") or "Ion_mode" entry (0 if unknown)
+    Int chargeFromMSP(const MSSpectrum& spectrum)
+    {
+      if (spectrum.metaValueExists("Precursor_type"))
+      {
+        const String type = spectrum.getMetaValue("Precursor_type").toString().trim();
+        if (!type.empty() && (type.back() == '+' || type.back() == '-'))
+        {
+          Int charge = 1;
+          if (type.size() > 1 && isdigit(type[type.size() - 2]))
+          {
+            charge = type[type.size() - 2] - '0';
+          }
+          return type.back() == '+' ? charge : -charge;
+        }
+      }
+      if (spectrum.metaValueExists("Ion_mode"))
+      {
+        const String mode = spectrum.getMetaValue("Ion_mode").toString().trim().toUpper();
+        if (mode.hasPrefix("P")) return 1;
+        if (mode.hasPrefix("N")) return -1;
+      }
+      return 0;
+    }
+
+    /// Size and modification time of a file
+    void fileStamp(const String& filename, UInt64& size, Int64& time)
+    {
+      QFileInfo info(filename.toQString());
+      size = static_cast<UInt64>(info.size());
+      time = static_cast<Int64>(info.lastModified().toMSecsSinceEpoch());
+    }
+  }
+
+  SpectralLibraryIndex::SpectralLibraryIndex(double bin_width) :
+    bin_width_(bin_width)
+  {
+    if (bin_width_ <= 0.0)
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The fragment bin width must be positive.", String(bin_width));
+    }
+  }
+
+  void SpectralLibraryIndex::build(const PeakMap& library)
+  {
+    spectra_.clear();
+    spectra_.reserve(library.size());
+    for (const MSSpectrum& spectrum : library)
+    {
+      if (spectrum.getPrecursors().empty()) continue;
+      spectra_.push_back(spectrum);
+    }
+    buildIndex_();
+  }
+
+  void SpectralLibraryIndex::loadMSP(const String& filename, const String& cache_filename)
+  {
+    if (!File::exists(filename))
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    UInt64 source_size(0);
+    Int64 source_time(0);
+    fileStamp(filename, source_size, source_time);
+    if (!cache_filename.empty() && File::exists(cache_filename))
+    {
+      try
+      {
+        if (load_(cache_filename, source_size, source_time, true)) return;
+      }
+      catch (Exception::BaseException& e)
+      {
+        OPENMS_LOG_WARN << "Ignoring invalid spectral library cache '" << cache_filename << "': " << e.what() << endl;
+      }
+    }
+
+    PeakMap library;
+    MSPGenericFile().load(filename, library);
+
+    // MSP entries carry the precursor and the reported information as plain fields
+    const std::pair<const char*, const char*> field_to_meta[] = {{"Formula", "Sum_Formula"}, {"InChI", "Inchi_String"},
+      {"SMILES", "SMILES_String"}, {"Precursor_type", "Precursor_Ion"}, {"DB#", "Massbank_Accession_ID"}};
+    spectra_.clear();
+    spectra_.reserve(library.size());
+    for (MSSpectrum& spectrum : library)
+    {
+      if (spectrum.getPrecursors().empty())
+      {
+        const char* mz_field = spectrum.metaValueExists("PrecursorMZ") ? "PrecursorMZ" : "PRECURSORMZ";
+        if (!spectrum.metaValueExists(mz_field)) continue;
+        Precursor precursor;
+        try
+        {
+          precursor.setMZ(spectrum.getMetaValue(mz_field).toString().toDouble());
+        }
+        catch (Exception::ConversionError&)
+        {
+          continue;
+        }
+        precursor.setCharge(chargeFromMSP(spectrum));
+        spectrum.getPrecursors().push_back(precursor);
+      }
+      if (!spectrum.metaValueExists("Metabolite_Name"))
+      {
+        spectrum.setMetaValue("Metabolite_Name", spectrum.getName());
+      }
+      for (const auto& field : field_to_meta)
+      {
+        if (spectrum.metaValueExists(field.first) && !spectrum.metaValueExists(field.second))
+        {
+          spectrum.setMetaValue(field.second, spectrum.getMetaValue(field.first));
+        }
+      }
+      spectra_.push_back(std::move(spectrum));
+    }
+    buildIndex_();
+
+    if (!cache_filename.empty())
+    {
+      // the cache only saves time later: failing to write it is not an error
+      try
+      {
+        store_(cache_filename, source_size, source_time);
+      }
+      catch (Exception::BaseException& e)
+      {
+        OPENMS_LOG_WARN << "Could not write spectral library cache '" << cache_filename << "': " << e.what() << endl;
+      }
+    }
+  }
+
+  void SpectralLibraryIndex::store(const String& filename) const
+  {
+    store_(filename, 0, 0);
+  }
+
+  void SpectralLibraryIndex::load(const String& filename)
+  {
+    if (!File::exists(filename))
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    load_(filename, 0, 0, false);
+  }
+
+  Size SpectralLibraryIndex::size() const
+  {
+    return spectra_.size();
+  }
+
+  bool SpectralLibraryIndex::empty() const
+  {
+    return spectra_.empty();
+  }
+
+  double SpectralLibraryIndex::getBinWidth() const
+  {
+    return bin_width_;
+  }
+
+  const MSSpectrum& SpectralLibraryIndex::getSpectrum(Size index) const
+  {
+    return spectra_[index];
+  }
+
+  double SpectralLibraryIndex::getPrecursorMZ(Size index) const
+  {
+    return precursor_mz_[index];
+  }
+
+  Int SpectralLibraryIndex::getPrecursorCharge(Size index) const
+  {
+    return precursor_charge_[index];
+  }
+
+  std::pair<Size, Size> SpectralLibraryIndex::getPrecursorRange(double mz_lower, double mz_upper) const
+  {
+    const Size first = lower_bound(precursor_mz_.begin(), precursor_mz_.end(), mz_lower) - precursor_mz_.begin();
+    const Size last = upper_bound(precursor_mz_.begin(), precursor_mz_.end(), mz_upper) - precursor_mz_.begin();
+    return make_pair(first, max(first, last));
+  }
+
+  void SpectralLibraryIndex::getQueryBins(const MSSpectrum& spectrum, double fragment_mass_error, bool fragment_mass_tolerance_unit_ppm, std::vector<UInt32>& bins) const
+  {
+    bins.clear();
+    for (const Peak1D& peak : spectrum)
+    {
+      const double mz = peak.getMZ();
+      // a ppm tolerance refers to the library peak, which may be slightly heavier than the query peak
+      const double tolerance = fragment_mass_tolerance_unit_ppm ?
+        mz * fragment_mass_error * 1e-6 / (1.0 - min(fragment_mass_error * 1e-6, 0.5)) : fragment_mass_error;
+      for (UInt32 bin = getBin_(mz - tolerance), last = getBin_(mz + tolerance); bin <= last; ++bin)
+      {
+        bins.push_back(bin);
+      }
+    }
+    sort(bins.begin(), bins.end());
+    bins.erase(unique(bins.begin(), bins.end()), bins.end());
+  }
+
+  Size SpectralLibraryIndex::countMatchingPeaks(Size index, const std::vector<UInt32>& query_bins) const
+  {
+    Size count(0);
+    auto query_it = query_bins.begin();
+    for (Size i = bin_offsets_[index]; i < bin_offsets_[index + 1] && query_it != query_bins.end(); ++i)
+    {
+      // both lists are sorted: advance the query bins to the current library bin
+      while (query_it != query_bins.end() && *query_it < bins_[i]) ++query_it;
+      if (query_it != query_bins.end() && *query_it == bins_[i]) ++count;
+    }
+    return count;
+  }
+
+  UInt32 SpectralLibraryIndex::getBin_(double mz) const
+  {
+    return static_cast<UInt32>(max(mz, 0.0) / bin_width_);
+  }
+
+  void SpectralLibraryIndex::buildIndex_()
+  {
+    // stable, so that spectra with equal precursor m/z keep the library order
+    stable_sort(spectra_.begin(), spectra_.end(), [](const MSSpectrum& a, const MSSpectrum& b)
+    {
+      return a.getPrecursors()[0].getMZ() < b.getPrecursors()[0].getMZ();
+    });
+
+    precursor_mz_.resize(spectra_.size());
+    precursor_charge_.resize(spectra_.size());
+    bin_offsets_.assign(1, 0);
+    bin_offsets_.reserve(spectra_.size() + 1);
+    bins_.clear();
+    for (Size i = 0; i < spectra_.size(); ++i)
+    {
+      MSSpectrum& spectrum = spectra_[i];
+      if (!spectrum.isSorted()) spectrum.sortByPosition();
+      precursor_mz_[i] = spectrum.getPrecursors()[0].getMZ();
+      precursor_charge_[i] = spectrum.getPrecursors()[0].getCharge();
+      for (const Peak1D& peak : spectrum)
+      {
+        bins_.push_back(getBin_(peak.getMZ()));
+      }
+      bin_offsets_.push_back(bins_.size());
+    }
+  }
+
+  bool SpectralLibraryIndex::load_(const String& filename, UInt64 source_size, Int64 source_time, bool check_source)
+  {
+    std::ifstream ifs(filename.c_str(), std::ios::binary);
+    char magic[sizeof(CACHE_MAGIC)];
+    UInt32 version(0);
+    double bin_width(0.0);
+    UInt64 stored_size(0), size(0);
+    Int64 stored_time(0);
+    ifs.read(magic, sizeof(magic));
+    ifs.read(reinterpret_cast<char*>(&version), sizeof(version));
+    ifs.read(reinterpret_cast<char*>(&bin_width), sizeof(bin_width));
+    ifs.read(reinterpret_cast<char*>(&stored_size), sizeof(stored_size));
+    ifs.read(reinterpret_cast<char*>(&stored_time), sizeof(stored_time));
+    ifs.read(reinterpret_cast<char*>(&size), sizeof(size));
+    if (!ifs || memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0 || version != CACHE_VERSION)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "not a spectral library cache of version " + String(CACHE_VERSION));
+    }
+    if (check_source && (stored_size != source_size || stored_time != source_time))
+    {
+      return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    if (data.size() != size)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "truncated spectral library cache");
+    }
+
+    CacheReader in(data, filename);
+    std::vector<MSSpectrum> spectra(in.read<UInt64>());
+    for (MSSpectrum& spectrum : spectra)
+    {
+      spectrum.setName(in.readString());
+      spectrum.setMSLevel(2);
+      Precursor precursor;
+      precursor.setMZ(in.read<double>());
+      precursor.setCharge(in.read<Int32>());
+      spectrum.getPrecursors().push_back(precursor);
+      const UInt32 n_meta = in.read<UInt32>();
+      for (UInt32 m = 0; m < n_meta; ++m)
+      {
+        const String key = in.readString();
+        spectrum.setMetaValue(key, in.readString());
+      }
+      spectrum.resize(in.read<UInt64>());
+      for (Peak1D& peak : spectrum)
+      {
+        peak.setMZ(in.read<double>());
+        peak.setIntensity(in.read<float>());
+      }
+    }
+
+    bin_width_ = bin_width;
+    spectra_.swap(spectra);
+    buildIndex_();
+    return true;
+  }
+
+  void SpectralLibraryIndex::store_(const String& filename, UInt64 source_size, Int64 source_time) const
+  {
+    CacheWriter out;
+    out.write<UInt64>(spectra_.size());
+    for (const MSSpectrum& spectrum : spectra_)
+    {
+      out.write(spectrum.getName());
+      out.write<double>(spectrum.getPrecursors()[0].getMZ());
+      out.write<Int32>(spectrum.getPrecursors()[0].getCharge());
+      std::vector<const char*> keys;
+      for (const char* key : CACHED_META_VALUES)
+      {
+        if (spectrum.metaValueExists(key)) keys.push_back(key);
+      }
+      out.write<UInt32>(static_cast<UInt32>(keys.size()));
+      for (const char* key : keys)
+      {
+        out.write(String(key));
+        out.write(spectrum.getMetaValue(key).toString());
+      }
+      out.write<UInt64>(spectrum.size());
+      for (const Peak1D& peak : spectrum)
+      {
+        out.write<double>(peak.getMZ());
+        out.write<float>(peak.getIntensity());
+      }
+    }
+
+    std::ofstream ofs(filename.c_str(), std::ios::binary);
+    const UInt64 size = out.data.size();
+    ofs.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    ofs.write(reinterpret_cast<const char*>(&CACHE_VERSION), sizeof(CACHE_VERSION));
+    ofs.write(reinterpret_cast<const char*>(&bin_width_), sizeof(bin_width_));
+    ofs.write(reinterpret_cast<const char*>(&source_size), sizeof(source_size));
+    ofs.write(reinterpret_cast<const char*>(&source_time), sizeof(source_time));
+    ofs.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    ofs.write(out.data.data(), out.data.size());
+    if (!ofs)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+  }
+
+} // namespace OpenMS
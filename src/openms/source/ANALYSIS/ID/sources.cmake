@@ -40,6 +40,7 @@ PercolatorFeatureSetHelper.cpp
 SimpleSearchEngineAlgorithm.cpp
 SiriusAdapterAlgorithm.cpp
 SiriusMSConverter.cpp
+SpectralLibraryIndex.cpp
 )
 
 ### add path to the filenames
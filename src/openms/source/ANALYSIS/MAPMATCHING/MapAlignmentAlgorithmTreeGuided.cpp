@@ -46,6 +46,8 @@
 
 #include <include/OpenMS/APPLICATIONS/MapAlignerBase.h>
 
+#include <exception>
+
 using namespace std;
 
 namespace OpenMS
@@ -73,12 +75,12 @@ namespace OpenMS
     model_param_ = model_param_.copy(model_type_+":", true);
   }
 
-  // Similarity functor that provides similarity calculations with the ()-operator for protected type SeqAndRTList
-  // that stores retention times given for individual peptide sequences of a feature map
+  // Similarity functor that provides similarity calculations with the ()-operator for protected type SeqIndexAndMedianRT
+  // that stores the median retention time given for individual peptide sequences of a feature map
   class MapAlignmentAlgorithmTreeGuided::PeptideIdentificationsPearsonDistance_
   {
   public:
-    float operator()(SeqAndRTList& map_first, SeqAndRTList& map_second) const
+    float operator()(const SeqIndexAndMedianRT& map_first, const SeqIndexAndMedianRT& map_second) const
     {
       // if both input maps have no peptide identifications with hits (sequence) they are not similar
       if (map_first.size()+map_second.size() == 0)
@@ -105,10 +107,8 @@ namespace OpenMS
         }
         else
         {
-          double med1 = Math::median(pep1_it->second.begin(), pep1_it->second.end(), true);
-          intercept_rts1.push_back(med1);
-          double med2 = Math::median(pep2_it->second.begin(), pep2_it->second.end(), true);
-          intercept_rts2.push_back(med2);
+          intercept_rts1.push_back(pep1_it->second);
+          intercept_rts2.push_back(pep2_it->second);
           ++pep1_it;
           ++pep2_it;
         }
@@ -134,8 +134,7 @@ namespace OpenMS
     {
       if (!peptide.getHits().empty())
       {
-        const String& sequence = peptide.getHits()[0].getSequence().toString();
-        peptide_rts[sequence].push_back(feature_rt);
+        peptide_rts.emplace_back(peptide.getHits()[0].getSequence().toString(), feature_rt);
         map_range.push_back(feature_rt);
       }
     }
@@ -145,7 +144,8 @@ namespace OpenMS
   void MapAlignmentAlgorithmTreeGuided::extractSeqAndRt_(const vector<FeatureMap>& feature_maps,
           vector<SeqAndRTList>& maps_seq_and_rt, vector<vector<double>>& maps_ranges)
   {
-    for (Size i = 0; i < feature_maps.size(); ++i)
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < (SignedSize)feature_maps.size(); ++i)
     {
       for (const BaseFeature& bf : feature_maps[i])
       {
@@ -158,6 +158,51 @@ namespace OpenMS
     }
   }
 
+  // Build the compact index of median RTs per sequence, using a sequence index shared by all maps.
+  void MapAlignmentAlgorithmTreeGuided::buildSeqIndex_(vector<SeqAndRTList>& maps_seq_and_rt, vector<SeqIndexAndMedianRT>& maps_index)
+  {
+    // stable sort by sequence: RTs of the same sequence stay in order of extraction
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < (SignedSize)maps_seq_and_rt.size(); ++i)
+    {
+      std::stable_sort(maps_seq_and_rt[i].begin(), maps_seq_and_rt[i].end(),
+                       [](const pair<String, double>& a, const pair<String, double>& b) { return a.first < b.first; });
+    }
+
+    // common sequence index of all maps (lexicographical order, so index order equals sequence order)
+    vector<String> sequences;
+    for (const SeqAndRTList& seq_and_rt : maps_seq_and_rt)
+    {
+      for (const auto& entry : seq_and_rt)
+      {
+        if (sequences.empty() || sequences.back() != entry.first) sequences.push_back(entry.first);
+      }
+    }
+    sort(sequences.begin(), sequences.end());
+    sequences.erase(unique(sequences.begin(), sequences.end()), sequences.end());
+
+    maps_index.clear();
+    maps_index.resize(maps_seq_and_rt.size());
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < (SignedSize)maps_seq_and_rt.size(); ++i)
+    {
+      const SeqAndRTList& seq_and_rt = maps_seq_and_rt[i];
+      vector<double> rts;
+      auto seq_it = sequences.begin();
+      for (auto group_begin = seq_and_rt.begin(); group_begin != seq_and_rt.end(); )
+      {
+        rts.clear();
+        auto group_end = group_begin;
+        for (; group_end != seq_and_rt.end() && group_end->first == group_begin->first; ++group_end)
+        {
+          rts.push_back(group_end->second);
+        }
+        seq_it = lower_bound(seq_it, sequences.end(), group_begin->first);
+        maps_index[i].emplace_back(seq_it - sequences.begin(), Math::median(rts.begin(), rts.end(), true));
+        group_begin = group_end;
+      }
+    }
+  }
 
   // Extract RTs given for individual features of each map, calculate distances for each pair of maps and cluster hierarchical using average linkage.
   void MapAlignmentAlgorithmTreeGuided::buildTree(std::vector<FeatureMap>& feature_maps, std::vector<BinaryTreeNode>& tree,
@@ -165,12 +210,32 @@ namespace OpenMS
   {
     vector<SeqAndRTList> maps_seq_and_rt(feature_maps.size());
     extractSeqAndRt_(feature_maps, maps_seq_and_rt, maps_ranges);
+    vector<SeqIndexAndMedianRT> maps_index;
+    buildSeqIndex_(maps_seq_and_rt, maps_index);
+    maps_seq_and_rt.clear();
+
     PeptideIdentificationsPearsonDistance_ pep_dist;
     AverageLinkage al;
     DistanceMatrix<float> dist_matrix; // will be filled
     ClusterHierarchical ch;
 
-    ch.cluster<SeqAndRTList, PeptideIdentificationsPearsonDistance_>(maps_seq_and_rt, pep_dist, al, tree, dist_matrix);
+    // fill the distance matrix in parallel, ClusterHierarchical only computes it if the dimension does not fit
+    const SignedSize n = maps_index.size();
+    if (n > 0)
+    {
+      dist_matrix.resize(n, 1);
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize i = 1; i < n; ++i)
+      {
+        for (SignedSize j = 0; j < i; ++j)
+        {
+          // distance value is 1-similarity value
+          dist_matrix.setValueQuick(i, j, 1 - pep_dist(maps_index[i], maps_index[j]));
+        }
+      }
+    }
+
+    ch.cluster<SeqIndexAndMedianRT, PeptideIdentificationsPearsonDistance_>(maps_index, pep_dist, al, tree, dist_matrix);
   }
 
   // Align feature maps tree guided using align() of MapAlignmentAlgorithmIdentification and use TreeNode with larger 10/90 percentile range as reference.
@@ -181,8 +246,6 @@ namespace OpenMS
                                                             std::vector<Size>& trafo_order)
   {
     Size last_trafo = 0;  // to get final transformation order from map_sets
-    vector<TransformationDescription> transformations_align;  // temporary for aligner output
-    vector<FeatureMap> to_align;
 
     // helper to memorize rt transformation order
     vector<vector<Size>> map_sets(feature_maps_transformed.size());
@@ -191,9 +254,6 @@ namespace OpenMS
       map_sets[i].push_back(i);
     }
 
-    Size ref;
-    Size to_transform;
-
     // check RT ranges of IDs
     for (size_t i = 0; i < maps_ranges.size(); ++i)
     {
@@ -202,70 +262,108 @@ namespace OpenMS
       if (maps_ranges[i].empty()) throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "FeatureMap originating from '" + ListUtils::concatenate(p, "', '") + "' contains no Peptide Identifications. Cannot align!");
     }
 
-    for (const auto& node : tree)
+    // group merge steps into levels: steps of one level do not depend on each other and touch disjoint clusters
+    vector<Size> cluster_level(feature_maps_transformed.size(), 0);
+    vector<vector<Size>> levels;
+    for (Size k = 0; k < tree.size(); ++k)
     {
-      // ----------------
-      // prepare alignment
-      // ----------------
-      //  determine the map with larger RT range for 10/90 percentile (->reference)
-      double left_range = maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.9] - maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.1];
-      double right_range = maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.9] - maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.1];
-
-      if (left_range > right_range)
-      {
-        ref = node.left_child;
-        to_transform = node.right_child;
-      }
-      else
-      {
-        ref = node.right_child;
-        to_transform = node.left_child;
-      }
-
-      vector<double> tmp;
-      std::merge(maps_ranges[node.right_child].begin(), maps_ranges[node.right_child].end(), maps_ranges[node.left_child].begin(), maps_ranges[node.left_child].end(), std::back_inserter(tmp));
-
-      to_align.push_back(feature_maps_transformed[to_transform]);
-      to_align.push_back(feature_maps_transformed[ref]);
-
-      // ----------------
-      // perform alignment
-      // ----------------
-      align_algorithm_.align(to_align, transformations_align, 1);
-
-      // transform retention times of non-identity for next iteration
-      transformations_align[0].fitModel(model_type_, model_param_);
-      MapAlignmentTransformer::transformRetentionTimes(feature_maps_transformed[to_transform],
-              transformations_align[0], true);
+      Size level = std::max(cluster_level[tree[k].left_child], cluster_level[tree[k].right_child]);
+      if (level >= levels.size()) levels.resize(level + 1);
+      levels[level].push_back(k);
+      cluster_level[tree[k].left_child] = level + 1;
+      cluster_level[tree[k].right_child] = level + 1;
+    }
+    // combined maps are always stored at the smaller index
+    if (!tree.empty()) last_trafo = std::min(tree.back().left_child, tree.back().right_child);
 
-      // combine aligned maps, store at smaller index, because tree always calls smaller number
-      // clear feature map at larger index to save memory
-      feature_maps_transformed[ref] += feature_maps_transformed[to_transform];
-      feature_maps_transformed[ref].updateRanges();
-      if (ref < to_transform)
-      {
-        feature_maps_transformed[to_transform].clear(true);
-        last_trafo = ref;
-      }
-      else
+    const Param align_param = align_algorithm_.getParameters();
+    for (const vector<Size>& level : levels)
+    {
+      std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize l = 0; l < (SignedSize)level.size(); ++l)
       {
-        feature_maps_transformed[to_transform] = feature_maps_transformed[ref];
-        feature_maps_transformed[ref].clear(true);
-        last_trafo = to_transform;
+        try
+        {
+          alignNode_(tree[level[l]], align_param, feature_maps_transformed, maps_ranges, map_sets);
+        }
+        catch (...)
+        {
+#pragma omp critical (MapAlignmentAlgorithmTreeGuided_error)
+          if (!error) error = std::current_exception();
+        }
       }
-
-      // update order of alignment for both aligned maps
-      map_sets[ref].insert(map_sets[ref].end(), map_sets[to_transform].begin(), map_sets[to_transform].end());
-      map_sets[to_transform] = map_sets[ref];
-
-      transformations_align.clear();
-      to_align.clear();
+      if (error) std::rethrow_exception(error);
     }
+
     // copy last transformed FeatureMap for reference return
     map_transformed = feature_maps_transformed[last_trafo];
     trafo_order = map_sets[last_trafo];
   }
 
+  // Align the two clusters of one tree node and combine them at the smaller index.
+  void MapAlignmentAlgorithmTreeGuided::alignNode_(const BinaryTreeNode& node, const Param& align_param,
+                                                   std::vector<FeatureMap>& feature_maps_transformed,
+                                                   const std::vector<std::vector<double>>& maps_ranges,
+                                                   std::vector<std::vector<Size>>& map_sets) const
+  {
+    // ----------------
+    // prepare alignment
+    // ----------------
+    //  determine the map with larger RT range for 10/90 percentile (->reference)
+    double left_range = maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.9] - maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.1];
+    double right_range = maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.9] - maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.1];
+
+    Size ref;
+    Size to_transform;
+    if (left_range > right_range)
+    {
+      ref = node.left_child;
+      to_transform = node.right_child;
+    }
+    else
+    {
+      ref = node.right_child;
+      to_transform = node.left_child;
+    }
+
+    vector<FeatureMap> to_align;
+    to_align.push_back(feature_maps_transformed[to_transform]);
+    to_align.push_back(feature_maps_transformed[ref]);
+
+    // ----------------
+    // perform alignment
+    // ----------------
+    // one aligner per node, since the aligner keeps state and nodes may be aligned concurrently
+    MapAlignmentAlgorithmIdentification aligner;
+    aligner.setParameters(align_param);
+    vector<TransformationDescription> transformations_align;  // temporary for aligner output
+    aligner.align(to_align, transformations_align, 1);
+
+    // transform retention times of non-identity for next iteration
+    transformations_align[0].fitModel(model_type_, model_param_);
+    MapAlignmentTransformer::transformRetentionTimes(feature_maps_transformed[to_transform],
+            transformations_align[0], true);
+
+    // combine aligned maps, store at smaller index, because tree always calls smaller number
+    // clear feature map at larger index to save memory
+    feature_maps_transformed[ref] += feature_maps_transformed[to_transform];
+    feature_maps_transformed[ref].updateRanges();
+    if (ref < to_transform)
+    {
+      feature_maps_transformed[to_transform].clear(true);
+    }
+    else
+    {
+      feature_maps_transformed[to_transform] = feature_maps_transformed[ref];
+      feature_maps_transformed[ref].clear(true);
+    }
+
+    // update order of alignment for both aligned maps
+    map_sets[ref].insert(map_sets[ref].end(), map_sets[to_transform].begin(), map_sets[to_transform].end());
+    map_sets[to_transform] = map_sets[ref];
+  }
+
   void MapAlignmentAlgorithmTreeGuided::align(std::vector<FeatureMap>& feature_maps,
            std::vector<TransformationDescription>& transformations)
   {
@@ -261,85 +261,93 @@ namespace OpenMS
     return ef;
   }
 
-  EmpiricalFormula EmpiricalFormula::operator+(const EmpiricalFormula& formula) const
+  EmpiricalFormula::MapType_ EmpiricalFormula::merge_(const MapType_& lhs, const MapType_& rhs, SignedSize sign)
   {
-    EmpiricalFormula ef;
-    ef.formula_ = formula.formula_;
-    for (const auto& it : formula_)
+    MapType_ result;
+    result.reserve(lhs.size() + rhs.size());
+    const MapType_::key_compare less = result.key_comp();
+    auto l = lhs.begin(), r = rhs.begin();
+    while (l != lhs.end() || r != rhs.end())
     {
-      auto ef_it  = ef.formula_.find(it.first);
-      if (ef_it != ef.formula_.end())
+      const Element* e;
+      SignedSize num;
+      if (r == rhs.end() || (l != lhs.end() && less(l->first, r->first)))
       {
-        ef_it->second += it.second;
+        e = l->first;
+        num = (l++)->second;
+      }
+      else if (l == lhs.end() || less(r->first, l->first))
+      {
+        e = r->first;
+        num = sign * (r++)->second;
       }
       else
       {
-        ef.formula_.insert(it);
+        e = l->first;
+        num = (l++)->second + sign * (r++)->second;
       }
+      // both inputs are sorted, so appending at the end keeps the map sorted in linear time
+      if (num != 0) result.emplace_hint(result.end(), e, num);
+    }
+    return result;
+  }
+
+  bool EmpiricalFormula::updateInPlace_(const MapType_& rhs, SignedSize sign)
+  {
+    // first pass: is every element of rhs already present? (both maps are sorted)
+    const MapType_::key_compare less = formula_.key_comp();
+    auto l = formula_.begin();
+    for (const auto& r : rhs)
+    {
+      while (l != formula_.end() && less(l->first, r.first)) ++l;
+      if (l == formula_.end() || l->first != r.first) return false;
     }
+    // second pass: update the counts
+    bool zeroed = false;
+    l = formula_.begin();
+    for (const auto& r : rhs)
+    {
+      while (l->first != r.first) ++l;
+      l->second += sign * r.second;
+      zeroed |= (l->second == 0);
+    }
+    if (zeroed) removeZeroedElements_();
+    return true;
+  }
+
+  EmpiricalFormula EmpiricalFormula::operator+(const EmpiricalFormula& formula) const
+  {
+    EmpiricalFormula ef;
+    ef.formula_ = merge_(formula_, formula.formula_, 1);
     ef.charge_ = charge_ + formula.charge_;
-    ef.removeZeroedElements_();
     return ef;
   }
 
   EmpiricalFormula& EmpiricalFormula::operator+=(const EmpiricalFormula& formula)
   {
-    for (const auto& it : formula.formula_)
+    if (!updateInPlace_(formula.formula_, 1))
     {
-      auto f_it  = formula_.find(it.first);
-      if (f_it != formula_.end())
-      {
-        f_it->second += it.second;
-      }
-      else
-      {
-        formula_.insert(it);
-      }
+      formula_ = merge_(formula_, formula.formula_, 1);
     }
     charge_ += formula.charge_;
-    removeZeroedElements_();
     return *this;
   }
 
   EmpiricalFormula EmpiricalFormula::operator-(const EmpiricalFormula& formula) const
   {
-    EmpiricalFormula ef(*this);
-    for (const auto& it : formula.formula_)
-    {
-      const Element* e = it.first;
-      SignedSize num = it.second;
-      auto ef_it  = ef.formula_.find(e);
-      if (ef_it != ef.formula_.end())
-      {
-        ef_it->second -= num;
-      }
-      else
-      {
-        ef.formula_[e] = -num;
-      }
-    }
-
+    EmpiricalFormula ef;
+    ef.formula_ = merge_(formula_, formula.formula_, -1);
     ef.charge_ = charge_ - formula.charge_;
-    ef.removeZeroedElements_();
     return ef;
   }
 
   EmpiricalFormula& EmpiricalFormula::operator-=(const EmpiricalFormula& formula)
   {
-    for (const auto& it : formula.formula_)
+    if (!updateInPlace_(formula.formula_, -1))
     {
-      auto f_it  = formula_.find(it.first);
-      if (f_it != formula_.end())
-      {
-        f_it->second -= it.second;
-      }
-      else
-      {
-        formula_[it.first] = -it.second;
-      }
+      formula_ = merge_(formula_, formula.formula_, -1);
     }
     charge_ -= formula.charge_;
-    removeZeroedElements_();
     return *this;
   }
 
@@ -423,7 +431,7 @@ namespace OpenMS
     return os;
   }
 
-  Int EmpiricalFormula::parseFormula_(std::map<const Element*, SignedSize>& ef, const String& input_formula) const
+  Int EmpiricalFormula::parseFormula_(MapType_& ef, const String& input_formula) const
   {
     Int charge = 0;
     String formula(input_formula);
@@ -588,7 +596,7 @@ namespace OpenMS
         if (num != 0)
         {
           const Element* e = db->getElement(symbol);
-          std::map<const Element*, SignedSize>::iterator it = ef.find(e);
+          MapType_::iterator it = ef.find(e);
           if (it != ef.end())
           {
             it->second += num;
@@ -606,12 +614,12 @@ namespace OpenMS
     }
 
     // remove elements with 0 counts
-    std::map<const Element*, SignedSize>::iterator it = ef.begin();
+    MapType_::iterator it = ef.begin();
     while (it != ef.end())
     {
       if (it->second == 0)
       {
-        ef.erase(it++);   // Note: post increment needed! Otherwise iterator is invalidated
+        it = ef.erase(it);
       }
       else
       {
@@ -629,7 +637,7 @@ namespace OpenMS
     {
       if (it->second == 0)
       {
-        formula_.erase(it++);   // Note: post increment needed! Otherwise iterator is invalidated
+        it = formula_.erase(it);
       }
       else
       {
@@ -37,12 +37,23 @@
 
 #include <OpenMS/FORMAT/UnimodXMLFile.h>
 #include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/CHEMISTRY/ElementDB.h>
 #include <OpenMS/CHEMISTRY/Residue.h>
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/CONCEPT/Macros.h>
 
+#include <QtCore/QDir>
+
+#include <zlib.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
 #include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
 
 using namespace std;
 
@@ -95,25 +106,384 @@ namespace OpenMS
     return db_;
   }
 
+  namespace
+  {
+    /// Identifies a ModificationsDB snapshot file
+    const char SNAPSHOT_MAGIC[8] = {'O', 'M', 'S', 'M', 'O', 'D', 'D', 'B'};
+
+    /// Increase whenever the snapshot layout or the parsers change
+    const UInt32 SNAPSHOT_VERSION = 1;
+
+    /// Binary output in host byte order (the snapshot is a local cache, not an exchange format)
+    class SnapshotWriter
+    {
+    public:
+      template <typename T>
+      void write(T value)
+      {
+        data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+      }
+
+      void write(const String& value)
+      {
+        write<UInt32>(static_cast<UInt32>(value.size()));
+        data.append(value);
+      }
+
+      void write(const EmpiricalFormula& formula)
+      {
+        write<Int32>(formula.getCharge());
+        write<UInt32>(static_cast<UInt32>(std::distance(formula.begin(), formula.end())));
+        for (const auto& element : formula)
+        {
+          write(String(element.first->getSymbol()));
+          write<Int64>(element.second);
+        }
+      }
+
+      std::string data;
+    };
+
+    /// Reads what SnapshotWriter wrote; throws on truncated data
+    class SnapshotReader
+    {
+    public:
+      explicit SnapshotReader(const std::string& data) :
+        data_(data)
+      {
+      }
+
+      template <typename T>
+      T read()
+      {
+        check_(sizeof(T));
+        T value;
+        memcpy(&value, data_.data() + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+      }
+
+      String readString()
+      {
+        const UInt32 size = read<UInt32>();
+        check_(size);
+        String value(data_.substr(pos_, size));
+        pos_ += size;
+        return value;
+      }
+
+      EmpiricalFormula readFormula()
+      {
+        EmpiricalFormula formula;
+        const Int32 charge = read<Int32>();
+        const UInt32 n = read<UInt32>();
+        for (UInt32 i = 0; i < n; ++i)
+        {
+          const String symbol = readString();
+          const Int64 count = read<Int64>();
+          const Element* element = ElementDB::getInstance()->getElement(symbol);
+          if (element == nullptr)
+          {
+            throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, symbol, "unknown element in ModificationsDB snapshot");
+          }
+          formula += EmpiricalFormula(count, element);
+        }
+        formula.setCharge(charge);
+        return formula;
+      }
+
+      bool atEnd() const
+      {
+        return pos_ == data_.size();
+      }
+
+    private:
+      void check_(Size n) const
+      {
+        if (n > data_.size() - pos_)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "", "truncated ModificationsDB snapshot");
+        }
+      }
+
+      const std::string& data_;
+      Size pos_ = 0;
+    };
+  }
+
   ModificationsDB::ModificationsDB(OpenMS::String unimod_file, OpenMS::String psimod_file, OpenMS::String xlmod_file)
   {
-    if (!unimod_file.empty())
+    // Parsing the text files is the dominant startup cost of many tools, so
+    // the result can be cached as a binary snapshot (opt-in, see class
+    // documentation). The snapshot is only used if it was generated from
+    // identical source files.
+    UInt32 checksum(0);
+    String snapshot;
+    if (getenv("OPENMS_MODIFICATIONSDB_SNAPSHOT") != nullptr &&
+        (!unimod_file.empty() || !psimod_file.empty() || !xlmod_file.empty()))
     {
-      readFromUnimodXMLFile(unimod_file);
+      snapshot = getenv("OPENMS_MODIFICATIONSDB_SNAPSHOT");
+      if (!snapshot.empty())
+      {
+        checksum = computeSnapshotChecksum({unimod_file, psimod_file, xlmod_file});
+      }
     }
 
-    if (!psimod_file.empty())
+    std::vector<std::unique_ptr<ResidueModification> > snapshot_mods;
+    if (checksum != 0 && loadSnapshot(snapshot, checksum, snapshot_mods, modification_names_))
     {
-      readFromOBOFile(psimod_file);
+      mods_.reserve(snapshot_mods.size());
+      for (std::unique_ptr<ResidueModification>& mod : snapshot_mods)
+      {
+        mods_.push_back(mod.release());
+      }
     }
-
-    if (!xlmod_file.empty())
+    else
     {
-      readFromOBOFile(xlmod_file);
+      if (!unimod_file.empty())
+      {
+        readFromUnimodXMLFile(unimod_file);
+      }
+
+      if (!psimod_file.empty())
+      {
+        readFromOBOFile(psimod_file);
+      }
+
+      if (!xlmod_file.empty())
+      {
+        readFromOBOFile(xlmod_file);
+      }
+
+      if (checksum != 0)
+      {
+        storeSnapshot(snapshot, checksum);
+      }
     }
     is_instantiated_ = true;
   }
 
+  UInt32 ModificationsDB::computeSnapshotChecksum(const std::vector<String>& files)
+  {
+    uLong crc = crc32(0L, Z_NULL, 0);
+    for (const String& file : files)
+    {
+      if (file.empty())
+      {
+        continue;
+      }
+      String path;
+      try
+      {
+        path = File::find(file);
+      }
+      catch (Exception::FileNotFound&)
+      {
+        return 0;
+      }
+      std::ifstream ifs(path.c_str(), std::ios::binary);
+      std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+      if (!ifs.eof())
+      {
+        return 0;
+      }
+      crc = crc32(crc, reinterpret_cast<const Bytef*>(file.c_str()), static_cast<uInt>(file.size()));
+      crc = crc32(crc, reinterpret_cast<const Bytef*>(content.data()), static_cast<uInt>(content.size()));
+    }
+    return static_cast<UInt32>(crc);
+  }
+
+  bool ModificationsDB::loadSnapshot(const String& filename, UInt32 checksum,
+                                     std::vector<std::unique_ptr<ResidueModification> >& mods,
+                                     std::unordered_map<String, std::set<const ResidueModification*> >& names)
+  {
+    mods.clear();
+    names.clear();
+    std::ifstream ifs(filename.c_str(), std::ios::binary);
+    if (!ifs)
+    {
+      return false;
+    }
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    UInt32 version(0), stored_checksum(0);
+    UInt64 size(0);
+    ifs.read(magic, sizeof(magic));
+    ifs.read(reinterpret_cast<char*>(&version), sizeof(version));
+    ifs.read(reinterpret_cast<char*>(&stored_checksum), sizeof(stored_checksum));
+    ifs.read(reinterpret_cast<char*>(&size), sizeof(size));
+    if (!ifs || memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0 ||
+        version != SNAPSHOT_VERSION || stored_checksum != checksum)
+    {
+      return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    if (data.size() != size)
+    {
+      return false;
+    }
+
+    try
+    {
+      SnapshotReader in(data);
+      const UInt32 n_mods = in.read<UInt32>();
+      for (UInt32 i = 0; i < n_mods; ++i)
+      {
+        mods.emplace_back(new ResidueModification());
+        ResidueModification* mod = mods.back().get();
+        mod->setId(in.readString());
+        mod->setFullId(in.readString());
+        mod->setPSIMODAccession(in.readString());
+        mod->setUniModRecordId(in.read<Int32>());
+        mod->setFullName(in.readString());
+        mod->setName(in.readString());
+        mod->setTermSpecificity(static_cast<ResidueModification::TermSpecificity>(in.read<Int32>()));
+        mod->setOrigin(in.read<char>());
+        mod->setSourceClassification(static_cast<ResidueModification::SourceClassification>(in.read<Int32>()));
+        mod->setAverageMass(in.read<double>());
+        mod->setMonoMass(in.read<double>());
+        mod->setDiffAverageMass(in.read<double>());
+        mod->setDiffMonoMass(in.read<double>());
+        mod->setFormula(in.readString());
+        mod->setDiffFormula(in.readFormula());
+        std::set<String> synonyms;
+        for (UInt32 n = in.read<UInt32>(); n > 0; --n)
+        {
+          synonyms.insert(synonyms.end(), in.readString());
+        }
+        mod->setSynonyms(synonyms);
+        std::vector<EmpiricalFormula> losses(in.read<UInt32>());
+        for (EmpiricalFormula& loss : losses)
+        {
+          loss = in.readFormula();
+        }
+        mod->setNeutralLossDiffFormulas(losses);
+        std::vector<double> masses(in.read<UInt32>());
+        for (double& mass : masses) mass = in.read<double>();
+        mod->setNeutralLossMonoMasses(masses);
+        masses.resize(in.read<UInt32>());
+        for (double& mass : masses) mass = in.read<double>();
+        mod->setNeutralLossAverageMasses(masses);
+      }
+
+      const UInt32 n_names = in.read<UInt32>();
+      for (UInt32 i = 0; i < n_names; ++i)
+      {
+        std::set<const ResidueModification*>& entry = names[in.readString()];
+        for (UInt32 n = in.read<UInt32>(); n > 0; --n)
+        {
+          const UInt32 index = in.read<UInt32>();
+          if (index >= mods.size())
+          {
+            throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "invalid modification index");
+          }
+          entry.insert(mods[index].get());
+        }
+      }
+      if (!in.atEnd())
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "trailing data");
+      }
+    }
+    catch (Exception::BaseException& e)
+    {
+      OPENMS_LOG_DEBUG << "Ignoring invalid ModificationsDB snapshot '" << filename << "': " << e.what() << endl;
+      mods.clear();
+      names.clear();
+      return false;
+    }
+    return true;
+  }
+
+  bool ModificationsDB::storeSnapshot(const String& filename, UInt32 checksum) const
+  {
+    SnapshotWriter out;
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      std::unordered_map<const ResidueModification*, UInt32> index;
+      out.write<UInt32>(static_cast<UInt32>(mods_.size()));
+      for (const ResidueModification* mod : mods_)
+      {
+        index.emplace(mod, static_cast<UInt32>(index.size()));
+        out.write(mod->getId());
+        out.write(mod->getFullId());
+        out.write(mod->getPSIMODAccession());
+        out.write<Int32>(mod->getUniModRecordId());
+        out.write(mod->getFullName());
+        out.write(mod->getName());
+        out.write<Int32>(mod->getTermSpecificity());
+        out.write<char>(mod->getOrigin());
+        out.write<Int32>(mod->getSourceClassification());
+        out.write<double>(mod->getAverageMass());
+        out.write<double>(mod->getMonoMass());
+        out.write<double>(mod->getDiffAverageMass());
+        out.write<double>(mod->getDiffMonoMass());
+        out.write(mod->getFormula());
+        out.write(mod->getDiffFormula());
+        out.write<UInt32>(static_cast<UInt32>(mod->getSynonyms().size()));
+        for (const String& synonym : mod->getSynonyms())
+        {
+          out.write(synonym);
+        }
+        out.write<UInt32>(static_cast<UInt32>(mod->getNeutralLossDiffFormulas().size()));
+        for (const EmpiricalFormula& loss : mod->getNeutralLossDiffFormulas())
+        {
+          out.write(loss);
+        }
+        for (const std::vector<double>& masses : {mod->getNeutralLossMonoMasses(), mod->getNeutralLossAverageMasses()})
+        {
+          out.write<UInt32>(static_cast<UInt32>(masses.size()));
+          for (double mass : masses) out.write<double>(mass);
+        }
+      }
+
+      out.write<UInt32>(static_cast<UInt32>(modification_names_.size()));
+      for (const auto& entry : modification_names_)
+      {
+        out.write(entry.first);
+        out.write<UInt32>(static_cast<UInt32>(entry.second.size()));
+        for (const ResidueModification* mod : entry.second)
+        {
+          out.write<UInt32>(index.at(mod));
+        }
+      }
+    }
+
+    // the snapshot is only a cache: failing to write it is not an error for callers
+    QDir dir(File::path(filename).toQString());
+    if (!dir.exists() && !dir.mkpath("."))
+    {
+      return false;
+    }
+    // write to a unique temporary file first, so concurrently starting tools never see a partial snapshot
+    const String tmp_filename = filename + "." + File::getUniqueName(false);
+    {
+      std::ofstream ofs(tmp_filename.c_str(), std::ios::binary);
+      const UInt64 size = out.data.size();
+      ofs.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+      ofs.write(reinterpret_cast<const char*>(&SNAPSHOT_VERSION), sizeof(SNAPSHOT_VERSION));
+      ofs.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+      ofs.write(reinterpret_cast<const char*>(&size), sizeof(size));
+      ofs.write(out.data.data(), out.data.size());
+      if (!ofs)
+      {
+        ofs.close();
+        std::remove(tmp_filename.c_str());
+        return false;
+      }
+    }
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+    {
+      // e.g. on Windows, where an existing file is not replaced (readers validate the snapshot, so a short gap is fine)
+      std::remove(filename.c_str());
+      if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+      {
+        std::remove(tmp_filename.c_str());
+        return false;
+      }
+    }
+    return true;
+  }
+
   ModificationsDB::~ModificationsDB()
   {
     modification_names_.clear();
@@ -130,12 +500,8 @@ namespace OpenMS
 
   Size ModificationsDB::getNumberOfModifications() const
   {
-    Size s;
-    #pragma omp critical (OpenMS_ModificationsDB)
-    {
-      s = mods_.size();
-    }
-    return s;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return mods_.size();
   }
 
   const ResidueModification* ModificationsDB::searchModificationsFast(const String& mod_name_,
@@ -152,8 +518,8 @@ namespace OpenMS
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
 
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       bool found = true;
       auto modifications = modification_names_.find(mod_name);
       if (modifications == modification_names_.end())
@@ -193,6 +559,7 @@ namespace OpenMS
 
   const ResidueModification* ModificationsDB::getModification(Size index) const
   {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     OPENMS_PRECONDITION(index < mods_.size(), "Index out of bounds in ModificationsDB::getModification(Size index)." );
     return mods_[index];
   }
@@ -209,8 +576,8 @@ namespace OpenMS
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
 
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       bool found = true;
       auto modifications = modification_names_.find(mod_name);
       if (modifications == modification_names_.end())
@@ -278,48 +645,41 @@ namespace OpenMS
 
   bool ModificationsDB::has(const String & modification) const
   {
-    bool has_mod;
-    #pragma omp critical(OpenMS_ModificationsDB)
-    {
-      has_mod = (modification_names_.find(modification) != modification_names_.end());
-    }
-    return has_mod;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return modification_names_.find(modification) != modification_names_.end();
   }
 
   Size ModificationsDB::findModificationIndex(const String & mod_name) const
   {
-    if (!has(mod_name))
-    {
-      throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Modification not found: " + mod_name);
-    }
-
-    bool one_mod(true);
-    #pragma omp critical(OpenMS_ModificationsDB)
-    {
-      if (modification_names_.find(mod_name)->second.size() > 1)
-      {
-        one_mod = false;
-      }
-    }
-    if (!one_mod) 
-    {
-      throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "More than one modification with name: " + mod_name);
-    }
-
+    bool found(false), one_mod(true);
     Size index(numeric_limits<Size>::max());
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
-      const ResidueModification* mod = *(modification_names_.find(mod_name)->second.begin());
-      for (Size i = 0; i != mods_.size(); ++i)
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      auto modifications = modification_names_.find(mod_name);
+      if (modifications != modification_names_.end())
       {
-        if (mods_[i] == mod)
+        found = true;
+        one_mod = (modifications->second.size() == 1);
+        const ResidueModification* mod = *(modifications->second.begin());
+        for (Size i = 0; one_mod && i != mods_.size(); ++i)
         {
-          index = i;
-          break;
+          if (mods_[i] == mod)
+          {
+            index = i;
+            break;
+          }
         }
       }
     }
 
+    if (!found)
+    {
+      throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Modification not found: " + mod_name);
+    }
+    if (!one_mod)
+    {
+      throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "More than one modification with name: " + mod_name);
+    }
     if (index == numeric_limits<Size>::max())
     {
       throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Modification name found but modification not found: " + mod_name);
@@ -332,8 +692,8 @@ namespace OpenMS
     mods.clear();
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       for (auto const & m : mods_)
       {
         if ((fabs(m->getDiffMonoMass() - mass) <= max_error) &&
@@ -352,8 +712,8 @@ namespace OpenMS
     mods.clear();
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       for (auto const & m : mods_)
       {
         if ((fabs(m->getDiffMonoMass() - mass) <= max_error) &&
@@ -375,8 +735,8 @@ namespace OpenMS
     if (!residue.empty()) res = residue[0];
     double diff = 0;
     Size cnt = 0;
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       for (auto const & m : mods_)
       {
         diff = fabs(m->getDiffMonoMass() - mass);
@@ -403,8 +763,8 @@ namespace OpenMS
     if (!residue.empty()) res = residue[0];
     double diff = 0;
     Size cnt = 0;
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       for (auto const & m : mods_)
       {
         diff = fabs(m->getDiffMonoMass() - mass);
@@ -430,8 +790,8 @@ namespace OpenMS
     const ResidueModification* mod = nullptr;
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       for (auto const & m : mods_)
       {
         // using less instead of less-or-equal will pick the first matching
@@ -461,8 +821,8 @@ namespace OpenMS
       // create full ID based on other information:
       m->setFullId();
 
-      #pragma omp critical(OpenMS_ModificationsDB)
       {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
         // e.g. Oxidation (M)
         modification_names_[m->getFullId()].insert(m);
         // e.g. Oxidation
@@ -479,13 +839,13 @@ namespace OpenMS
   const ResidueModification* ModificationsDB::addModification(std::unique_ptr<ResidueModification> new_mod)
   {
     const ResidueModification* ret;
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::unique_lock<std::shared_mutex> lock(mutex_);
       auto it = modification_names_.find(new_mod->getFullId());
       if (it != modification_names_.end())
       {
         OPENMS_LOG_WARN << "Modification already exists in ModificationsDB. Skipping." << new_mod->getFullId() << endl;
-        ret = *(it->second.begin()); // returning from omp critical is not allowed
+        ret = *(it->second.begin());
       }
       else
       {
@@ -756,8 +1116,8 @@ namespace OpenMS
     }
 
     // now use the term and all synonyms to build the database
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::unique_lock<std::shared_mutex> lock(mutex_);
       for (multimap<String, ResidueModification>::const_iterator it = all_mods.begin(); it != all_mods.end(); ++it)
       {
         // check whether a unimod definition already exists, then simply add synonyms to it
@@ -807,8 +1167,8 @@ namespace OpenMS
   {
     modifications.clear();
 
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       for (auto const & m : mods_)
       {
         if (m->getUniModRecordId() > 0)
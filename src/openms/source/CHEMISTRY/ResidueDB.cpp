@@ -40,6 +40,7 @@
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 
 #include <iostream>
+#include <mutex>
 
 using namespace std;
 
@@ -71,8 +72,8 @@ namespace OpenMS
     }
 
     const Residue* r{};
-    #pragma omp critical (ResidueDB)
-    {   
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       auto it = residue_names_.find(name);
       if (it != residue_names_.end()) 
       { 
@@ -96,8 +97,8 @@ namespace OpenMS
   Size ResidueDB::getNumberOfResidues() const
   {
     Size s;
-    #pragma omp critical (ResidueDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       s = const_residues_.size();
     } 
     return s;
@@ -106,8 +107,8 @@ namespace OpenMS
   Size ResidueDB::getNumberOfModifiedResidues() const
   {
     Size s;
-    #pragma omp critical (ResidueDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       s = const_modified_residues_.size();
     } 
     return s;
@@ -116,8 +117,8 @@ namespace OpenMS
   const set<const Residue*> ResidueDB::getResidues(const String& residue_set) const
   {
     set<const Residue*> s;
-    #pragma omp critical (ResidueDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       auto it = residues_by_set_.find(residue_set);
       if (it != residues_by_set_.end())
       {
@@ -155,8 +156,8 @@ namespace OpenMS
   bool ResidueDB::hasResidue(const String& res_name) const
   {
     bool found = false;
-    #pragma omp critical (ResidueDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       found = residue_names_.find(res_name) != residue_names_.end();
     }  
     return found;
@@ -165,8 +166,8 @@ namespace OpenMS
   bool ResidueDB::hasResidue(const Residue* residue) const
   {
     bool found = false;
-    #pragma omp critical (ResidueDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       found = (const_residues_.find(residue) != const_residues_.end() ||
           const_modified_residues_.find(residue) != const_modified_residues_.end());
     } 
@@ -300,8 +301,8 @@ namespace OpenMS
   const set<String> ResidueDB::getResidueSets() const
   {
     set<String> rs;
-    #pragma omp critical (ResidueDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       rs = residue_sets_; 
     }
     return rs;
@@ -383,77 +384,61 @@ namespace OpenMS
   const Residue* ResidueDB::getModifiedResidue(const Residue* residue, const String& modification)
   {
     OPENMS_PRECONDITION(!modification.empty(), "Modification cannot be empty")
-    // search if the mod already exists
     const String & res_name = residue->getName();
-    Residue* res{};
-    bool residue_found(true), mod_found(true);
-    #pragma omp critical (ResidueDB)
+    bool residue_found(false);
     {
-      // Perform a single lookup of the residue name in our database, we assume
-      // that if it is present in residue_mod_names_ then we have seen it
-      // before and can directly grab it. If its not present, we may have as
-      // unmodified residue in residue_names_ but need to create a new entry as
-      // modified residue. If the residue itself is unknow, we will throw (see
-      // below).
-      const auto& rm_entry = residue_mod_names_.find(res_name);
-      if (rm_entry == residue_mod_names_.end())
-      {
-        if (residue_names_.find(res_name) == residue_names_.end())
-        {
-          residue_found = false;
-        }
-      }
-
-      if (residue_found)
-      {
-        const ResidueModification* mod{};
-        try
-        {
-          // terminal modifications don't apply to residues (side chain), so only consider internal ones
-          static const ModificationsDB* mdb = ModificationsDB::getInstance();
-          mod = mdb->getModification(modification, residue->getOneLetterCode(), ResidueModification::ANYWHERE);
-        }
-        catch (...)
-        {
-          mod_found = false;
-        }
-
-        // check if modification in ResidueDB
-        if (mod_found)
-        {
-          // check if modified residue is already present in ResidueDB
-          bool found = false;
-          if (rm_entry != residue_mod_names_.end())
-          {
-            const String& id = mod->getId().empty() ? mod->getFullId() : mod->getId();
-            const auto& inner = rm_entry->second.find(id);
-            if (inner != rm_entry->second.end())
-            {
-              res = const_cast<Residue*>(inner->second);
-              found = true;
-            }
-          }
-          if (!found)
-          {
-            // create and register this modified residue
-            res = new Residue(*residue_names_.at(res_name));
-            res->setModification(mod);
-            addResidue_(res);            
-          }
-        }
-      }
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      residue_found = residue_mod_names_.find(res_name) != residue_mod_names_.end() ||
+                      residue_names_.find(res_name) != residue_names_.end();
     }
-
-    // throwing (uncaught) exceptions needs to happen outside of critical section (see OpenMP reference manual)
     if (!residue_found)
     {
       throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Residue not found: ", res_name);
     }
-    else if (!mod_found)
+
+    const ResidueModification* mod{};
+    try
+    {
+      // terminal modifications don't apply to residues (side chain), so only consider internal ones
+      static const ModificationsDB* mdb = ModificationsDB::getInstance();
+      mod = mdb->getModification(modification, residue->getOneLetterCode(), ResidueModification::ANYWHERE);
+    }
+    catch (...)
+    {
+    }
+    if (mod == nullptr)
     {
       throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Modification not found: ", modification);
     }
-    
+
+    // check if modified residue is already present in ResidueDB
+    const String& id = mod->getId().empty() ? mod->getFullId() : mod->getId();
+    auto find_modified = [&]() -> const Residue*
+    {
+      auto rm_entry = residue_mod_names_.find(res_name);
+      if (rm_entry == residue_mod_names_.end()) return nullptr;
+      auto inner = rm_entry->second.find(id);
+      return inner == rm_entry->second.end() ? nullptr : inner->second;
+    };
+
+    // common case: the modified residue was created before, a shared lock suffices
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      const Residue* res = find_modified();
+      if (res != nullptr) return res;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    // another thread may have created it while we did not hold the lock
+    const Residue* res = find_modified();
+    if (res == nullptr)
+    {
+      // create and register this modified residue
+      Residue* new_res = new Residue(*residue_names_.at(res_name));
+      new_res->setModification(mod);
+      addResidue_(new_res);
+      res = new_res;
+    }
     return res;
   }
 }
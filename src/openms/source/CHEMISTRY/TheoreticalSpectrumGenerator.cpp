@@ -42,6 +42,7 @@
 #include <OpenMS/CHEMISTRY/ResidueDB.h>
 #include <OpenMS/KERNEL/MSSpectrum.h>
 
+#include <algorithm>
 #include <unordered_set>
 
 using namespace std;
@@ -241,6 +242,85 @@ namespace OpenMS
     spectrum.getPrecursors().push_back(prec);
   }
 
+  void TheoreticalSpectrumGenerator::getFragmentMZs(std::vector<double>& mzs, const AASequence& peptide, Int min_charge, Int max_charge) const
+  {
+    mzs.clear();
+    if (peptide.empty())
+    {
+      return;
+    }
+
+    const Size n = peptide.size();
+    if ((add_c_ions_ || add_x_ions_) && n < 2)
+    {
+      throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 1);
+    }
+
+    static const double stat_a = Residue::getInternalToAIon().getMonoWeight();
+    static const double stat_b = Residue::getInternalToBIon().getMonoWeight();
+    static const double stat_c = Residue::getInternalToCIon().getMonoWeight();
+    static const double stat_x = Residue::getInternalToXIon().getMonoWeight();
+    static const double stat_y = Residue::getInternalToYIon().getMonoWeight();
+    static const double stat_z = Residue::getInternalToZIon().getMonoWeight();
+
+    // ion offsets of the enabled prefix (a, b, c) and suffix (x, y, z) ion types
+    double prefix_offsets[3], suffix_offsets[3];
+    Size n_prefix_types(0), n_suffix_types(0);
+    if (add_a_ions_) prefix_offsets[n_prefix_types++] = stat_a;
+    if (add_b_ions_) prefix_offsets[n_prefix_types++] = stat_b;
+    if (add_c_ions_) prefix_offsets[n_prefix_types++] = stat_c;
+    if (add_x_ions_) suffix_offsets[n_suffix_types++] = stat_x;
+    if (add_y_ions_) suffix_offsets[n_suffix_types++] = stat_y;
+    if (add_z_ions_) suffix_offsets[n_suffix_types++] = stat_z;
+
+    // like in addPeaks_(), ions of the full peptide are not generated
+    const Size first_prefix = add_first_prefix_ion_ ? 0 : 1;
+    const Size n_prefix = (n - 1 > first_prefix) ? n - 1 - first_prefix : 0;
+    const Size n_suffix = n - 1;
+    const Size n_charges = (max_charge >= min_charge) ? Size(max_charge - min_charge + 1) : 0;
+    const Size n_ions = (n_prefix_types * n_prefix + n_suffix_types * n_suffix) * n_charges;
+
+    // the residue mass ladders are stored behind the ions in the same buffer
+    mzs.resize(n_ions + n_prefix + n_suffix);
+    double* prefix_ladder = mzs.data() + n_ions;
+    double* suffix_ladder = prefix_ladder + n_prefix;
+
+    double mass = peptide.hasNTerminalModification() ? peptide.getNTerminalModification()->getDiffMonoMass() : 0.0;
+    for (Size i = 0; i < n - 1; ++i)
+    {
+      mass += peptide[i].getMonoWeight(Residue::Internal);
+      if (i >= first_prefix) prefix_ladder[i - first_prefix] = mass;
+    }
+    mass = peptide.hasCTerminalModification() ? peptide.getCTerminalModification()->getDiffMonoMass() : 0.0;
+    for (Size i = n - 1; i > 0; --i)
+    {
+      mass += peptide[i].getMonoWeight(Residue::Internal);
+      suffix_ladder[n - 1 - i] = mass;
+    }
+
+    Size pos(0);
+    for (Int z = min_charge; z <= max_charge; ++z)
+    {
+      const double proton_mass = Constants::PROTON_MASS_U * z;
+      for (Size t = 0; t < n_prefix_types; ++t)
+      {
+        for (Size k = 0; k < n_prefix; ++k)
+        {
+          mzs[pos++] = (proton_mass + prefix_ladder[k] + prefix_offsets[t]) / z;
+        }
+      }
+      for (Size t = 0; t < n_suffix_types; ++t)
+      {
+        for (Size k = 0; k < n_suffix; ++k)
+        {
+          mzs[pos++] = (proton_mass + suffix_ladder[k] + suffix_offsets[t]) / z;
+        }
+      }
+    }
+    mzs.resize(n_ions);
+    std::sort(mzs.begin(), mzs.end());
+  }
+
   MSSpectrum TheoreticalSpectrumGenerator::generateSpectrum(const Precursor::ActivationMethod& fm, const AASequence& seq, int precursor_charge)
   {
     if (precursor_charge == 0)
@@ -75,4 +75,96 @@ namespace OpenMS
 
   }
 
+  double GaussFilterAlgorithm::interpolateCoefficient_(double distance) const
+  {
+    const Size middle = coeffs_.size();
+    Size left_position = std::min((Size)floor(distance / spacing_), middle - 1);
+    Size right_position = left_position + 1;
+    if (right_position >= middle) return coeffs_[left_position];
+
+    double d = fabs((left_position * spacing_) - distance) / spacing_;
+    return (1 - d) * coeffs_[left_position] + d * coeffs_[right_position];
+  }
+
+  bool GaussFilterAlgorithm::filterEquidistant_(const std::vector<double>& intensities, double data_spacing, std::vector<double>& smoothed) const
+  {
+    const Size n = intensities.size();
+    smoothed.assign(n, 0.0);
+
+    // number of trapezoids on each side of a data point that lie within the kernel (same criterion as in integrate_)
+    const double max_distance = coeffs_.size() * spacing_;
+    Size nr_segments = 0;
+    while (nr_segments + 1 < n && (nr_segments + 1) * data_spacing < max_distance)
+    {
+      ++nr_segments;
+    }
+    if (nr_segments == 0) return false;
+
+    std::vector<double> kernel(nr_segments + 1);
+    for (Size k = 0; k <= nr_segments; ++k)
+    {
+      kernel[k] = interpolateCoefficient_(k * data_spacing);
+    }
+    // kernel area covered by the first m trapezoids of one side (the common factor data_spacing / 2 cancels out)
+    std::vector<double> side_norm(nr_segments + 1, 0.0);
+    for (Size m = 1; m <= nr_segments; ++m)
+    {
+      side_norm[m] = side_norm[m - 1] + kernel[m - 1] + kernel[m];
+    }
+
+    const double* y = intensities.data();
+    double* out = smoothed.data();
+
+    // interior points: integrate_ never stops at the first or last data point, so the trapezoidal rule
+    // collapses into a symmetric convolution with weights 2*c_k (and c_K for the outermost points)
+    const Size interior_begin = nr_segments + 1;
+    const Size interior_end = (n > nr_segments + 1) ? n - nr_segments - 1 : 0;
+    if (interior_begin < interior_end)
+    {
+      const Size interior_size = interior_end - interior_begin;
+      double* dst = out + interior_begin;
+      for (SignedSize m = -(SignedSize)nr_segments; m <= (SignedSize)nr_segments; ++m)
+      {
+        const Size k = std::abs(m);
+        const double weight = (k == nr_segments) ? kernel[k] : 2 * kernel[k];
+        const double* src = y + interior_begin + m;
+        for (Size i = 0; i < interior_size; ++i)
+        {
+          dst[i] += src[i] * weight;
+        }
+      }
+      const double norm = 2 * side_norm[nr_segments];
+      for (Size i = 0; i < interior_size; ++i)
+      {
+        dst[i] = (dst[i] > 0) ? dst[i] / norm : 0;
+      }
+    }
+
+    // points close to the ends: like integrate_, the trapezoid ending at the first (last) data point is omitted
+    for (Size i = 0; i < n; ++i)
+    {
+      if (i == interior_begin && interior_begin < interior_end) i = interior_end;
+      if (i >= n) break;
+
+      const Size nr_left = (i >= 1) ? std::min(nr_segments, i - 1) : 0;
+      const Size nr_right = (i + 2 <= n) ? std::min(nr_segments, n - 2 - i) : 0;
+      double v = 0;
+      for (Size k = 0; k < nr_left; ++k)
+      {
+        v += kernel[k] * y[i - k] + kernel[k + 1] * y[i - k - 1];
+      }
+      for (Size k = 0; k < nr_right; ++k)
+      {
+        v += kernel[k] * y[i + k] + kernel[k + 1] * y[i + k + 1];
+      }
+      out[i] = (v > 0) ? v / (side_norm[nr_left] + side_norm[nr_right]) : 0;
+    }
+
+    for (Size i = 0; i < n; ++i)
+    {
+      if (fabs(out[i]) > 0) return true;
+    }
+    return false;
+  }
+
 }
@@ -38,6 +38,8 @@
 #include <Eigen/Core>
 #include <Eigen/SVD>
 
+#include <algorithm>
+
 namespace OpenMS
 {
   SavitzkyGolayFilter::SavitzkyGolayFilter() :
@@ -105,4 +107,66 @@ namespace OpenMS
       }
     }
   }
+
+  void SavitzkyGolayFilter::filterIntensities(const std::vector<double>& input, std::vector<double>& output) const
+  {
+    output = input;
+    const Size n = input.size();
+    if (frame_size_ > n) { return; }
+
+    const Size mid = frame_size_ / 2;
+    const double* in = input.data();
+    double* out = output.data();
+
+    // transient on: the first mid + 1 points use the window [0, frame_size_)
+    for (Size i = 0; i <= mid; ++i)
+    {
+      const double* coeffs = &coeffs_[(i + 1) * frame_size_ - 1];
+      double help = 0;
+      for (Size j = 0; j < frame_size_; ++j)
+      {
+        help += in[j] * *(coeffs - j);
+      }
+      out[i] = help;
+    }
+
+    // steady state: points [mid + 1, n - mid) use the centered window. Iterating over the coefficients in the
+    // outer loop turns the convolution into frame_size_ independent axpy operations on contiguous memory.
+    const Size steady_begin = mid + 1;
+    const Size steady_end = n - mid;
+    if (steady_begin < steady_end)
+    {
+      const Size steady_size = steady_end - steady_begin;
+      const double* coeffs = &coeffs_[mid * frame_size_];
+      double* dst = out + steady_begin;
+      std::fill(dst, dst + steady_size, 0.0);
+      for (Size j = 0; j < frame_size_; ++j)
+      {
+        const double c = coeffs[j];
+        const double* src = in + steady_begin - mid + j;
+        for (Size k = 0; k < steady_size; ++k)
+        {
+          dst[k] += src[k] * c;
+        }
+      }
+    }
+
+    // transient off: the last mid points use the window [n - frame_size_, n)
+    const double* window = in + (n - frame_size_);
+    for (Size i = 0; i < mid; ++i)
+    {
+      const double* coeffs = &coeffs_[(mid - 1 - i) * frame_size_];
+      double help = 0;
+      for (Size j = 0; j < frame_size_; ++j)
+      {
+        help += window[j] * coeffs[j];
+      }
+      out[n - mid + i] = help;
+    }
+
+    for (Size i = 0; i < n; ++i)
+    {
+      out[i] = std::max(0.0, out[i]);
+    }
+  }
 }
@@ -35,6 +35,13 @@
 
 #include <OpenMS/FILTERING/TRANSFORMERS/SpectraMerger.h>
 
+#include <exception>
+#include <numeric>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 namespace OpenMS
 {
@@ -112,4 +119,87 @@ namespace OpenMS
     return *this;
   }
 
+  std::vector<std::vector<Size> > SpectraMerger::clusterPrecursors_(const std::vector<BaseFeature>& data) const
+  {
+    SpectraDistance_ llc;
+    llc.setParameters(param_.copy("precursor_method:", true));
+    const double mz_tolerance = param_.getValue("precursor_method:mz_tolerance");
+
+    // sweep over the precursors in order of m/z: only pairs within the m/z tolerance can be similar
+    std::vector<Size> order(data.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&data](Size a, Size b) { return data[a].getMZ() < data[b].getMZ(); });
+
+    std::vector<std::pair<Size, Size> > links;
+    std::exception_ptr error;
+#pragma omp parallel
+    {
+      std::vector<std::pair<Size, Size> > thread_links;
+#pragma omp for schedule(dynamic, 256) nowait
+      for (SignedSize p = 0; p < (SignedSize)order.size(); ++p)
+      {
+        try
+        {
+          const BaseFeature& first = data[order[p]];
+          for (Size q = p + 1; q < order.size() && data[order[q]].getMZ() - first.getMZ() <= mz_tolerance; ++q)
+          {
+            // same criterion as the distance matrix of ClusterHierarchical (distances of 1 are not clustered)
+            float distance = 1 - llc(first, data[order[q]]);
+            if (distance < 1)
+            {
+              thread_links.emplace_back(order[p], order[q]);
+            }
+          }
+        }
+        catch (...)
+        {
+#pragma omp critical (SpectraMerger_error)
+          if (!error) error = std::current_exception();
+        }
+      }
+#pragma omp critical (SpectraMerger_links)
+      links.insert(links.end(), thread_links.begin(), thread_links.end());
+    }
+    if (error) std::rethrow_exception(error);
+
+    // union-find over the links: the connected components are the single linkage clusters
+    std::vector<Size> parent(data.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find_root = [&parent](Size i)
+    {
+      while (parent[i] != i)
+      {
+        parent[i] = parent[parent[i]]; // path halving
+        i = parent[i];
+      }
+      return i;
+    };
+    for (const auto& link : links)
+    {
+      Size root_a = find_root(link.first);
+      Size root_b = find_root(link.second);
+      if (root_a != root_b)
+      {
+        // keep the smaller index as root
+        if (root_a < root_b) parent[root_b] = root_a;
+        else parent[root_a] = root_b;
+      }
+    }
+
+    std::vector<std::vector<Size> > clusters;
+    std::vector<Size> cluster_of_root(data.size(), data.size());
+    for (Size i = 0; i < data.size(); ++i)
+    {
+      Size root = find_root(i);
+      if (root == i) continue; // root of a cluster is its smallest element and is added below
+      if (cluster_of_root[root] == data.size())
+      {
+        cluster_of_root[root] = clusters.size();
+        clusters.push_back(std::vector<Size>(1, root));
+      }
+      clusters[cluster_of_root[root]].push_back(i);
+    }
+    return clusters;
+  }
+
 }
@@ -38,8 +38,13 @@
 #include <OpenMS/SYSTEM/File.h>
 #include <OpenMS/METADATA/DataProcessing.h>
 #include <OpenMS/CHEMISTRY/ProteaseDB.h>
+#include <exception>
 #include <fstream>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 
 namespace OpenMS
@@ -883,7 +888,62 @@ namespace OpenMS
     consensus_map_->setLoadedFileType(file_);
     consensus_map_->setLoadedFilePath(file_);
 
-    parse_(filename, this);
+    // large files are split at consensus element boundaries and the elements are parsed in parallel
+    String skeleton;
+    std::vector<std::string> chunks;
+    std::vector<Size> chunk_list;
+    std::vector<ElementList> lists;
+    if (!splitDocument_(filename, "consensusElementList", "consensusElement", skeleton, chunks, chunk_list, lists))
+    {
+      parse_(filename, this);
+    }
+    else
+    {
+      // the skeleton contains everything but the consensus elements, in particular the identification runs they refer to
+      parseBuffer_(skeleton, this);
+      skeleton.clear();
+
+      std::vector<ConsensusMap> chunk_maps(chunks.size());
+      std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)chunks.size(); ++i)
+      {
+        try
+        {
+          ConsensusXMLFile reader;
+          reader.file_ = file_;
+          reader.options_ = options_;
+          reader.id_identifier_ = id_identifier_;
+          reader.proteinid_to_accession_ = proteinid_to_accession_;
+          reader.consensus_map_ = &chunk_maps[i];
+          reader.parseBuffer_(chunks[i], &reader);
+          std::string().swap(chunks[i]);
+        }
+        catch (...)
+        {
+#pragma omp critical (ConsensusXMLFile_load)
+          if (!error) error = std::current_exception();
+        }
+      }
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+
+      Size n_elements = map.size();
+      for (const ConsensusMap& chunk_map : chunk_maps)
+      {
+        n_elements += chunk_map.size();
+      }
+      map.reserve(n_elements);
+      for (ConsensusMap& chunk_map : chunk_maps)
+      {
+        for (ConsensusFeature& element : chunk_map)
+        {
+          map.push_back(std::move(element));
+        }
+      }
+    }
 
     if (!map.isMapConsistent(&OpenMS_Log_warn)) // a warning is printed to LOG_WARN during isMapConsistent()
     {
@@ -0,0 +1,203 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/DATAACCESS/IdentificationFilteringConsumer.h>
+
+#include <OpenMS/FILTERING/ID/IDFilter.h>
+
+namespace OpenMS
+{
+
+  IdentificationFilteringConsumer::IdentificationFilteringConsumer(
+    Interfaces::IIdentificationConsumer* next_consumer) :
+    next_consumer_(next_consumer),
+    protein_ids_(nullptr),
+    peptide_ids_(nullptr),
+    n_consumed_(0),
+    n_accepted_(0)
+  {
+    if (next_consumer_ == nullptr)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "A valid consumer is required to forward identifications to");
+    }
+  }
+
+  IdentificationFilteringConsumer::IdentificationFilteringConsumer(
+    std::vector<ProteinIdentification>& protein_ids,
+    std::vector<PeptideIdentification>& peptide_ids) :
+    next_consumer_(nullptr),
+    protein_ids_(&protein_ids),
+    peptide_ids_(&peptide_ids),
+    n_consumed_(0),
+    n_accepted_(0)
+  {
+  }
+
+  void IdentificationFilteringConsumer::consumeProteinIdentification(ProteinIdentification& protein_id)
+  {
+    for (const ProteinFilter& filter : protein_filters_)
+    {
+      filter(protein_id);
+    }
+    if (next_consumer_ != nullptr)
+    {
+      next_consumer_->consumeProteinIdentification(protein_id);
+    }
+    else
+    {
+      protein_ids_->push_back(protein_id);
+    }
+  }
+
+  void IdentificationFilteringConsumer::consumePeptideIdentification(PeptideIdentification& peptide_id)
+  {
+    ++n_consumed_;
+    for (const PeptideFilter& filter : peptide_filters_)
+    {
+      if (!filter(peptide_id)) return;
+    }
+    ++n_accepted_;
+    if (next_consumer_ != nullptr)
+    {
+      next_consumer_->consumePeptideIdentification(peptide_id);
+    }
+    else
+    {
+      peptide_ids_->push_back(std::move(peptide_id));
+    }
+  }
+
+  void IdentificationFilteringConsumer::addPeptideFilter(const PeptideFilter& filter)
+  {
+    peptide_filters_.push_back(filter);
+  }
+
+  void IdentificationFilteringConsumer::addProteinFilter(const ProteinFilter& filter)
+  {
+    protein_filters_.push_back(filter);
+  }
+
+  void IdentificationFilteringConsumer::filterPeptidesByRT(double min_rt, double max_rt)
+  {
+    addPeptideFilter([min_rt, max_rt](PeptideIdentification& id)
+    {
+      double rt = id.getRT();
+      return (rt >= min_rt) && (rt <= max_rt);
+    });
+  }
+
+  void IdentificationFilteringConsumer::filterPeptidesByMZ(double min_mz, double max_mz)
+  {
+    addPeptideFilter([min_mz, max_mz](PeptideIdentification& id)
+    {
+      double mz = id.getMZ();
+      return (mz >= min_mz) && (mz <= max_mz);
+    });
+  }
+
+  void IdentificationFilteringConsumer::filterPeptidesByCharge(Int min_charge, Int max_charge)
+  {
+    addPeptideFilter([min_charge, max_charge](PeptideIdentification& id)
+    {
+      std::vector<PeptideHit>& hits = id.getHits();
+      hits.erase(std::remove_if(hits.begin(), hits.end(), [&](const PeptideHit& hit)
+        {
+          // like in IDFilter, the upper bound is ignored if it is below the lower one:
+          return (hit.getCharge() < min_charge) ||
+                 ((max_charge >= min_charge) && (hit.getCharge() > max_charge));
+        }), hits.end());
+      return true;
+    });
+  }
+
+  void IdentificationFilteringConsumer::filterPeptideHitsByScore(double threshold_score)
+  {
+    addPeptideFilter([threshold_score](PeptideIdentification& id)
+    {
+      IDFilter::filterHitsByScore(id, threshold_score);
+      return true;
+    });
+  }
+
+  void IdentificationFilteringConsumer::filterProteinHitsByScore(double threshold_score)
+  {
+    addProteinFilter([threshold_score](ProteinIdentification& id)
+    {
+      IDFilter::filterHitsByScore(id, threshold_score);
+    });
+  }
+
+  void IdentificationFilteringConsumer::keepNBestPeptideHits(Size n)
+  {
+    addPeptideFilter([n](PeptideIdentification& id)
+    {
+      id.sort();
+      if (n < id.getHits().size()) id.getHits().resize(n);
+      return true;
+    });
+  }
+
+  void IdentificationFilteringConsumer::removeDecoyHits()
+  {
+    addPeptideFilter([](PeptideIdentification& id)
+    {
+      IDFilter::removeMatchingItems(id.getHits(), IDFilter::HasDecoyAnnotation<PeptideHit>());
+      return true;
+    });
+    addProteinFilter([](ProteinIdentification& id)
+    {
+      IDFilter::removeMatchingItems(id.getHits(), IDFilter::HasDecoyAnnotation<ProteinHit>());
+    });
+  }
+
+  void IdentificationFilteringConsumer::removeEmptyIdentifications()
+  {
+    addPeptideFilter([](PeptideIdentification& id)
+    {
+      return !id.getHits().empty();
+    });
+  }
+
+  Size IdentificationFilteringConsumer::getNumberOfConsumedPeptideIdentifications() const
+  {
+    return n_consumed_;
+  }
+
+  Size IdentificationFilteringConsumer::getNumberOfAcceptedPeptideIdentifications() const
+  {
+    return n_accepted_;
+  }
+
+} //end namespace OpenMS
@@ -0,0 +1,209 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataParallelTransformingConsumer.h>
+
+#include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <exception>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace OpenMS
+{
+  namespace
+  {
+    int maxThreads()
+    {
+#ifdef _OPENMP
+      return omp_get_max_threads();
+#else
+      return 1;
+#endif
+    }
+
+    /// applies the per-thread functions (created from @p factory on demand) to all entries of @p data
+    template <typename DataType, typename FuncType, typename FactoryType>
+    void processInParallel(DataType* data, SignedSize size, const FactoryType& factory, std::vector<FuncType>& funcs)
+    {
+      if (!factory || size == 0) return;
+      // the factory itself does not need to be thread-safe
+      while (funcs.size() < static_cast<Size>(maxThreads()))
+      {
+        funcs.push_back(factory());
+      }
+
+      std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize i = 0; i < size; ++i)
+      {
+        try
+        {
+#ifdef _OPENMP
+          FuncType& func = funcs[omp_get_thread_num()];
+#else
+          FuncType& func = funcs[0];
+#endif
+          if (func) func(data[i]);
+        }
+        catch (...)
+        {
+#pragma omp critical (MSDataParallelTransformingConsumer_error)
+          if (!error) error = std::current_exception();
+        }
+      }
+      if (error) std::rethrow_exception(error);
+    }
+  }
+
+  MSDataParallelTransformingConsumer::MSDataParallelTransformingConsumer(Interfaces::IMSDataConsumer* next_consumer, Size block_size) :
+    next_consumer_(next_consumer),
+    block_size_(block_size == 0 ? 32 * static_cast<Size>(maxThreads()) : block_size),
+    spectra_factory_(nullptr),
+    chrom_factory_(nullptr)
+  {
+  }
+
+  MSDataParallelTransformingConsumer::~MSDataParallelTransformingConsumer()
+  {
+    try
+    {
+      flush();
+    }
+    catch (std::exception& e)
+    {
+      OPENMS_LOG_ERROR << "MSDataParallelTransformingConsumer: error while processing pending data: " << e.what() << std::endl;
+    }
+    catch (...)
+    {
+      OPENMS_LOG_ERROR << "MSDataParallelTransformingConsumer: error while processing pending data." << std::endl;
+    }
+  }
+
+  void MSDataParallelTransformingConsumer::setExpectedSize(Size expectedSpectra, Size expectedChromatograms)
+  {
+    if (next_consumer_ != nullptr) next_consumer_->setExpectedSize(expectedSpectra, expectedChromatograms);
+  }
+
+  void MSDataParallelTransformingConsumer::setExperimentalSettings(const ExperimentalSettings& exp)
+  {
+    if (next_consumer_ != nullptr) next_consumer_->setExperimentalSettings(exp);
+  }
+
+  void MSDataParallelTransformingConsumer::consumeSpectrum(SpectrumType& s)
+  {
+    // keep the order of spectra and chromatograms
+    if (!chromatograms_.empty()) flushChromatograms_();
+
+    if (spectra_.empty()) spectra_.reserve(block_size_);
+    spectra_.push_back(std::move(s));
+    if (spectra_.size() >= block_size_) flushSpectra_();
+  }
+
+  void MSDataParallelTransformingConsumer::consumeChromatogram(ChromatogramType& c)
+  {
+    // keep the order of spectra and chromatograms
+    if (!spectra_.empty()) flushSpectra_();
+
+    if (chromatograms_.empty()) chromatograms_.reserve(block_size_);
+    chromatograms_.push_back(std::move(c));
+    if (chromatograms_.size() >= block_size_) flushChromatograms_();
+  }
+
+  void MSDataParallelTransformingConsumer::setSpectraProcessingFactory(SpectrumProcessingFactory factory)
+  {
+    flushSpectra_(); // pending data was consumed with the old functions
+    spectra_factory_ = factory;
+    spectra_funcs_.clear();
+  }
+
+  void MSDataParallelTransformingConsumer::setChromatogramProcessingFactory(ChromatogramProcessingFactory factory)
+  {
+    flushChromatograms_(); // pending data was consumed with the old functions
+    chrom_factory_ = factory;
+    chrom_funcs_.clear();
+  }
+
+  void MSDataParallelTransformingConsumer::flush()
+  {
+    flushSpectra_();
+    flushChromatograms_();
+  }
+
+  void MSDataParallelTransformingConsumer::processExperiment(PeakMap& exp)
+  {
+    processInParallel(exp.getSpectra().data(), static_cast<SignedSize>(exp.size()), spectra_factory_, spectra_funcs_);
+    std::vector<ChromatogramType>& chroms = exp.getChromatograms();
+    processInParallel(chroms.data(), static_cast<SignedSize>(chroms.size()), chrom_factory_, chrom_funcs_);
+  }
+
+  Size MSDataParallelTransformingConsumer::getBlockSize() const
+  {
+    return block_size_;
+  }
+
+  void MSDataParallelTransformingConsumer::flushSpectra_()
+  {
+    if (spectra_.empty()) return;
+    std::vector<SpectrumType> block;
+    block.swap(spectra_); // leaves a consistent state if processing throws
+    processInParallel(block.data(), static_cast<SignedSize>(block.size()), spectra_factory_, spectra_funcs_);
+    if (next_consumer_ != nullptr)
+    {
+      for (SpectrumType& s : block)
+      {
+        next_consumer_->consumeSpectrum(s);
+      }
+    }
+  }
+
+  void MSDataParallelTransformingConsumer::flushChromatograms_()
+  {
+    if (chromatograms_.empty()) return;
+    std::vector<ChromatogramType> block;
+    block.swap(chromatograms_); // leaves a consistent state if processing throws
+    processInParallel(block.data(), static_cast<SignedSize>(block.size()), chrom_factory_, chrom_funcs_);
+    if (next_consumer_ != nullptr)
+    {
+      for (ChromatogramType& c : block)
+      {
+        next_consumer_->consumeChromatogram(c);
+      }
+    }
+  }
+
+} // namespace OpenMS
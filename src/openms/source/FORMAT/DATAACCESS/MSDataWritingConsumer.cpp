@@ -111,11 +111,34 @@ namespace OpenMS
       ofs_ << "\t\t<spectrumList count=\"" << spectra_expected_ << "\" defaultDataProcessingRef=\"dp_sp_0\">\n";
       writing_spectra_ = true;
     }
+    // spectra are buffered and encoded in parallel once the buffer is full
+    spectra_buffer_.push_back(std::move(scpy));
+    ++spectra_written_;
+    if (spectra_buffer_.size() >= getWriteBatchSize_())
+    {
+      flushSpectra_();
+    }
+  }
+
+  void MSDataWritingConsumer::flushSpectra_()
+  {
+    if (spectra_buffer_.empty()) return;
+
     bool renew_native_ids = false;
     // TODO writeSpectrum assumes that dps_ has at least one value -> assert
     // this here ...
-    Internal::MzMLHandler::writeSpectrum_(ofs_, scpy,
-            spectra_written_++, *validator_, renew_native_ids, dps_);
+    Internal::MzMLHandler::writeSpectra_(ofs_, spectra_buffer_, 0, spectra_buffer_.size(),
+            spectra_written_ - spectra_buffer_.size(), *validator_, renew_native_ids, dps_);
+    spectra_buffer_.clear();
+  }
+
+  void MSDataWritingConsumer::flushChromatograms_()
+  {
+    if (chromatograms_buffer_.empty()) return;
+
+    Internal::MzMLHandler::writeChromatograms_(ofs_, chromatograms_buffer_, 0, chromatograms_buffer_.size(),
+            chromatograms_written_ - chromatograms_buffer_.size(), *validator_);
+    chromatograms_buffer_.clear();
   }
 
    void MSDataWritingConsumer::consumeChromatogram(ChromatogramType & c)
@@ -123,6 +146,7 @@ namespace OpenMS
     // make sure to close an open List tag
     if (writing_spectra_)
     {
+      flushSpectra_();
       ofs_ << "\t\t</spectrumList>\n";
       writing_spectra_ = false;
     }
@@ -156,8 +180,13 @@ namespace OpenMS
       ofs_ << "\t\t<chromatogramList count=\"" << chromatograms_expected_ << "\" defaultDataProcessingRef=\"dp_sp_0\">\n";
       writing_chromatograms_ = true;
     }
-    Internal::MzMLHandler::writeChromatogram_(ofs_, ccpy,
-            chromatograms_written_++, *validator_);
+    // chromatograms are buffered and encoded in parallel once the buffer is full
+    chromatograms_buffer_.push_back(std::move(ccpy));
+    ++chromatograms_written_;
+    if (chromatograms_buffer_.size() >= getWriteBatchSize_())
+    {
+      flushChromatograms_();
+    }
   }
 
    void MSDataWritingConsumer::addDataProcessing(DataProcessing d)
@@ -175,13 +204,15 @@ namespace OpenMS
     //--------------------------------------------------------------------------------------------
     //cleanup
     //--------------------------------------------------------------------------------------------
-    // make sure to close an open List tag
+    // write remaining buffered data and make sure to close an open List tag
     if (writing_spectra_)
     {
+      flushSpectra_();
       ofs_ << "\t\t</spectrumList>\n";
     }
     else if (writing_chromatograms_)
     {
+      flushChromatograms_();
       ofs_ << "\t\t</chromatogramList>\n";
     }
 
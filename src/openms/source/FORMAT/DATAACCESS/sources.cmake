@@ -4,11 +4,13 @@ set(directory source/FORMAT/DATAACCESS)
 ### list all filenames of the directory here
 set(sources_list
   CsiFingerIdMzTabWriter.cpp
+  IdentificationFilteringConsumer.cpp
   MSDataWritingConsumer.cpp
   MSDataTransformingConsumer.cpp
   MSDataAggregatingConsumer.cpp
   MSDataCachedConsumer.cpp
   MSDataChainingConsumer.cpp
+  MSDataParallelTransformingConsumer.cpp
   MSDataStoringConsumer.cpp
   MSDataSqlConsumer.cpp
   MSDataTransformingConsumer.cpp
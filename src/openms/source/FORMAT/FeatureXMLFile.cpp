@@ -40,8 +40,13 @@
 #include <OpenMS/CHEMISTRY/ProteaseDB.h>
 #include <OpenMS/FORMAT/FileHandler.h>
 
+#include <exception>
 #include <fstream>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 
 namespace OpenMS
@@ -112,7 +117,62 @@ namespace OpenMS
     map_->setLoadedFileType(file_);
     map_->setLoadedFilePath(file_);
 
-    parse_(filename, this);
+    // large files are split at feature boundaries and the features are parsed in parallel
+    String skeleton;
+    std::vector<std::string> chunks;
+    std::vector<Size> chunk_list;
+    std::vector<ElementList> lists;
+    if (options_.getMetadataOnly() || !splitDocument_(filename, "featureList", "feature", skeleton, chunks, chunk_list, lists))
+    {
+      parse_(filename, this);
+    }
+    else
+    {
+      // the skeleton contains everything but the features, in particular the identification runs they refer to
+      parseBuffer_(skeleton, this);
+      skeleton.clear();
+
+      std::vector<FeatureMap> chunk_maps(chunks.size());
+      std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)chunks.size(); ++i)
+      {
+        try
+        {
+          FeatureXMLFile reader;
+          reader.file_ = file_;
+          reader.options_ = options_;
+          reader.id_identifier_ = id_identifier_;
+          reader.proteinid_to_accession_ = proteinid_to_accession_;
+          reader.map_ = &chunk_maps[i];
+          reader.parseBuffer_(chunks[i], &reader);
+          std::string().swap(chunks[i]);
+        }
+        catch (...)
+        {
+#pragma omp critical (FeatureXMLFile_load)
+          if (!error) error = std::current_exception();
+        }
+      }
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+
+      Size n_features = map_->size();
+      for (const FeatureMap& chunk_map : chunk_maps)
+      {
+        n_features += chunk_map.size();
+      }
+      map_->reserve(n_features);
+      for (FeatureMap& chunk_map : chunk_maps)
+      {
+        for (Feature& feature : chunk_map)
+        {
+          map_->push_back(std::move(feature));
+        }
+      }
+    }
 
     // !!! Hack: set feature FWHM from meta info entries as
     // long as featureXML doesn't support a width entry.
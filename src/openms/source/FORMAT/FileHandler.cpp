@@ -39,6 +39,9 @@
 #include <OpenMS/FORMAT/MzXMLFile.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
+#include <OpenMS/FORMAT/ConsensusXMLFile.h>
+#include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/FORMAT/NativeBinaryFile.h>
 #include <OpenMS/FORMAT/MzDataFile.h>
 #include <OpenMS/FORMAT/MascotGenericFile.h>
 #include <OpenMS/FORMAT/MS2File.h>
@@ -187,6 +190,13 @@ namespace OpenMS
     // so far, compression is only supported for XML files
     vector<String> complete_file;
 
+    // OpenMS binary formats carry their content type in the header
+    FileTypes::Type binary_type = NativeBinaryFile::getContentType(filename);
+    if (binary_type != FileTypes::UNKNOWN)
+    {
+      return binary_type;
+    }
+
     // test whether the file is compressed (bzip2 or gzip)
     ifstream compressed_file(filename.c_str());
     char bz[2];
@@ -565,6 +575,10 @@ if (first_line.hasSubstring("File	First Scan	Last Scan	Num of Scans	Charge	Monoi
     {
       FeatureXMLFile().load(filename, map);
     }
+    else if (type == FileTypes::FEATUREBIN)
+    {
+      NativeBinaryFile().load(filename, map);
+    }
     else if (type == FileTypes::TSV)
     {
       MsInspectFile().load(filename, map);
@@ -585,6 +599,116 @@ if (first_line.hasSubstring("File	First Scan	Last Scan	Num of Scans	Charge	Monoi
     return true;
   }
 
+  void FileHandler::storeFeatures(const String& filename, const FeatureMap& map)
+  {
+    if (getTypeByFileName(filename) == FileTypes::FEATUREBIN)
+    {
+      NativeBinaryFile().store(filename, map);
+    }
+    else
+    {
+      FeatureXMLFile().store(filename, map);
+    }
+  }
+
+  bool FileHandler::loadConsensusFeatures(const String& filename, ConsensusMap& map, FileTypes::Type force_type)
+  {
+    //determine file type
+    FileTypes::Type type;
+    if (force_type != FileTypes::UNKNOWN)
+    {
+      type = force_type;
+    }
+    else
+    {
+      try
+      {
+        type = getType(filename);
+      }
+      catch ( Exception::FileNotFound& )
+      {
+        return false;
+      }
+    }
+
+    //load right file
+    if (type == FileTypes::CONSENSUSXML)
+    {
+      ConsensusXMLFile().load(filename, map);
+    }
+    else if (type == FileTypes::CONSENSUSBIN)
+    {
+      NativeBinaryFile().load(filename, map);
+    }
+    else
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  void FileHandler::storeConsensusFeatures(const String& filename, const ConsensusMap& map)
+  {
+    if (getTypeByFileName(filename) == FileTypes::CONSENSUSBIN)
+    {
+      NativeBinaryFile().store(filename, map);
+    }
+    else
+    {
+      ConsensusXMLFile().store(filename, map);
+    }
+  }
+
+  bool FileHandler::loadIdentifications(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids, FileTypes::Type force_type)
+  {
+    //determine file type
+    FileTypes::Type type;
+    if (force_type != FileTypes::UNKNOWN)
+    {
+      type = force_type;
+    }
+    else
+    {
+      try
+      {
+        type = getType(filename);
+      }
+      catch ( Exception::FileNotFound& )
+      {
+        return false;
+      }
+    }
+
+    //load right file
+    if (type == FileTypes::IDXML)
+    {
+      IdXMLFile().load(filename, protein_ids, peptide_ids);
+    }
+    else if (type == FileTypes::IDBIN)
+    {
+      NativeBinaryFile().load(filename, protein_ids, peptide_ids);
+    }
+    else
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  void FileHandler::storeIdentifications(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids)
+  {
+    if (getTypeByFileName(filename) == FileTypes::IDBIN)
+    {
+      NativeBinaryFile().store(filename, protein_ids, peptide_ids);
+    }
+    else
+    {
+      IdXMLFile().store(filename, protein_ids, peptide_ids);
+    }
+  }
+
   bool FileHandler::loadExperiment(const String& filename, PeakMap& exp, FileTypes::Type force_type, ProgressLogger::LogType log, const bool rewrite_source_file, const bool compute_hash)
   {
     // setting the flag for hash recomputation only works if source file entries are rewritten
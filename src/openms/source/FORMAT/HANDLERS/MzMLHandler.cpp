@@ -44,6 +44,13 @@
 #include <OpenMS/INTERFACES/IMSDataConsumer.h>
 #include <OpenMS/SYSTEM/File.h>
 
+#include <exception>
+#include <sstream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace OpenMS
 {
   namespace Internal
@@ -1231,6 +1238,9 @@ namespace OpenMS
           }
           */
 
+          // spectra of a run usually have only a few distinct instrument settings and source files
+          spec_.shareSettings(shared_settings_);
+
           // Move current data to (temporary) spectral data object
           SpectrumData tmp;
           tmp.spectrum = std::move(spec_);
@@ -3858,6 +3868,7 @@ namespace OpenMS
           {
             default:
               // assume milliseconds, but warn
+#pragma omp critical(MZMLErrorHandling)
               warning(STORE, String("Precursor drift time unit not set, assume milliseconds"));
               [[fallthrough]];
             case DriftTimeUnit::MILLISECOND:
@@ -4012,13 +4023,15 @@ namespace OpenMS
           warning(STORE, String("Invalid native IDs detected. Using spectrum identifier nativeID format (spectrum=xsd:nonNegativeInteger) for all spectra."));
         }
 
-        // write actual data
-        for (Size s_idx = 0; s_idx < exp.size(); ++s_idx)
+        // write actual data (encoded in parallel, batch by batch)
+        const Size batch_size = getWriteBatchSize_();
+        for (Size s_idx = 0; s_idx < exp.size(); s_idx += batch_size)
         {
-          logger_.setProgress(progress++);
-          const SpectrumType& spec = exp[s_idx];
-          writeSpectrum_(os, spec, s_idx, validator, renew_native_ids, dps);
-          ++stored_spectra;
+          logger_.setProgress(progress);
+          const Size end = std::min(s_idx + batch_size, exp.size());
+          writeSpectra_(os, exp.getSpectra(), s_idx, end, s_idx, validator, renew_native_ids, dps);
+          progress += end - s_idx;
+          stored_spectra += end - s_idx;
         }
         os << "\t\t</spectrumList>\n";
       }
@@ -4033,12 +4046,14 @@ namespace OpenMS
         // meta information needs to be stored here but the actual data is
         // stored somewhere else).
         os << "\t\t<chromatogramList count=\"" << exp.getChromatograms().size() << "\" defaultDataProcessingRef=\"dp_sp_0\">\n";
-        for (Size c_idx = 0; c_idx != exp.getChromatograms().size(); ++c_idx)
+        const Size batch_size = getWriteBatchSize_();
+        for (Size c_idx = 0; c_idx < exp.getChromatograms().size(); c_idx += batch_size)
         {
-          logger_.setProgress(progress++);
-          const ChromatogramType& chromatogram = exp.getChromatograms()[c_idx];
-          writeChromatogram_(os, chromatogram, c_idx, validator);
-          ++stored_chromatograms;
+          logger_.setProgress(progress);
+          const Size end = std::min(c_idx + batch_size, exp.getChromatograms().size());
+          writeChromatograms_(os, exp.getChromatograms(), c_idx, end, c_idx, validator);
+          progress += end - c_idx;
+          stored_chromatograms += end - c_idx;
         }
         os << "\t\t</chromatogramList>" << "\n";
       }
@@ -5000,7 +5015,72 @@ namespace OpenMS
       Int64 offset = os.tellp();
       spectra_offsets_.push_back(make_pair(native_id, offset + 3));
 
-      // IMPORTANT make sure the offset (above) corresponds to the start of the <spectrum tag
+      writeSpectrumContent_(os, spec, s, native_id, validator, dps);
+    }
+
+    void MzMLHandler::writeSpectra_(std::ostream& os,
+                                    const std::vector<SpectrumType>& spectra,
+                                    Size begin,
+                                    Size end,
+                                    Size spec_idx,
+                                    const Internal::MzMLValidator& validator,
+                                    bool renew_native_ids,
+                                    std::vector<std::vector< ConstDataProcessingPtr > >& dps)
+    {
+      std::vector<String> native_ids(end - begin);
+      std::vector<std::string> buffers(end - begin);
+      std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)buffers.size(); ++i)
+      {
+        // parallel exception catching and re-throwing business
+        try
+        {
+          const SpectrumType& spec = spectra[begin + i];
+          native_ids[i] = renew_native_ids ? String("spectrum=") + (spec_idx + i) : spec.getNativeID();
+          std::ostringstream buffer;
+          buffer.copyfmt(os); // same precision as the output stream
+          writeSpectrumContent_(buffer, spec, spec_idx + i, native_ids[i], validator, dps);
+          buffers[i] = buffer.str();
+        }
+        catch (...)
+        {
+#pragma omp critical(MZMLErrorHandling)
+          if (!error) error = std::current_exception();
+        }
+      }
+      if (error) std::rethrow_exception(error);
+
+      // write in original order, the offset has to correspond to the start of the <spectrum tag
+      for (Size i = 0; i < buffers.size(); ++i)
+      {
+        Int64 offset = os.tellp();
+        spectra_offsets_.push_back(make_pair(native_ids[i], offset + 3));
+        os << buffers[i];
+      }
+    }
+
+    Size MzMLHandler::getWriteBatchSize_()
+    {
+#ifdef _OPENMP
+      // a few spectra per thread to balance differently sized spectra while keeping the buffers small
+      const Size threads = omp_get_max_threads();
+      return threads > 1 ? 4 * threads : 1;
+#else
+      return 1;
+#endif
+    }
+
+    void MzMLHandler::writeSpectrumContent_(std::ostream& os,
+                                            const SpectrumType& spec,
+                                            Size s,
+                                            const String& native_id,
+                                            const Internal::MzMLValidator& validator,
+                                            const std::vector<std::vector< ConstDataProcessingPtr > >& dps)
+    {
+      // IMPORTANT make sure the offset (recorded by the caller) corresponds to the start of the <spectrum tag
       os << "\t\t\t<spectrum id=\"" << writeXMLEscape(native_id) << "\" index=\"" << s << "\" defaultArrayLength=\"" << spec.size() << "\"";
       if (spec.getSourceFile() != SourceFile())
       {
@@ -5171,6 +5251,7 @@ namespace OpenMS
             else
             {
               // assume milliseconds, but warn
+#pragma omp critical(MZMLErrorHandling)
               warning(STORE, String("Spectrum drift time unit not set, assume milliseconds"));
               os << "\t\t\t\t\t\t<cvParam cvRef=\"MS\" accession=\"MS:1002476\" name=\"ion mobility drift time\" value=\"" << spec.getDriftTime()
                  << "\" unitAccession=\"UO:0000028\" unitName=\"millisecond\" unitCvRef=\"UO\" />\n";
@@ -5580,8 +5661,55 @@ namespace OpenMS
       Int64 offset = os.tellp();
       chromatograms_offsets_.push_back(make_pair(chromatogram.getNativeID(), offset + 3));
 
+      writeChromatogramContent_(os, chromatogram, c, validator);
+    }
+
+    void MzMLHandler::writeChromatograms_(std::ostream& os,
+                                          const std::vector<ChromatogramType>& chromatograms,
+                                          Size begin,
+                                          Size end,
+                                          Size chrom_idx,
+                                          const Internal::MzMLValidator& validator)
+    {
+      std::vector<std::string> buffers(end - begin);
+      std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)buffers.size(); ++i)
+      {
+        // parallel exception catching and re-throwing business
+        try
+        {
+          std::ostringstream buffer;
+          buffer.copyfmt(os); // same precision as the output stream
+          writeChromatogramContent_(buffer, chromatograms[begin + i], chrom_idx + i, validator);
+          buffers[i] = buffer.str();
+        }
+        catch (...)
+        {
+#pragma omp critical(MZMLErrorHandling)
+          if (!error) error = std::current_exception();
+        }
+      }
+      if (error) std::rethrow_exception(error);
+
+      // write in original order, the offset has to correspond to the start of the <chromatogram tag
+      for (Size i = 0; i < buffers.size(); ++i)
+      {
+        Int64 offset = os.tellp();
+        chromatograms_offsets_.push_back(make_pair(chromatograms[begin + i].getNativeID(), offset + 3));
+        os << buffers[i];
+      }
+    }
+
+    void MzMLHandler::writeChromatogramContent_(std::ostream& os,
+                                                const ChromatogramType& chromatogram,
+                                                Size c,
+                                                const Internal::MzMLValidator& validator)
+    {
       // TODO native id with chromatogram=?? prefix?
-      // IMPORTANT make sure the offset (above) corresponds to the start of the <chromatogram tag
+      // IMPORTANT make sure the offset (recorded by the caller) corresponds to the start of the <chromatogram tag
       os << "\t\t\t<chromatogram id=\"" << writeXMLEscape(chromatogram.getNativeID()) << "\" index=\"" << c << "\" defaultArrayLength=\"" << chromatogram.size() << "\">" << "\n";
 
       // write cvParams (chromatogram type)
@@ -43,9 +43,15 @@
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/SYSTEM/File.h>
 
+#include <algorithm>
+#include <exception>
 #include <fstream>
 #include <unordered_map>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 
 namespace OpenMS
@@ -56,7 +62,8 @@ namespace OpenMS
     XMLFile("/SCHEMAS/IdXML_1_5.xsd", "1.5"),
     last_meta_(nullptr),
     document_id_(),
-    prot_id_in_run_(false)
+    prot_id_in_run_(false),
+    consumer_(nullptr)
   {
   }
 
@@ -80,9 +87,131 @@ namespace OpenMS
     pep_ids_ = &peptide_ids;
     document_id_ = &document_id;
 
-    parse_(filename, this);
+    // large files are split at peptide identification boundaries and the peptide identifications are parsed in parallel
+    String skeleton;
+    std::vector<std::string> chunks;
+    std::vector<Size> chunk_list;
+    std::vector<ElementList> lists;
+    bool chunked = splitDocument_(filename, "IdentificationRun", "PeptideIdentification", skeleton, chunks, chunk_list, lists);
+    // each run needs exactly one <ProteinIdentification> (as written by store()), so runs map to protein identifications one-to-one
+    for (const ElementList& list : lists)
+    {
+      chunked = chunked && std::count(list.head_tags.begin(), list.head_tags.end(), "ProteinIdentification") == 1;
+    }
+    if (chunked)
+    {
+      // the skeleton contains everything but the peptide identifications
+      parseBuffer_(skeleton, this);
+      skeleton.clear();
 
-    //reset members
+      // protein hit ids must be unique within the file, otherwise references depend on the position of the peptide identification
+      Size n_protein_hits = 0;
+      for (const ProteinIdentification& prot_id : protein_ids)
+      {
+        n_protein_hits += prot_id.getHits().size();
+      }
+      if (protein_ids.size() != lists.size() || proteinid_to_accession_.size() != n_protein_hits)
+      {
+        chunked = false;
+        protein_ids.clear();
+        proteinid_to_accession_.clear();
+        parameters_.clear();
+      }
+    }
+
+    if (!chunked)
+    {
+      parse_(filename, this);
+    }
+    else
+    {
+      std::vector<std::vector<PeptideIdentification>> chunk_peptides(chunks.size());
+      std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)chunks.size(); ++i)
+      {
+        try
+        {
+          // a placeholder for the run the chunk belongs to (only its identifier is used)
+          std::vector<ProteinIdentification> run(1);
+          run[0].setIdentifier(protein_ids[chunk_list[i]].getIdentifier());
+
+          IdXMLFile reader;
+          reader.file_ = file_;
+          reader.prot_ids_ = &run;
+          reader.pep_ids_ = &chunk_peptides[i];
+          reader.prot_id_in_run_ = true;
+          reader.proteinid_to_accession_ = proteinid_to_accession_;
+          reader.parseBuffer_(chunks[i], &reader);
+          std::string().swap(chunks[i]);
+        }
+        catch (...)
+        {
+#pragma omp critical (IdXMLFile_load)
+          if (!error) error = std::current_exception();
+        }
+      }
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+
+      Size n_peptides = peptide_ids.size();
+      for (const std::vector<PeptideIdentification>& peptides : chunk_peptides)
+      {
+        n_peptides += peptides.size();
+      }
+      peptide_ids.reserve(n_peptides);
+      for (std::vector<PeptideIdentification>& peptides : chunk_peptides)
+      {
+        std::move(peptides.begin(), peptides.end(), std::back_inserter(peptide_ids));
+      }
+    }
+
+    resetMembers_();
+
+    endProgress();
+  }
+
+  void IdXMLFile::load(const String& filename, Interfaces::IIdentificationConsumer* consumer)
+  {
+    if (consumer == nullptr)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "A valid consumer is required");
+    }
+    startProgress(0, 0, "Loading idXML");
+    //Filename for error messages in XMLHandler
+    file_ = filename;
+
+    // only a placeholder for the current run is kept (its identifier is needed for the peptide IDs)
+    std::vector<ProteinIdentification> current_run;
+    std::vector<PeptideIdentification> no_peptides;
+    String document_id;
+    prot_ids_ = &current_run;
+    pep_ids_ = &no_peptides;
+    document_id_ = &document_id;
+    consumer_ = consumer;
+
+    // no chunked parsing here - identifications have to be passed on in file order
+    try
+    {
+      parse_(filename, this);
+    }
+    catch (...)
+    {
+      consumer_ = nullptr;
+      resetMembers_();
+      throw;
+    }
+
+    consumer_ = nullptr;
+    resetMembers_();
+
+    endProgress();
+  }
+
+  void IdXMLFile::resetMembers_()
+  {
     prot_ids_ = nullptr;
     pep_ids_ = nullptr;
     last_meta_ = nullptr;
@@ -94,8 +223,20 @@ namespace OpenMS
     prot_hit_ = ProteinHit();
     pep_hit_ = PeptideHit();
     proteinid_to_accession_.clear();
+  }
 
-    endProgress();
+  void IdXMLFile::addProteinIdentification_(const ProteinIdentification& prot_id)
+  {
+    if (consumer_ == nullptr)
+    {
+      prot_ids_->push_back(prot_id);
+      return;
+    }
+    ProteinIdentification run = prot_id;
+    consumer_->consumeProteinIdentification(run);
+    // keep only what is needed to annotate the following peptide IDs:
+    prot_ids_->assign(1, ProteinIdentification());
+    prot_ids_->back().setIdentifier(prot_id.getIdentifier());
   }
 
   void IdXMLFile::store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids, const String& document_id)
@@ -614,7 +755,7 @@ namespace OpenMS
       // check whether a prot id has been given, add "empty" one to list else
       if (!prot_id_in_run_)
       {
-        prot_ids_->push_back(prot_id_);
+        addProteinIdentification_(prot_id_);
         prot_id_in_run_ = true; // set to true, cause we have created one; will be reset for next run
       }
 
@@ -886,7 +1027,7 @@ namespace OpenMS
       getProteinGroups_(prot_id_.getIndistinguishableProteins(),
                         "indistinguishable_proteins");
 
-      prot_ids_->push_back(prot_id_);
+      addProteinIdentification_(prot_id_);
       prot_id_ = ProteinIdentification();
       last_meta_  = nullptr;
       prot_id_in_run_ = true;
@@ -896,7 +1037,7 @@ namespace OpenMS
       if (prot_ids_->empty())
       {
         // add empty <ProteinIdentification> if there was none so far (that's where the IdentificationRun parameters are stored)
-        prot_ids_->emplace_back(std::move(prot_id_));
+        addProteinIdentification_(prot_id_);
       }
       prot_id_ = ProteinIdentification();
       last_meta_ = nullptr;
@@ -910,7 +1051,14 @@ namespace OpenMS
     //PEPTIDES
     else if (tag == "PeptideIdentification")
     {
-      pep_ids_->emplace_back(std::move(pep_id_));
+      if (consumer_ == nullptr)
+      {
+        pep_ids_->emplace_back(std::move(pep_id_));
+      }
+      else
+      {
+        consumer_->consumePeptideIdentification(pep_id_);
+      }
       pep_id_ = PeptideIdentification();
       last_meta_ = nullptr;
     }
@@ -0,0 +1,1276 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/NativeBinaryFile.h>
+
+#include <OpenMS/CHEMISTRY/ProteaseDB.h>
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/METADATA/PeptideIdentification.h>
+#include <OpenMS/METADATA/ProteinIdentification.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <unordered_map>
+
+using namespace std;
+
+namespace OpenMS
+{
+  const UInt32 NativeBinaryFile::VERSION = 2;
+
+  namespace
+  {
+    /// Identifies the format (the line break detects text mode conversions)
+    const char MAGIC[8] = {'O', 'M', 'S', 'B', 'I', 'N', '\r', '\n'};
+
+    /// Content tags of the header (fixed, independent of the order of FileTypes::Type)
+    const std::uint8_t CONTENT_FEATURES = 1;
+    const std::uint8_t CONTENT_CONSENSUS = 2;
+    const std::uint8_t CONTENT_IDS = 3;
+
+    /// Maximum number of bytes compressed at once (compressed blocks are stored as a series of chunks)
+    const UInt32 CHUNK_SIZE = UInt32(1) << 26;
+
+    /// Content tag for @p type
+    std::uint8_t contentTag(FileTypes::Type type)
+    {
+      switch (type)
+      {
+        case FileTypes::FEATUREBIN: return CONTENT_FEATURES;
+        case FileTypes::CONSENSUSBIN: return CONTENT_CONSENSUS;
+        case FileTypes::IDBIN: return CONTENT_IDS;
+        default:
+          throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "not a binary content type", FileTypes::typeToName(type));
+      }
+    }
+
+    /// File type of content tag @p tag (FileTypes::UNKNOWN for invalid tags)
+    FileTypes::Type contentType(std::uint8_t tag)
+    {
+      switch (tag)
+      {
+        case CONTENT_FEATURES: return FileTypes::FEATUREBIN;
+        case CONTENT_CONSENSUS: return FileTypes::CONSENSUSBIN;
+        case CONTENT_IDS: return FileTypes::IDBIN;
+        default: return FileTypes::UNKNOWN;
+      }
+    }
+
+    /// Serializes objects into a data block, storing each distinct string only once in a string block
+    class BinaryWriter
+    {
+    public:
+      const std::string& data() const
+      {
+        return data_;
+      }
+
+      /// The string block: number of strings followed by the strings (in order of first use)
+      std::string strings() const
+      {
+        std::string block;
+        appendUInt_(block, string_index_.size());
+        block.append(strings_);
+        return block;
+      }
+
+      template <typename T>
+      void writePOD(T value)
+      {
+        static_assert(std::is_trivially_copyable<T>::value, "only plain values can be written");
+        data_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+      }
+
+      void writeUInt(UInt64 value)
+      {
+        appendUInt_(data_, value);
+      }
+
+      void writeInt(Int64 value)
+      {
+        // zig-zag encoding keeps small negative numbers short
+        writeUInt((UInt64(value) << 1) ^ UInt64(value >> 63));
+      }
+
+      void writeBool(bool value)
+      {
+        data_.push_back(value ? 1 : 0);
+      }
+
+      void writeString(const std::string& value)
+      {
+        auto it = string_index_.emplace(value, string_index_.size());
+        if (it.second)
+        {
+          appendUInt_(strings_, value.size());
+          strings_.append(value);
+        }
+        writeUInt(it.first->second);
+      }
+
+      void writeStrings(const std::vector<String>& values)
+      {
+        writeUInt(values.size());
+        for (const String& value : values)
+        {
+          writeString(value);
+        }
+      }
+
+      void writeDataValue(const DataValue& value)
+      {
+        writePOD<std::uint8_t>(value.valueType());
+        switch (value.valueType())
+        {
+          case DataValue::STRING_VALUE:
+            writeString(value.toString());
+            break;
+          case DataValue::INT_VALUE:
+            writeInt(static_cast<long long>(value));
+            break;
+          case DataValue::DOUBLE_VALUE:
+            writePOD<double>(value);
+            break;
+          case DataValue::STRING_LIST:
+            writeStrings(value.toStringList());
+            break;
+          case DataValue::INT_LIST:
+          {
+            const IntList list = value.toIntList();
+            writeUInt(list.size());
+            for (Int v : list) writeInt(v);
+            break;
+          }
+          case DataValue::DOUBLE_LIST:
+          {
+            const DoubleList list = value.toDoubleList();
+            writeUInt(list.size());
+            for (double v : list) writePOD<double>(v);
+            break;
+          }
+          default:
+            break;
+        }
+        writePOD<std::uint8_t>(value.getUnitType());
+        writeInt(value.getUnit());
+      }
+
+      void writeMetaInfo(const MetaInfoInterface& meta)
+      {
+        meta.getKeys(keys_);
+        writeUInt(keys_.size());
+        for (UInt key : keys_)
+        {
+          // meta value names are resolved once per registry index
+          auto it = key_index_.find(key);
+          if (it == key_index_.end())
+          {
+            const String name = MetaInfoInterface::metaRegistry().getName(key);
+            auto s = string_index_.emplace(name, string_index_.size());
+            if (s.second)
+            {
+              appendUInt_(strings_, name.size());
+              strings_.append(name);
+            }
+            it = key_index_.emplace(key, s.first->second).first;
+          }
+          writeUInt(it->second);
+          writeDataValue(meta.getMetaValue(key));
+        }
+      }
+
+    private:
+      static void appendUInt_(std::string& out, UInt64 value)
+      {
+        while (value >= 0x80)
+        {
+          out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+          value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+      }
+
+      std::string data_;
+      std::string strings_;
+      std::unordered_map<std::string, UInt64> string_index_;
+      std::unordered_map<UInt, UInt64> key_index_;
+      std::vector<UInt> keys_;
+    };
+
+    /// Reads objects written by BinaryWriter
+    class BinaryReader
+    {
+    public:
+      BinaryReader(const std::string& strings, const std::string& data, const String& filename) :
+        data_(data),
+        pos_(0),
+        filename_(filename)
+      {
+        // parse the string block with the same primitives
+        const std::string& block = strings;
+        Size pos = 0;
+        const UInt64 n = readUInt_(block, pos);
+        if (n > block.size())
+        {
+          fail_();
+        }
+        strings_.reserve(n);
+        for (UInt64 i = 0; i < n; ++i)
+        {
+          const UInt64 length = readUInt_(block, pos);
+          if (length > block.size() - pos)
+          {
+            fail_();
+          }
+          strings_.emplace_back(block.substr(pos, length));
+          pos += length;
+        }
+        meta_index_.assign(strings_.size(), -1);
+      }
+
+      bool atEnd() const
+      {
+        return pos_ == data_.size();
+      }
+
+      template <typename T>
+      T readPOD()
+      {
+        static_assert(std::is_trivially_copyable<T>::value, "only plain values can be read");
+        if (sizeof(T) > data_.size() - pos_)
+        {
+          fail_();
+        }
+        T value;
+        memcpy(&value, data_.data() + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+      }
+
+      UInt64 readUInt()
+      {
+        return readUInt_(data_, pos_);
+      }
+
+      /// Reads a number of elements (each element occupies at least one byte, which guards allocations against corrupt input)
+      Size readCount()
+      {
+        const UInt64 n = readUInt();
+        if (n > data_.size() - pos_)
+        {
+          fail_();
+        }
+        return n;
+      }
+
+      Int64 readInt()
+      {
+        const UInt64 value = readUInt();
+        return Int64(value >> 1) ^ -Int64(value & 1);
+      }
+
+      bool readBool()
+      {
+        return readPOD<std::uint8_t>() != 0;
+      }
+
+      const String& readString()
+      {
+        const UInt64 index = readUInt();
+        if (index >= strings_.size())
+        {
+          fail_();
+        }
+        return strings_[index];
+      }
+
+      std::vector<String> readStrings()
+      {
+        std::vector<String> values(readCount());
+        for (String& value : values)
+        {
+          value = readString();
+        }
+        return values;
+      }
+
+      /// Reads a peptide sequence; each distinct sequence is only parsed once
+      const AASequence& readSequence()
+      {
+        const UInt64 index = readUInt();
+        if (index >= strings_.size())
+        {
+          fail_();
+        }
+        auto it = sequences_.find(index);
+        if (it == sequences_.end())
+        {
+          it = sequences_.emplace(index, AASequence::fromString(strings_[index])).first;
+        }
+        return it->second;
+      }
+
+      DataValue readDataValue()
+      {
+        DataValue value;
+        const std::uint8_t type = readPOD<std::uint8_t>();
+        switch (type)
+        {
+          case DataValue::STRING_VALUE:
+            value = DataValue(readString());
+            break;
+          case DataValue::INT_VALUE:
+            value = DataValue(static_cast<long long>(readInt()));
+            break;
+          case DataValue::DOUBLE_VALUE:
+            value = DataValue(readPOD<double>());
+            break;
+          case DataValue::STRING_LIST:
+            value = DataValue(readStrings());
+            break;
+          case DataValue::INT_LIST:
+          {
+            IntList list(readCount());
+            for (Int& v : list) v = static_cast<Int>(readInt());
+            value = DataValue(list);
+            break;
+          }
+          case DataValue::DOUBLE_LIST:
+          {
+            DoubleList list(readCount());
+            for (double& v : list) v = readPOD<double>();
+            value = DataValue(list);
+            break;
+          }
+          case DataValue::EMPTY_VALUE:
+            break;
+          default:
+            fail_();
+        }
+        const std::uint8_t unit_type = readPOD<std::uint8_t>();
+        if (unit_type > DataValue::OTHER)
+        {
+          fail_();
+        }
+        value.setUnitType(static_cast<DataValue::UnitType>(unit_type));
+        value.setUnit(static_cast<int32_t>(readInt()));
+        return value;
+      }
+
+      void readMetaInfo(MetaInfoInterface& meta)
+      {
+        const Size n = readCount();
+        for (Size i = 0; i < n; ++i)
+        {
+          const UInt64 name = readUInt();
+          if (name >= strings_.size())
+          {
+            fail_();
+          }
+          // meta value names are registered once per file
+          if (meta_index_[name] < 0)
+          {
+            meta_index_[name] = MetaInfoInterface::metaRegistry().registerName(strings_[name]);
+          }
+          meta.setMetaValue(static_cast<UInt>(meta_index_[name]), readDataValue());
+        }
+      }
+
+      [[noreturn]] void fail_() const
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_, "truncated or corrupt binary data");
+      }
+
+    private:
+      UInt64 readUInt_(const std::string& in, Size& pos) const
+      {
+        UInt64 value = 0;
+        for (UInt shift = 0; shift < 64; shift += 7)
+        {
+          if (pos >= in.size())
+          {
+            fail_();
+          }
+          const std::uint8_t byte = static_cast<std::uint8_t>(in[pos++]);
+          value |= UInt64(byte & 0x7F) << shift;
+          if ((byte & 0x80) == 0)
+          {
+            return value;
+          }
+        }
+        fail_();
+      }
+
+      const std::string& data_;
+      Size pos_;
+      String filename_;
+      std::vector<String> strings_;
+      std::vector<SignedSize> meta_index_;
+      std::unordered_map<UInt64, AASequence> sequences_;
+    };
+
+    // --- writing ---
+
+    void writeDateTime(BinaryWriter& out, const DateTime& date)
+    {
+      out.writeBool(date.isNull());
+      if (!date.isNull())
+      {
+        UInt month, day, year, hour, minute, second;
+        date.get(month, day, year, hour, minute, second);
+        for (UInt v : {month, day, year, hour, minute, second})
+        {
+          out.writeUInt(v);
+        }
+      }
+    }
+
+    void writeDataProcessing(BinaryWriter& out, const std::vector<DataProcessing>& processing)
+    {
+      out.writeUInt(processing.size());
+      for (const DataProcessing& dp : processing)
+      {
+        out.writeString(dp.getSoftware().getName());
+        out.writeString(dp.getSoftware().getVersion());
+        out.writeMetaInfo(dp.getSoftware());
+        out.writeUInt(dp.getProcessingActions().size());
+        for (DataProcessing::ProcessingAction action : dp.getProcessingActions())
+        {
+          out.writeUInt(action);
+        }
+        writeDateTime(out, dp.getCompletionTime());
+        out.writeMetaInfo(dp);
+      }
+    }
+
+    void writeProteinGroups(BinaryWriter& out, const std::vector<ProteinIdentification::ProteinGroup>& groups)
+    {
+      out.writeUInt(groups.size());
+      for (const ProteinIdentification::ProteinGroup& group : groups)
+      {
+        out.writePOD<double>(group.probability);
+        out.writeStrings(group.accessions);
+        out.writeUInt(group.getFloatDataArrays().size());
+        for (const auto& array : group.getFloatDataArrays())
+        {
+          out.writeString(array.getName());
+          out.writeUInt(array.size());
+          for (float v : array) out.writePOD<float>(v);
+        }
+        out.writeUInt(group.getStringDataArrays().size());
+        for (const auto& array : group.getStringDataArrays())
+        {
+          out.writeString(array.getName());
+          out.writeStrings(array);
+        }
+        out.writeUInt(group.getIntegerDataArrays().size());
+        for (const auto& array : group.getIntegerDataArrays())
+        {
+          out.writeString(array.getName());
+          out.writeUInt(array.size());
+          for (Int v : array) out.writeInt(v);
+        }
+      }
+    }
+
+    void writeProteinIdentifications(BinaryWriter& out, const std::vector<ProteinIdentification>& protein_ids)
+    {
+      out.writeUInt(protein_ids.size());
+      for (const ProteinIdentification& prot_id : protein_ids)
+      {
+        out.writeString(prot_id.getIdentifier());
+        out.writeString(prot_id.getSearchEngine());
+        out.writeString(prot_id.getSearchEngineVersion());
+        writeDateTime(out, prot_id.getDateTime());
+        out.writeString(prot_id.getScoreType());
+        out.writeBool(prot_id.isHigherScoreBetter());
+        out.writePOD<double>(prot_id.getSignificanceThreshold());
+
+        const ProteinIdentification::SearchParameters& params = prot_id.getSearchParameters();
+        out.writeString(params.db);
+        out.writeString(params.db_version);
+        out.writeString(params.taxonomy);
+        out.writeString(params.charges);
+        out.writeUInt(params.mass_type);
+        out.writeStrings(params.fixed_modifications);
+        out.writeStrings(params.variable_modifications);
+        out.writeUInt(params.missed_cleavages);
+        out.writePOD<double>(params.fragment_mass_tolerance);
+        out.writeBool(params.fragment_mass_tolerance_ppm);
+        out.writePOD<double>(params.precursor_mass_tolerance);
+        out.writeBool(params.precursor_mass_tolerance_ppm);
+        out.writeString(params.digestion_enzyme.getName());
+        out.writeUInt(params.enzyme_term_specificity);
+        out.writeMetaInfo(params);
+
+        out.writeUInt(prot_id.getHits().size());
+        for (const ProteinHit& hit : prot_id.getHits())
+        {
+          out.writePOD<double>(hit.getScore());
+          out.writeUInt(hit.getRank());
+          out.writeString(hit.getAccession());
+          out.writeString(hit.getSequence());
+          out.writePOD<double>(hit.getCoverage());
+          out.writeMetaInfo(hit);
+        }
+        writeProteinGroups(out, prot_id.getProteinGroups());
+        writeProteinGroups(out, prot_id.getIndistinguishableProteins());
+        out.writeMetaInfo(prot_id);
+      }
+    }
+
+    void writePeptideIdentifications(BinaryWriter& out, const std::vector<PeptideIdentification>& peptide_ids)
+    {
+      out.writeUInt(peptide_ids.size());
+      for (const PeptideIdentification& pep_id : peptide_ids)
+      {
+        out.writeString(pep_id.getIdentifier());
+        out.writeString(pep_id.getScoreType());
+        out.writeBool(pep_id.isHigherScoreBetter());
+        out.writePOD<double>(pep_id.getSignificanceThreshold());
+        out.writePOD<double>(pep_id.getRT());
+        out.writePOD<double>(pep_id.getMZ());
+        out.writeString(pep_id.getBaseName());
+
+        out.writeUInt(pep_id.getHits().size());
+        for (const PeptideHit& hit : pep_id.getHits())
+        {
+          out.writeString(hit.getSequence().toString());
+          out.writePOD<double>(hit.getScore());
+          out.writeUInt(hit.getRank());
+          out.writeInt(hit.getCharge());
+
+          out.writeUInt(hit.getPeptideEvidences().size());
+          for (const PeptideEvidence& evidence : hit.getPeptideEvidences())
+          {
+            out.writeString(evidence.getProteinAccession());
+            out.writeInt(evidence.getStart());
+            out.writeInt(evidence.getEnd());
+            out.writePOD<char>(evidence.getAABefore());
+            out.writePOD<char>(evidence.getAAAfter());
+          }
+
+          out.writeUInt(hit.getAnalysisResults().size());
+          for (const PeptideHit::PepXMLAnalysisResult& result : hit.getAnalysisResults())
+          {
+            out.writeString(result.score_type);
+            out.writeBool(result.higher_is_better);
+            out.writePOD<double>(result.main_score);
+            out.writeUInt(result.sub_scores.size());
+            for (const auto& sub_score : result.sub_scores)
+            {
+              out.writeString(sub_score.first);
+              out.writePOD<double>(sub_score.second);
+            }
+          }
+
+          out.writeUInt(hit.getPeakAnnotations().size());
+          for (const PeptideHit::PeakAnnotation& annotation : hit.getPeakAnnotations())
+          {
+            out.writeString(annotation.annotation);
+            out.writeInt(annotation.charge);
+            out.writePOD<double>(annotation.mz);
+            out.writePOD<double>(annotation.intensity);
+          }
+          out.writeMetaInfo(hit);
+        }
+        out.writeMetaInfo(pep_id);
+      }
+    }
+
+    void writeBaseFeature(BinaryWriter& out, const BaseFeature& feature)
+    {
+      out.writePOD<double>(feature.getRT());
+      out.writePOD<double>(feature.getMZ());
+      out.writePOD<float>(feature.getIntensity());
+      out.writePOD<UInt64>(feature.getUniqueId());
+      out.writePOD<float>(feature.getQuality());
+      out.writeInt(feature.getCharge());
+      out.writePOD<float>(feature.getWidth());
+      writePeptideIdentifications(out, feature.getPeptideIdentifications());
+      out.writeMetaInfo(feature);
+    }
+
+    void writeFeature(BinaryWriter& out, const Feature& feature)
+    {
+      writeBaseFeature(out, feature);
+      out.writePOD<float>(feature.getQuality(0));
+      out.writePOD<float>(feature.getQuality(1));
+      out.writeUInt(feature.getConvexHulls().size());
+      for (const ConvexHull2D& hull : feature.getConvexHulls())
+      {
+        out.writeUInt(hull.getHullPoints().size());
+        for (const ConvexHull2D::PointType& point : hull.getHullPoints())
+        {
+          out.writePOD<double>(point[0]);
+          out.writePOD<double>(point[1]);
+        }
+      }
+      out.writeUInt(feature.getSubordinates().size());
+      for (const Feature& subordinate : feature.getSubordinates())
+      {
+        writeFeature(out, subordinate);
+      }
+    }
+
+    void writeConsensusFeature(BinaryWriter& out, const ConsensusFeature& feature)
+    {
+      writeBaseFeature(out, feature);
+      out.writeUInt(feature.getFeatures().size());
+      for (const FeatureHandle& handle : feature.getFeatures())
+      {
+        out.writePOD<UInt64>(handle.getMapIndex());
+        out.writePOD<UInt64>(handle.getUniqueId());
+        out.writePOD<double>(handle.getRT());
+        out.writePOD<double>(handle.getMZ());
+        out.writePOD<float>(handle.getIntensity());
+        out.writeInt(handle.getCharge());
+        out.writePOD<float>(handle.getWidth());
+      }
+      const std::vector<ConsensusFeature::Ratio> ratios = feature.getRatios();
+      out.writeUInt(ratios.size());
+      for (const ConsensusFeature::Ratio& ratio : ratios)
+      {
+        out.writePOD<double>(ratio.ratio_value_);
+        out.writeString(ratio.denominator_ref_);
+        out.writeString(ratio.numerator_ref_);
+        out.writeStrings(ratio.description_);
+      }
+    }
+
+    // --- reading ---
+
+    DateTime readDateTime(BinaryReader& in)
+    {
+      DateTime date;
+      if (!in.readBool())
+      {
+        UInt v[6];
+        for (UInt& value : v)
+        {
+          value = static_cast<UInt>(in.readUInt());
+        }
+        date.set(v[0], v[1], v[2], v[3], v[4], v[5]);
+      }
+      return date;
+    }
+
+    void readDataProcessing(BinaryReader& in, DataProcessing& dp)
+    {
+      dp.getSoftware().setName(in.readString());
+      dp.getSoftware().setVersion(in.readString());
+      in.readMetaInfo(dp.getSoftware());
+      const Size n_actions = in.readCount();
+      for (Size i = 0; i < n_actions; ++i)
+      {
+        const UInt64 action = in.readUInt();
+        if (action >= DataProcessing::SIZE_OF_PROCESSINGACTION)
+        {
+          in.fail_();
+        }
+        dp.getProcessingActions().insert(static_cast<DataProcessing::ProcessingAction>(action));
+      }
+      dp.setCompletionTime(readDateTime(in));
+      in.readMetaInfo(dp);
+    }
+
+    void readProteinGroups(BinaryReader& in, std::vector<ProteinIdentification::ProteinGroup>& groups)
+    {
+      groups.resize(in.readCount());
+      for (ProteinIdentification::ProteinGroup& group : groups)
+      {
+        group.probability = in.readPOD<double>();
+        group.accessions = in.readStrings();
+        group.getFloatDataArrays().resize(in.readCount());
+        for (auto& array : group.getFloatDataArrays())
+        {
+          array.setName(in.readString());
+          array.resize(in.readCount());
+          for (float& v : array) v = in.readPOD<float>();
+        }
+        group.getStringDataArrays().resize(in.readCount());
+        for (auto& array : group.getStringDataArrays())
+        {
+          array.setName(in.readString());
+          std::vector<String> values = in.readStrings();
+          array.assign(values.begin(), values.end());
+        }
+        group.getIntegerDataArrays().resize(in.readCount());
+        for (auto& array : group.getIntegerDataArrays())
+        {
+          array.setName(in.readString());
+          array.resize(in.readCount());
+          for (Int& v : array) v = static_cast<Int>(in.readInt());
+        }
+      }
+    }
+
+    void readProteinIdentifications(BinaryReader& in, std::vector<ProteinIdentification>& protein_ids)
+    {
+      protein_ids.resize(in.readCount());
+      for (ProteinIdentification& prot_id : protein_ids)
+      {
+        prot_id.setIdentifier(in.readString());
+        prot_id.setSearchEngine(in.readString());
+        prot_id.setSearchEngineVersion(in.readString());
+        prot_id.setDateTime(readDateTime(in));
+        prot_id.setScoreType(in.readString());
+        prot_id.setHigherScoreBetter(in.readBool());
+        prot_id.setSignificanceThreshold(in.readPOD<double>());
+
+        ProteinIdentification::SearchParameters& params = prot_id.getSearchParameters();
+        params.db = in.readString();
+        params.db_version = in.readString();
+        params.taxonomy = in.readString();
+        params.charges = in.readString();
+        const UInt64 mass_type = in.readUInt();
+        if (mass_type >= ProteinIdentification::SIZE_OF_PEAKMASSTYPE)
+        {
+          in.fail_();
+        }
+        params.mass_type = static_cast<ProteinIdentification::PeakMassType>(mass_type);
+        params.fixed_modifications = in.readStrings();
+        params.variable_modifications = in.readStrings();
+        params.missed_cleavages = static_cast<UInt>(in.readUInt());
+        params.fragment_mass_tolerance = in.readPOD<double>();
+        params.fragment_mass_tolerance_ppm = in.readBool();
+        params.precursor_mass_tolerance = in.readPOD<double>();
+        params.precursor_mass_tolerance_ppm = in.readBool();
+        const String& enzyme = in.readString();
+        if (ProteaseDB::getInstance()->hasEnzyme(enzyme))
+        {
+          params.digestion_enzyme = *(ProteaseDB::getInstance()->getEnzyme(enzyme));
+        }
+        const UInt64 specificity = in.readUInt();
+        if (specificity >= EnzymaticDigestion::SIZE_OF_SPECIFICITY)
+        {
+          in.fail_();
+        }
+        params.enzyme_term_specificity = static_cast<EnzymaticDigestion::Specificity>(specificity);
+        in.readMetaInfo(params);
+
+        std::vector<ProteinHit>& hits = prot_id.getHits();
+        hits.resize(in.readCount());
+        for (ProteinHit& hit : hits)
+        {
+          hit.setScore(in.readPOD<double>());
+          hit.setRank(static_cast<UInt>(in.readUInt()));
+          hit.setAccession(in.readString());
+          hit.setSequence(in.readString());
+          hit.setCoverage(in.readPOD<double>());
+          in.readMetaInfo(hit);
+        }
+        readProteinGroups(in, prot_id.getProteinGroups());
+        readProteinGroups(in, prot_id.getIndistinguishableProteins());
+        in.readMetaInfo(prot_id);
+      }
+    }
+
+    void readPeptideIdentifications(BinaryReader& in, std::vector<PeptideIdentification>& peptide_ids)
+    {
+      peptide_ids.resize(in.readCount());
+      for (PeptideIdentification& pep_id : peptide_ids)
+      {
+        pep_id.setIdentifier(in.readString());
+        pep_id.setScoreType(in.readString());
+        pep_id.setHigherScoreBetter(in.readBool());
+        pep_id.setSignificanceThreshold(in.readPOD<double>());
+        pep_id.setRT(in.readPOD<double>());
+        pep_id.setMZ(in.readPOD<double>());
+        pep_id.setBaseName(in.readString());
+
+        std::vector<PeptideHit>& hits = pep_id.getHits();
+        hits.resize(in.readCount());
+        for (PeptideHit& hit : hits)
+        {
+          hit.setSequence(in.readSequence());
+          hit.setScore(in.readPOD<double>());
+          hit.setRank(static_cast<UInt>(in.readUInt()));
+          hit.setCharge(static_cast<Int>(in.readInt()));
+
+          std::vector<PeptideEvidence> evidences(in.readCount());
+          for (PeptideEvidence& evidence : evidences)
+          {
+            evidence.setProteinAccession(in.readString());
+            evidence.setStart(static_cast<Int>(in.readInt()));
+            evidence.setEnd(static_cast<Int>(in.readInt()));
+            evidence.setAABefore(in.readPOD<char>());
+            evidence.setAAAfter(in.readPOD<char>());
+          }
+          hit.setPeptideEvidences(std::move(evidences));
+
+          const Size n_results = in.readCount();
+          if (n_results > 0)
+          {
+            std::vector<PeptideHit::PepXMLAnalysisResult> results(n_results);
+            for (PeptideHit::PepXMLAnalysisResult& result : results)
+            {
+              result.score_type = in.readString();
+              result.higher_is_better = in.readBool();
+              result.main_score = in.readPOD<double>();
+              const Size n_sub_scores = in.readCount();
+              for (Size i = 0; i < n_sub_scores; ++i)
+              {
+                const String& name = in.readString();
+                result.sub_scores[name] = in.readPOD<double>();
+              }
+            }
+            hit.setAnalysisResults(std::move(results));
+          }
+
+          std::vector<PeptideHit::PeakAnnotation> annotations(in.readCount());
+          for (PeptideHit::PeakAnnotation& annotation : annotations)
+          {
+            annotation.annotation = in.readString();
+            annotation.charge = static_cast<int>(in.readInt());
+            annotation.mz = in.readPOD<double>();
+            annotation.intensity = in.readPOD<double>();
+          }
+          hit.setPeakAnnotations(std::move(annotations));
+          in.readMetaInfo(hit);
+        }
+        in.readMetaInfo(pep_id);
+      }
+    }
+
+    void readBaseFeature(BinaryReader& in, BaseFeature& feature)
+    {
+      feature.setRT(in.readPOD<double>());
+      feature.setMZ(in.readPOD<double>());
+      feature.setIntensity(in.readPOD<float>());
+      feature.setUniqueId(in.readPOD<UInt64>());
+      feature.setQuality(in.readPOD<float>());
+      feature.setCharge(static_cast<Int>(in.readInt()));
+      feature.setWidth(in.readPOD<float>());
+      readPeptideIdentifications(in, feature.getPeptideIdentifications());
+      in.readMetaInfo(feature);
+    }
+
+    void readFeature(BinaryReader& in, Feature& feature)
+    {
+      readBaseFeature(in, feature);
+      feature.setQuality(0, in.readPOD<float>());
+      feature.setQuality(1, in.readPOD<float>());
+      std::vector<ConvexHull2D>& hulls = feature.getConvexHulls();
+      hulls.resize(in.readCount());
+      for (ConvexHull2D& hull : hulls)
+      {
+        ConvexHull2D::PointArrayType points(in.readCount());
+        for (ConvexHull2D::PointType& point : points)
+        {
+          point[0] = in.readPOD<double>();
+          point[1] = in.readPOD<double>();
+        }
+        hull.setHullPoints(points);
+      }
+      feature.getSubordinates().resize(in.readCount());
+      for (Feature& subordinate : feature.getSubordinates())
+      {
+        readFeature(in, subordinate);
+      }
+    }
+
+    void readConsensusFeature(BinaryReader& in, ConsensusFeature& feature)
+    {
+      readBaseFeature(in, feature);
+      ConsensusFeature::HandleSetType handles;
+      const Size n_handles = in.readCount();
+      for (Size i = 0; i < n_handles; ++i)
+      {
+        FeatureHandle handle;
+        handle.setMapIndex(in.readPOD<UInt64>());
+        handle.setUniqueId(in.readPOD<UInt64>());
+        handle.setRT(in.readPOD<double>());
+        handle.setMZ(in.readPOD<double>());
+        handle.setIntensity(in.readPOD<float>());
+        handle.setCharge(static_cast<Int>(in.readInt()));
+        handle.setWidth(in.readPOD<float>());
+        // handles were written in set order
+        handles.emplace_hint(handles.end(), std::move(handle));
+      }
+      feature.setFeatures(std::move(handles));
+      std::vector<ConsensusFeature::Ratio>& ratios = feature.getRatios();
+      ratios.resize(in.readCount());
+      for (ConsensusFeature::Ratio& ratio : ratios)
+      {
+        ratio.ratio_value_ = in.readPOD<double>();
+        ratio.denominator_ref_ = in.readString();
+        ratio.numerator_ref_ = in.readString();
+        ratio.description_ = in.readStrings();
+      }
+    }
+
+    void checkEnd(const BinaryReader& in)
+    {
+      if (!in.atEnd())
+      {
+        in.fail_();
+      }
+    }
+  }
+
+  NativeBinaryFile::NativeBinaryFile() :
+    ProgressLogger(),
+    compress_(false)
+  {
+  }
+
+  NativeBinaryFile::~NativeBinaryFile() = default;
+
+  void NativeBinaryFile::setCompression(bool compress)
+  {
+    compress_ = compress;
+  }
+
+  bool NativeBinaryFile::getCompression() const
+  {
+    return compress_;
+  }
+
+  FileTypes::Type NativeBinaryFile::getContentType(const String& filename)
+  {
+    std::ifstream ifs(filename.c_str(), std::ios::binary);
+    char magic[sizeof(MAGIC)];
+    UInt32 version = 0;
+    std::uint8_t content = 0;
+    ifs.read(magic, sizeof(MAGIC));
+    ifs.read(reinterpret_cast<char*>(&version), sizeof(version));
+    ifs.read(reinterpret_cast<char*>(&content), sizeof(content));
+    if (!ifs || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION)
+    {
+      return FileTypes::UNKNOWN;
+    }
+    return contentType(content);
+  }
+
+  void NativeBinaryFile::write_(const String& filename, FileTypes::Type content_type, const std::string& strings, const std::string& data) const
+  {
+    if (!FileHandler::hasValidExtension(filename, content_type))
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "invalid file extension, expected '" + FileTypes::typeToName(content_type) + "'");
+    }
+
+    std::ofstream ofs(filename.c_str(), std::ios::out | std::ios::binary);
+    if (!ofs)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    const UInt32 version = VERSION;
+    const std::uint8_t content = contentTag(content_type);
+    const std::uint8_t compressed = compress_ ? 1 : 0;
+    ofs.write(MAGIC, sizeof(MAGIC));
+    ofs.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    ofs.write(reinterpret_cast<const char*>(&content), sizeof(content));
+    ofs.write(reinterpret_cast<const char*>(&compressed), sizeof(compressed));
+
+    // each block: uncompressed size, stored size, stored bytes
+    // (compressed: a series of chunks, each its compressed size followed by the zlib data of up to CHUNK_SIZE bytes)
+    for (const std::string* block : {&strings, &data})
+    {
+      const UInt64 size = block->size();
+      std::string compressed_block;
+      const std::string* stored = block;
+      if (compress_)
+      {
+        std::string chunk;
+        for (UInt64 offset = 0; offset < size; offset += CHUNK_SIZE)
+        {
+          const uLong chunk_size = static_cast<uLong>(std::min<UInt64>(CHUNK_SIZE, size - offset));
+          uLongf compressed_size = compressBound(chunk_size);
+          chunk.resize(compressed_size);
+          if (compress2(reinterpret_cast<Bytef*>(&chunk[0]), &compressed_size,
+                        reinterpret_cast<const Bytef*>(block->data() + offset), chunk_size, Z_BEST_SPEED) != Z_OK)
+          {
+            throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "zlib compression failed");
+          }
+          const UInt32 stored_chunk_size = static_cast<UInt32>(compressed_size);
+          compressed_block.append(reinterpret_cast<const char*>(&stored_chunk_size), sizeof(stored_chunk_size));
+          compressed_block.append(chunk.data(), compressed_size);
+        }
+        stored = &compressed_block;
+      }
+      const UInt64 stored_size = stored->size();
+      ofs.write(reinterpret_cast<const char*>(&size), sizeof(size));
+      ofs.write(reinterpret_cast<const char*>(&stored_size), sizeof(stored_size));
+      ofs.write(stored->data(), stored_size);
+    }
+    if (!ofs)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "error while writing");
+    }
+  }
+
+  void NativeBinaryFile::read_(const String& filename, FileTypes::Type content_type, std::string& strings, std::string& data) const
+  {
+    std::ifstream ifs(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!ifs)
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    char magic[sizeof(MAGIC)];
+    UInt32 version = 0;
+    std::uint8_t content = 0;
+    std::uint8_t compressed = 0;
+    ifs.read(magic, sizeof(MAGIC));
+    ifs.read(reinterpret_cast<char*>(&version), sizeof(version));
+    ifs.read(reinterpret_cast<char*>(&content), sizeof(content));
+    ifs.read(reinterpret_cast<char*>(&compressed), sizeof(compressed));
+    if (!ifs || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "not a file in OpenMS binary format");
+    }
+    if (version != VERSION)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename,
+        "file format version " + String(version) + " is not supported (expected version " + String(VERSION) + ")");
+    }
+    if (contentType(content) != content_type)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename,
+        "file contains '" + (contentType(content) != FileTypes::UNKNOWN ? FileTypes::typeToName(contentType(content)) : String("unknown"))
+        + "' data, expected '" + FileTypes::typeToName(content_type) + "'");
+    }
+
+    ifs.seekg(0, std::ios::end);
+    const UInt64 file_size = static_cast<UInt64>(ifs.tellg());
+    ifs.seekg(sizeof(MAGIC) + sizeof(version) + sizeof(content) + sizeof(compressed));
+    for (std::string* block : {&strings, &data})
+    {
+      UInt64 size = 0, stored_size = 0;
+      ifs.read(reinterpret_cast<char*>(&size), sizeof(size));
+      ifs.read(reinterpret_cast<char*>(&stored_size), sizeof(stored_size));
+      if (!ifs || stored_size > file_size || (!compressed && size != stored_size))
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "truncated or corrupt binary data");
+      }
+      std::string stored(stored_size, '\0');
+      ifs.read(&stored[0], stored_size);
+      if (!ifs)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "truncated or corrupt binary data");
+      }
+      if (!compressed)
+      {
+        block->swap(stored);
+        continue;
+      }
+      block->resize(size);
+      UInt64 stored_pos = 0;
+      for (UInt64 offset = 0; offset < size; offset += CHUNK_SIZE)
+      {
+        UInt32 chunk_stored_size = 0;
+        if (stored_size - stored_pos < sizeof(chunk_stored_size))
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "truncated or corrupt binary data");
+        }
+        memcpy(&chunk_stored_size, stored.data() + stored_pos, sizeof(chunk_stored_size));
+        stored_pos += sizeof(chunk_stored_size);
+        if (stored_size - stored_pos < chunk_stored_size)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "truncated or corrupt binary data");
+        }
+        const uLong chunk_size = static_cast<uLong>(std::min<UInt64>(CHUNK_SIZE, size - offset));
+        uLongf uncompressed_size = chunk_size;
+        if (uncompress(reinterpret_cast<Bytef*>(&(*block)[offset]), &uncompressed_size,
+                       reinterpret_cast<const Bytef*>(stored.data() + stored_pos), chunk_stored_size) != Z_OK || uncompressed_size != chunk_size)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "zlib decompression failed");
+        }
+        stored_pos += chunk_stored_size;
+      }
+      if (stored_pos != stored_size)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "truncated or corrupt binary data");
+      }
+    }
+  }
+
+  void NativeBinaryFile::store(const String& filename, const FeatureMap& map)
+  {
+    startProgress(0, map.size(), "storing binary feature map");
+    BinaryWriter out;
+    out.writeString(map.getIdentifier());
+    out.writePOD<UInt64>(map.getUniqueId());
+    writeDataProcessing(out, map.getDataProcessing());
+    writeProteinIdentifications(out, map.getProteinIdentifications());
+    writePeptideIdentifications(out, map.getUnassignedPeptideIdentifications());
+    out.writeMetaInfo(map);
+    out.writeUInt(map.size());
+    for (Size i = 0; i < map.size(); ++i)
+    {
+      setProgress(i);
+      writeFeature(out, map[i]);
+    }
+    write_(filename, FileTypes::FEATUREBIN, out.strings(), out.data());
+    endProgress();
+  }
+
+  void NativeBinaryFile::load(const String& filename, FeatureMap& map)
+  {
+    std::string strings, data;
+    read_(filename, FileTypes::FEATUREBIN, strings, data);
+    BinaryReader in(strings, data, filename);
+
+    map.clear(true);
+    map.setIdentifier(in.readString());
+    map.setUniqueId(in.readPOD<UInt64>());
+    map.getDataProcessing().resize(in.readCount());
+    for (DataProcessing& dp : map.getDataProcessing())
+    {
+      readDataProcessing(in, dp);
+    }
+    readProteinIdentifications(in, map.getProteinIdentifications());
+    readPeptideIdentifications(in, map.getUnassignedPeptideIdentifications());
+    in.readMetaInfo(map);
+    const Size n_features = in.readCount();
+    startProgress(0, n_features, "loading binary feature map");
+    map.resize(n_features);
+    for (Size i = 0; i < n_features; ++i)
+    {
+      setProgress(i);
+      readFeature(in, map[i]);
+    }
+    checkEnd(in);
+    endProgress();
+
+    map.setLoadedFileType(filename);
+    map.setLoadedFilePath(filename);
+    map.updateRanges();
+  }
+
+  void NativeBinaryFile::store(const String& filename, const ConsensusMap& map)
+  {
+    startProgress(0, map.size(), "storing binary consensus map");
+    BinaryWriter out;
+    out.writeString(map.getIdentifier());
+    out.writePOD<UInt64>(map.getUniqueId());
+    out.writeString(map.getExperimentType());
+    out.writeUInt(map.getColumnHeaders().size());
+    for (const auto& header : map.getColumnHeaders())
+    {
+      out.writePOD<UInt64>(header.first);
+      out.writeString(header.second.filename);
+      out.writeString(header.second.label);
+      out.writeUInt(header.second.size);
+      out.writePOD<UInt64>(header.second.unique_id);
+      out.writeMetaInfo(header.second);
+    }
+    writeDataProcessing(out, map.getDataProcessing());
+    writeProteinIdentifications(out, map.getProteinIdentifications());
+    writePeptideIdentifications(out, map.getUnassignedPeptideIdentifications());
+    out.writeMetaInfo(map);
+    out.writeUInt(map.size());
+    for (Size i = 0; i < map.size(); ++i)
+    {
+      setProgress(i);
+      writeConsensusFeature(out, map[i]);
+    }
+    write_(filename, FileTypes::CONSENSUSBIN, out.strings(), out.data());
+    endProgress();
+  }
+
+  void NativeBinaryFile::load(const String& filename, ConsensusMap& map)
+  {
+    std::string strings, data;
+    read_(filename, FileTypes::CONSENSUSBIN, strings, data);
+    BinaryReader in(strings, data, filename);
+
+    map.clear(true);
+    map.setIdentifier(in.readString());
+    map.setUniqueId(in.readPOD<UInt64>());
+    map.setExperimentType(in.readString());
+    const Size n_headers = in.readCount();
+    for (Size i = 0; i < n_headers; ++i)
+    {
+      ConsensusMap::ColumnHeader& header = map.getColumnHeaders()[in.readPOD<UInt64>()];
+      header.filename = in.readString();
+      header.label = in.readString();
+      header.size = in.readUInt();
+      header.unique_id = in.readPOD<UInt64>();
+      in.readMetaInfo(header);
+    }
+    map.getDataProcessing().resize(in.readCount());
+    for (DataProcessing& dp : map.getDataProcessing())
+    {
+      readDataProcessing(in, dp);
+    }
+    readProteinIdentifications(in, map.getProteinIdentifications());
+    readPeptideIdentifications(in, map.getUnassignedPeptideIdentifications());
+    in.readMetaInfo(map);
+    const Size n_features = in.readCount();
+    startProgress(0, n_features, "loading binary consensus map");
+    map.resize(n_features);
+    for (Size i = 0; i < n_features; ++i)
+    {
+      setProgress(i);
+      readConsensusFeature(in, map[i]);
+    }
+    checkEnd(in);
+    endProgress();
+
+    map.setLoadedFileType(filename);
+    map.setLoadedFilePath(filename);
+    map.updateRanges();
+  }
+
+  void NativeBinaryFile::store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids)
+  {
+    BinaryWriter out;
+    writeProteinIdentifications(out, protein_ids);
+    writePeptideIdentifications(out, peptide_ids);
+    write_(filename, FileTypes::IDBIN, out.strings(), out.data());
+  }
+
+  void NativeBinaryFile::load(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids)
+  {
+    std::string strings, data;
+    read_(filename, FileTypes::IDBIN, strings, data);
+    BinaryReader in(strings, data, filename);
+
+    protein_ids.clear();
+    peptide_ids.clear();
+    readProteinIdentifications(in, protein_ids);
+    readPeptideIdentifications(in, peptide_ids);
+    checkEnd(in);
+  }
+
+} // namespace OpenMS
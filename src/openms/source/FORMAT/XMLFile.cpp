@@ -51,6 +51,14 @@
 #include <iomanip> // setprecision etc.
 
 #include <boost/shared_ptr.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cctype>
+#include <cstring>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace std;
 
@@ -79,6 +87,30 @@ private:
       XMLHandler * p_;
     };
 
+    /// Initializes the Xerces-C platform. The call is reference counted but not thread-safe, so it is serialized.
+    void initializeXMLPlatform_()
+    {
+      bool failed = false;
+      String message;
+#pragma omp critical (XMLFile_XMLPlatformUtils)
+      {
+        try
+        {
+          xercesc::XMLPlatformUtils::Initialize();
+        }
+        catch (const xercesc::XMLException & toCatch)
+        {
+          failed = true;
+          message = StringManager().convert(toCatch.getMessage());
+        }
+      }
+      if (failed)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+            "", String("Error during initialization: ") + message);
+      }
+    }
+
     XMLFile::XMLFile()
     {
     }
@@ -112,15 +144,7 @@ private:
       }
 
       // initialize parser
-      try
-      {
-        xercesc::XMLPlatformUtils::Initialize();
-      }
-      catch (const xercesc::XMLException & toCatch)
-      {
-        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-            "", String("Error during initialization: ") + StringManager().convert(toCatch.getMessage()));
-      }
+      initializeXMLPlatform_();
 
       boost::shared_ptr< xercesc::SAX2XMLReader > parser(xercesc::XMLReaderFactory::createXMLReader());
       parser->setFeature(xercesc::XMLUni::fgSAX2CoreNameSpaces, false);
@@ -198,15 +222,7 @@ private:
       StringManager sm;
 
       // initialize parser
-      try
-      {
-        xercesc::XMLPlatformUtils::Initialize();
-      }
-      catch (const xercesc::XMLException & toCatch)
-      {
-        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-            "", String("Error during initialization: ") + StringManager().convert(toCatch.getMessage()));
-      }
+      initializeXMLPlatform_();
 
       boost::shared_ptr< xercesc::SAX2XMLReader > parser(xercesc::XMLReaderFactory::createXMLReader());
       parser->setFeature(xercesc::XMLUni::fgSAX2CoreNameSpaces, false);
@@ -257,6 +273,281 @@ private:
       }
     }
 
+    bool XMLFile::scanElementLists_(const char* data, Size size, const String& list_tag, const String& element_tag, std::vector<ElementList>& lists)
+    {
+      lists.clear();
+
+      // skip UTF-8 byte order mark; anything else that does not start with markup is not ASCII-compatible (e.g. UTF-16)
+      Size pos = 0;
+      if (size >= 3 && memcmp(data, "\xEF\xBB\xBF", 3) == 0)
+      {
+        pos = 3;
+      }
+      while (pos < size && isspace(static_cast<unsigned char>(data[pos])))
+      {
+        ++pos;
+      }
+      if (pos >= size || data[pos] != '<')
+      {
+        return false;
+      }
+
+      // returns the offset after the first occurrence of 'pattern' at or after 'from' (or 'size' if there is none)
+      auto skip_past = [&data, &size](Size from, const char* pattern)
+      {
+        const Size length = strlen(pattern);
+        for (Size i = from; i + length <= size; ++i)
+        {
+          if (memcmp(data + i, pattern, length) == 0)
+          {
+            return i + length;
+          }
+        }
+        return size;
+      };
+
+      std::vector<std::string> open_tags;
+      Size list_depth = 0; // number of open tags including the current list (0: not inside a list)
+      ElementList current;
+      while (pos < size)
+      {
+        const char* next = static_cast<const char*>(memchr(data + pos, '<', size - pos));
+        if (next == nullptr)
+        {
+          break;
+        }
+        const Size tag_begin = next - data;
+        if (tag_begin + 1 >= size)
+        {
+          return false;
+        }
+        const char first = data[tag_begin + 1];
+        if (first == '?') // processing instruction or XML declaration
+        {
+          pos = skip_past(tag_begin + 2, "?>");
+          continue;
+        }
+        if (first == '!')
+        {
+          if (size - tag_begin >= 4 && memcmp(data + tag_begin, "<!--", 4) == 0)
+          {
+            pos = skip_past(tag_begin + 4, "-->");
+            continue;
+          }
+          if (size - tag_begin >= 9 && memcmp(data + tag_begin, "<![CDATA[", 9) == 0)
+          {
+            pos = skip_past(tag_begin + 9, "]]>");
+            continue;
+          }
+          return false; // document type declaration (might define entities or default attributes)
+        }
+
+        // find the end of the tag (a '>' may occur in attribute values)
+        Size tag_end = tag_begin + 1;
+        char quote = 0;
+        for (; tag_end < size; ++tag_end)
+        {
+          const char c = data[tag_end];
+          if (quote != 0)
+          {
+            if (c == quote) quote = 0;
+          }
+          else if (c == '"' || c == '\'')
+          {
+            quote = c;
+          }
+          else if (c == '>')
+          {
+            break;
+          }
+        }
+        if (tag_end >= size)
+        {
+          return false;
+        }
+        const bool closing = (first == '/');
+        const bool empty = !closing && data[tag_end - 1] == '/';
+        Size name_end = tag_begin + (closing ? 2 : 1);
+        const Size name_begin = name_end;
+        while (name_end < tag_end && data[name_end] != '/' && !isspace(static_cast<unsigned char>(data[name_end])))
+        {
+          ++name_end;
+        }
+        const std::string name(data + name_begin, data + name_end);
+        pos = tag_end + 1;
+
+        if (closing)
+        {
+          if (open_tags.empty() || open_tags.back() != name)
+          {
+            return false;
+          }
+          if (list_depth == open_tags.size())
+          {
+            current.content_end = tag_begin;
+            lists.push_back(std::move(current));
+            current = ElementList();
+            list_depth = 0;
+          }
+          open_tags.pop_back();
+          continue;
+        }
+
+        if (list_depth != 0 && list_depth == open_tags.size()) // direct child of the current list
+        {
+          if (name == element_tag)
+          {
+            current.element_begin.push_back(tag_begin);
+          }
+          else if (!current.element_begin.empty())
+          {
+            return false;
+          }
+          else
+          {
+            current.head_tags.push_back(name);
+          }
+        }
+        if (list_depth == 0 && name == list_tag)
+        {
+          current.content_begin = pos;
+          if (empty)
+          {
+            current.content_end = pos;
+            lists.push_back(std::move(current));
+            current = ElementList();
+          }
+          else
+          {
+            list_depth = open_tags.size() + 1;
+          }
+        }
+        if (!empty)
+        {
+          open_tags.push_back(name);
+        }
+      }
+      return open_tags.empty();
+    }
+
+    bool XMLFile::splitDocument_(const String& filename, const String& list_tag, const String& element_tag, String& skeleton,
+                                 std::vector<std::string>& chunks, std::vector<Size>& chunk_list, std::vector<ElementList>& lists)
+    {
+      // smaller files are parsed faster than they are split
+      const Size min_file_size = 4 * 1024 * 1024;
+      // chunks per thread (for load balancing)
+      const Size chunks_per_thread = 4;
+
+      skeleton.clear();
+      chunks.clear();
+      chunk_list.clear();
+      lists.clear();
+
+#ifdef _OPENMP
+      const Size threads = omp_get_max_threads();
+#else
+      const Size threads = 1;
+#endif
+      if (threads < 2 || !File::exists(filename) || !File::readable(filename))
+      {
+        return false;
+      }
+
+      boost::iostreams::mapped_file_source file;
+      try
+      {
+        file.open(filename);
+      }
+      catch (const std::exception&)
+      {
+        return false;
+      }
+      const char* data = file.data();
+      const Size size = file.size();
+      if (size < min_file_size)
+      {
+        return false;
+      }
+      // compressed files (bzip2 or gzip) are not split
+      if ((data[0] == 'B' && data[1] == 'Z') || (data[0] == '\x1f' && data[1] == '\x8b'))
+      {
+        return false;
+      }
+      if (!scanElementLists_(data, size, list_tag, element_tag, lists))
+      {
+        lists.clear();
+        return false;
+      }
+
+      // distribute the list children evenly over the chunks; chunks do not span lists
+      Size chunk_bytes = 0;
+      for (const ElementList& list : lists)
+      {
+        if (!list.element_begin.empty())
+        {
+          chunk_bytes += list.content_end - list.element_begin.front();
+        }
+      }
+      chunk_bytes = std::max(chunk_bytes / (threads * chunks_per_thread), Size(1));
+
+      // chunks keep the XML declaration (and thereby the encoding) of the file
+      String declaration;
+      Size decl_begin = 0;
+      while (decl_begin < size && data[decl_begin] != '<')
+      {
+        ++decl_begin;
+      }
+      if (size - decl_begin > 5 && memcmp(data + decl_begin, "<?xml", 5) == 0)
+      {
+        const std::string head(data + decl_begin, std::min(size - decl_begin, Size(1024)));
+        const Size decl_end = head.find("?>");
+        if (decl_end != std::string::npos)
+        {
+          declaration = head.substr(0, decl_end + 2);
+        }
+      }
+
+      Size skeleton_pos = 0;
+      for (Size l = 0; l < lists.size(); ++l)
+      {
+        const ElementList& list = lists[l];
+        if (list.element_begin.empty())
+        {
+          continue;
+        }
+        skeleton.append(data + skeleton_pos, data + list.element_begin.front());
+        skeleton_pos = list.content_end;
+
+        Size chunk_begin = list.element_begin.front();
+        for (Size e = 1; e <= list.element_begin.size(); ++e)
+        {
+          const Size chunk_end = (e == list.element_begin.size()) ? list.content_end : list.element_begin[e];
+          if (chunk_end - chunk_begin >= chunk_bytes || e == list.element_begin.size())
+          {
+            std::string chunk;
+            chunk.reserve(declaration.size() + (chunk_end - chunk_begin) + 32);
+            chunk.append(declaration).append("<XMLFileChunk>");
+            chunk.append(data + chunk_begin, data + chunk_end);
+            chunk.append("</XMLFileChunk>");
+            chunks.push_back(std::move(chunk));
+            chunk_list.push_back(l);
+            chunk_begin = chunk_end;
+          }
+        }
+      }
+      skeleton.append(data + skeleton_pos, data + size);
+
+      if (chunks.size() < 2)
+      {
+        skeleton.clear();
+        chunks.clear();
+        chunk_list.clear();
+        lists.clear();
+        return false;
+      }
+      return true;
+    }
+
     void XMLFile::save_(const String & filename, XMLHandler * handler) const
     {
       // open file in binary mode to avoid any line ending conversions
@@ -53,6 +53,7 @@ MzQuantMLFile.cpp
 MzTab.cpp
 MzTabFile.cpp
 MzXMLFile.cpp
+NativeBinaryFile.cpp
 OMSSACSVFile.cpp
 OMSSAXMLFile.cpp
 OSWFile.cpp
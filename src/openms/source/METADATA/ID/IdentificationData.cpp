@@ -784,4 +784,22 @@ namespace OpenMS
     }
   }
 
+
+  void IdentificationData::clearMatchData()
+  {
+    // clear in order of dependencies (referencing elements first):
+    query_match_groups_.clear();
+    query_matches_.clear();
+    identified_peptides_.clear();
+    identified_compounds_.clear();
+    identified_oligos_.clear();
+    data_queries_.clear();
+
+    query_match_lookup_.clear();
+    identified_peptide_lookup_.clear();
+    identified_compound_lookup_.clear();
+    identified_oligo_lookup_.clear();
+    data_query_lookup_.clear();
+  }
+
 } // end namespace OpenMS
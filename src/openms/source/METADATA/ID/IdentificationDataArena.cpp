@@ -0,0 +1,794 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hendrik Weisser $
+// $Authors: Hendrik Weisser $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/METADATA/ID/IdentificationDataArena.h>
+
+#include <cmath>
+#include <exception>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace std;
+
+namespace OpenMS
+{
+  using ID = IdentificationData;
+
+  constexpr IdentificationDataArena::Handle IdentificationDataArena::NO_HANDLE;
+
+
+  void IdentificationDataArena::ScoreTable_::resize(Size n_rows)
+  {
+    for (StepColumns_& step : steps)
+    {
+      step.applied.resize(n_rows, 0);
+      for (auto& score_pair : step.scores)
+      {
+        score_pair.second.resize(n_rows,
+                                 numeric_limits<double>::quiet_NaN());
+      }
+    }
+    rows = n_rows;
+  }
+
+
+  IdentificationDataArena::StepColumns_&
+  IdentificationDataArena::ScoreTable_::getStep(const StepOpt& step_opt)
+  {
+    for (StepColumns_& step : steps)
+    {
+      if (step.step_opt == step_opt) return step;
+    }
+    steps.emplace_back();
+    steps.back().step_opt = step_opt;
+    steps.back().applied.resize(rows, 0);
+    return steps.back();
+  }
+
+
+  vector<double>& IdentificationDataArena::ScoreTable_::getColumn(
+    StepColumns_& step, ScoreTypeRef score_ref)
+  {
+    for (auto& score_pair : step.scores)
+    {
+      if (score_pair.first == score_ref) return score_pair.second;
+    }
+    step.scores.emplace_back(
+      score_ref, vector<double>(rows, numeric_limits<double>::quiet_NaN()));
+    return step.scores.back().second;
+  }
+
+
+  const vector<double>* IdentificationDataArena::ScoreTable_::findColumn(
+    ScoreTypeRef score_ref, const StepOpt& step_opt) const
+  {
+    for (const StepColumns_& step : steps)
+    {
+      if (step.step_opt != step_opt) continue;
+      for (const auto& score_pair : step.scores)
+      {
+        if (score_pair.first == score_ref) return &score_pair.second;
+      }
+    }
+    return nullptr;
+  }
+
+
+  void IdentificationDataArena::ScoreTable_::setScore(
+    Size row, ScoreTypeRef score_ref, double value, const StepOpt& step_opt)
+  {
+    StepColumns_& step = getStep(step_opt);
+    step.applied[row] = 1;
+    getColumn(step, score_ref)[row] = value;
+  }
+
+
+  pair<double, bool> IdentificationDataArena::ScoreTable_::getScore(
+    Size row, ScoreTypeRef score_ref) const
+  {
+    // give priority to scores from later processing steps:
+    for (auto it = steps.rbegin(); it != steps.rend(); ++it)
+    {
+      if (!it->applied[row]) continue;
+      for (const auto& score_pair : it->scores)
+      {
+        if ((score_pair.first == score_ref) &&
+            !std::isnan(score_pair.second[row]))
+        {
+          return make_pair(score_pair.second[row], true);
+        }
+      }
+    }
+    return make_pair(numeric_limits<double>::quiet_NaN(), false);
+  }
+
+
+  void IdentificationDataArena::ScoreTable_::importSteps(
+    Size row, const ID::AppliedProcessingSteps& steps_and_scores)
+  {
+    for (const ID::AppliedProcessingStep& applied : steps_and_scores)
+    {
+      StepColumns_& step = getStep(applied.processing_step_opt);
+      step.applied[row] = 1;
+      for (const auto& score_pair : applied.scores)
+      {
+        getColumn(step, score_pair.first)[row] = score_pair.second;
+      }
+    }
+  }
+
+
+  void IdentificationDataArena::ScoreTable_::exportSteps(
+    Size row, IdentificationDataInternal::ScoredProcessingResult& result) const
+  {
+    for (const StepColumns_& step : steps)
+    {
+      if (!step.applied[row]) continue;
+      ID::AppliedProcessingStep applied(step.step_opt);
+      for (const auto& score_pair : step.scores)
+      {
+        if (!std::isnan(score_pair.second[row]))
+        {
+          applied.scores[score_pair.first] = score_pair.second[row];
+        }
+      }
+      result.addProcessingStep(applied);
+    }
+  }
+
+
+  IdentificationDataArena::IdentificationDataArena(IdentificationData& id_data):
+    id_data_(id_data)
+  {
+  }
+
+
+  IdentificationData& IdentificationDataArena::getIdentificationData()
+  {
+    return id_data_;
+  }
+
+
+  void IdentificationDataArena::clear()
+  {
+    string_lookup_.clear();
+    strings_.clear();
+
+    query_ids_.clear();
+    query_files_.clear();
+    query_rts_.clear();
+    query_mzs_.clear();
+    query_meta_.clear();
+    query_lookup_.clear();
+
+    molecule_types_.clear();
+    molecule_keys_.clear();
+    molecule_meta_.clear();
+    molecule_scores_ = ScoreTable_();
+    molecule_lookup_.clear();
+    parent_matches_.clear();
+    compounds_.clear();
+
+    match_queries_.clear();
+    match_molecules_.clear();
+    match_charges_.clear();
+    match_meta_.clear();
+    match_scores_ = ScoreTable_();
+    peak_annotations_.clear();
+  }
+
+
+  void IdentificationDataArena::reserve(Size n_queries, Size n_molecules,
+                                        Size n_matches)
+  {
+    query_ids_.reserve(n_queries);
+    query_files_.reserve(n_queries);
+    query_rts_.reserve(n_queries);
+    query_mzs_.reserve(n_queries);
+    query_meta_.reserve(n_queries);
+    query_lookup_.reserve(n_queries);
+
+    molecule_types_.reserve(n_molecules);
+    molecule_keys_.reserve(n_molecules);
+    molecule_meta_.reserve(n_molecules);
+    molecule_lookup_.reserve(n_molecules);
+
+    match_queries_.reserve(n_matches);
+    match_molecules_.reserve(n_matches);
+    match_charges_.reserve(n_matches);
+    match_meta_.reserve(n_matches);
+  }
+
+
+  void IdentificationDataArena::checkHandle_(Size handle, Size size)
+  {
+    if (handle >= size)
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__,
+                                     OPENMS_PRETTY_FUNCTION, handle, size);
+    }
+  }
+
+
+  IdentificationDataArena::Handle
+  IdentificationDataArena::internString(const String& str)
+  {
+    auto result = string_lookup_.emplace(str, Handle(strings_.size()));
+    if (result.second) // new string
+    {
+      // unordered_map guarantees stable addresses of its elements:
+      strings_.push_back(&result.first->first);
+    }
+    return result.first->second;
+  }
+
+
+  const String& IdentificationDataArena::getString(Handle handle) const
+  {
+    checkHandle_(handle, strings_.size());
+    return *strings_[handle];
+  }
+
+
+  Size IdentificationDataArena::getNumberOfStrings() const
+  {
+    return strings_.size();
+  }
+
+
+  IdentificationDataArena::Handle IdentificationDataArena::addDataQuery(
+    const String& data_id,
+    const boost::optional<ID::InputFileRef>& input_file_opt, double rt,
+    double mz)
+  {
+    if (data_id.empty())
+    {
+      String msg = "missing identifier in data query";
+      throw Exception::IllegalArgument(__FILE__, __LINE__,
+                                       OPENMS_PRETTY_FUNCTION, msg);
+    }
+    Handle id_handle = internString(data_id);
+    Handle file_handle = input_file_opt ? internString(**input_file_opt) :
+      NO_HANDLE;
+    UInt64 key = (UInt64(file_handle) << 32) | id_handle;
+    auto result = query_lookup_.emplace(key, Handle(query_ids_.size()));
+    if (result.second) // new query
+    {
+      query_ids_.push_back(id_handle);
+      query_files_.push_back(file_handle);
+      query_rts_.push_back(rt);
+      query_mzs_.push_back(mz);
+      query_meta_.emplace_back();
+    }
+    return result.first->second;
+  }
+
+
+  Size IdentificationDataArena::getNumberOfDataQueries() const
+  {
+    return query_ids_.size();
+  }
+
+
+  const String& IdentificationDataArena::getDataQueryID(Handle query) const
+  {
+    checkHandle_(query, query_ids_.size());
+    return *strings_[query_ids_[query]];
+  }
+
+
+  double IdentificationDataArena::getDataQueryRT(Handle query) const
+  {
+    checkHandle_(query, query_rts_.size());
+    return query_rts_[query];
+  }
+
+
+  double IdentificationDataArena::getDataQueryMZ(Handle query) const
+  {
+    checkHandle_(query, query_mzs_.size());
+    return query_mzs_[query];
+  }
+
+
+  MetaInfoInterface& IdentificationDataArena::getDataQueryMetaInfo(
+    Handle query)
+  {
+    checkHandle_(query, query_meta_.size());
+    return query_meta_[query];
+  }
+
+
+  IdentificationDataArena::Handle IdentificationDataArena::addMolecule_(
+    MoleculeType type, const String& key)
+  {
+    Handle key_handle = internString(key);
+    UInt64 lookup_key = (UInt64(type) << 32) | key_handle;
+    auto result = molecule_lookup_.emplace(lookup_key,
+                                           Handle(molecule_types_.size()));
+    if (result.second) // new molecule
+    {
+      molecule_types_.push_back(std::uint8_t(type));
+      molecule_keys_.push_back(key_handle);
+      molecule_meta_.emplace_back();
+      molecule_scores_.resize(molecule_types_.size());
+    }
+    return result.first->second;
+  }
+
+
+  IdentificationDataArena::Handle
+  IdentificationDataArena::addIdentifiedPeptide(const AASequence& sequence)
+  {
+    if (sequence.empty())
+    {
+      String msg = "missing sequence for peptide";
+      throw Exception::IllegalArgument(__FILE__, __LINE__,
+                                       OPENMS_PRETTY_FUNCTION, msg);
+    }
+    return addMolecule_(MoleculeType::PROTEIN, sequence.toString());
+  }
+
+
+  IdentificationDataArena::Handle
+  IdentificationDataArena::addIdentifiedOligo(const NASequence& sequence)
+  {
+    if (sequence.empty())
+    {
+      String msg = "missing sequence for oligonucleotide";
+      throw Exception::IllegalArgument(__FILE__, __LINE__,
+                                       OPENMS_PRETTY_FUNCTION, msg);
+    }
+    return addMolecule_(MoleculeType::RNA, sequence.toString());
+  }
+
+
+  IdentificationDataArena::Handle
+  IdentificationDataArena::addIdentifiedCompound(
+    const ID::IdentifiedCompound& compound)
+  {
+    if (compound.identifier.empty())
+    {
+      String msg = "missing identifier for compound";
+      throw Exception::IllegalArgument(__FILE__, __LINE__,
+                                       OPENMS_PRETTY_FUNCTION, msg);
+    }
+    Handle handle = addMolecule_(MoleculeType::COMPOUND, compound.identifier);
+    if (!compounds_.count(handle))
+    {
+      // store only the descriptive fields - scores/meta info go elsewhere:
+      ID::IdentifiedCompound details(compound.identifier, compound.formula,
+                                     compound.name, compound.smile,
+                                     compound.inchi);
+      compounds_.emplace(handle, details);
+    }
+    return handle;
+  }
+
+
+  Size IdentificationDataArena::getNumberOfIdentifiedMolecules() const
+  {
+    return molecule_types_.size();
+  }
+
+
+  IdentificationDataArena::MoleculeType
+  IdentificationDataArena::getMoleculeType(Handle molecule) const
+  {
+    checkHandle_(molecule, molecule_types_.size());
+    return MoleculeType(molecule_types_[molecule]);
+  }
+
+
+  const String& IdentificationDataArena::getMoleculeKey(Handle molecule) const
+  {
+    checkHandle_(molecule, molecule_keys_.size());
+    return *strings_[molecule_keys_[molecule]];
+  }
+
+
+  void IdentificationDataArena::addParentMatch(
+    Handle molecule, ID::ParentMoleculeRef parent_ref,
+    const ID::MoleculeParentMatch& match)
+  {
+    checkHandle_(molecule, molecule_types_.size());
+    if (parent_ref->molecule_type != getMoleculeType(molecule))
+    {
+      String msg = "type of parent molecule doesn't match identified molecule";
+      throw Exception::IllegalArgument(__FILE__, __LINE__,
+                                       OPENMS_PRETTY_FUNCTION, msg);
+    }
+    parent_matches_[molecule][parent_ref].insert(match);
+  }
+
+
+  void IdentificationDataArena::setMoleculeScore(
+    Handle molecule, ScoreTypeRef score_ref, double value,
+    const StepOpt& step_opt)
+  {
+    checkHandle_(molecule, molecule_types_.size());
+    molecule_scores_.setScore(molecule, score_ref, value, step_opt);
+  }
+
+
+  pair<double, bool> IdentificationDataArena::getMoleculeScore(
+    Handle molecule, ScoreTypeRef score_ref) const
+  {
+    checkHandle_(molecule, molecule_types_.size());
+    return molecule_scores_.getScore(molecule, score_ref);
+  }
+
+
+  MetaInfoInterface& IdentificationDataArena::getMoleculeMetaInfo(
+    Handle molecule)
+  {
+    checkHandle_(molecule, molecule_meta_.size());
+    return molecule_meta_[molecule];
+  }
+
+
+  IdentificationDataArena::Handle IdentificationDataArena::addQueryMatch(
+    Handle query, Handle molecule, Int charge)
+  {
+    return addQueryMatches(vector<Handle>(1, query),
+                           vector<Handle>(1, molecule), vector<Int>(1, charge));
+  }
+
+
+  IdentificationDataArena::Handle IdentificationDataArena::addQueryMatches(
+    const vector<Handle>& queries, const vector<Handle>& molecules,
+    const vector<Int>& charges)
+  {
+    if ((queries.size() != molecules.size()) ||
+        (queries.size() != charges.size()))
+    {
+      String msg = "input vectors must have the same size";
+      throw Exception::IllegalArgument(__FILE__, __LINE__,
+                                       OPENMS_PRETTY_FUNCTION, msg);
+    }
+    // check everything before changing anything:
+    for (Size i = 0; i < queries.size(); ++i)
+    {
+      checkHandle_(queries[i], query_ids_.size());
+      checkHandle_(molecules[i], molecule_types_.size());
+    }
+    Size first = match_queries_.size();
+    if (first + queries.size() >= NO_HANDLE)
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__,
+                                     OPENMS_PRETTY_FUNCTION,
+                                     first + queries.size(), NO_HANDLE);
+    }
+    match_queries_.insert(match_queries_.end(), queries.begin(),
+                          queries.end());
+    match_molecules_.insert(match_molecules_.end(), molecules.begin(),
+                            molecules.end());
+    match_charges_.insert(match_charges_.end(), charges.begin(),
+                          charges.end());
+    match_meta_.resize(match_queries_.size());
+    match_scores_.resize(match_queries_.size());
+    return Handle(first);
+  }
+
+
+  Size IdentificationDataArena::getNumberOfQueryMatches() const
+  {
+    return match_queries_.size();
+  }
+
+
+  IdentificationDataArena::Handle
+  IdentificationDataArena::getMatchQuery(Handle match) const
+  {
+    checkHandle_(match, match_queries_.size());
+    return match_queries_[match];
+  }
+
+
+  IdentificationDataArena::Handle
+  IdentificationDataArena::getMatchMolecule(Handle match) const
+  {
+    checkHandle_(match, match_molecules_.size());
+    return match_molecules_[match];
+  }
+
+
+  Int IdentificationDataArena::getMatchCharge(Handle match) const
+  {
+    checkHandle_(match, match_charges_.size());
+    return match_charges_[match];
+  }
+
+
+  MetaInfoInterface& IdentificationDataArena::getMatchMetaInfo(Handle match)
+  {
+    checkHandle_(match, match_meta_.size());
+    return match_meta_[match];
+  }
+
+
+  void IdentificationDataArena::addProcessingStep(Handle match,
+                                                  ProcessingStepRef step_ref)
+  {
+    checkHandle_(match, match_queries_.size());
+    match_scores_.getStep(step_ref).applied[match] = 1;
+  }
+
+
+  void IdentificationDataArena::setScore(Handle match, ScoreTypeRef score_ref,
+                                         double value, const StepOpt& step_opt)
+  {
+    checkHandle_(match, match_queries_.size());
+    match_scores_.setScore(match, score_ref, value, step_opt);
+  }
+
+
+  void IdentificationDataArena::setScores(ScoreTypeRef score_ref,
+                                          const vector<double>& values,
+                                          const StepOpt& step_opt,
+                                          Handle first_match)
+  {
+    if (values.empty()) return;
+    checkHandle_(first_match + values.size() - 1, match_queries_.size());
+    StepColumns_& step = match_scores_.getStep(step_opt);
+    vector<double>& column = match_scores_.getColumn(step, score_ref);
+    copy(values.begin(), values.end(), column.begin() + first_match);
+    fill(step.applied.begin() + first_match,
+         step.applied.begin() + first_match + values.size(), 1);
+  }
+
+
+  pair<double, bool> IdentificationDataArena::getScore(
+    Handle match, ScoreTypeRef score_ref) const
+  {
+    checkHandle_(match, match_queries_.size());
+    return match_scores_.getScore(match, score_ref);
+  }
+
+
+  const vector<double>& IdentificationDataArena::getScoreColumn(
+    ScoreTypeRef score_ref, const StepOpt& step_opt) const
+  {
+    const vector<double>* column = match_scores_.findColumn(score_ref,
+                                                            step_opt);
+    if (!column)
+    {
+      throw Exception::ElementNotFound(__FILE__, __LINE__,
+                                       OPENMS_PRETTY_FUNCTION,
+                                       score_ref->cv_term.getName());
+    }
+    return *column;
+  }
+
+
+  void IdentificationDataArena::transformScores(
+    ScoreTypeRef source_ref, ScoreTypeRef target_ref,
+    const function<double(double)>& transform, const StepOpt& step_opt)
+  {
+    // create the target column up-front, so the loop doesn't modify the table
+    // structure (references to columns stay valid):
+    StepColumns_& step = match_scores_.getStep(step_opt);
+    vector<double>& target = match_scores_.getColumn(step, target_ref);
+    const ScoreTable_& table = match_scores_;
+
+    std::exception_ptr error;
+#pragma omp parallel for schedule(static)
+    for (SignedSize i = 0; i < SignedSize(match_queries_.size()); ++i)
+    {
+      try
+      {
+        pair<double, bool> source = table.getScore(i, source_ref);
+        if (!source.second) continue;
+        target[i] = transform(source.first);
+        step.applied[i] = 1;
+      }
+      catch (...)
+      {
+#pragma omp critical (IdentificationDataArena_error)
+        if (!error) error = std::current_exception();
+      }
+    }
+    if (error) std::rethrow_exception(error);
+  }
+
+
+  void IdentificationDataArena::importFrom(bool clear_source)
+  {
+    clear();
+    reserve(id_data_.getDataQueries().size(),
+            id_data_.getIdentifiedPeptides().size() +
+            id_data_.getIdentifiedCompounds().size() +
+            id_data_.getIdentifiedOligos().size(),
+            id_data_.getMoleculeQueryMatches().size());
+
+    // element addresses -> arena handles:
+    unordered_map<uintptr_t, Handle> query_handles, molecule_handles;
+
+    for (const ID::DataQuery& query : id_data_.getDataQueries())
+    {
+      Handle handle = addDataQuery(query.data_id, query.input_file_opt,
+                                   query.rt, query.mz);
+      query_meta_[handle] = query;
+      query_handles[uintptr_t(&query)] = handle;
+    }
+
+    for (const ID::IdentifiedPeptide& peptide :
+           id_data_.getIdentifiedPeptides())
+    {
+      Handle handle = addIdentifiedPeptide(peptide.sequence);
+      if (!peptide.parent_matches.empty())
+      {
+        parent_matches_[handle] = peptide.parent_matches;
+      }
+      molecule_scores_.importSteps(handle, peptide.steps_and_scores);
+      molecule_meta_[handle] = peptide;
+      molecule_handles[uintptr_t(&peptide)] = handle;
+    }
+    for (const ID::IdentifiedCompound& compound :
+           id_data_.getIdentifiedCompounds())
+    {
+      Handle handle = addIdentifiedCompound(compound);
+      molecule_scores_.importSteps(handle, compound.steps_and_scores);
+      molecule_meta_[handle] = compound;
+      molecule_handles[uintptr_t(&compound)] = handle;
+    }
+    for (const ID::IdentifiedOligo& oligo : id_data_.getIdentifiedOligos())
+    {
+      Handle handle = addIdentifiedOligo(oligo.sequence);
+      if (!oligo.parent_matches.empty())
+      {
+        parent_matches_[handle] = oligo.parent_matches;
+      }
+      molecule_scores_.importSteps(handle, oligo.steps_and_scores);
+      molecule_meta_[handle] = oligo;
+      molecule_handles[uintptr_t(&oligo)] = handle;
+    }
+
+    for (const ID::MoleculeQueryMatch& match :
+           id_data_.getMoleculeQueryMatches())
+    {
+      uintptr_t molecule_address = 0;
+      switch (match.getMoleculeType())
+      {
+      case MoleculeType::PROTEIN:
+        molecule_address = match.getIdentifiedPeptideRef();
+        break;
+      case MoleculeType::COMPOUND:
+        molecule_address = match.getIdentifiedCompoundRef();
+        break;
+      case MoleculeType::RNA:
+        molecule_address = match.getIdentifiedOligoRef();
+        break;
+      default:
+        break;
+      }
+      Handle handle = addQueryMatch(query_handles[match.data_query_ref],
+                                    molecule_handles[molecule_address],
+                                    match.charge);
+      match_scores_.importSteps(handle, match.steps_and_scores);
+      match_meta_[handle] = match;
+      if (!match.peak_annotations.empty())
+      {
+        peak_annotations_[handle] = match.peak_annotations;
+      }
+    }
+
+    if (clear_source) id_data_.clearMatchData();
+  }
+
+
+  void IdentificationDataArena::exportTo() const
+  {
+    // don't let a "current" processing step interfere:
+    ID::ProcessingStepRef current_step = id_data_.getCurrentProcessingStep();
+    bool has_current_step =
+      (current_step != id_data_.getDataProcessingSteps().end());
+    id_data_.clearCurrentProcessingStep();
+
+    vector<ID::DataQueryRef> query_refs;
+    query_refs.reserve(query_ids_.size());
+    for (Size i = 0; i < query_ids_.size(); ++i)
+    {
+      boost::optional<ID::InputFileRef> file_opt;
+      if (query_files_[i] != NO_HANDLE)
+      {
+        file_opt = id_data_.registerInputFile(*strings_[query_files_[i]]);
+      }
+      ID::DataQuery query(*strings_[query_ids_[i]], file_opt, query_rts_[i],
+                          query_mzs_[i]);
+      static_cast<MetaInfoInterface&>(query) = query_meta_[i];
+      query_refs.push_back(id_data_.registerDataQuery(query));
+    }
+
+    vector<ID::IdentifiedMoleculeRef> molecule_refs;
+    molecule_refs.reserve(molecule_types_.size());
+    for (Size i = 0; i < molecule_types_.size(); ++i)
+    {
+      const String& key = *strings_[molecule_keys_[i]];
+      auto parent_pos = parent_matches_.find(Handle(i));
+      ID::ParentMatches parent_matches;
+      if (parent_pos != parent_matches_.end())
+      {
+        parent_matches = parent_pos->second;
+      }
+      switch (MoleculeType(molecule_types_[i]))
+      {
+      case MoleculeType::PROTEIN:
+      {
+        ID::IdentifiedPeptide peptide(AASequence::fromString(key),
+                                      parent_matches);
+        molecule_scores_.exportSteps(i, peptide);
+        static_cast<MetaInfoInterface&>(peptide) = molecule_meta_[i];
+        molecule_refs.push_back(id_data_.registerIdentifiedPeptide(peptide));
+      }
+      break;
+      case MoleculeType::COMPOUND:
+      {
+        ID::IdentifiedCompound compound = compounds_.at(Handle(i));
+        molecule_scores_.exportSteps(i, compound);
+        static_cast<MetaInfoInterface&>(compound) = molecule_meta_[i];
+        molecule_refs.push_back(id_data_.registerIdentifiedCompound(compound));
+      }
+      break;
+      default: // RNA
+      {
+        ID::IdentifiedOligo oligo(NASequence::fromString(key), parent_matches);
+        molecule_scores_.exportSteps(i, oligo);
+        static_cast<MetaInfoInterface&>(oligo) = molecule_meta_[i];
+        molecule_refs.push_back(id_data_.registerIdentifiedOligo(oligo));
+      }
+      }
+    }
+
+    for (Size i = 0; i < match_queries_.size(); ++i)
+    {
+      ID::MoleculeQueryMatch match(molecule_refs[match_molecules_[i]],
+                                   query_refs[match_queries_[i]],
+                                   match_charges_[i]);
+      match_scores_.exportSteps(i, match);
+      static_cast<MetaInfoInterface&>(match) = match_meta_[i];
+      auto pos = peak_annotations_.find(Handle(i));
+      if (pos != peak_annotations_.end())
+      {
+        match.peak_annotations = pos->second;
+      }
+      id_data_.registerMoleculeQueryMatch(match);
+    }
+
+    if (has_current_step) id_data_.setCurrentProcessingStep(current_step);
+  }
+
+} // end namespace OpenMS
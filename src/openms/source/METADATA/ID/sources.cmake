@@ -4,6 +4,7 @@ set(directory source/METADATA/ID)
 ### list all filenames of the directory here
 set(sources_list
 IdentificationData.cpp
+IdentificationDataArena.cpp
 IdentificationDataConverter.cpp
 )
 
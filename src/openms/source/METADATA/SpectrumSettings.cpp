@@ -44,13 +44,66 @@ namespace OpenMS
 
   const std::string SpectrumSettings::NamesOfSpectrumType[] = {"Unknown", "Centroid", "Profile"};
 
+  namespace
+  {
+    // shared by all default constructed spectra
+    const boost::shared_ptr<InstrumentSettings>& defaultInstrumentSettings()
+    {
+      static const boost::shared_ptr<InstrumentSettings> instrument_settings(new InstrumentSettings());
+      return instrument_settings;
+    }
+
+    const boost::shared_ptr<SourceFile>& defaultSourceFile()
+    {
+      static const boost::shared_ptr<SourceFile> source_file(new SourceFile());
+      return source_file;
+    }
+
+    // copy of the shared object if it is not exclusively owned
+    template <typename T>
+    T& detach(boost::shared_ptr<T>& ptr)
+    {
+      if (ptr.use_count() != 1)
+      {
+        ptr.reset(new T(*ptr));
+      }
+      return *ptr;
+    }
+
+    // replace by an equal instance from the pool (or add to the pool)
+    template <typename T>
+    void share(boost::shared_ptr<T>& ptr, std::vector<boost::shared_ptr<T> >& pool, Size capacity)
+    {
+      for (auto it = pool.rbegin(); it != pool.rend(); ++it)
+      {
+        if (*it == ptr) return;
+        if (**it == *ptr)
+        {
+          ptr = *it;
+          return;
+        }
+      }
+      if (capacity == 0) return;
+      if (pool.size() >= capacity)
+      {
+        pool.erase(pool.begin());
+      }
+      pool.push_back(ptr);
+    }
+  }
+
+  SpectrumSettings::SharedSettingsPool::SharedSettingsPool(Size capacity) :
+    capacity_(capacity)
+  {
+  }
+
   SpectrumSettings::SpectrumSettings() :
     MetaInfoInterface(),
     type_(UNKNOWN),
     native_id_(),
     comment_(),
-    instrument_settings_(),
-    source_file_(),
+    instrument_settings_(defaultInstrumentSettings()),
+    source_file_(defaultSourceFile()),
     acquisition_info_(),
     precursors_(),
     products_(),
@@ -59,6 +112,39 @@ namespace OpenMS
   {
   }
 
+  SpectrumSettings::SpectrumSettings(SpectrumSettings&& rhs) noexcept :
+    MetaInfoInterface(std::move(rhs)),
+    type_(rhs.type_),
+    native_id_(std::move(rhs.native_id_)),
+    comment_(std::move(rhs.comment_)),
+    instrument_settings_(rhs.instrument_settings_),
+    source_file_(rhs.source_file_),
+    acquisition_info_(std::move(rhs.acquisition_info_)),
+    precursors_(std::move(rhs.precursors_)),
+    products_(std::move(rhs.products_)),
+    identification_(std::move(rhs.identification_)),
+    data_processing_(std::move(rhs.data_processing_))
+  {
+  }
+
+  SpectrumSettings& SpectrumSettings::operator=(SpectrumSettings&& rhs) & noexcept
+  {
+    if (&rhs == this) return *this;
+
+    MetaInfoInterface::operator=(std::move(rhs));
+    type_ = rhs.type_;
+    native_id_ = std::move(rhs.native_id_);
+    comment_ = std::move(rhs.comment_);
+    instrument_settings_ = rhs.instrument_settings_;
+    source_file_ = rhs.source_file_;
+    acquisition_info_ = std::move(rhs.acquisition_info_);
+    precursors_ = std::move(rhs.precursors_);
+    products_ = std::move(rhs.products_);
+    identification_ = std::move(rhs.identification_);
+    data_processing_ = std::move(rhs.data_processing_);
+    return *this;
+  }
+
   SpectrumSettings::~SpectrumSettings()
   {
   }
@@ -69,9 +155,9 @@ namespace OpenMS
            type_ == rhs.type_ &&
            native_id_ == rhs.native_id_ &&
            comment_ == rhs.comment_ &&
-           instrument_settings_ == rhs.instrument_settings_ &&
+           (instrument_settings_ == rhs.instrument_settings_ || *instrument_settings_ == *rhs.instrument_settings_) &&
            acquisition_info_ == rhs.acquisition_info_ &&
-           source_file_ == rhs.source_file_ &&
+           (source_file_ == rhs.source_file_ || *source_file_ == *rhs.source_file_) &&
            precursors_ == rhs.precursors_ &&
            products_ == rhs.products_ &&
            identification_ == rhs.identification_ &&
@@ -131,17 +217,17 @@ namespace OpenMS
 
   const InstrumentSettings & SpectrumSettings::getInstrumentSettings() const
   {
-    return instrument_settings_;
+    return *instrument_settings_;
   }
 
   InstrumentSettings & SpectrumSettings::getInstrumentSettings()
   {
-    return instrument_settings_;
+    return detach(instrument_settings_);
   }
 
   void SpectrumSettings::setInstrumentSettings(const InstrumentSettings & instrument_settings)
   {
-    instrument_settings_ = instrument_settings;
+    instrument_settings_.reset(new InstrumentSettings(instrument_settings));
   }
 
   const AcquisitionInfo & SpectrumSettings::getAcquisitionInfo() const
@@ -161,17 +247,23 @@ namespace OpenMS
 
   const SourceFile & SpectrumSettings::getSourceFile() const
   {
-    return source_file_;
+    return *source_file_;
   }
 
   SourceFile & SpectrumSettings::getSourceFile()
   {
-    return source_file_;
+    return detach(source_file_);
   }
 
   void SpectrumSettings::setSourceFile(const SourceFile & source_file)
   {
-    source_file_ = source_file;
+    source_file_.reset(new SourceFile(source_file));
+  }
+
+  void SpectrumSettings::shareSettings(SharedSettingsPool& pool)
+  {
+    share(instrument_settings_, pool.instrument_settings_, pool.capacity_);
+    share(source_file_, pool.source_files_, pool.capacity_);
   }
 
   const vector<Precursor> & SpectrumSettings::getPrecursors() const
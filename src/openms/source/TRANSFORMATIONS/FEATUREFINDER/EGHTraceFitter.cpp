@@ -68,32 +68,29 @@ namespace OpenMS
 
     double fegh = 0.0;
 
-    UInt count = 0;
-    for (Size t = 0; t < m_data->traces_ptr->size(); ++t)
+    const double baseline = m_data->traces_ptr->baseline;
+    const double* rts = m_data->rt.data();
+    const double* intensities = m_data->intensity.data();
+    const double* theoretical_ints = m_data->theoretical_int.data();
+    const double* weights = m_data->weight.data();
+    const Size count = m_data->rt.size();
+    for (Size i = 0; i < count; ++i)
     {
-      const FeatureFinderAlgorithmPickedHelperStructs::MassTrace& trace = m_data->traces_ptr->at(t);
-      double weight = m_data->weighted ? trace.theoretical_int : 1.0;
-      for (Size i = 0; i < trace.peaks.size(); ++i)
-      {
-        double rt = trace.peaks[i].first;
-
-        t_diff = rt - tR;
-        t_diff2 = t_diff * t_diff; // -> (t - t_R)^2
-
-        denominator = 2 * sigma * sigma + tau * t_diff; // -> 2\sigma_{g}^{2} + \tau \left(t - t_R\right)
+      t_diff = rts[i] - tR;
+      t_diff2 = t_diff * t_diff; // -> (t - t_R)^2
 
-        if (denominator > 0.0)
-        {
-          fegh =  m_data->traces_ptr->baseline + trace.theoretical_int * H * exp(-t_diff2 / denominator);
-        }
-        else
-        {
-          fegh = 0.0;
-        }
+      denominator = 2 * sigma * sigma + tau * t_diff; // -> 2\sigma_{g}^{2} + \tau \left(t - t_R\right)
 
-        fvec(count) = (fegh - trace.peaks[i].second->getIntensity()) * weight;
-        ++count;
+      if (denominator > 0.0)
+      {
+        fegh =  baseline + theoretical_ints[i] * H * exp(-t_diff2 / denominator);
       }
+      else
+      {
+        fegh = 0.0;
+      }
+
+      fvec(i) = (fegh - intensities[i]) * weights[i];
     }
     return 0;
   }
@@ -108,55 +105,50 @@ namespace OpenMS
     double derivative_H, derivative_tR, derivative_sigma, derivative_tau = 0.0;
     double t_diff, t_diff2, exp1, denominator = 0.0;
 
-    UInt count = 0;
-    for (Size t = 0; t < m_data->traces_ptr->size(); ++t)
+    const double* rts = m_data->rt.data();
+    const double* theoretical_ints = m_data->theoretical_int.data();
+    const double* weights = m_data->weight.data();
+    const Size count = m_data->rt.size();
+    for (Size i = 0; i < count; ++i)
     {
-      const FeatureFinderAlgorithmPickedHelperStructs::MassTrace& trace = m_data->traces_ptr->at(t);
-      double weight = m_data->weighted ? trace.theoretical_int : 1.0;
-      for (Size i = 0; i < trace.peaks.size(); ++i)
+      t_diff = rts[i] - tR;
+      t_diff2 = t_diff * t_diff; // -> (t - t_R)^2
+
+      denominator = 2 * sigma * sigma + tau * t_diff; // -> 2\sigma_{g}^{2} + \tau \left(t - t_R\right)
+
+      if (denominator > 0)
       {
-        double rt = trace.peaks[i].first;
-
-        t_diff = rt - tR;
-        t_diff2 = t_diff * t_diff; // -> (t - t_R)^2
-
-        denominator = 2 * sigma * sigma + tau * t_diff; // -> 2\sigma_{g}^{2} + \tau \left(t - t_R\right)
-
-        if (denominator > 0)
-        {
-          exp1 = exp(-t_diff2 / denominator);
-
-          // \partial H f_{egh}(t) = \exp\left( \frac{-\left(t-t_R \right)}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right)
-          derivative_H = trace.theoretical_int * exp1;
-
-          // \partial t_R f_{egh}(t) &=& H \exp \left( \frac{-\left(t-t_R \right)}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right) \left( \frac{\left( 4 \sigma_{g}^{2} + \tau \left(t-t_R \right) \right) \left(t-t_R \right)}{\left( 2\sigma_{g}^{2} + \tau \left(t - t_R\right) \right)^2} \right)
-          derivative_tR = trace.theoretical_int * H * exp1 * ((4 * sigma * sigma + tau * t_diff) * t_diff) / (denominator * denominator);
-
-          // \partial \sigma_{g}^{2} f_{egh}(t) &=& H \exp \left( \frac{-\left(t-t_R \right)^2}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right) \left( \frac{ 2 \left(t - t_R\right)^2}{\left( 2\sigma_{g}^{2} + \tau \left(t - t_R\right) \right)^2} \right)
-          // // \partial \sigma_{g}^{2} f_{egh}(t) &=& H \exp \left( \frac{-\left(t-t_R \right)^2}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right) \left( \frac{ 2 \left(t - t_R\right)^2}{\left( 2\sigma_{g}^{2} + \tau \left(t - t_R\right) \right)^2} \right)
-          // derivative_sigma_square = trace.theoretical_int * H * exp1 * 2 * t_diff2 / (denominator * denominator));
-
-          // \partial \sigma_{g} f_{egh}(t) &=& H \exp \left( \frac{-\left(t-t_R \right)^2}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right) \left( \frac{ 4 \sigma_{g} \left(t - t_R\right)^2}{\left( 2\sigma_{g}^{2} + \tau \left(t - t_R\right) \right)^2} \right)
-          derivative_sigma = trace.theoretical_int * H * exp1 * 4 * sigma * t_diff2 / (denominator * denominator);
-
-          // \partial \tau f_{egh}(t) &=& H \exp \left( \frac{-\left(t-t_R \right)^2}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right) \left( \frac{ \left(t - t_R\right)^3}{\left( 2\sigma_{g}^{2} + \tau \left(t - t_R\right) \right)^2} \right)
-          derivative_tau = trace.theoretical_int * H * exp1 * t_diff * t_diff2 / (denominator * denominator);
-        }
-        else
-        {
-          derivative_H = 0.0;
-          derivative_tR = 0.0;
-          derivative_sigma = 0.0;
-          derivative_tau = 0.0;
-        }
-
-        // set the jacobian matrix
-        J(count, 0) = derivative_H * weight;
-        J(count, 1) = derivative_tR * weight;
-        J(count, 2) = derivative_sigma * weight;
-        J(count, 3) = derivative_tau * weight;
-        ++count;
+        exp1 = exp(-t_diff2 / denominator);
+
+        // \partial H f_{egh}(t) = \exp\left( \frac{-\left(t-t_R \right)}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right)
+        derivative_H = theoretical_ints[i] * exp1;
+
+        // \partial t_R f_{egh}(t) &=& H \exp \left( \frac{-\left(t-t_R \right)}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right) \left( \frac{\left( 4 \sigma_{g}^{2} + \tau \left(t-t_R \right) \right) \left(t-t_R \right)}{\left( 2\sigma_{g}^{2} + \tau \left(t - t_R\right) \right)^2} \right)
+        derivative_tR = theoretical_ints[i] * H * exp1 * ((4 * sigma * sigma + tau * t_diff) * t_diff) / (denominator * denominator);
+
+        // \partial \sigma_{g}^{2} f_{egh}(t) &=& H \exp \left( \frac{-\left(t-t_R \right)^2}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right) \left( \frac{ 2 \left(t - t_R\right)^2}{\left( 2\sigma_{g}^{2} + \tau \left(t - t_R\right) \right)^2} \right)
+        // // \partial \sigma_{g}^{2} f_{egh}(t) &=& H \exp \left( \frac{-\left(t-t_R \right)^2}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right) \left( \frac{ 2 \left(t - t_R\right)^2}{\left( 2\sigma_{g}^{2} + \tau \left(t - t_R\right) \right)^2} \right)
+        // derivative_sigma_square = theoretical_ints[i] * H * exp1 * 2 * t_diff2 / (denominator * denominator));
+
+        // \partial \sigma_{g} f_{egh}(t) &=& H \exp \left( \frac{-\left(t-t_R \right)^2}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right) \left( \frac{ 4 \sigma_{g} \left(t - t_R\right)^2}{\left( 2\sigma_{g}^{2} + \tau \left(t - t_R\right) \right)^2} \right)
+        derivative_sigma = theoretical_ints[i] * H * exp1 * 4 * sigma * t_diff2 / (denominator * denominator);
+
+        // \partial \tau f_{egh}(t) &=& H \exp \left( \frac{-\left(t-t_R \right)^2}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right) \left( \frac{ \left(t - t_R\right)^3}{\left( 2\sigma_{g}^{2} + \tau \left(t - t_R\right) \right)^2} \right)
+        derivative_tau = theoretical_ints[i] * H * exp1 * t_diff * t_diff2 / (denominator * denominator);
+      }
+      else
+      {
+        derivative_H = 0.0;
+        derivative_tR = 0.0;
+        derivative_sigma = 0.0;
+        derivative_tau = 0.0;
       }
+
+      // set the jacobian matrix
+      J(i, 0) = derivative_H * weights[i];
+      J(i, 1) = derivative_tR * weights[i];
+      J(i, 2) = derivative_sigma * weights[i];
+      J(i, 3) = derivative_tau * weights[i];
     }
     return 0;
   }
@@ -206,10 +198,8 @@ namespace OpenMS
     x_init(2) = sigma_;
     x_init(3) = tau_;
 
-    TraceFitter::ModelData data{};
-    data.traces_ptr = &traces;
-    data.weighted = this->weighted_;
-    EGHTraceFunctor functor(NUM_PARAMS_, &data);
+    model_data_.setTraces(traces, this->weighted_);
+    EGHTraceFunctor functor(NUM_PARAMS_, &model_data_);
 
     TraceFitter::optimize_(x_init, functor);
   }
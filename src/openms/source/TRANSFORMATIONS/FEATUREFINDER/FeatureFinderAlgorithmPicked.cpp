@@ -46,10 +46,12 @@
 #include <OpenMS/CHEMISTRY/ElementDB.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopeDistribution.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
+#include <OpenMS/SYSTEM/StopWatch.h>
 
 #include <QtCore/QDir>
 
 #ifdef _OPENMP
+#include <omp.h>
 #endif
 
 namespace OpenMS
@@ -204,6 +206,23 @@ namespace OpenMS
     Param trace_fitter_params;
     trace_fitter_params.setValue("max_iteration", max_iterations);
 
+    // wall-clock time spent in each stage (summed over charges), reported at the end
+    std::vector<std::pair<String, double> > stage_times;
+    StopWatch stage_timer;
+    stage_timer.start();
+    auto finishStage = [&stage_times, &stage_timer](const String& stage)
+    {
+      std::vector<std::pair<String, double> >::iterator it = std::find_if(stage_times.begin(), stage_times.end(),
+        [&stage](const std::pair<String, double>& t) { return t.first == stage; });
+      if (it == stage_times.end())
+      {
+        stage_times.emplace_back(stage, 0.0);
+        it = stage_times.end() - 1;
+      }
+      it->second += stage_timer.getClockTime();
+      stage_timer.reset();
+    };
+
     //copy the input map
     map_ = *(FeatureFinderAlgorithm::map_);
 
@@ -303,7 +322,8 @@ namespace OpenMS
       }
 
       //store intensity score in PeakInfo
-      for (Size s = 0; s < map_.size(); ++s)
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize s = 0; s < (SignedSize)map_.size(); ++s)
       {
         for (Size p = 0; p < map_[s].size(); ++p)
         {
@@ -312,6 +332,7 @@ namespace OpenMS
       }
       ff_->endProgress();
     }
+    finishStage("intensity scores");
 
     //---------------------------------------------------------------------------
     //Step 2:
@@ -322,9 +343,11 @@ namespace OpenMS
       Size end_iteration = map_.size() - std::min((Size) min_spectra_, map_.size());
       ff_->startProgress(min_spectra_, end_iteration, "Precalculating mass trace scores");
       // skip first and last scans since we cannot extend the mass traces there
-      for (Size s = min_spectra_; s < end_iteration; ++s)
+      // (each spectrum only writes its own score arrays, so spectra are independent)
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize s = min_spectra_; s < (SignedSize)end_iteration; ++s)
       {
-        ff_->setProgress(s);
+        IF_MASTERTHREAD ff_->setProgress(s);
         SpectrumType& spectrum = map_[s];
         //iterate over all peaks of the scan
         for (Size p = 0; p < spectrum.size(); ++p)
@@ -338,7 +361,7 @@ namespace OpenMS
           bool is_max_peak = true; //checking the maximum intensity peaks -> use them later as feature seeds.
           for (Size i = 1; i <= min_spectra_; ++i)
           {
-            SpectrumType& next_spectrum = map_[s + i];
+            const SpectrumType& next_spectrum = map_[s + i];
             if (!next_spectrum.empty()) // There are peaks in the spectrum
             {
               Size spec_index = next_spectrum.findNearest(pos);
@@ -349,7 +372,7 @@ namespace OpenMS
           }
           for (Size i = 1; i <= min_spectra_; ++i)
           {
-            SpectrumType& next_spectrum = map_[s - i];
+            const SpectrumType& next_spectrum = map_[s - i];
             if (!next_spectrum.empty()) // There are peaks in the spectrum
             {
               Size spec_index = next_spectrum.findNearest(pos);
@@ -368,6 +391,7 @@ namespace OpenMS
       }
       ff_->endProgress();
     }
+    finishStage("mass trace scores");
 
     //---------------------------------------------------------------------------
     //Step 2.5:
@@ -442,6 +466,7 @@ namespace OpenMS
 
       ff_->endProgress();
     }
+    finishStage("isotope distributions");
 
     //-------------------------------------------------------------------------
     //Step 3:
@@ -499,6 +524,7 @@ namespace OpenMS
         }
       }
       ff_->endProgress();
+      finishStage("isotope pattern scores");
       //-----------------------------------------------------------
       //Step 3.2:
       //Find seeds for this charge
@@ -586,6 +612,7 @@ namespace OpenMS
 
       ff_->endProgress();
       std::cout << "Found " << seeds.size() << " seeds for charge " << c << "." << std::endl;
+      finishStage("seed detection");
 
       //------------------------------------------------------------------
       //Step 3.3:
@@ -593,22 +620,50 @@ namespace OpenMS
       //------------------------------------------------------------------
 
       // We do not want to store features whose seeds lie within other
-      // features with higher intensity. We thus store this information in
-      // the map seeds_in_features which contains for each seed i a vector
-      // of other seeds that are contained in the corresponding feature i.
+      // features with higher intensity. We thus store for each feature
+      // the other seeds that are contained in it.
       //
-      // The features are stored in an temporary feature map until it is
-      // decided whether they are contained within a seed of higher
-      // intensity.
-      std::map<Size, std::vector<Size> > seeds_in_features;
-      typedef std::map<Size, Feature> FeatureMapType;
-      FeatureMapType tmp_feature_map;
+      // The features are stored in temporary per-thread buffers until it
+      // is decided whether they are contained within a seed of higher
+      // intensity. Buffers are merged in seed order after the loop, so no
+      // locking is needed while extending seeds.
+      struct SeedFeature
+      {
+        Size seed;
+        Feature feature;
+        std::vector<Size> contained_seeds;
+      };
+      struct ThreadResults
+      {
+        std::vector<SeedFeature> features;
+        std::vector<std::pair<Size, String> > aborts;
+      };
+#ifdef _OPENMP
+      std::vector<ThreadResults> thread_results(omp_get_max_threads());
+#else
+      std::vector<ThreadResults> thread_results(1);
+#endif
+
+      // seed positions sorted by m/z, to find the seeds inside a feature quickly
+      std::vector<std::pair<double, Size> > seeds_by_mz;
+      seeds_by_mz.reserve(seeds.size());
+      for (Size j = 0; j < seeds.size(); ++j)
+      {
+        seeds_by_mz.emplace_back(map_[seeds[j].spectrum][seeds[j].peak].getMZ(), j);
+      }
+      std::sort(seeds_by_mz.begin(), seeds_by_mz.end());
+
       int gl_progress = 0;
       ff_->startProgress(0, seeds.size(), String("Extending seeds for charge ") + String(c));
 
-#pragma omp parallel for
+#pragma omp parallel for schedule(dynamic)
       for (SignedSize i = 0; i < (SignedSize)seeds.size(); ++i)
       {
+#ifdef _OPENMP
+        ThreadResults& results = thread_results[omp_get_thread_num()];
+#else
+        ThreadResults& results = thread_results[0];
+#endif
         //------------------------------------------------------------------
         //Step 3.3.1:
         //Extend all mass traces
@@ -638,7 +693,7 @@ namespace OpenMS
 
         if (isotope_fit_quality < min_isotope_fit_)
         {
-          abort_(seeds[i], "Could not find good enough isotope pattern containing the seed");
+          results.aborts.emplace_back(i, "Could not find good enough isotope pattern containing the seed");
           continue;
         }
         //extend the convex hull in RT dimension (starting from the trace peaks)
@@ -651,7 +706,7 @@ namespace OpenMS
 
         if (!traces.isValid(seed_mz, trace_tolerance_))
         {
-          abort_(seeds[i], "Could not extend seed");
+          results.aborts.emplace_back(i, "Could not extend seed");
           continue;
         }
 
@@ -662,10 +717,8 @@ namespace OpenMS
         Int plot_nr = -1;
 
 
-#pragma omp critical (FeatureFinderAlgorithmPicked_PLOTNR)
-        {
-          plot_nr = ++plot_nr_global;
-        }
+#pragma omp atomic capture
+        plot_nr = ++plot_nr_global;
 
         //------------------------------------------------------------------
 
@@ -734,7 +787,7 @@ namespace OpenMS
         //validity output
         if (!feature_ok)
         {
-          abort_(seeds[i], error_msg);
+          results.aborts.emplace_back(i, error_msg);
           continue;
         }
         traces = new_traces;
@@ -803,54 +856,62 @@ namespace OpenMS
           f.getConvexHulls().push_back(traces[j].getConvexhull());
         }
 
-#pragma omp critical (FeatureFinderAlgorithmPicked_TMPFEATUREMAP)
-        {
-          tmp_feature_map[i] = f;
-        }
-
         //----------------------------------------------------------------
-        //Remember all seeds that lie inside the convex hull of the new feature
+        //Remember all (lower intensity) seeds that lie inside the convex hull of the new feature
+        SeedFeature seed_feature;
+        seed_feature.seed = i;
         DBoundingBox<2> bb = f.getConvexHull().getBoundingBox();
-        for (Size j = i + 1; j < seeds.size(); ++j)
+        std::vector<std::pair<double, Size> >::const_iterator seed_it = std::lower_bound(seeds_by_mz.begin(), seeds_by_mz.end(), std::make_pair(bb.minY(), Size(0)));
+        for (; seed_it != seeds_by_mz.end() && seed_it->first <= bb.maxY(); ++seed_it)
         {
+          Size j = seed_it->second;
+          if (j <= (Size)i) continue;
           double rt = map_[seeds[j].spectrum].getRT();
-          double mz = map_[seeds[j].spectrum][seeds[j].peak].getMZ();
+          double mz = seed_it->first;
           if (bb.encloses(rt, mz) && f.encloses(rt, mz))
           {
-#pragma omp critical (FeatureFinderAlgorithmPicked_SEEDSINFEATURES)
-            {
-              seeds_in_features[i].push_back(j);
-            }
+            seed_feature.contained_seeds.push_back(j);
           }
         }
+        seed_feature.feature = std::move(f);
+        results.features.push_back(std::move(seed_feature));
       } // end of OPENMP over seeds
+      finishStage("seed extension");
+
+      // merge the thread buffers in seed order
+      std::vector<SeedFeature> seed_features;
+      for (ThreadResults& results : thread_results)
+      {
+        std::move(results.features.begin(), results.features.end(), std::back_inserter(seed_features));
+        for (const std::pair<Size, String>& abort : results.aborts)
+        {
+          abort_(seeds[abort.first], abort.second);
+        }
+      }
+      std::sort(seed_features.begin(), seed_features.end(), [](const SeedFeature& a, const SeedFeature& b)
+      {
+        return a.seed < b.seed;
+      });
 
       // Here we have to evaluate which seeds are already contained in
       // features of seeds with higher intensities. Only if the seed is not
       // used in any feature with higher intensity, we can add it to the
       // features_ list.
-      std::vector<Size> seeds_contained;
-      for (auto& f : tmp_feature_map)
+      std::vector<bool> seeds_contained(seeds.size(), false);
+      for (SeedFeature& f : seed_features)
       {
-        Size seed_nr = f.first;
-        bool is_used = false;
-        for (Size i : seeds_contained)
-        {
-          if (seed_nr == i) { is_used = true; break; }
-        }
-        if (!is_used)
+        if (!seeds_contained[f.seed])
         {
           ++feature_candidates;
 
           //re-set label
-          f.second.setMetaValue(3, feature_nr_global);
+          f.feature.setMetaValue(3, feature_nr_global);
           ++feature_nr_global;
-          features_->push_back(f.second);
+          features_->push_back(std::move(f.feature));
 
-          std::vector<Size> curr_seed = seeds_in_features[seed_nr];
-          for (Size k : curr_seed)
+          for (Size k : f.contained_seeds)
           {
-            seeds_contained.push_back(k);
+            seeds_contained[k] = true;
           }
         }
       }
@@ -964,6 +1025,13 @@ namespace OpenMS
     // sort features by intensity
     features_->sortByIntensity(true);
     ff_->endProgress();
+    finishStage("overlap resolution");
+
+    OPENMS_LOG_INFO << "Time per stage (wall clock):\n";
+    for (const std::pair<String, double>& stage : stage_times)
+    {
+      OPENMS_LOG_INFO << " - " << stage.first << ": " << StopWatch::toString(stage.second) << "\n";
+    }
 
     // Abort reasons
     OPENMS_LOG_INFO << '\n';
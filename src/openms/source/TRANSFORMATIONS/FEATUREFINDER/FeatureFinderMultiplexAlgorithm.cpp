@@ -61,11 +61,16 @@
 #include <iostream>
 #include <ostream>
 #include <algorithm>
+#include <exception>
 
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/algorithm/string/classification.hpp>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 //#define DEBUG
 
 using namespace std;
@@ -559,339 +564,398 @@ namespace OpenMS
     return intensity_peptide;
   }
 
+  void FeatureFinderMultiplexAlgorithm::mergePatternResults_(std::vector<std::vector<Feature> >& features_pattern, std::vector<std::vector<ConsensusFeature> >& consensus_pattern, const std::vector<std::vector<Size> >& column_sizes_pattern)
+  {
+    for (Size pattern = 0; pattern < consensus_pattern.size(); ++pattern)
+    {
+      for (Size peptide = 0; peptide < column_sizes_pattern[pattern].size(); ++peptide)
+      {
+        if (column_sizes_pattern[pattern][peptide] == 0) continue;
+        consensus_map_.getColumnHeaders()[peptide].size += column_sizes_pattern[pattern][peptide];
+      }
+      for (ConsensusFeature& consensus : consensus_pattern[pattern])
+      {
+        consensus_map_.push_back(std::move(consensus));
+      }
+      for (Feature& feature : features_pattern[pattern])
+      {
+        feature_map_.push_back(std::move(feature));
+      }
+    }
+  }
+
   void FeatureFinderMultiplexAlgorithm::generateMapsCentroided_(const std::vector<MultiplexIsotopicPeakPattern>& patterns, const std::vector<MultiplexFilteredMSExperiment>& filter_results, std::vector<std::map<int, GridBasedCluster> >& cluster_results)
   {
+    // Patterns are processed in parallel. Features, consensus features and column header
+    // counts are collected per pattern and merged in pattern order afterwards.
+    std::vector<std::vector<Feature> > features_pattern(patterns.size());
+    std::vector<std::vector<ConsensusFeature> > consensus_pattern(patterns.size());
+    std::vector<std::vector<Size> > column_sizes_pattern(patterns.size());
+    std::exception_ptr error;
+
     // loop over peak patterns
-    for (unsigned pattern = 0; pattern < patterns.size(); ++pattern)
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize pattern = 0; pattern < (SignedSize) patterns.size(); ++pattern)
     {
-      // loop over clusters
-      for (std::map<int, GridBasedCluster>::const_iterator cluster_it = cluster_results[pattern].begin(); cluster_it != cluster_results[pattern].end(); ++cluster_it)
+      try
       {
-        GridBasedCluster cluster = cluster_it->second;
-        std::vector<int> points = cluster.getPoints();
-
-        // Construct a satellite set for the complete peptide multiplet
-        // Make sure there are no duplicates, i.e. the same satellite from different filtered peaks.
-        std::multimap<size_t, MultiplexSatelliteCentroided > satellites;
-        // loop over points in cluster
-        for (std::vector<int>::const_iterator point_it = points.begin(); point_it != points.end(); ++point_it)
+        column_sizes_pattern[pattern].resize(patterns[pattern].getMassShiftCount(), 0);
+
+        // loop over clusters
+        for (std::map<int, GridBasedCluster>::const_iterator cluster_it = cluster_results[pattern].begin(); cluster_it != cluster_results[pattern].end(); ++cluster_it)
         {
-          MultiplexFilteredPeak peak = filter_results[pattern].getPeak(*point_it);
-          // loop over satellites of the peak
-          for (std::multimap<size_t, MultiplexSatelliteCentroided >::const_iterator satellite_it = peak.getSatellites().begin(); satellite_it != peak.getSatellites().end(); ++satellite_it)
+          GridBasedCluster cluster = cluster_it->second;
+          std::vector<int> points = cluster.getPoints();
+
+          // Construct a satellite set for the complete peptide multiplet
+          // Make sure there are no duplicates, i.e. the same satellite from different filtered peaks.
+          std::multimap<size_t, MultiplexSatelliteCentroided > satellites;
+          // loop over points in cluster
+          for (std::vector<int>::const_iterator point_it = points.begin(); point_it != points.end(); ++point_it)
           {
-            // check if this satellite (i.e. these indices) are already in the set
-            bool satellite_in_set = false;
-            for (std::multimap<size_t, MultiplexSatelliteCentroided >::const_iterator satellite_it_2 = satellites.begin(); satellite_it_2 != satellites.end(); ++satellite_it_2)
+            MultiplexFilteredPeak peak = filter_results[pattern].getPeak(*point_it);
+            // loop over satellites of the peak
+            for (std::multimap<size_t, MultiplexSatelliteCentroided >::const_iterator satellite_it = peak.getSatellites().begin(); satellite_it != peak.getSatellites().end(); ++satellite_it)
             {
-              if ((satellite_it_2->second.getRTidx() == satellite_it->second.getRTidx()) && (satellite_it_2->second.getMZidx() == satellite_it->second.getMZidx()))
+              // check if this satellite (i.e. these indices) are already in the set
+              bool satellite_in_set = false;
+              for (std::multimap<size_t, MultiplexSatelliteCentroided >::const_iterator satellite_it_2 = satellites.begin(); satellite_it_2 != satellites.end(); ++satellite_it_2)
+              {
+                if ((satellite_it_2->second.getRTidx() == satellite_it->second.getRTidx()) && (satellite_it_2->second.getMZidx() == satellite_it->second.getMZidx()))
+                {
+                  satellite_in_set = true;
+                  break;
+                }
+              }
+              if (satellite_in_set)
               {
-                satellite_in_set = true;
                 break;
               }
-            }
-            if (satellite_in_set)
-            {
-              break;
-            }
 
-            satellites.insert(std::make_pair(satellite_it->first, MultiplexSatelliteCentroided(satellite_it->second.getRTidx(), satellite_it->second.getMZidx())));
+              satellites.insert(std::make_pair(satellite_it->first, MultiplexSatelliteCentroided(satellite_it->second.getRTidx(), satellite_it->second.getMZidx())));
+            }
           }
-        }
-
-        // determine peptide intensities
-        std::vector<double> peptide_intensities = determinePeptideIntensitiesCentroided_(patterns[pattern], satellites);
 
-        // If no reliable peptide intensity can be determined, we do not report the peptide multiplet.
-        if (std::find(peptide_intensities.begin(), peptide_intensities.end(), -1.0) != peptide_intensities.end())
-        {
-          continue;
-        }
-
-        std::vector<Feature> features;
-        ConsensusFeature consensus;
-        bool abort = false;
+          // determine peptide intensities
+          std::vector<double> peptide_intensities = determinePeptideIntensitiesCentroided_(patterns[pattern], satellites);
 
-        // construct the feature and consensus maps
-        // loop over peptides
-        for (size_t peptide = 0; (peptide < patterns[pattern].getMassShiftCount() && !abort); ++peptide)
-        {
-          // coordinates of the peptide feature
-          // RT is the intensity-average of all satellites peaks of the mono-isotopic mass trace
-          // m/z is the intensity-average of all satellites peaks of the mono-isotopic mass trace
-          Feature feature;
-          double rt(0);
-          double mz(0);
-          double intensity_sum(0);
-
-          // loop over isotopes i.e. mass traces of the peptide
-          for (size_t isotope = 0; isotope < isotopes_per_peptide_max_; ++isotope)
+          // If no reliable peptide intensity can be determined, we do not report the peptide multiplet.
+          if (std::find(peptide_intensities.begin(), peptide_intensities.end(), -1.0) != peptide_intensities.end())
           {
-            // find satellites for this isotope i.e. mass trace
-            size_t idx = peptide * isotopes_per_peptide_max_ + isotope;
-            std::pair<std::multimap<size_t, MultiplexSatelliteCentroided >::const_iterator, std::multimap<size_t, MultiplexSatelliteCentroided >::const_iterator> satellites_isotope;
-            satellites_isotope = satellites.equal_range(idx);
+            continue;
+          }
 
-            DBoundingBox<2> mass_trace;
+          std::vector<Feature> features;
+          ConsensusFeature consensus;
+          bool abort = false;
 
-            // loop over satellites for this isotope i.e. mass trace
-            for (std::multimap<size_t, MultiplexSatelliteCentroided >::const_iterator satellite_it = satellites_isotope.first; satellite_it != satellites_isotope.second; ++satellite_it)
+          // construct the feature and consensus maps
+          // loop over peptides
+          for (size_t peptide = 0; (peptide < patterns[pattern].getMassShiftCount() && !abort); ++peptide)
+          {
+            // coordinates of the peptide feature
+            // RT is the intensity-average of all satellites peaks of the mono-isotopic mass trace
+            // m/z is the intensity-average of all satellites peaks of the mono-isotopic mass trace
+            Feature feature;
+            double rt(0);
+            double mz(0);
+            double intensity_sum(0);
+
+            // loop over isotopes i.e. mass traces of the peptide
+            for (size_t isotope = 0; isotope < isotopes_per_peptide_max_; ++isotope)
             {
-              // find indices of the peak
-              size_t rt_idx = (satellite_it->second).getRTidx();
-              size_t mz_idx = (satellite_it->second).getMZidx();
+              // find satellites for this isotope i.e. mass trace
+              size_t idx = peptide * isotopes_per_peptide_max_ + isotope;
+              std::pair<std::multimap<size_t, MultiplexSatelliteCentroided >::const_iterator, std::multimap<size_t, MultiplexSatelliteCentroided >::const_iterator> satellites_isotope;
+              satellites_isotope = satellites.equal_range(idx);
 
-              // find peak itself
-              MSExperiment::ConstIterator it_rt = exp_centroid_.begin();
-              std::advance(it_rt, rt_idx);
-              MSSpectrum::ConstIterator it_mz = it_rt->begin();
-              std::advance(it_mz, mz_idx);
+              DBoundingBox<2> mass_trace;
 
-              if (isotope == 0)
+              // loop over satellites for this isotope i.e. mass trace
+              for (std::multimap<size_t, MultiplexSatelliteCentroided >::const_iterator satellite_it = satellites_isotope.first; satellite_it != satellites_isotope.second; ++satellite_it)
               {
-                rt += it_rt->getRT() * it_mz->getIntensity();
-                mz += it_mz->getMZ() * it_mz->getIntensity();
-                intensity_sum += it_mz->getIntensity();
+                // find indices of the peak
+                size_t rt_idx = (satellite_it->second).getRTidx();
+                size_t mz_idx = (satellite_it->second).getMZidx();
+
+                // find peak itself
+                MSExperiment::ConstIterator it_rt = exp_centroid_.begin();
+                std::advance(it_rt, rt_idx);
+                MSSpectrum::ConstIterator it_mz = it_rt->begin();
+                std::advance(it_mz, mz_idx);
+
+                if (isotope == 0)
+                {
+                  rt += it_rt->getRT() * it_mz->getIntensity();
+                  mz += it_mz->getMZ() * it_mz->getIntensity();
+                  intensity_sum += it_mz->getIntensity();
+                }
+
+                mass_trace.enlarge(it_rt->getRT(), it_mz->getMZ());
               }
 
-              mass_trace.enlarge(it_rt->getRT(), it_mz->getMZ());
-            }
+              if ((mass_trace.width() == 0) || (mass_trace.height() == 0))
+              {
+                // The mass trace contains only a single point. Add a small margin around
+                // the point, otherwise the mass trace is considered empty and not drawn.
+                // TODO: Remove the magic number for the margin.
+                mass_trace.enlarge(mass_trace.minX() - 0.01, mass_trace.minY() - 0.01);
+                mass_trace.enlarge(mass_trace.maxX() + 0.01, mass_trace.maxY() + 0.01);
+              }
 
-            if ((mass_trace.width() == 0) || (mass_trace.height() == 0))
-            {
-              // The mass trace contains only a single point. Add a small margin around
-              // the point, otherwise the mass trace is considered empty and not drawn.
-              // TODO: Remove the magic number for the margin.
-              mass_trace.enlarge(mass_trace.minX() - 0.01, mass_trace.minY() - 0.01);
-              mass_trace.enlarge(mass_trace.maxX() + 0.01, mass_trace.maxY() + 0.01);
+              if (!(mass_trace.isEmpty()))
+              {
+                ConvexHull2D hull;
+                hull.addPoint(DPosition<2>(mass_trace.minX(), mass_trace.minY()));
+                hull.addPoint(DPosition<2>(mass_trace.minX(), mass_trace.maxY()));
+                hull.addPoint(DPosition<2>(mass_trace.maxX(), mass_trace.minY()));
+                hull.addPoint(DPosition<2>(mass_trace.maxX(), mass_trace.maxY()));
+                feature.getConvexHulls().push_back(hull);
+              }
             }
 
-            if (!(mass_trace.isEmpty()))
-            {
-              ConvexHull2D hull;
-              hull.addPoint(DPosition<2>(mass_trace.minX(), mass_trace.minY()));
-              hull.addPoint(DPosition<2>(mass_trace.minX(), mass_trace.maxY()));
-              hull.addPoint(DPosition<2>(mass_trace.maxX(), mass_trace.minY()));
-              hull.addPoint(DPosition<2>(mass_trace.maxX(), mass_trace.maxY()));
-              feature.getConvexHulls().push_back(hull);
-            }
-          }
+            if (intensity_sum <= 0) continue;
 
-          if (intensity_sum <= 0) continue;
+            rt /= intensity_sum;
+            mz /= intensity_sum;
 
-          rt /= intensity_sum;
-          mz /= intensity_sum;
+            feature.setRT(rt);
+            feature.setMZ(mz);
+            feature.setIntensity(peptide_intensities[peptide]);
+            feature.setCharge(patterns[pattern].getCharge());
+            feature.setOverallQuality(1.0);
 
-          feature.setRT(rt);
-          feature.setMZ(mz);
-          feature.setIntensity(peptide_intensities[peptide]);
-          feature.setCharge(patterns[pattern].getCharge());
-          feature.setOverallQuality(1.0);
+            // Check that the feature eluted long enough.
+            // DBoundingBox<2> box = feature.getConvexHull().getBoundingBox();    // convex hull of the entire peptide feature
+            DBoundingBox<2> box = feature.getConvexHulls()[0].getBoundingBox();    // convex hull of the mono-isotopic mass trace
+            if (box.maxX() - box.minX() < static_cast<double>(param_.getValue("algorithm:rt_min")))
+            {
+              abort = true;
+              break;
+            }
 
-          // Check that the feature eluted long enough.
-          // DBoundingBox<2> box = feature.getConvexHull().getBoundingBox();    // convex hull of the entire peptide feature
-          DBoundingBox<2> box = feature.getConvexHulls()[0].getBoundingBox();    // convex hull of the mono-isotopic mass trace
-          if (box.maxX() - box.minX() < static_cast<double>(param_.getValue("algorithm:rt_min")))
-          {
-            abort = true;
-            break;
-          }
+            features.push_back(feature);
 
-          features.push_back(feature);
+            if (peptide == 0)
+            {
+              // The first/lightest peptide acts as anchor of the peptide multiplet consensus.
+              // All peptide feature handles are connected to this point.
+              consensus.setRT(rt);
+              consensus.setMZ(mz);
+              consensus.setIntensity(peptide_intensities[peptide]);
+              consensus.setCharge(patterns[pattern].getCharge());
+              consensus.setQuality(1.0);
+            }
 
-          if (peptide == 0)
-          {
-            // The first/lightest peptide acts as anchor of the peptide multiplet consensus.
-            // All peptide feature handles are connected to this point.
-            consensus.setRT(rt);
-            consensus.setMZ(mz);
-            consensus.setIntensity(peptide_intensities[peptide]);
-            consensus.setCharge(patterns[pattern].getCharge());
-            consensus.setQuality(1.0);
+            FeatureHandle feature_handle;
+            feature_handle.setRT(rt);
+            feature_handle.setMZ(mz);
+            feature_handle.setIntensity(peptide_intensities[peptide]);
+            feature_handle.setCharge(patterns[pattern].getCharge());
+            feature_handle.setMapIndex(peptide);
+            //feature_handle.setUniqueId(&UniqueIdInterface::setUniqueId);    // TODO: Do we need to set unique ID?
+            consensus.insert(feature_handle);
+            ++column_sizes_pattern[pattern][peptide];
           }
 
-          FeatureHandle feature_handle;
-          feature_handle.setRT(rt);
-          feature_handle.setMZ(mz);
-          feature_handle.setIntensity(peptide_intensities[peptide]);
-          feature_handle.setCharge(patterns[pattern].getCharge());
-          feature_handle.setMapIndex(peptide);
-          //feature_handle.setUniqueId(&UniqueIdInterface::setUniqueId);    // TODO: Do we need to set unique ID?
-          consensus.insert(feature_handle);
-          consensus_map_.getColumnHeaders()[peptide].size++;
-        }
-
-        if (!abort)
-        {
-          consensus_map_.push_back(consensus);
-          for (std::vector<Feature>::iterator it = features.begin(); it != features.end(); ++it)
+          if (!abort)
           {
-            feature_map_.push_back(*it);
+            consensus_pattern[pattern].push_back(consensus);
+            features_pattern[pattern].insert(features_pattern[pattern].end(), features.begin(), features.end());
           }
-        }
 
+        }
+      }
+      catch (...)
+      {
+#pragma omp critical (FeatureFinderMultiplexAlgorithm_error)
+        if (!error) error = std::current_exception();
       }
 
     }
+    if (error) std::rethrow_exception(error);
+
+    mergePatternResults_(features_pattern, consensus_pattern, column_sizes_pattern);
 
   }
 
   void FeatureFinderMultiplexAlgorithm::generateMapsProfile_(const std::vector<MultiplexIsotopicPeakPattern>& patterns, const std::vector<MultiplexFilteredMSExperiment>& filter_results, const std::vector<std::map<int, GridBasedCluster> >& cluster_results)
   {
     // progress logger
-    unsigned progress = 0;
+    Size progress = 0;
     startProgress(0, patterns.size(), "constructing maps");
 
+    // Patterns are processed in parallel. Features, consensus features and column header
+    // counts are collected per pattern and merged in pattern order afterwards.
+    std::vector<std::vector<Feature> > features_pattern(patterns.size());
+    std::vector<std::vector<ConsensusFeature> > consensus_pattern(patterns.size());
+    std::vector<std::vector<Size> > column_sizes_pattern(patterns.size());
+    std::exception_ptr error;
+
     // loop over peak patterns
-    for (unsigned pattern = 0; pattern < patterns.size(); ++pattern)
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize pattern = 0; pattern < (SignedSize) patterns.size(); ++pattern)
     {
-      setProgress(++progress);
+      IF_MASTERTHREAD setProgress(progress);
 
-      // loop over clusters
-      for (std::map<int, GridBasedCluster>::const_iterator cluster_it = cluster_results[pattern].begin(); cluster_it != cluster_results[pattern].end(); ++cluster_it)
+#pragma omp atomic
+      ++progress;
+
+      try
       {
-        GridBasedCluster cluster = cluster_it->second;
-        std::vector<int> points = cluster.getPoints();
-
-        // Construct a satellite set for the complete peptide multiplet
-        // Make sure there are no duplicates, i.e. the same satellite from different filtered peaks.
-        std::multimap<size_t, MultiplexSatelliteProfile > satellites;
-        // loop over points in cluster
-        for (std::vector<int>::const_iterator point_it = points.begin(); point_it != points.end(); ++point_it)
+        column_sizes_pattern[pattern].resize(patterns[pattern].getMassShiftCount(), 0);
+
+        // loop over clusters
+        for (std::map<int, GridBasedCluster>::const_iterator cluster_it = cluster_results[pattern].begin(); cluster_it != cluster_results[pattern].end(); ++cluster_it)
         {
-          MultiplexFilteredPeak peak = filter_results[pattern].getPeak(*point_it);
-          // loop over satellites of the peak
-          for (std::multimap<size_t, MultiplexSatelliteProfile >::const_iterator satellite_it = peak.getSatellitesProfile().begin(); satellite_it != peak.getSatellitesProfile().end(); ++satellite_it)
+          GridBasedCluster cluster = cluster_it->second;
+          std::vector<int> points = cluster.getPoints();
+
+          // Construct a satellite set for the complete peptide multiplet
+          // Make sure there are no duplicates, i.e. the same satellite from different filtered peaks.
+          std::multimap<size_t, MultiplexSatelliteProfile > satellites;
+          // loop over points in cluster
+          for (std::vector<int>::const_iterator point_it = points.begin(); point_it != points.end(); ++point_it)
           {
-            satellites.insert(std::make_pair(satellite_it->first, MultiplexSatelliteProfile(satellite_it->second.getRT(), satellite_it->second.getMZ(), satellite_it->second.getIntensity())));
+            MultiplexFilteredPeak peak = filter_results[pattern].getPeak(*point_it);
+            // loop over satellites of the peak
+            for (std::multimap<size_t, MultiplexSatelliteProfile >::const_iterator satellite_it = peak.getSatellitesProfile().begin(); satellite_it != peak.getSatellitesProfile().end(); ++satellite_it)
+            {
+              satellites.insert(std::make_pair(satellite_it->first, MultiplexSatelliteProfile(satellite_it->second.getRT(), satellite_it->second.getMZ(), satellite_it->second.getIntensity())));
+            }
           }
-        }
 
-        // determine peptide intensities
-        std::vector<double> peptide_intensities = determinePeptideIntensitiesProfile_(patterns[pattern], satellites);
+          // determine peptide intensities
+          std::vector<double> peptide_intensities = determinePeptideIntensitiesProfile_(patterns[pattern], satellites);
 
-        // If no reliable peptide intensity can be determined for one of the peptides, we do not report the peptide multiplet.
-        if (std::find(peptide_intensities.begin(), peptide_intensities.end(), -1.0) != peptide_intensities.end())
-        {
-          continue;
-        }
+          // If no reliable peptide intensity can be determined for one of the peptides, we do not report the peptide multiplet.
+          if (std::find(peptide_intensities.begin(), peptide_intensities.end(), -1.0) != peptide_intensities.end())
+          {
+            continue;
+          }
 
-        std::vector<Feature> features;
-        ConsensusFeature consensus;
-        bool abort = false;
+          std::vector<Feature> features;
+          ConsensusFeature consensus;
+          bool abort = false;
 
-        // construct the feature and consensus maps
-        // loop over peptides
-        for (size_t peptide = 0; (peptide < patterns[pattern].getMassShiftCount() && !abort); ++peptide)
-        {
-          // coordinates of the peptide feature
-          // RT is the intensity-average of all satellites peaks of the mono-isotopic mass trace
-          // m/z is the intensity-average of all satellites peaks of the mono-isotopic mass trace
-          Feature feature;
-          double rt(0);
-          double mz(0);
-          double intensity_sum(0);
-
-          // loop over isotopes i.e. mass traces of the peptide
-          for (size_t isotope = 0; isotope < isotopes_per_peptide_max_; ++isotope)
+          // construct the feature and consensus maps
+          // loop over peptides
+          for (size_t peptide = 0; (peptide < patterns[pattern].getMassShiftCount() && !abort); ++peptide)
           {
-            // find satellites for this isotope i.e. mass trace
-            size_t idx = peptide * isotopes_per_peptide_max_ + isotope;
-            std::pair<std::multimap<size_t, MultiplexSatelliteProfile >::const_iterator, std::multimap<size_t, MultiplexSatelliteProfile >::const_iterator> satellites_isotope;
-            satellites_isotope = satellites.equal_range(idx);
+            // coordinates of the peptide feature
+            // RT is the intensity-average of all satellites peaks of the mono-isotopic mass trace
+            // m/z is the intensity-average of all satellites peaks of the mono-isotopic mass trace
+            Feature feature;
+            double rt(0);
+            double mz(0);
+            double intensity_sum(0);
+
+            // loop over isotopes i.e. mass traces of the peptide
+            for (size_t isotope = 0; isotope < isotopes_per_peptide_max_; ++isotope)
+            {
+              // find satellites for this isotope i.e. mass trace
+              size_t idx = peptide * isotopes_per_peptide_max_ + isotope;
+              std::pair<std::multimap<size_t, MultiplexSatelliteProfile >::const_iterator, std::multimap<size_t, MultiplexSatelliteProfile >::const_iterator> satellites_isotope;
+              satellites_isotope = satellites.equal_range(idx);
 
-            DBoundingBox<2> mass_trace;
+              DBoundingBox<2> mass_trace;
 
-            // loop over satellites for this isotope i.e. mass trace
-            for (std::multimap<size_t, MultiplexSatelliteProfile >::const_iterator satellite_it = satellites_isotope.first; satellite_it != satellites_isotope.second; ++satellite_it)
-            {
-              if (isotope == 0)
+              // loop over satellites for this isotope i.e. mass trace
+              for (std::multimap<size_t, MultiplexSatelliteProfile >::const_iterator satellite_it = satellites_isotope.first; satellite_it != satellites_isotope.second; ++satellite_it)
               {
-                // Satellites of zero intensity makes sense (borders of peaks), but mess up feature/consensus construction.
-                double intensity_temp = (satellite_it->second).getIntensity() + 0.0001;
+                if (isotope == 0)
+                {
+                  // Satellites of zero intensity makes sense (borders of peaks), but mess up feature/consensus construction.
+                  double intensity_temp = (satellite_it->second).getIntensity() + 0.0001;
 
-                rt += (satellite_it->second).getRT() * intensity_temp;
-                mz += (satellite_it->second).getMZ() * intensity_temp;
-                intensity_sum += intensity_temp;
+                  rt += (satellite_it->second).getRT() * intensity_temp;
+                  mz += (satellite_it->second).getMZ() * intensity_temp;
+                  intensity_sum += intensity_temp;
+                }
+
+                mass_trace.enlarge((satellite_it->second).getRT(), (satellite_it->second).getMZ());
               }
 
-              mass_trace.enlarge((satellite_it->second).getRT(), (satellite_it->second).getMZ());
-            }
+              if ((mass_trace.width() == 0) || (mass_trace.height() == 0))
+              {
+                // The mass trace contains only a single point. Add a small margin around
+                // the point, otherwise the mass trace is considered empty and not drawn.
+                // TODO: Remove the magic number for the margin.
+                mass_trace.enlarge(mass_trace.minX() - 0.01, mass_trace.minY() - 0.01);
+                mass_trace.enlarge(mass_trace.maxX() + 0.01, mass_trace.maxY() + 0.01);
+              }
 
-            if ((mass_trace.width() == 0) || (mass_trace.height() == 0))
-            {
-              // The mass trace contains only a single point. Add a small margin around
-              // the point, otherwise the mass trace is considered empty and not drawn.
-              // TODO: Remove the magic number for the margin.
-              mass_trace.enlarge(mass_trace.minX() - 0.01, mass_trace.minY() - 0.01);
-              mass_trace.enlarge(mass_trace.maxX() + 0.01, mass_trace.maxY() + 0.01);
+              if (!(mass_trace.isEmpty()))
+              {
+                ConvexHull2D hull;
+                hull.addPoint(DPosition<2>(mass_trace.minX(), mass_trace.minY()));
+                hull.addPoint(DPosition<2>(mass_trace.minX(), mass_trace.maxY()));
+                hull.addPoint(DPosition<2>(mass_trace.maxX(), mass_trace.minY()));
+                hull.addPoint(DPosition<2>(mass_trace.maxX(), mass_trace.maxY()));
+                feature.getConvexHulls().push_back(hull);
+              }
             }
 
-            if (!(mass_trace.isEmpty()))
+            rt /= intensity_sum;
+            mz /= intensity_sum;
+
+            feature.setRT(rt);
+            feature.setMZ(mz);
+            feature.setIntensity(peptide_intensities[peptide]);
+            feature.setCharge(patterns[pattern].getCharge());
+            feature.setOverallQuality(1.0);
+
+            // Check that the feature eluted long enough.
+            // DBoundingBox<2> box = feature.getConvexHull().getBoundingBox();    // convex hull of the entire peptide feature
+            DBoundingBox<2> box = feature.getConvexHulls()[0].getBoundingBox();    // convex hull of the mono-isotopic mass trace
+            if (box.maxX() - box.minX() < static_cast<double>(param_.getValue("algorithm:rt_min")))
             {
-              ConvexHull2D hull;
-              hull.addPoint(DPosition<2>(mass_trace.minX(), mass_trace.minY()));
-              hull.addPoint(DPosition<2>(mass_trace.minX(), mass_trace.maxY()));
-              hull.addPoint(DPosition<2>(mass_trace.maxX(), mass_trace.minY()));
-              hull.addPoint(DPosition<2>(mass_trace.maxX(), mass_trace.maxY()));
-              feature.getConvexHulls().push_back(hull);
+              abort = true;
+              break;
             }
-          }
 
-          rt /= intensity_sum;
-          mz /= intensity_sum;
+            features.push_back(feature);
 
-          feature.setRT(rt);
-          feature.setMZ(mz);
-          feature.setIntensity(peptide_intensities[peptide]);
-          feature.setCharge(patterns[pattern].getCharge());
-          feature.setOverallQuality(1.0);
+            if (peptide == 0)
+            {
+              // The first/lightest peptide acts as anchor of the peptide multiplet consensus.
+              // All peptide feature handles are connected to this point.
+              consensus.setRT(rt);
+              consensus.setMZ(mz);
+              consensus.setIntensity(peptide_intensities[peptide]);
+              consensus.setCharge(patterns[pattern].getCharge());
+              consensus.setQuality(1.0);
+            }
 
-          // Check that the feature eluted long enough.
-          // DBoundingBox<2> box = feature.getConvexHull().getBoundingBox();    // convex hull of the entire peptide feature
-          DBoundingBox<2> box = feature.getConvexHulls()[0].getBoundingBox();    // convex hull of the mono-isotopic mass trace
-          if (box.maxX() - box.minX() < static_cast<double>(param_.getValue("algorithm:rt_min")))
-          {
-            abort = true;
-            break;
+            FeatureHandle feature_handle;
+            feature_handle.setRT(rt);
+            feature_handle.setMZ(mz);
+            feature_handle.setIntensity(peptide_intensities[peptide]);
+            feature_handle.setCharge(patterns[pattern].getCharge());
+            feature_handle.setMapIndex(peptide);
+            //feature_handle.setUniqueId(&UniqueIdInterface::setUniqueId);    // TODO: Do we need to set unique ID?
+            consensus.insert(feature_handle);
+            ++column_sizes_pattern[pattern][peptide];
           }
 
-          features.push_back(feature);
-
-          if (peptide == 0)
+          if (!abort)
           {
-            // The first/lightest peptide acts as anchor of the peptide multiplet consensus.
-            // All peptide feature handles are connected to this point.
-            consensus.setRT(rt);
-            consensus.setMZ(mz);
-            consensus.setIntensity(peptide_intensities[peptide]);
-            consensus.setCharge(patterns[pattern].getCharge());
-            consensus.setQuality(1.0);
+            consensus_pattern[pattern].push_back(consensus);
+            features_pattern[pattern].insert(features_pattern[pattern].end(), features.begin(), features.end());
           }
 
-          FeatureHandle feature_handle;
-          feature_handle.setRT(rt);
-          feature_handle.setMZ(mz);
-          feature_handle.setIntensity(peptide_intensities[peptide]);
-          feature_handle.setCharge(patterns[pattern].getCharge());
-          feature_handle.setMapIndex(peptide);
-          //feature_handle.setUniqueId(&UniqueIdInterface::setUniqueId);    // TODO: Do we need to set unique ID?
-          consensus.insert(feature_handle);
-          consensus_map_.getColumnHeaders()[peptide].size++;
         }
-
-        if (!abort)
-        {
-          consensus_map_.push_back(consensus);
-          for (std::vector<Feature>::iterator it = features.begin(); it != features.end(); ++it)
-          {
-            feature_map_.push_back(*it);
-          }
-        }
-
+      }
+      catch (...)
+      {
+#pragma omp critical (FeatureFinderMultiplexAlgorithm_error)
+        if (!error) error = std::current_exception();
       }
 
     }
+    if (error) std::rethrow_exception(error);
+
+    mergePatternResults_(features_pattern, consensus_pattern, column_sizes_pattern);
 
     endProgress();
   }
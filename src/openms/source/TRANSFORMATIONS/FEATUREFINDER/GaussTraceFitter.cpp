@@ -84,10 +84,8 @@ namespace OpenMS
     x_init(1) = x0_;
     x_init(2) = sigma_;
 
-    TraceFitter::ModelData data;
-    data.traces_ptr = &traces;
-    data.weighted = this->weighted_;
-    GaussTraceFunctor functor(NUM_PARAMS_, &data);
+    model_data_.setTraces(traces, this->weighted_);
+    GaussTraceFunctor functor(NUM_PARAMS_, &model_data_);
 
     TraceFitter::optimize_(x_init, functor);
   }
@@ -173,17 +171,16 @@ namespace OpenMS
     double sig = x(2);
     double c_fac = -0.5 / pow(sig, 2);
 
-    Size count = 0;
-    for (Size t = 0; t < m_data->traces_ptr->size(); ++t)
+    const double baseline = m_data->traces_ptr->baseline;
+    const double* rts = m_data->rt.data();
+    const double* intensities = m_data->intensity.data();
+    const double* theoretical_ints = m_data->theoretical_int.data();
+    const double* weights = m_data->weight.data();
+    const Size count = m_data->rt.size();
+    for (Size i = 0; i < count; ++i)
     {
-      const FeatureFinderAlgorithmPickedHelperStructs::MassTrace& trace = (*m_data->traces_ptr)[t];
-      double weight = m_data->weighted ? trace.theoretical_int : 1.0;
-      for (Size i = 0; i < trace.peaks.size(); ++i)
-      {
-        fvec(count) = (m_data->traces_ptr->baseline + trace.theoretical_int * height
-                       * exp(c_fac * pow(trace.peaks[i].first - x0, 2)) - trace.peaks[i].second->getIntensity()) * weight;
-        ++count;
-      }
+      fvec(i) = (baseline + theoretical_ints[i] * height
+                 * exp(c_fac * pow(rts[i] - x0, 2)) - intensities[i]) * weights[i];
     }
 
     return 0;
@@ -199,20 +196,17 @@ namespace OpenMS
     double sig_3 = pow(sig, 3);
     double c_fac = -0.5 / sig_sq;
 
-    Size count = 0;
-    for (Size t = 0; t < m_data->traces_ptr->size(); ++t)
+    const double* rts = m_data->rt.data();
+    const double* theoretical_ints = m_data->theoretical_int.data();
+    const double* weights = m_data->weight.data();
+    const Size count = m_data->rt.size();
+    for (Size i = 0; i < count; ++i)
     {
-      const FeatureFinderAlgorithmPickedHelperStructs::MassTrace& trace = (*m_data->traces_ptr)[t];
-      double weight = m_data->weighted ? trace.theoretical_int : 1.0;
-      for (Size i = 0; i < trace.peaks.size(); ++i)
-      {
-        double rt = trace.peaks[i].first;
-        double e = exp(c_fac * pow(rt - x0, 2));
-        J(count, 0) = trace.theoretical_int * e * weight;
-        J(count, 1) = trace.theoretical_int * height * e * (rt - x0) / sig_sq * weight;
-        J(count, 2) = 0.125* trace.theoretical_int* height* e* pow(rt - x0, 2) / sig_3 * weight;
-        ++count;
-      }
+      double rt = rts[i];
+      double e = exp(c_fac * pow(rt - x0, 2));
+      J(i, 0) = theoretical_ints[i] * e * weights[i];
+      J(i, 1) = theoretical_ints[i] * height * e * (rt - x0) / sig_sq * weights[i];
+      J(i, 2) = 0.125* theoretical_ints[i]* height* e* pow(rt - x0, 2) / sig_3 * weights[i];
     }
     return 0;
   }
@@ -44,6 +44,12 @@
 
 #include<QDir>
 
+#include <exception>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 
 namespace OpenMS
@@ -172,21 +178,55 @@ namespace OpenMS
 
   std::vector<std::map<int, GridBasedCluster> > MultiplexClustering::cluster(const std::vector<MultiplexFilteredMSExperiment>& filter_results)
   {
+    // split each filter result into blocks which cannot interact during clustering
+    std::vector<std::vector<double> > mz(filter_results.size());
+    std::vector<std::vector<double> > rt(filter_results.size());
+    std::vector<std::pair<Size, std::vector<int> > > blocks;
+    for (Size i = 0; i < filter_results.size(); ++i)
+    {
+      mz[i] = filter_results[i].getMZ();
+      rt[i] = filter_results[i].getRT();
+      std::vector<std::vector<int> > blocks_pattern = splitIntoBlocks_(rt[i]);
+      for (std::vector<int>& block : blocks_pattern)
+      {
+        blocks.push_back(std::make_pair(i, std::vector<int>()));
+        blocks.back().second.swap(block);
+      }
+    }
+
     // progress logger
-    unsigned progress = 0;
-    startProgress(0, filter_results.size(), "clustering filtered LC-MS data");
-      
-    std::vector<std::map<int, GridBasedCluster> > cluster_results;
+    Size progress = 0;
+    startProgress(0, blocks.size(), "clustering filtered LC-MS data");
 
-    // loop over patterns i.e. cluster each of the corresponding filter results
-    for (unsigned i = 0; i < filter_results.size(); ++i)
+    // cluster all blocks of all patterns in parallel
+    std::vector<std::map<int, GridBasedCluster> > block_results(blocks.size());
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize b = 0; b < (SignedSize) blocks.size(); ++b)
     {
-      setProgress(++progress);
-        
-      GridBasedClustering<MultiplexDistance> clustering(MultiplexDistance(rt_scaling_), filter_results[i].getMZ(), filter_results[i].getRT(), grid_spacing_mz_, grid_spacing_rt_);
-      clustering.cluster();
-      //clustering.extendClustersY();
-      cluster_results.push_back(clustering.getResults());
+      IF_MASTERTHREAD setProgress(progress);
+
+#pragma omp atomic
+      ++progress;
+
+      try
+      {
+        const Size pattern = blocks[b].first;
+        block_results[b] = clusterBlock_(mz[pattern], rt[pattern], blocks[b].second);
+      }
+      catch (...)
+      {
+#pragma omp critical (MultiplexClustering_error)
+        if (!error) error = std::current_exception();
+      }
+    }
+    if (error) std::rethrow_exception(error);
+
+    // merge block results in a fixed order, cluster indices of different blocks are disjoint
+    std::vector<std::map<int, GridBasedCluster> > cluster_results(filter_results.size());
+    for (Size b = 0; b < blocks.size(); ++b)
+    {
+      cluster_results[blocks[b].first].insert(block_results[b].begin(), block_results[b].end());
     }
 
     endProgress();
@@ -194,6 +234,92 @@ namespace OpenMS
     return cluster_results;
   }
 
+  std::vector<std::vector<int> > MultiplexClustering::splitIntoBlocks_(const std::vector<double>& rt) const
+  {
+    // RT cell of each point, same convention as in ClusteringGrid::getIndex()
+    std::vector<std::pair<int, int> > cells;
+    cells.reserve(rt.size());
+    for (Size i = 0; i < rt.size(); ++i)
+    {
+      int cell = std::upper_bound(grid_spacing_rt_.begin(), grid_spacing_rt_.end(), rt[i]) - grid_spacing_rt_.begin();
+      cells.push_back(std::make_pair(cell, (int) i));
+    }
+    std::sort(cells.begin(), cells.end());
+
+    std::vector<std::vector<int> > blocks;
+    for (Size i = 0; i < cells.size(); ++i)
+    {
+      // Clusters are only compared to clusters in neighbouring cells. Start a new block
+      // whenever there is at least one empty row of cells in between.
+      if (i == 0 || cells[i].first - cells[i - 1].first > 1)
+      {
+        blocks.push_back(std::vector<int>());
+      }
+      blocks.back().push_back(cells[i].second);
+    }
+
+    // keep the original point order within each block, it determines how ties are resolved
+    for (std::vector<int>& block : blocks)
+    {
+      std::sort(block.begin(), block.end());
+    }
+
+    return blocks;
+  }
+
+  namespace
+  {
+    // grid boundaries enclosing all cells between min and max
+    std::vector<double> sliceGridSpacing(const std::vector<double>& grid_spacing, double min, double max)
+    {
+      SignedSize first = std::upper_bound(grid_spacing.begin(), grid_spacing.end(), min) - grid_spacing.begin();
+      SignedSize last = std::upper_bound(grid_spacing.begin(), grid_spacing.end(), max) - grid_spacing.begin();
+      first = std::max(first - 1, (SignedSize) 0);
+      last = std::min(last, (SignedSize) grid_spacing.size() - 1);
+      return std::vector<double>(grid_spacing.begin() + first, grid_spacing.begin() + last + 1);
+    }
+  }
+
+  std::map<int, GridBasedCluster> MultiplexClustering::clusterBlock_(const std::vector<double>& mz, const std::vector<double>& rt, const std::vector<int>& block) const
+  {
+    std::vector<double> block_mz;
+    std::vector<double> block_rt;
+    block_mz.reserve(block.size());
+    block_rt.reserve(block.size());
+    for (int i : block)
+    {
+      block_mz.push_back(mz[i]);
+      block_rt.push_back(rt[i]);
+    }
+
+    // The restricted grid keeps the cell boundaries of the full grid, hence the clustering is identical.
+    std::pair<std::vector<double>::const_iterator, std::vector<double>::const_iterator> mz_range = std::minmax_element(block_mz.begin(), block_mz.end());
+    std::pair<std::vector<double>::const_iterator, std::vector<double>::const_iterator> rt_range = std::minmax_element(block_rt.begin(), block_rt.end());
+    std::vector<double> grid_spacing_mz = sliceGridSpacing(grid_spacing_mz_, *mz_range.first, *mz_range.second);
+    std::vector<double> grid_spacing_rt = sliceGridSpacing(grid_spacing_rt_, *rt_range.first, *rt_range.second);
+
+    GridBasedClustering<MultiplexDistance> clustering(MultiplexDistance(rt_scaling_), block_mz, block_rt, grid_spacing_mz, grid_spacing_rt);
+    clustering.cluster();
+    //clustering.extendClustersY();
+
+    // map cluster and point indices back to the complete filter result
+    std::map<int, GridBasedCluster> cluster_results;
+    std::map<int, GridBasedCluster> block_results = clustering.getResults();
+    for (std::map<int, GridBasedCluster>::const_iterator it = block_results.begin(); it != block_results.end(); ++it)
+    {
+      const GridBasedCluster& cluster = it->second;
+      std::vector<int> points;
+      points.reserve(cluster.getPoints().size());
+      for (int p : cluster.getPoints())
+      {
+        points.push_back(block[p]);
+      }
+      cluster_results.insert(cluster_results.end(), std::make_pair(block[it->first], GridBasedCluster(cluster.getCentre(), cluster.getBoundingBox(), points, cluster.getPropertyA(), cluster.getPropertiesB())));
+    }
+
+    return cluster_results;
+  }
+
   MultiplexClustering::MultiplexDistance::MultiplexDistance(double rt_scaling)
   : rt_scaling_(rt_scaling)
   {
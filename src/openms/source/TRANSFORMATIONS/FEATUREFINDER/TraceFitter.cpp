@@ -98,6 +98,34 @@ namespace OpenMS
     weighted_ = this->param_.getValue("weighted") == "true";
   }
 
+  void TraceFitter::ModelData::setTraces(FeatureFinderAlgorithmPickedHelperStructs::MassTraces& traces, bool weighted_fit)
+  {
+    traces_ptr = &traces;
+    weighted = weighted_fit;
+
+    rt.clear();
+    intensity.clear();
+    theoretical_int.clear();
+    weight.clear();
+    Size peak_count = traces.getPeakCount();
+    rt.reserve(peak_count);
+    intensity.reserve(peak_count);
+    theoretical_int.reserve(peak_count);
+    weight.reserve(peak_count);
+
+    for (const FeatureFinderAlgorithmPickedHelperStructs::MassTrace& trace : traces)
+    {
+      double trace_weight = weighted ? trace.theoretical_int : 1.0;
+      for (const std::pair<double, const Peak1D*>& peak : trace.peaks)
+      {
+        rt.push_back(peak.first);
+        intensity.push_back(peak.second->getIntensity());
+        theoretical_int.push_back(trace.theoretical_int);
+        weight.push_back(trace_weight);
+      }
+    }
+  }
+
   void TraceFitter::optimize_(Eigen::VectorXd& x_init, GenericFunctor& functor)
   {
     //TODO: this function is copy&paste from LevMarqFitter1d.h. Make a generic wrapper for
@@ -0,0 +1,151 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+// OpenMS_GUI config
+#include <OpenMS/VISUAL/OpenMS_GUIConfig.h>
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/KERNEL/StandardTypes.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Multi-resolution maximum intensity grid over RT x m/z of the MS1 spectra of a peak map (like image mipmaps)
+
+    Level 0 has the finest bins. Each further level halves the number of bins in both dimensions, i.e. a bin holds
+    the maximum of 2x2 bins of the level below, until a single bin is left. All levels share the origin
+    (getRTMin(), getMZMin()).
+
+    The number of RT bins of level 0 is the number of MS1 spectra (but at most 4096) and the number of m/z bins is chosen
+    such that level 0 contains at most @p max_cells bins. The whole pyramid needs about 4/3 * 4 bytes per level 0 bin.
+
+    Plot2DCanvas uses the pyramid to paint the maximum intensities of large maps: if the bins of a level are not larger
+    than a pixel, painting needs time proportional to the number of pixels instead of the number of visible peaks.
+
+    @ingroup Visual
+  */
+  class OPENMS_GUI_DLLAPI IntensityPyramid
+  {
+public:
+    /// One level of the pyramid
+    struct Level
+    {
+      /// number of bins in RT dimension
+      Size rt_bins = 0;
+      /// number of bins in m/z dimension
+      Size mz_bins = 0;
+      /// width of a bin in RT dimension
+      double rt_bin_width = 0;
+      /// width of a bin in m/z dimension
+      double mz_bin_width = 0;
+      /// maximum intensity of each bin, stored row-wise (one row per RT bin). Bins without data are -1.
+      std::vector<float> max_intensity;
+
+      /// maximum intensity of the given bin (-1 if it contains no data)
+      float getMaxIntensity(Size rt_bin, Size mz_bin) const
+      {
+        return max_intensity[rt_bin * mz_bins + mz_bin];
+      }
+    };
+
+    /// Default constructor (empty pyramid)
+    IntensityPyramid() = default;
+
+    /**
+      @brief Builds the pyramid from the MS1 spectra of @p map
+
+      @param map The peak data (spectra sorted by RT and peaks sorted by m/z)
+      @param max_cells Maximum number of bins of level 0
+      @param coarser_levels Also compute the coarser levels? If false, only level 0 is built and addCoarserLevels() can be called later.
+    */
+    explicit IntensityPyramid(const PeakMap& map, Size max_cells = Size(1) << 24, bool coarser_levels = true);
+
+    /**
+      @brief Computes the coarser levels from level 0 (if not done yet)
+
+      Does not access the peak map the pyramid was built from, i.e. it can run in another thread while the map is modified.
+    */
+    void addCoarserLevels();
+
+    /// true if the map contained no MS1 peaks
+    bool empty() const
+    {
+      return levels_.empty();
+    }
+
+    /// number of levels
+    Size size() const
+    {
+      return levels_.size();
+    }
+
+    /// returns the given level (0 = finest)
+    const Level& getLevel(Size level) const
+    {
+      return levels_[level];
+    }
+
+    /**
+      @brief Returns the coarsest level whose bins are not larger than @p rt_bin_width x @p mz_bin_width
+
+      @return The level index, or size() if even the bins of level 0 are too large
+    */
+    Size findLevel(double rt_bin_width, double mz_bin_width) const;
+
+    /// smallest RT of the MS1 spectra
+    double getRTMin() const
+    {
+      return rt_min_;
+    }
+
+    /// smallest m/z of the MS1 peaks
+    double getMZMin() const
+    {
+      return mz_min_;
+    }
+
+protected:
+    /// smallest RT
+    double rt_min_ = 0;
+    /// smallest m/z
+    double mz_min_ = 0;
+    /// levels, finest first
+    std::vector<Level> levels_;
+  };
+
+} // namespace OpenMS
@@ -55,12 +55,15 @@
 
 #include <vector>
 #include <bitset>
+#include <future>
+#include <memory>
 
 class QWidget;
 
 namespace OpenMS
 {
 
+  class IntensityPyramid;
   class OnDiscMSExperiment;
   class OSWData;
 
@@ -225,6 +228,9 @@ public:
     cached on disk.
 
     @note Do *not* use this function to access the current spectrum for the 1D view, use getCurrentSpectrum() instead.
+
+    @note Do *not* modify peaks (or their order) through this pointer while the layer is shown, since the intensity
+    pyramid may be built from them concurrently (see getIntensityPyramid()). Use setPeakData() to replace the peak data instead.
     */
     const ExperimentSharedPtrType & getPeakDataMuteable() {return peak_map_;}
 
@@ -234,9 +240,22 @@ public:
     void setPeakData(ExperimentSharedPtrType p)
     {
       peak_map_ = p;
+      intensity_pyramid_ = std::shared_future<std::shared_ptr<const IntensityPyramid> >();
       updateCache_();
     }
 
+    /**
+    @brief Returns the multi-resolution maximum intensity pyramid of the peak data (used by the 2D view)
+
+    The first call starts building the pyramid in a background thread and returns a null pointer, as does
+    every call until the pyramid is ready. Callers fall back to the raw peak data in this case.
+    The background thread holds its own reference to the peak data, so replacing it with setPeakData()
+    (which discards the pyramid) is safe at any time, whereas modifying the peaks in place is not.
+
+    @return The pyramid, or a null pointer if this is not a peak layer or the pyramid is not ready yet
+    */
+    std::shared_ptr<const IntensityPyramid> getIntensityPyramid() const;
+
     /// Set the current on-disc data
     void setOnDiscPeakData(ODExperimentSharedPtrType p)
     {
@@ -511,6 +530,9 @@ private:
 
     /// Current cached spectrum
     ExperimentType::SpectrumType cached_spectrum_;
+
+    /// Intensity pyramid of the peak data (built on demand in a background thread)
+    mutable std::shared_future<std::shared_ptr<const IntensityPyramid> > intensity_pyramid_;
   };
 
   /// A base class to annotate layers of specific types with (identification) data
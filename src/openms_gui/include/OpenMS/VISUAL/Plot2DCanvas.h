@@ -40,6 +40,7 @@
 // OpenMS
 #include <OpenMS/VISUAL/PlotCanvas.h>
 #include <OpenMS/VISUAL/Plot1DCanvas.h>
+#include <OpenMS/VISUAL/IntensityPyramid.h>
 #include <OpenMS/KERNEL/PeakIndex.h>
 
 // QT
@@ -192,6 +193,20 @@ protected:
     */
     void paintMaximumIntensities_(Size layer_index, Size rt_pixel_count, Size mz_pixel_count, QPainter& p);
 
+    /**
+      @brief Paints maximum intensities from a level of the layer's intensity pyramid (see LayerData::getIntensityPyramid()).
+
+      Each bin of the level is assigned to the pixel containing its center. The bins must not be larger than a pixel.
+
+      @param layer_index The index of the layer.
+      @param level The pyramid level to paint from.
+      @param rt_origin The RT of the lower border of the first bin.
+      @param mz_origin The m/z of the lower border of the first bin.
+      @param rt_pixel_count
+      @param mz_pixel_count
+    */
+    void paintMaximumIntensitiesFromPyramid_(Size layer_index, const IntensityPyramid::Level& level, double rt_origin, double mz_origin, Size rt_pixel_count, Size mz_pixel_count);
+
     /**
       @brief Paints the precursor peaks.
 
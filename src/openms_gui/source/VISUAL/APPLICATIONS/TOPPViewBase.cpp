@@ -2708,17 +2708,20 @@ namespace OpenMS
     // reload data
     if (layer.type == LayerData::DT_PEAK) //peak data
     {
+      // load into a new map instead of in place, since the intensity pyramid of the layer may still be built from the old one
+      ExperimentSharedPtrType new_exp(new ExperimentType());
       try
       {
-        FileHandler().loadExperiment(layer.filename, *layer.getPeakDataMuteable());
+        FileHandler().loadExperiment(layer.filename, *new_exp);
       }
       catch (Exception::BaseException& e)
       {
         QMessageBox::critical(this, "Error", (String("Error while loading file") + layer.filename + "\nError message: " + e.what()).toQString());
-        layer.getPeakDataMuteable()->clear(true);
+        new_exp->clear(true);
       }
-      layer.getPeakDataMuteable()->sortSpectra(true);
-      layer.getPeakDataMuteable()->updateRanges(1);
+      new_exp->sortSpectra(true);
+      new_exp->updateRanges(1);
+      layer.setPeakData(new_exp);
     }
     else if (layer.type == LayerData::DT_FEATURE) //feature data
     {
@@ -2749,17 +2752,20 @@ namespace OpenMS
     else if (layer.type == LayerData::DT_CHROMATOGRAM) //chromatogram
     {
       //TODO CHROM
+      // load into a new map instead of in place, since the intensity pyramid of the layer may still be built from the old one
+      ExperimentSharedPtrType new_exp(new ExperimentType());
       try
       {
-        FileHandler().loadExperiment(layer.filename, *layer.getPeakDataMuteable());
+        FileHandler().loadExperiment(layer.filename, *new_exp);
       }
       catch (Exception::BaseException& e)
       {
         QMessageBox::critical(this, "Error", (String("Error while loading file") + layer.filename + "\nError message: " + e.what()).toQString());
-        layer.getPeakDataMuteable()->clear(true);
+        new_exp->clear(true);
       }
-      layer.getPeakDataMuteable()->sortChromatograms(true);
-      layer.getPeakDataMuteable()->updateRanges(1);
+      new_exp->sortChromatograms(true);
+      new_exp->updateRanges(1);
+      layer.setPeakData(new_exp);
     }
 
     // update all layers that need an update
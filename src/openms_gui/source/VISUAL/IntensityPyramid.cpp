@@ -0,0 +1,134 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/VISUAL/IntensityPyramid.h>
+
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <algorithm>
+
+namespace OpenMS
+{
+  namespace
+  {
+    /// bin of @p offset from the origin (clamped to the valid bins)
+    Size binIndex(double offset, double bin_width, Size bins)
+    {
+      if (offset <= 0) return 0;
+      return std::min(Size(offset / bin_width), bins - 1);
+    }
+  }
+
+  IntensityPyramid::IntensityPyramid(const PeakMap& map, Size max_cells, bool coarser_levels)
+  {
+    // range of the MS1 data
+    Size ms1_count(0);
+    double rt_max(0), mz_max(0);
+    for (const MSSpectrum& spec : map)
+    {
+      if (spec.getMSLevel() != 1 || spec.empty()) continue;
+      if (ms1_count == 0)
+      {
+        rt_min_ = rt_max = spec.getRT();
+        mz_min_ = spec.front().getMZ();
+        mz_max = spec.back().getMZ();
+      }
+      rt_min_ = std::min(rt_min_, spec.getRT());
+      rt_max = std::max(rt_max, spec.getRT());
+      mz_min_ = std::min(mz_min_, spec.front().getMZ());
+      mz_max = std::max(mz_max, spec.back().getMZ());
+      ++ms1_count;
+    }
+    if (ms1_count == 0) return;
+
+    // level 0
+    Level base;
+    base.rt_bins = std::min(ms1_count, Size(4096));
+    base.mz_bins = std::max(Size(1), std::min(max_cells / base.rt_bins, Size(65536)));
+    base.rt_bin_width = (rt_max > rt_min_) ? (rt_max - rt_min_) / base.rt_bins : 1.0;
+    base.mz_bin_width = (mz_max > mz_min_) ? (mz_max - mz_min_) / base.mz_bins : 1.0;
+    base.max_intensity.assign(base.rt_bins * base.mz_bins, -1.0f);
+    for (const MSSpectrum& spec : map)
+    {
+      if (spec.getMSLevel() != 1) continue;
+      float* row = &base.max_intensity[binIndex(spec.getRT() - rt_min_, base.rt_bin_width, base.rt_bins) * base.mz_bins];
+      for (const Peak1D& peak : spec)
+      {
+        float& bin = row[binIndex(peak.getMZ() - mz_min_, base.mz_bin_width, base.mz_bins)];
+        bin = std::max(bin, peak.getIntensity());
+      }
+    }
+    levels_.push_back(std::move(base));
+
+    if (coarser_levels) addCoarserLevels();
+  }
+
+  void IntensityPyramid::addCoarserLevels()
+  {
+    if (levels_.empty()) return;
+    // coarser levels: maximum of 2x2 bins
+    while (levels_.back().rt_bins > 1 || levels_.back().mz_bins > 1)
+    {
+      const Level& fine = levels_.back();
+      Level coarse;
+      coarse.rt_bins = (fine.rt_bins + 1) / 2;
+      coarse.mz_bins = (fine.mz_bins + 1) / 2;
+      coarse.rt_bin_width = fine.rt_bin_width * 2;
+      coarse.mz_bin_width = fine.mz_bin_width * 2;
+      coarse.max_intensity.assign(coarse.rt_bins * coarse.mz_bins, -1.0f);
+      for (Size rt = 0; rt < fine.rt_bins; ++rt)
+      {
+        const float* fine_row = &fine.max_intensity[rt * fine.mz_bins];
+        float* coarse_row = &coarse.max_intensity[(rt / 2) * coarse.mz_bins];
+        for (Size mz = 0; mz < fine.mz_bins; ++mz)
+        {
+          coarse_row[mz / 2] = std::max(coarse_row[mz / 2], fine_row[mz]);
+        }
+      }
+      levels_.push_back(std::move(coarse));
+    }
+  }
+
+  Size IntensityPyramid::findLevel(double rt_bin_width, double mz_bin_width) const
+  {
+    Size result = levels_.size();
+    for (Size l = 0; l < levels_.size(); ++l)
+    {
+      if (levels_[l].rt_bin_width > rt_bin_width || levels_[l].mz_bin_width > mz_bin_width) break;
+      result = l;
+    }
+    return result;
+  }
+
+} // namespace OpenMS
@@ -43,6 +43,7 @@
 #include <OpenMS/FORMAT/MzIdentMLFile.h>
 #include <OpenMS/FORMAT/OSWFile.h>
 #include <OpenMS/KERNEL/OnDiscMSExperiment.h>
+#include <OpenMS/VISUAL/IntensityPyramid.h>
 #include <OpenMS/VISUAL/ANNOTATION/Annotation1DPeakItem.h>
 #include <OpenMS/VISUAL/MISC/GUIHelpers.h>
 
@@ -50,6 +51,9 @@
 #include <QtWidgets/QFileDialog>
 #include <QtWidgets/QMessageBox>
 
+#include <chrono>
+#include <thread>
+
 using namespace std;
 
 namespace OpenMS
@@ -113,6 +117,41 @@ namespace OpenMS
     cached_spectrum_.updateRanges();
   }
 
+  std::shared_ptr<const IntensityPyramid> LayerData::getIntensityPyramid() const
+  {
+    if (type != DT_PEAK || peak_map_.get() == nullptr)
+    {
+      return nullptr;
+    }
+
+    if (!intensity_pyramid_.valid())
+    {
+      // the task keeps the peak data alive, even if the layer gets new data (see setPeakData()) in the meantime
+      ConstExperimentSharedPtrType map = getPeakData();
+      std::packaged_task<std::shared_ptr<const IntensityPyramid>()> task([map]()
+      {
+        try
+        {
+          return std::shared_ptr<const IntensityPyramid>(new IntensityPyramid(*map));
+        }
+        catch (...) // e.g. std::bad_alloc; painting will use the raw data
+        {
+          return std::shared_ptr<const IntensityPyramid>();
+        }
+      });
+      intensity_pyramid_ = task.get_future().share();
+      // detached, since waiting for it (e.g. when the layer is closed) would block the GUI
+      std::thread(std::move(task)).detach();
+      return nullptr;
+    }
+
+    if (intensity_pyramid_.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+      return nullptr;
+    }
+    return intensity_pyramid_.get();
+  }
+
   /// Returns the minimum intensity of the internal data, depending on type
 
   float LayerData::getMinIntensity() const
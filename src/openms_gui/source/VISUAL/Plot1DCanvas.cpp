@@ -1232,9 +1232,13 @@ namespace OpenMS
 
     // sort spectra in ascending order of position (ensure that we sort all spectra as well as the currently
     // TODO: check why this is need since we load data already sorted! 
+    // (only unsorted spectra are touched, since the peak data may be shared with other layers, see LayerData::getIntensityPyramid())
     for (Size i = 0; i < getCurrentLayer().getPeakData()->size(); ++i)
     {
-      (*getCurrentLayer().getPeakDataMuteable())[i].sortByPosition();
+      if (!(*getCurrentLayer().getPeakData())[i].isSorted())
+      {
+        (*getCurrentLayer().getPeakDataMuteable())[i].sortByPosition();
+      }
     }
     getCurrentLayer().sortCurrentSpectrumByPosition();
 
@@ -638,6 +638,22 @@ namespace OpenMS
     double rt_step_size = (rt_max - rt_min) / rt_pixel_count;
     double mz_step_size = (mz_max - mz_min) / mz_pixel_count;
 
+    // paint from the intensity pyramid if it has a level with bins not larger than a pixel
+    // (not possible with data filters, since the pyramid only knows the maxima)
+    if (!layer.filters.isActive())
+    {
+      std::shared_ptr<const IntensityPyramid> pyramid = layer.getIntensityPyramid();
+      if (pyramid && !pyramid->empty())
+      {
+        Size level = pyramid->findLevel(rt_step_size, mz_step_size);
+        if (level < pyramid->size())
+        {
+          paintMaximumIntensitiesFromPyramid_(layer_index, pyramid->getLevel(level), pyramid->getRTMin(), pyramid->getMZMin(), rt_pixel_count, mz_pixel_count);
+          return;
+        }
+      }
+    }
+
     // start at first visible RT scan
     Size scan_index = std::distance(map.begin(), map.RTBegin(rt_min));
     //iterate over all pixels (RT dimension)
@@ -709,6 +725,73 @@ namespace OpenMS
     }
   }
 
+  void Plot2DCanvas::paintMaximumIntensitiesFromPyramid_(Size layer_index, const IntensityPyramid::Level& level, double rt_origin, double mz_origin, Size rt_pixel_count, Size mz_pixel_count)
+  {
+    Int image_width = buffer_.width();
+    Int image_height = buffer_.height();
+
+    const LayerData & layer = getLayer(layer_index);
+    const double rt_min = visible_area_.minPosition()[1];
+    const double rt_max = visible_area_.maxPosition()[1];
+    const double mz_min = visible_area_.minPosition()[0];
+    const double mz_max = visible_area_.maxPosition()[0];
+
+    double snap_factor = snap_factors_[layer_index];
+
+    //calculate pixel size in data coordinates
+    double rt_step_size = (rt_max - rt_min) / rt_pixel_count;
+    double mz_step_size = (mz_max - mz_min) / mz_pixel_count;
+
+    // range of bins whose center lies within [start, start + step)
+    auto bin_range = [](double start, double step, double origin, double bin_width, Size bins)
+    {
+      double first = std::ceil((start - origin) / bin_width - 0.5);
+      double last = std::ceil((start + step - origin) / bin_width - 0.5);
+      first = std::min(std::max(first, 0.0), (double)bins);
+      last = std::min(std::max(last, 0.0), (double)bins);
+      return std::make_pair((Size)first, (Size)last);
+    };
+
+    // the bins of each m/z pixel are the same for all RT pixels
+    std::vector<std::pair<Size, Size> > mz_bin_ranges(mz_pixel_count);
+    for (Size mz = 0; mz < mz_pixel_count; ++mz)
+    {
+      mz_bin_ranges[mz] = bin_range(mz_min + mz_step_size * mz, mz_step_size, mz_origin, level.mz_bin_width, level.mz_bins);
+    }
+
+    //iterate over all pixels (RT dimension)
+    for (Size rt = 0; rt < rt_pixel_count; ++rt)
+    {
+      double rt_start = rt_min + rt_step_size * rt;
+      std::pair<Size, Size> rt_bins = bin_range(rt_start, rt_step_size, rt_origin, level.rt_bin_width, level.rt_bins);
+      if (rt_bins.first >= rt_bins.second) continue;
+
+      //iterate over all pixels (m/z dimension)
+      for (Size mz = 0; mz < mz_pixel_count; ++mz)
+      {
+        float max = -1.0;
+        for (Size rt_bin = rt_bins.first; rt_bin < rt_bins.second; ++rt_bin)
+        {
+          for (Size mz_bin = mz_bin_ranges[mz].first; mz_bin < mz_bin_ranges[mz].second; ++mz_bin)
+          {
+            max = std::max(max, level.getMaxIntensity(rt_bin, mz_bin));
+          }
+        }
+
+        //draw to buffer
+        if (max >= 0.0)
+        {
+          QPoint pos;
+          dataToWidget_(mz_min + (mz + 0.5) * mz_step_size, rt_start + 0.5 * rt_step_size, pos);
+          if (pos.y() < image_height && pos.x() < image_width)
+          {
+            buffer_.setPixel(pos.x(), pos.y(), heightColor_(max, layer.gradient, snap_factor).rgb());
+          }
+        }
+      }
+    }
+  }
+
   void Plot2DCanvas::paintFeatureData_(Size layer_index, QPainter& painter)
   {
     const LayerData& layer = getLayer(layer_index);
@@ -20,6 +20,7 @@ InputFile.cpp
 InputFile.ui
 InputFileList.cpp
 InputFileList.ui
+IntensityPyramid.cpp
 LayerListView.cpp
 LayerData.cpp
 ListEditor.cpp
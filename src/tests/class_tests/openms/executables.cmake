@@ -96,6 +96,7 @@ set(metadata_executables_list
   DocumentIDTagger_test
   Identification_test
   IdentificationData_test
+  IdentificationDataArena_test
   IdentificationDataConverter_test
   IdentificationHit_test
   InstrumentSettings_test
@@ -226,6 +227,7 @@ set(format_executables_list
   MzQuantMLFile_test
   #MzQuantMLValidator_test
   MzXMLFile_test
+  NativeBinaryFile_test
   NoopMSDataConsumer_test
   TraMLValidator_test
   OMSSACSVFile_test
@@ -266,8 +268,10 @@ set(format_executables_list
   # DATAACCESS
   MSDataCachedConsumer_test
   MSDataTransformingConsumer_test
+  MSDataParallelTransformingConsumer_test
   MSDataChainingConsumer_test
   MSDataStoringConsumer_test
+  IdentificationFilteringConsumer_test
   MSDataAggregatingConsumer_test
   SpectrumAccessQuadMZTransforming_test
   SpectrumAccessSqMass_test
@@ -528,6 +532,7 @@ set(analysis_executables_list
   MassDecomposition_test
   MetaboliteFeatureDeconvolution_test
   MetaboliteSpectralMatching_test
+  SpectralLibraryIndex_test
   ModifiedPeptideGenerator_test
   NeedlemanWunsch_test
   OfflinePrecursorIonSelection_test
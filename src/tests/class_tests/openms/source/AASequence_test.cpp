@@ -1554,6 +1554,25 @@ START_SECTION([EXTRA] multithreaded example)
 }
 END_SECTION
 
+START_SECTION([EXTRA] multithreaded parsing of known modifications)
+{
+  // Read-only use of ModificationsDB/ResidueDB (modifications and modified
+  // residues already exist), as when loading identifications in parallel.
+  // Lookups only take shared locks, so this scales with the number of threads.
+  const std::vector<String> peptides = {"PEPT(Phospho)IDEM(Oxidation)K", "C(Carbamidomethyl)PEPS(Phospho)TIDER",
+                                        ".(Acetyl)PEPTIDEM(Oxidation)R", "PEPTIDEN(Deamidated)Q(Deamidated)K"};
+  int nr_iterations(10000);
+  int test = 0;
+#pragma omp parallel for reduction (+: test)
+  for (int k = 0; k < nr_iterations; k++)
+  {
+    AASequence aa = AASequence::fromString(peptides[k % peptides.size()]);
+    test += aa.isModified() ? 1 : 0;
+  }
+  TEST_EQUAL(test, nr_iterations)
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
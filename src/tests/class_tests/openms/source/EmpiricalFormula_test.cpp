@@ -186,6 +186,20 @@ START_SECTION(EmpiricalFormula& operator+=(const EmpiricalFormula& rhs))
   TEST_EQUAL(ef, "C")
   ef += EmpiricalFormula("C-1H2");
   TEST_EQUAL(ef, "H2")
+
+  // all elements present (updated in place) vs. new elements (merged)
+  ef = EmpiricalFormula("C6H12O6N2S");
+  ef += EmpiricalFormula("C2H4O");
+  TEST_EQUAL(ef.toString(), EmpiricalFormula("C8H16O7N2S").toString())
+  ef += EmpiricalFormula("H-16S-1");
+  TEST_EQUAL(ef.toString(), EmpiricalFormula("C8O7N2").toString())
+  ef += EmpiricalFormula("HP");
+  TEST_EQUAL(ef.toString(), EmpiricalFormula("C8HO7N2P").toString())
+  ef += EmpiricalFormula("O2+");
+  TEST_EQUAL(ef.getCharge(), 1)
+  ef -= ef;
+  TEST_EQUAL(ef.isEmpty(), true)
+  TEST_EQUAL(ef.getCharge(), 0)
 END_SECTION
 
 START_SECTION(EmpiricalFormula operator+(const EmpiricalFormula& rhs) const)
@@ -213,6 +227,14 @@ START_SECTION(EmpiricalFormula operator-(const EmpiricalFormula& rhs) const)
   TEST_EQUAL(*e_ptr == ef3, true)
   ef3 = ef3 - EmpiricalFormula("C4H-2");
   TEST_EQUAL(ef3, "H2");
+
+  // elements present in only one operand and cancelling elements
+  EmpiricalFormula ef5("C6H12O6N2S"), ef6("H2O(13)C2P");
+  EmpiricalFormula ef7 = (ef5 + ef6) - ef6;
+  TEST_EQUAL(ef7 == ef5, true)
+  TEST_EQUAL(ef7.toString(), ef5.toString())
+  TEST_EQUAL((ef5 - ef5).isEmpty(), true)
+  TEST_EQUAL((ef6 - ef5).getNumberOf(db->getElement("S")), -1)
 END_SECTION
 
 START_SECTION(bool isEmpty() const)
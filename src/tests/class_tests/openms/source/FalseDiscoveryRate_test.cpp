@@ -235,6 +235,68 @@ START_SECTION((void apply(std::vector<ProteinIdentification>& ids)))
 }
 END_SECTION
 
+START_SECTION((void applyBasic(std::vector<PeptideIdentification> & ids)))
+{
+  // scores 10 (t), 9 (t), 8 (d), 7 (t), 6 (d), 5 (t) -> q-values 1/3, 1/3, 0.5, 0.5, 0.6, 0.6 (conservative formula)
+  double scores[] = {10.0, 9.0, 8.0, 7.0, 6.0, 5.0};
+  const char* labels[] = {"target", "target+decoy", "decoy", "target", "decoy", "target"};
+  vector<PeptideIdentification> pep_ids;
+  for (Size i = 0; i < 6; ++i)
+  {
+    PeptideIdentification id;
+    id.setScoreType("XTandem");
+    id.setHigherScoreBetter(true);
+    PeptideHit hit;
+    hit.setScore(scores[i]);
+    hit.setCharge(2);
+    hit.setMetaValue("target_decoy", labels[i]);
+    id.insertHit(hit);
+    pep_ids.push_back(id);
+  }
+  // second-best hit is not used for the calculation, but gets the value of the closest score
+  PeptideHit second;
+  second.setScore(4.0);
+  second.setMetaValue("target_decoy", "target");
+  pep_ids[0].insertHit(second);
+
+  FalseDiscoveryRate fdr;
+  fdr.applyBasic(pep_ids);
+
+  TEST_EQUAL(pep_ids.size(), 6)
+  TEST_EQUAL(pep_ids[0].getScoreType(), "q-value")
+  TEST_EQUAL(pep_ids[0].isHigherScoreBetter(), false)
+  TEST_REAL_SIMILAR(pep_ids[0].getHits()[0].getScore(), 1.0 / 3.0)
+  TEST_REAL_SIMILAR((double)pep_ids[0].getHits()[0].getMetaValue("XTandem_score"), 10.0)
+  TEST_REAL_SIMILAR(pep_ids[0].getHits()[1].getScore(), 0.6)
+  TEST_REAL_SIMILAR(pep_ids[1].getHits()[0].getScore(), 1.0 / 3.0)
+  TEST_REAL_SIMILAR(pep_ids[2].getHits()[0].getScore(), 0.5)
+  TEST_REAL_SIMILAR(pep_ids[3].getHits()[0].getScore(), 0.5)
+  TEST_REAL_SIMILAR(pep_ids[4].getHits()[0].getScore(), 0.6)
+  TEST_REAL_SIMILAR(pep_ids[5].getHits()[0].getScore(), 0.6)
+
+  // decoys are removed in ConsensusMaps (unless 'add_decoy_peptides' is set)
+  ConsensusMap cmap;
+  ConsensusFeature cf;
+  for (Size i = 0; i < 6; ++i)
+  {
+    pep_ids[i].setScoreType("XTandem");
+    pep_ids[i].setHigherScoreBetter(true);
+    pep_ids[i].getHits().resize(1);
+    pep_ids[i].getHits()[0].setScore(scores[i]);
+  }
+  cf.setPeptideIdentifications(pep_ids);
+  cmap.push_back(cf);
+  fdr.applyBasic(cmap);
+
+  const vector<PeptideIdentification>& cmap_ids = cmap[0].getPeptideIdentifications();
+  TEST_REAL_SIMILAR(cmap_ids[0].getHits()[0].getScore(), 1.0 / 3.0)
+  TEST_EQUAL(cmap_ids[2].getHits().size(), 0)
+  TEST_REAL_SIMILAR(cmap_ids[3].getHits()[0].getScore(), 0.5)
+  TEST_EQUAL(cmap_ids[4].getHits().size(), 0)
+  TEST_REAL_SIMILAR(cmap_ids[5].getHits()[0].getScore(), 0.6)
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
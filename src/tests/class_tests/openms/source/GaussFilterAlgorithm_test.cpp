@@ -38,9 +38,22 @@
 ///////////////////////////
 
 #include <OpenMS/FILTERING/SMOOTHING/GaussFilterAlgorithm.h>
+#include <OpenMS/SYSTEM/StopWatch.h>
+
+#include <cmath>
 
 ///////////////////////////
 
+// exposes the general (non-equidistant) integration for comparison
+class GaussFilterAlgorithmTest : public OpenMS::GaussFilterAlgorithm
+{
+public:
+  double integrate(std::vector<double>& mz, std::vector<double>& intensities, OpenMS::Size i)
+  {
+    return integrate_(mz.begin() + i, intensities.begin() + i, mz.begin(), mz.end());
+  }
+};
+
 START_TEST(GaussFilterAlgorithm<D>, "$Id$")
 
 /////////////////////////////////////////////////////////////
@@ -98,6 +111,79 @@ START_SECTION((template <typename ConstIterT, typename IterT> bool filter(ConstI
   TEST_REAL_SIMILAR(*it,1.0)
 END_SECTION 
 
+START_SECTION(([EXTRA] equidistant data is convolved with the same result as the general integration))
+  std::vector<double> mz;
+  std::vector<double> intensities;
+  for (Size i = 0; i < 200; ++i)
+  {
+    mz.push_back(500.0 + 0.0123 * i);
+    intensities.push_back((i * 37) % 101 + 0.5 * (i % 7));
+  }
+  std::vector<double> mz_out(mz.size());
+  std::vector<double> intensities_out(mz.size());
+
+  GaussFilterAlgorithmTest gauss;
+  // kernel wider than the data, a few data points wide and narrower than the data spacing
+  for (double width : {8.0, 0.2, 0.01})
+  {
+    gauss.initialize(width, 0.001, 10.0, false);
+    gauss.filter(mz.begin(), mz.end(), intensities.begin(), mz_out.begin(), intensities_out.begin());
+    for (Size i = 0; i < mz.size(); ++i)
+    {
+      TEST_REAL_SIMILAR(mz_out[i], mz[i])
+      TEST_REAL_SIMILAR(intensities_out[i], gauss.integrate(mz, intensities, i))
+    }
+  }
+END_SECTION
+
+START_SECTION(([EXTRA] benchmark equidistant convolution vs. general integration))
+{
+  // profile spectrum: a gaussian peak every 50 data points
+  std::vector<double> mz;
+  std::vector<double> intensities;
+  for (Size i = 0; i < 20000; ++i)
+  {
+    const double d = double(i % 50) - 25.0;
+    mz.push_back(400.0 + 0.001 * i);
+    intensities.push_back(1000.0 * std::exp(-d * d / 32.0) + (i % 7));
+  }
+  std::vector<double> mz_out(mz.size());
+  std::vector<double> intensities_out(mz.size());
+  std::vector<double> integrated(mz.size());
+
+  GaussFilterAlgorithmTest gauss;
+  gauss.initialize(0.02, 0.001, 10.0, false);
+  const Size n = 20;
+
+  StopWatch sw;
+  sw.start();
+  for (Size i = 0; i != n; ++i)
+  {
+    // what filter() does for non-equidistant data
+    for (Size j = 0; j < mz.size(); ++j)
+    {
+      integrated[j] = gauss.integrate(mz, intensities, j);
+    }
+  }
+  sw.stop();
+  STATUS("integrate_(): " << sw.getClockTime() << " s")
+
+  sw.reset();
+  sw.start();
+  for (Size i = 0; i != n; ++i)
+  {
+    gauss.filter(mz.begin(), mz.end(), intensities.begin(), mz_out.begin(), intensities_out.begin());
+  }
+  sw.stop();
+  STATUS("filter() on equidistant data: " << sw.getClockTime() << " s")
+
+  for (Size i = 0; i < mz.size(); i += 1000)
+  {
+    TEST_REAL_SIMILAR(intensities_out[i], integrated[i])
+  }
+}
+END_SECTION
+
 START_SECTION((bool filter(OpenMS::Interfaces::SpectrumPtr spectrum)))
 
   OpenMS::Interfaces::SpectrumPtr spectrum(new OpenMS::Interfaces::Spectrum);
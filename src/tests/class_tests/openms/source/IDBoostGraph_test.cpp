@@ -105,6 +105,7 @@ START_TEST(IDBoostGraph, "$Id$")
           IDBoostGraph idb{prots[0], peps, 0, false, false};
           TEST_EQUAL(idb.getNrConnectedComponents(), 0)
           TEST_EQUAL(boost::num_vertices(idb.getComponent(0)), 14)
+          Size nr_edges = boost::num_edges(idb.getComponent(0));
           idb.computeConnectedComponents();
           // Now it is 5 ccs because there is an unmatched peptide and a new PSM that only matches to
           // previously uncovered protein PH2.
@@ -114,6 +115,31 @@ START_TEST(IDBoostGraph, "$Id$")
           TEST_EQUAL(boost::num_vertices(idb.getComponent(2)), 5)
           TEST_EQUAL(boost::num_vertices(idb.getComponent(3)), 1)
           TEST_EQUAL(boost::num_vertices(idb.getComponent(4)), 2)
+          // splitting must neither lose nor duplicate edges
+          Size nr_cc_edges = 0;
+          for (Size cc = 0; cc < idb.getNrConnectedComponents(); ++cc)
+          {
+            nr_cc_edges += boost::num_edges(idb.getComponent(cc));
+          }
+          TEST_EQUAL(nr_cc_edges, nr_edges)
+
+          // scheduling is by size, but functor indices and statistics refer to the original components
+          std::vector<unsigned long> seen(idb.getNrConnectedComponents(), 0);
+          idb.applyFunctorOnCCs([&seen](IDBoostGraph::Graph& cc, unsigned int idx)
+            {
+              seen[idx] = boost::num_vertices(cc);
+              return static_cast<unsigned long>(boost::num_vertices(cc));
+            });
+          const auto& stats = idb.getComponentStatistics();
+          TEST_EQUAL(stats.size(), 5)
+          for (Size cc = 0; cc < stats.size(); ++cc)
+          {
+            TEST_EQUAL(seen[cc], boost::num_vertices(idb.getComponent(cc)))
+            TEST_EQUAL(stats[cc].nr_vertices, boost::num_vertices(idb.getComponent(cc)))
+            TEST_EQUAL(stats[cc].nr_edges, boost::num_edges(idb.getComponent(cc)))
+            TEST_EQUAL(stats[cc].functor_result, stats[cc].nr_vertices)
+            TEST_EQUAL(stats[cc].seconds >= 0.0, true)
+          }
         }
     END_SECTION
 
@@ -653,6 +653,87 @@ START_SECTION((void annotate(ConsensusMap& map, const std::vector<PeptideIdentif
 }
 END_SECTION
 
+START_SECTION([EXTRA] annotate(FeatureMap/ConsensusMap) matches the exhaustive pairwise comparison)
+{
+  IDMapper mapper;
+  Param p = mapper.getParameters();
+  p.setValue("rt_tolerance", 5.0);
+  p.setValue("mz_tolerance", 0.02);
+  p.setValue("mz_measure", "Da");
+  p.setValue("ignore_charge", "true");
+  mapper.setParameters(p);
+
+  // features on a regular grid, IDs on a different one (no pair lies exactly on the tolerance border)
+  const Size n_features = 100, n_ids = 300;
+  std::vector<double> feature_rt, feature_mz;
+  FeatureMap fmap;
+  ConsensusMap cmap;
+  for (Size k = 0; k < n_features; ++k)
+  {
+    feature_rt.push_back(3.7 * k + 0.05);
+    feature_mz.push_back(400.0 + 0.013 * (k % 7) + 0.0005);
+    Feature f;
+    f.setRT(feature_rt.back());
+    f.setMZ(feature_mz.back());
+    fmap.push_back(f);
+    ConsensusFeature cf;
+    cf.setRT(feature_rt.back());
+    cf.setMZ(feature_mz.back());
+    cmap.push_back(cf);
+  }
+  std::vector<PeptideIdentification> ids;
+  for (Size j = 0; j < n_ids; ++j)
+  {
+    PeptideIdentification id;
+    id.setRT(1.3 * j);
+    id.setMZ(400.0 + 0.011 * (j % 9));
+    id.setHits(std::vector<PeptideHit>(1));
+    ids.push_back(id);
+  }
+
+  // expected assignments: all IDs within tolerance, in the order of the input
+  std::vector<std::vector<Size> > expected(n_features);
+  Size expected_unassigned = 0;
+  for (Size j = 0; j < n_ids; ++j)
+  {
+    bool assigned = false;
+    for (Size k = 0; k < n_features; ++k)
+    {
+      if (fabs(ids[j].getRT() - feature_rt[k]) <= 5.0 && fabs(ids[j].getMZ() - feature_mz[k]) <= 0.02)
+      {
+        expected[k].push_back(j);
+        assigned = true;
+      }
+    }
+    if (!assigned) ++expected_unassigned;
+  }
+
+  std::vector<ProteinIdentification> protein_ids;
+  mapper.annotate(fmap, ids, protein_ids, true, true);
+  mapper.annotate(cmap, ids, protein_ids);
+
+  TEST_EQUAL(fmap.getUnassignedPeptideIdentifications().size(), expected_unassigned)
+  TEST_EQUAL(cmap.getUnassignedPeptideIdentifications().size(), expected_unassigned)
+  for (Size k = 0; k < n_features; ++k)
+  {
+    const std::vector<PeptideIdentification>& f_ids = fmap[k].getPeptideIdentifications();
+    const std::vector<PeptideIdentification>& c_ids = cmap[k].getPeptideIdentifications();
+    TEST_EQUAL(f_ids.size(), expected[k].size())
+    TEST_EQUAL(c_ids.size(), expected[k].size())
+    for (Size i = 0; i < std::min(f_ids.size(), expected[k].size()); ++i)
+    {
+      TEST_REAL_SIMILAR(f_ids[i].getRT(), ids[expected[k][i]].getRT())
+      TEST_REAL_SIMILAR(f_ids[i].getMZ(), ids[expected[k][i]].getMZ())
+    }
+    for (Size i = 0; i < std::min(c_ids.size(), expected[k].size()); ++i)
+    {
+      TEST_REAL_SIMILAR(c_ids[i].getRT(), ids[expected[k][i]].getRT())
+      TEST_REAL_SIMILAR(c_ids[i].getMZ(), ids[expected[k][i]].getMZ())
+    }
+  }
+}
+END_SECTION
+
 START_SECTION([EXTRA] double getAbsoluteMZTolerance_(const double mz) const)
   IDMapper2 mapper;
   Param p = mapper.getParameters();
@@ -38,6 +38,7 @@
 ///////////////////////////
 
 #include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/FORMAT/DATAACCESS/IdentificationFilteringConsumer.h>
 #include <OpenMS/CONCEPT/FuzzyStringComparator.h>
 
 ///////////////////////////
@@ -203,6 +204,47 @@ START_SECTION(void load(const String& filename, std::vector<ProteinIdentificatio
   TEST_EQUAL(pes4[0].getAAAfter(), PeptideEvidence::UNKNOWN_AA)
 END_SECTION
 
+START_SECTION(void load(const String& filename, Interfaces::IIdentificationConsumer* consumer))
+  std::vector<ProteinIdentification> protein_ids, protein_ids2;
+  std::vector<PeptideIdentification> peptide_ids, peptide_ids2;
+  IdXMLFile().load(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), protein_ids, peptide_ids);
+
+  IdentificationFilteringConsumer consumer(protein_ids2, peptide_ids2);
+  IdXMLFile().load(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), &consumer);
+  TEST_EQUAL(protein_ids2.size(), 2)
+  TEST_EQUAL(peptide_ids2.size(), 3)
+  TEST_EQUAL(consumer.getNumberOfConsumedPeptideIdentifications(), 3)
+  // same content as with the non-streaming variant (apart from the identifiers, which contain a unique ID):
+  for (Size i = 0; i < protein_ids.size(); ++i)
+  {
+    TEST_EQUAL(protein_ids2[i].getSearchEngine(), protein_ids[i].getSearchEngine())
+    TEST_EQUAL(protein_ids2[i].getHits() == protein_ids[i].getHits(), true)
+  }
+  for (Size i = 0; i < peptide_ids.size(); ++i)
+  {
+    TEST_EQUAL(peptide_ids2[i].getHits() == peptide_ids[i].getHits(), true)
+    TEST_EQUAL(peptide_ids2[i].hasMZ(), peptide_ids[i].hasMZ())
+  }
+  TEST_REAL_SIMILAR(peptide_ids2[0].getMZ(), 675.9)
+  // peptide IDs refer to the right runs:
+  TEST_EQUAL(peptide_ids2[0].getIdentifier(), protein_ids2[0].getIdentifier())
+  TEST_EQUAL(peptide_ids2[2].getIdentifier(), protein_ids2[1].getIdentifier())
+
+  // filters are applied while loading:
+  protein_ids2.clear();
+  peptide_ids2.clear();
+  IdentificationFilteringConsumer filter(protein_ids2, peptide_ids2);
+  filter.keepNBestPeptideHits(1);
+  IdXMLFile().load(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), &filter);
+  TEST_EQUAL(peptide_ids2.size(), 3)
+  for (const PeptideIdentification& pep : peptide_ids2)
+  {
+    TEST_EQUAL(pep.getHits().size() <= 1, true)
+  }
+
+  TEST_EXCEPTION(Exception::IllegalArgument, IdXMLFile().load(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), nullptr))
+END_SECTION
+
 START_SECTION(void store(String filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids, const String& document_id="") )
 
   // load, store, and reload data
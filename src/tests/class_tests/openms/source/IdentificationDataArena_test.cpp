@@ -0,0 +1,263 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hendrik Weisser $
+// $Authors: Hendrik Weisser $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/METADATA/ID/IdentificationDataArena.h>
+#include <OpenMS/METADATA/ID/IdentificationDataConverter.h>
+#include <OpenMS/FORMAT/IdXMLFile.h>
+
+///////////////////////////
+
+START_TEST(IdentificationDataArena, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+typedef IdentificationDataArena::Handle Handle;
+
+IdentificationData data;
+IdentificationDataArena* ptr = 0;
+IdentificationDataArena* null = 0;
+START_SECTION((IdentificationDataArena(IdentificationData& id_data)))
+{
+  ptr = new IdentificationDataArena(data);
+  TEST_NOT_EQUAL(ptr, null);
+  TEST_EQUAL(&(ptr->getIdentificationData()), &data);
+  TEST_EQUAL(ptr->getNumberOfQueryMatches(), 0);
+  delete ptr;
+}
+END_SECTION
+
+IdentificationDataArena arena(data);
+
+START_SECTION((Handle internString(const String& str)))
+{
+  Handle first = arena.internString("spectrum=1");
+  Handle second = arena.internString("spectrum=2");
+  TEST_NOT_EQUAL(first, second);
+  TEST_EQUAL(arena.internString("spectrum=1"), first);
+  TEST_EQUAL(arena.getNumberOfStrings(), 2);
+  TEST_STRING_EQUAL(arena.getString(second), "spectrum=2");
+  TEST_EXCEPTION(Exception::IndexOverflow, arena.getString(2));
+}
+END_SECTION
+
+IdentificationData::InputFileRef file_ref = data.registerInputFile("test.mzML");
+IdentificationData::ScoreTypeRef score_ref =
+  data.registerScoreType(IdentificationData::ScoreType("E-value", false));
+IdentificationData::ScoreTypeRef log_ref =
+  data.registerScoreType(IdentificationData::ScoreType("-log10(E-value)", true));
+IdentificationData::ProcessingSoftwareRef sw_ref =
+  data.registerDataProcessingSoftware(IdentificationData::DataProcessingSoftware("Tool"));
+IdentificationData::ProcessingStepRef step_ref =
+  data.registerDataProcessingStep(IdentificationData::DataProcessingStep(sw_ref));
+
+START_SECTION((Handle addDataQuery(const String& data_id, const boost::optional<IdentificationData::InputFileRef>& input_file_opt, double rt, double mz)))
+{
+  Handle query = arena.addDataQuery("spectrum=1", file_ref, 100.0, 500.0);
+  TEST_EQUAL(query, 0);
+  TEST_EQUAL(arena.addDataQuery("spectrum=2", file_ref, 200.0, 600.0), 1);
+  // same identifier and file - same query:
+  TEST_EQUAL(arena.addDataQuery("spectrum=1", file_ref), query);
+  // same identifier, but no file - different query:
+  TEST_EQUAL(arena.addDataQuery("spectrum=1"), 2);
+  TEST_EQUAL(arena.getNumberOfDataQueries(), 3);
+  TEST_STRING_EQUAL(arena.getDataQueryID(1), "spectrum=2");
+  TEST_REAL_SIMILAR(arena.getDataQueryRT(1), 200.0);
+  TEST_REAL_SIMILAR(arena.getDataQueryMZ(1), 600.0);
+  TEST_EXCEPTION(Exception::IllegalArgument, arena.addDataQuery(""));
+}
+END_SECTION
+
+START_SECTION((Handle addIdentifiedPeptide(const AASequence& sequence)))
+{
+  Handle peptide = arena.addIdentifiedPeptide(AASequence::fromString("PEPTIDE"));
+  TEST_EQUAL(peptide, 0);
+  TEST_EQUAL(arena.addIdentifiedPeptide(AASequence::fromString("PEPTIDER")), 1);
+  TEST_EQUAL(arena.addIdentifiedPeptide(AASequence::fromString("PEPTIDE")), peptide);
+  TEST_EQUAL(arena.getNumberOfIdentifiedMolecules(), 2);
+  TEST_EQUAL(arena.getMoleculeType(1), IdentificationData::MoleculeType::PROTEIN);
+  TEST_STRING_EQUAL(arena.getMoleculeKey(1), "PEPTIDER");
+}
+END_SECTION
+
+START_SECTION((Handle addIdentifiedOligo(const NASequence& sequence)))
+{
+  // same string as a peptide, but different molecule type:
+  Handle oligo = arena.addIdentifiedOligo(NASequence::fromString("AUCG"));
+  TEST_EQUAL(oligo, 2);
+  TEST_EQUAL(arena.getMoleculeType(oligo), IdentificationData::MoleculeType::RNA);
+}
+END_SECTION
+
+START_SECTION((Handle addQueryMatches(const std::vector<Handle>& queries, const std::vector<Handle>& molecules, const std::vector<Int>& charges)))
+{
+  TEST_EQUAL(arena.addQueryMatch(0, 0, 2), 0);
+  vector<Handle> queries = {0, 1, 1};
+  vector<Handle> molecules = {1, 0, 1};
+  vector<Int> charges = {2, 3, 3};
+  TEST_EQUAL(arena.addQueryMatches(queries, molecules, charges), 1);
+  TEST_EQUAL(arena.getNumberOfQueryMatches(), 4);
+  TEST_EQUAL(arena.getMatchQuery(2), 1);
+  TEST_EQUAL(arena.getMatchMolecule(2), 0);
+  TEST_EQUAL(arena.getMatchCharge(2), 3);
+  charges.pop_back();
+  TEST_EXCEPTION(Exception::IllegalArgument, arena.addQueryMatches(queries, molecules, charges));
+  TEST_EXCEPTION(Exception::IndexOverflow, arena.addQueryMatch(5, 0));
+  TEST_EQUAL(arena.getNumberOfQueryMatches(), 4);
+}
+END_SECTION
+
+START_SECTION((void setScores(ScoreTypeRef score_ref, const std::vector<double>& values, const StepOpt& step_opt, Handle first_match)))
+{
+  arena.setScores(score_ref, {0.01, 0.001, 1.0}, step_ref);
+  arena.setScore(3, score_ref, 0.1, step_ref);
+  TEST_REAL_SIMILAR(arena.getScore(1, score_ref).first, 0.001);
+  TEST_EQUAL(arena.getScore(3, score_ref).second, true);
+  TEST_EQUAL(arena.getScore(3, log_ref).second, false);
+  TEST_EXCEPTION(Exception::IndexOverflow, arena.setScores(score_ref, {1.0, 2.0}, step_ref, 3));
+}
+END_SECTION
+
+START_SECTION((const std::vector<double>& getScoreColumn(ScoreTypeRef score_ref, const StepOpt& step_opt) const))
+{
+  const vector<double>& column = arena.getScoreColumn(score_ref, step_ref);
+  TEST_EQUAL(column.size(), 4);
+  TEST_REAL_SIMILAR(column[2], 1.0);
+  TEST_EXCEPTION(Exception::ElementNotFound, arena.getScoreColumn(score_ref));
+}
+END_SECTION
+
+START_SECTION((void transformScores(ScoreTypeRef source_ref, ScoreTypeRef target_ref, const std::function<double(double)>& transform, const StepOpt& step_opt)))
+{
+  arena.transformScores(score_ref, log_ref,
+                        [](double value) { return -log10(value); }, step_ref);
+  TEST_REAL_SIMILAR(arena.getScore(0, log_ref).first, 2.0);
+  TEST_REAL_SIMILAR(arena.getScore(1, log_ref).first, 3.0);
+  TEST_REAL_SIMILAR(arena.getScore(3, log_ref).first, 1.0);
+  // original scores are unchanged:
+  TEST_REAL_SIMILAR(arena.getScore(1, score_ref).first, 0.001);
+}
+END_SECTION
+
+START_SECTION((void exportTo() const))
+{
+  arena.exportTo();
+  TEST_EQUAL(data.getDataQueries().size(), 3);
+  TEST_EQUAL(data.getIdentifiedPeptides().size(), 2);
+  TEST_EQUAL(data.getIdentifiedOligos().size(), 1);
+  TEST_EQUAL(data.getMoleculeQueryMatches().size(), 4);
+  for (const auto& match : data.getMoleculeQueryMatches())
+  {
+    TEST_EQUAL(match.getScore(score_ref).second, true);
+    TEST_EQUAL(match.getScore(log_ref).second, true);
+    TEST_EQUAL(match.steps_and_scores.size(), 1);
+  }
+}
+END_SECTION
+
+START_SECTION((void importFrom(bool clear_source)))
+{
+  IdentificationDataArena other(data);
+  other.importFrom(true);
+  TEST_EQUAL(other.getNumberOfDataQueries(), 3);
+  TEST_EQUAL(other.getNumberOfIdentifiedMolecules(), 3);
+  TEST_EQUAL(other.getNumberOfQueryMatches(), 4);
+  // data was moved out of the source:
+  TEST_EQUAL(data.getMoleculeQueryMatches().empty(), true);
+  TEST_EQUAL(data.getDataQueries().empty(), true);
+  TEST_EQUAL(data.getScoreTypes().size(), 2);
+  // scores survived the round-trip:
+  double sum = 0.0;
+  for (Size i = 0; i < other.getNumberOfQueryMatches(); ++i)
+  {
+    sum += other.getScore(i, log_ref).first;
+  }
+  TEST_REAL_SIMILAR(sum, 6.0);
+}
+END_SECTION
+
+START_SECTION(([EXTRA] round-trip with IdentificationDataConverter))
+{
+  vector<ProteinIdentification> proteins_in;
+  vector<PeptideIdentification> peptides_in;
+  IdXMLFile().load(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), proteins_in, peptides_in);
+  // IdentificationData doesn't allow score types with the same name, but different orientations:
+  peptides_in[0].setHigherScoreBetter(true);
+
+  IdentificationData ids;
+  IdentificationDataConverter::importIDs(ids, proteins_in, peptides_in);
+  Size n_matches = ids.getMoleculeQueryMatches().size();
+
+  IdentificationDataArena ids_arena(ids);
+  ids_arena.importFrom(true);
+  TEST_EQUAL(ids_arena.getNumberOfQueryMatches(), n_matches);
+  ids_arena.exportTo();
+  TEST_EQUAL(ids.getMoleculeQueryMatches().size(), n_matches);
+
+  vector<ProteinIdentification> proteins_out;
+  vector<PeptideIdentification> peptides_out;
+  IdentificationDataConverter::exportIDs(ids, proteins_out, peptides_out);
+
+  TEST_EQUAL(peptides_in.size(), peptides_out.size());
+  vector<PeptideHit> hits_in, hits_out;
+  for (const auto& pep : peptides_in)
+  {
+    hits_in.insert(hits_in.end(), pep.getHits().begin(), pep.getHits().end());
+  }
+  for (const auto& pep : peptides_out)
+  {
+    hits_out.insert(hits_out.end(), pep.getHits().begin(), pep.getHits().end());
+  }
+  TEST_EQUAL(hits_in.size(), hits_out.size());
+  // order of hits is different, check that every output one is in the input:
+  for (const auto& hit : hits_out)
+  {
+    TEST_EQUAL(find(hits_in.begin(), hits_in.end(), hit) != hits_in.end(),
+               true);
+  }
+  TEST_EQUAL(proteins_in.size(), proteins_out.size());
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
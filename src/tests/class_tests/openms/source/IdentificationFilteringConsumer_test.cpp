@@ -0,0 +1,261 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/DATAACCESS/IdentificationFilteringConsumer.h>
+
+///////////////////////////
+
+START_TEST(IdentificationFilteringConsumer, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+// test data: one peptide ID with four hits (one decoy)
+PeptideIdentification test_pep;
+test_pep.setRT(100.0);
+test_pep.setMZ(500.0);
+test_pep.setHigherScoreBetter(true);
+for (Int i = 1; i <= 4; ++i)
+{
+  PeptideHit hit(double(i), 0, i, AASequence::fromString("PEPTIDE"));
+  if (i == 4) hit.setMetaValue("target_decoy", "decoy");
+  test_pep.insertHit(hit);
+}
+
+IdentificationFilteringConsumer* ptr = nullptr;
+IdentificationFilteringConsumer* null_ptr = nullptr;
+vector<ProteinIdentification> proteins;
+vector<PeptideIdentification> peptides;
+
+START_SECTION((IdentificationFilteringConsumer(std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids)))
+{
+  ptr = new IdentificationFilteringConsumer(proteins, peptides);
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((explicit IdentificationFilteringConsumer(Interfaces::IIdentificationConsumer* next_consumer)))
+{
+  IdentificationFilteringConsumer storing(proteins, peptides);
+  IdentificationFilteringConsumer forwarding(&storing);
+  forwarding.removeDecoyHits();
+  PeptideIdentification pep = test_pep;
+  forwarding.consumePeptideIdentification(pep);
+  TEST_EQUAL(peptides.size(), 1)
+  TEST_EQUAL(peptides[0].getHits().size(), 3)
+  TEST_EQUAL(storing.getNumberOfConsumedPeptideIdentifications(), 1)
+  TEST_EXCEPTION(Exception::IllegalArgument, IdentificationFilteringConsumer(nullptr))
+  peptides.clear();
+}
+END_SECTION
+
+START_SECTION((void consumeProteinIdentification(ProteinIdentification& protein_id)))
+{
+  IdentificationFilteringConsumer consumer(proteins, peptides);
+  consumer.removeDecoyHits();
+  ProteinIdentification prot;
+  prot.setIdentifier("run");
+  ProteinHit target, decoy;
+  target.setAccession("P1");
+  decoy.setAccession("DECOY_P1");
+  decoy.setMetaValue("target_decoy", "decoy");
+  prot.insertHit(target);
+  prot.insertHit(decoy);
+  consumer.consumeProteinIdentification(prot);
+  TEST_EQUAL(proteins.size(), 1)
+  TEST_EQUAL(proteins[0].getHits().size(), 1)
+  TEST_EQUAL(proteins[0].getHits()[0].getAccession(), "P1")
+  proteins.clear();
+}
+END_SECTION
+
+START_SECTION((void consumePeptideIdentification(PeptideIdentification& peptide_id)))
+{
+  IdentificationFilteringConsumer consumer(proteins, peptides);
+  PeptideIdentification pep = test_pep;
+  consumer.consumePeptideIdentification(pep);
+  TEST_EQUAL(peptides.size(), 1)
+  TEST_EQUAL(peptides[0].getHits().size(), 4)
+  peptides.clear();
+}
+END_SECTION
+
+START_SECTION((void filterPeptidesByRT(double min_rt, double max_rt)))
+{
+  IdentificationFilteringConsumer consumer(proteins, peptides);
+  consumer.filterPeptidesByRT(150.0, 200.0);
+  PeptideIdentification pep = test_pep;
+  consumer.consumePeptideIdentification(pep);
+  TEST_EQUAL(peptides.empty(), true)
+  TEST_EQUAL(consumer.getNumberOfConsumedPeptideIdentifications(), 1)
+  TEST_EQUAL(consumer.getNumberOfAcceptedPeptideIdentifications(), 0)
+}
+END_SECTION
+
+START_SECTION((void filterPeptidesByMZ(double min_mz, double max_mz)))
+{
+  IdentificationFilteringConsumer consumer(proteins, peptides);
+  consumer.filterPeptidesByMZ(400.0, 600.0);
+  PeptideIdentification pep = test_pep;
+  consumer.consumePeptideIdentification(pep);
+  TEST_EQUAL(peptides.size(), 1)
+  peptides.clear();
+}
+END_SECTION
+
+START_SECTION((void filterPeptidesByCharge(Int min_charge, Int max_charge)))
+{
+  IdentificationFilteringConsumer consumer(proteins, peptides);
+  consumer.filterPeptidesByCharge(2, 3);
+  PeptideIdentification pep = test_pep;
+  consumer.consumePeptideIdentification(pep);
+  TEST_EQUAL(peptides[0].getHits().size(), 2)
+  peptides.clear();
+}
+END_SECTION
+
+START_SECTION((void filterPeptideHitsByScore(double threshold_score)))
+{
+  IdentificationFilteringConsumer consumer(proteins, peptides);
+  consumer.filterPeptideHitsByScore(2.5);
+  PeptideIdentification pep = test_pep;
+  consumer.consumePeptideIdentification(pep);
+  TEST_EQUAL(peptides[0].getHits().size(), 2)
+  peptides.clear();
+}
+END_SECTION
+
+START_SECTION((void filterProteinHitsByScore(double threshold_score)))
+{
+  IdentificationFilteringConsumer consumer(proteins, peptides);
+  consumer.filterProteinHitsByScore(0.5);
+  ProteinIdentification prot;
+  prot.setHigherScoreBetter(true);
+  prot.insertHit(ProteinHit(0.1, 1, "P1", ""));
+  prot.insertHit(ProteinHit(0.9, 1, "P2", ""));
+  consumer.consumeProteinIdentification(prot);
+  TEST_EQUAL(proteins[0].getHits().size(), 1)
+  TEST_EQUAL(proteins[0].getHits()[0].getAccession(), "P2")
+  proteins.clear();
+}
+END_SECTION
+
+START_SECTION((void keepNBestPeptideHits(Size n)))
+{
+  // filters are applied in the order in which they were added:
+  IdentificationFilteringConsumer consumer(proteins, peptides);
+  consumer.removeDecoyHits();
+  consumer.keepNBestPeptideHits(1);
+  PeptideIdentification pep = test_pep;
+  consumer.consumePeptideIdentification(pep);
+  TEST_EQUAL(peptides[0].getHits().size(), 1)
+  TEST_REAL_SIMILAR(peptides[0].getHits()[0].getScore(), 3.0)
+  peptides.clear();
+}
+END_SECTION
+
+START_SECTION((void removeDecoyHits()))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((void removeEmptyIdentifications()))
+{
+  IdentificationFilteringConsumer consumer(proteins, peptides);
+  consumer.filterPeptideHitsByScore(10.0);
+  PeptideIdentification pep = test_pep;
+  consumer.consumePeptideIdentification(pep);
+  TEST_EQUAL(peptides.size(), 1) // empty, but kept
+  consumer.removeEmptyIdentifications();
+  pep = test_pep;
+  consumer.consumePeptideIdentification(pep);
+  TEST_EQUAL(peptides.size(), 1)
+  peptides.clear();
+}
+END_SECTION
+
+START_SECTION((void addPeptideFilter(const PeptideFilter& filter)))
+{
+  IdentificationFilteringConsumer consumer(proteins, peptides);
+  consumer.addPeptideFilter([](PeptideIdentification& pep)
+                            {
+                              pep.setScoreType("custom");
+                              return true;
+                            });
+  PeptideIdentification pep = test_pep;
+  consumer.consumePeptideIdentification(pep);
+  TEST_EQUAL(peptides[0].getScoreType(), "custom")
+  peptides.clear();
+}
+END_SECTION
+
+START_SECTION((void addProteinFilter(const ProteinFilter& filter)))
+{
+  IdentificationFilteringConsumer consumer(proteins, peptides);
+  consumer.addProteinFilter([](ProteinIdentification& prot)
+                            {
+                              prot.setScoreType("custom");
+                            });
+  ProteinIdentification prot;
+  consumer.consumeProteinIdentification(prot);
+  TEST_EQUAL(proteins[0].getScoreType(), "custom")
+  proteins.clear();
+}
+END_SECTION
+
+START_SECTION((Size getNumberOfConsumedPeptideIdentifications() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((Size getNumberOfAcceptedPeptideIdentifications() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,230 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/DATAACCESS/MSDataParallelTransformingConsumer.h>
+///////////////////////////
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataStoringConsumer.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/NLargest.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+
+START_TEST(MSDataParallelTransformingConsumer, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+using namespace OpenMS;
+
+MSDataParallelTransformingConsumer* ptr = nullptr;
+MSDataParallelTransformingConsumer* null_ptr = nullptr;
+
+PeakMap expc;
+MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), expc);
+
+// sorts by intensity and tags the spectrum, so we can see it was processed exactly once
+MSDataParallelTransformingConsumer::SpectrumProcessingFactory tag_factory = []()
+{
+  return MSDataParallelTransformingConsumer::SpectrumProcessingFunc([](MSSpectrum& s)
+    {
+      s.sortByIntensity();
+      s.setMetaValue("processed", s.metaValueExists("processed") ? 2 : 1);
+    });
+};
+
+START_SECTION((MSDataParallelTransformingConsumer(Interfaces::IMSDataConsumer* next_consumer, Size block_size = 0)))
+  ptr = new MSDataParallelTransformingConsumer(nullptr);
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->getBlockSize() > 0, true)
+END_SECTION
+
+START_SECTION((~MSDataParallelTransformingConsumer()))
+  delete ptr;
+END_SECTION
+
+START_SECTION((Size getBlockSize() const))
+  MSDataParallelTransformingConsumer consumer(nullptr, 3);
+  TEST_EQUAL(consumer.getBlockSize(), 3)
+END_SECTION
+
+START_SECTION((void consumeSpectrum(SpectrumType& s)))
+{
+  // block size 2: spectra are passed on in blocks, flush() passes on the rest
+  PeakMap exp = expc;
+  TEST_EQUAL(exp.getNrSpectra() > 2, true)
+  MSDataStoringConsumer storing_consumer;
+  MSDataParallelTransformingConsumer consumer(&storing_consumer, 2);
+  consumer.setSpectraProcessingFactory(tag_factory);
+  consumer.setExpectedSize(exp.size(), 0);
+  for (Size i = 0; i < exp.size(); ++i)
+  {
+    MSSpectrum s = exp[i];
+    consumer.consumeSpectrum(s);
+    TEST_EQUAL(s.empty(), true) // data was taken over
+  }
+  TEST_EQUAL(storing_consumer.getData().size(), exp.size() - exp.size() % 2)
+  consumer.flush();
+  const PeakMap& out = storing_consumer.getData();
+  TEST_EQUAL(out.size(), exp.size())
+  ABORT_IF(out.size() != exp.size())
+  for (Size i = 0; i < exp.size(); ++i)
+  {
+    TEST_EQUAL(out[i].getNativeID(), exp[i].getNativeID()) // order is kept
+    TEST_EQUAL(int(out[i].getMetaValue("processed")), 1)
+    TEST_EQUAL(out[i].size(), exp[i].size())
+  }
+}
+END_SECTION
+
+START_SECTION((void consumeChromatogram(ChromatogramType& c)))
+{
+  // chromatograms are passed on unchanged without factory, and after all pending spectra
+  PeakMap exp = expc;
+  TEST_EQUAL(exp.getNrChromatograms() > 0, true)
+  MSDataStoringConsumer storing_consumer;
+  MSDataParallelTransformingConsumer consumer(&storing_consumer, 100);
+  MSSpectrum s = exp[0];
+  consumer.consumeSpectrum(s);
+  TEST_EQUAL(storing_consumer.getData().size(), 0)
+  MSChromatogram c = exp.getChromatogram(0);
+  consumer.consumeChromatogram(c);
+  TEST_EQUAL(storing_consumer.getData().size(), 1)
+  TEST_EQUAL(storing_consumer.getData().getNrChromatograms(), 0)
+  consumer.flush();
+  TEST_EQUAL(storing_consumer.getData().getNrChromatograms(), 1)
+  TEST_EQUAL(storing_consumer.getData().getChromatograms()[0] == exp.getChromatogram(0), true)
+}
+END_SECTION
+
+START_SECTION((void setExpectedSize(Size expectedSpectra, Size expectedChromatograms)))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((void setExperimentalSettings(const ExperimentalSettings& exp)))
+{
+  MSDataStoringConsumer storing_consumer;
+  MSDataParallelTransformingConsumer consumer(&storing_consumer);
+  ExperimentalSettings settings;
+  settings.setComment("parallel");
+  consumer.setExperimentalSettings(settings);
+  TEST_EQUAL(storing_consumer.getData().getComment(), "parallel")
+}
+END_SECTION
+
+START_SECTION((void setSpectraProcessingFactory(SpectrumProcessingFactory factory)))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((void setChromatogramProcessingFactory(ChromatogramProcessingFactory factory)))
+{
+  PeakMap exp = expc;
+  exp.getChromatogram(0).sortByPosition();
+  MSDataParallelTransformingConsumer consumer(nullptr);
+  consumer.setChromatogramProcessingFactory([]()
+    {
+      return MSDataParallelTransformingConsumer::ChromatogramProcessingFunc([](MSChromatogram& c) { c.sortByIntensity(); });
+    });
+  TEST_EQUAL(exp.getChromatogram(0).isSorted(), true)
+  consumer.processExperiment(exp);
+  TEST_EQUAL(exp.getChromatogram(0).isSorted(), false)
+}
+END_SECTION
+
+START_SECTION((void flush()))
+{
+  // the destructor flushes as well
+  MSDataStoringConsumer storing_consumer;
+  {
+    MSDataParallelTransformingConsumer consumer(&storing_consumer, 100);
+    MSSpectrum s = expc[0];
+    consumer.consumeSpectrum(s);
+    TEST_EQUAL(storing_consumer.getData().size(), 0)
+  }
+  TEST_EQUAL(storing_consumer.getData().size(), 1)
+
+  // exceptions of the processing functions are passed on
+  MSDataParallelTransformingConsumer consumer(nullptr, 100);
+  consumer.setSpectraProcessingFactory([]()
+    {
+      return MSDataParallelTransformingConsumer::SpectrumProcessingFunc([](MSSpectrum&)
+        {
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "test");
+        });
+    });
+  MSSpectrum s = expc[0];
+  consumer.consumeSpectrum(s);
+  TEST_EXCEPTION(Exception::IllegalArgument, consumer.flush())
+  consumer.flush(); // nothing left
+}
+END_SECTION
+
+START_SECTION((void processExperiment(PeakMap& exp)))
+{
+  PeakMap exp = expc;
+  MSDataParallelTransformingConsumer consumer(nullptr);
+  consumer.setSpectraProcessingFactory(tag_factory);
+  consumer.processExperiment(exp);
+  for (Size i = 0; i < exp.size(); ++i)
+  {
+    TEST_EQUAL(int(exp[i].getMetaValue("processed")), 1)
+    TEST_EQUAL(exp[i].size(), expc[i].size())
+  }
+}
+END_SECTION
+
+START_SECTION((template <typename FilterType, typename DataType> static std::function<std::function<void (DataType&)> ()> copyPerThread(const FilterType& filter, void (FilterType::*method)(DataType&))))
+{
+  PeakMap exp = expc;
+  PeakMap expected = expc;
+  NLargest nlargest(2);
+  nlargest.filterPeakMap(expected);
+
+  MSDataParallelTransformingConsumer consumer(nullptr);
+  consumer.setSpectraProcessingFactory(MSDataParallelTransformingConsumer::copyPerThread(nlargest, &NLargest::filterPeakSpectrum));
+  consumer.processExperiment(exp);
+  TEST_EQUAL(exp.size(), expected.size())
+  for (Size i = 0; i < exp.size(); ++i)
+  {
+    TEST_EQUAL(exp[i] == expected[i], true)
+  }
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
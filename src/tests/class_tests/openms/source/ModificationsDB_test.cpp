@@ -39,6 +39,8 @@
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
 #include <limits>
 #include <algorithm>
+#include <fstream>
+#include <iterator>
 ///////////////////////////
 
 using namespace OpenMS;
@@ -296,6 +298,104 @@ START_SECTION((bool addModification(ResidueModification* modification)))
 }
 END_SECTION
 
+START_SECTION((bool storeSnapshot(const String& filename, UInt32 checksum) const))
+{
+  NOT_TESTABLE // tested with loadSnapshot
+}
+END_SECTION
+
+START_SECTION((static bool loadSnapshot(const String& filename, UInt32 checksum, std::vector<std::unique_ptr<ResidueModification> >& mods, std::unordered_map<String, std::set<const ResidueModification*> >& names)))
+{
+  ModificationsDB* mdb = ModificationsDB::getInstance();
+  String snapshot;
+  NEW_TMP_FILE(snapshot)
+  TEST_EQUAL(mdb->storeSnapshot(snapshot, 1234), true)
+
+  // round trip
+  std::vector<std::unique_ptr<ResidueModification> > mods;
+  std::unordered_map<String, std::set<const ResidueModification*> > names;
+  TEST_EQUAL(ModificationsDB::loadSnapshot(snapshot, 1234, mods, names), true)
+  TEST_EQUAL(mods.size(), mdb->getNumberOfModifications())
+  ABORT_IF(mods.size() != mdb->getNumberOfModifications())
+  bool all_equal = true;
+  for (Size i = 0; i < mods.size(); ++i)
+  {
+    all_equal &= (*mods[i] == *mdb->getModification(i));
+  }
+  TEST_EQUAL(all_equal, true)
+  set<const ResidueModification*> expected;
+  mdb->searchModifications(expected, "Oxidation");
+  TEST_EQUAL(names["Oxidation"].size(), expected.size())
+
+  // outdated snapshot (written for different source files)
+  TEST_EQUAL(ModificationsDB::loadSnapshot(snapshot, 4321, mods, names), false)
+  TEST_EQUAL(mods.empty(), true)
+  TEST_EQUAL(names.empty(), true)
+
+  // truncated snapshot
+  std::string content;
+  {
+    std::ifstream ifs(snapshot.c_str(), std::ios::binary);
+    content.assign((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  }
+  String truncated;
+  NEW_TMP_FILE(truncated)
+  {
+    std::ofstream ofs(truncated.c_str(), std::ios::binary);
+    ofs.write(content.data(), content.size() / 2);
+  }
+  TEST_EQUAL(ModificationsDB::loadSnapshot(truncated, 1234, mods, names), false)
+  TEST_EQUAL(mods.empty(), true)
+
+  // corrupt snapshot (valid header and size, garbage data)
+  String corrupt;
+  NEW_TMP_FILE(corrupt)
+  {
+    std::ofstream ofs(corrupt.c_str(), std::ios::binary);
+    const Size header_size = 8 + sizeof(UInt32) + sizeof(UInt32) + sizeof(UInt64);
+    ofs.write(content.data(), header_size);
+    ofs.write(std::string(content.size() - header_size, '\xff').data(), content.size() - header_size);
+  }
+  TEST_EQUAL(ModificationsDB::loadSnapshot(corrupt, 1234, mods, names), false)
+  TEST_EQUAL(mods.empty(), true)
+  TEST_EQUAL(names.empty(), true)
+
+  TEST_EQUAL(ModificationsDB::loadSnapshot("does_not_exist.bin", 1234, mods, names), false)
+}
+END_SECTION
+
+START_SECTION((static UInt32 computeSnapshotChecksum(const std::vector<String>& files)))
+{
+  String source;
+  NEW_TMP_FILE(source)
+  {
+    std::ofstream ofs(source.c_str());
+    ofs << "[Term]\nid: MOD:00001\n";
+  }
+  UInt32 checksum = ModificationsDB::computeSnapshotChecksum({source, ""});
+  TEST_NOT_EQUAL(checksum, 0)
+  TEST_EQUAL(ModificationsDB::computeSnapshotChecksum({source}), checksum)
+
+  // a snapshot becomes stale when a source file changes
+  String snapshot;
+  NEW_TMP_FILE(snapshot)
+  ModificationsDB::getInstance()->storeSnapshot(snapshot, checksum);
+  {
+    std::ofstream ofs(source.c_str());
+    ofs << "[Term]\nid: MOD:00002\n";
+  }
+  UInt32 new_checksum = ModificationsDB::computeSnapshotChecksum({source});
+  TEST_NOT_EQUAL(new_checksum, checksum)
+  std::vector<std::unique_ptr<ResidueModification> > mods;
+  std::unordered_map<String, std::set<const ResidueModification*> > names;
+  TEST_EQUAL(ModificationsDB::loadSnapshot(snapshot, new_checksum, mods, names), false)
+  TEST_EQUAL(ModificationsDB::loadSnapshot(snapshot, checksum, mods, names), true)
+
+  // unreadable source files
+  TEST_EQUAL(ModificationsDB::computeSnapshotChecksum({"does_not_exist.obo"}), 0)
+}
+END_SECTION
+
 START_SECTION([EXTRA] multithreaded example)
 {
   // All measurements are best of three (wall time, Linux, 8 threads)
@@ -347,6 +447,20 @@ START_SECTION([EXTRA] multithreaded example)
   }
   TEST_EQUAL(test, nr_iterations*1.0)
 
+  // Read-only lookups of existing modifications (shared lock only)
+  const ResidueModification* oxidation = mdb->getModification("Oxidation", "M");
+  Size phospho_index = mdb->findModificationIndex("Phospho (T)");
+  test = 0;
+  #pragma omp parallel for reduction (+: test)
+  for (int k = 1; k < nr_iterations + 1; k++)
+  {
+    bool ok = mdb->getModification("Oxidation", "M") == oxidation &&
+              mdb->findModificationIndex("Phospho (T)") == phospho_index &&
+              mdb->has("Carbamidomethyl (C)");
+    test += ok ? 1 : 0;
+  }
+  TEST_EQUAL(test, nr_iterations)
+
  }
 END_SECTION
 
@@ -124,4 +124,40 @@ START_SECTION(cluster(const std::vector<MultiplexFilteredMSExperiment>& filter_r
     TEST_EQUAL(cluster_results[7].size(), 0);
 END_SECTION
 
+START_SECTION([EXTRA] cluster(const std::vector<MultiplexFilteredMSExperiment>& filter_results) assigns each filtered peak to exactly one cluster)
+    std::vector<std::map<int,GridBasedCluster> > cluster_results = clustering.cluster(filter_results);
+    TEST_EQUAL(cluster_results.size(), filter_results.size());
+    for (Size pattern = 0; pattern < cluster_results.size(); ++pattern)
+    {
+      std::vector<int> points;
+      for (std::map<int,GridBasedCluster>::const_iterator it = cluster_results[pattern].begin(); it != cluster_results[pattern].end(); ++it)
+      {
+        const std::vector<int>& cluster_points = it->second.getPoints();
+        // clusters are labelled by one of their points
+        TEST_EQUAL(std::find(cluster_points.begin(), cluster_points.end(), it->first) != cluster_points.end(), true);
+        points.insert(points.end(), cluster_points.begin(), cluster_points.end());
+      }
+      std::sort(points.begin(), points.end());
+      TEST_EQUAL(points.size(), filter_results[pattern].size());
+      for (Size i = 0; i < points.size(); ++i)
+      {
+        TEST_EQUAL(points[i], (int) i);
+      }
+    }
+
+    // repeated runs give identical results
+    std::vector<std::map<int,GridBasedCluster> > cluster_results_2 = clustering.cluster(filter_results);
+    TEST_EQUAL(cluster_results_2.size(), cluster_results.size());
+    for (Size pattern = 0; pattern < cluster_results.size(); ++pattern)
+    {
+      TEST_EQUAL(cluster_results_2[pattern].size(), cluster_results[pattern].size());
+      std::map<int,GridBasedCluster>::const_iterator it2 = cluster_results_2[pattern].begin();
+      for (std::map<int,GridBasedCluster>::const_iterator it = cluster_results[pattern].begin(); it != cluster_results[pattern].end(); ++it, ++it2)
+      {
+        TEST_EQUAL(it2->first, it->first);
+        TEST_EQUAL(it2->second.getPoints() == it->second.getPoints(), true);
+      }
+    }
+END_SECTION
+
 END_TEST
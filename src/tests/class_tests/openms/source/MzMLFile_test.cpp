@@ -1071,6 +1071,45 @@ START_SECTION((template <typename MapType> void store(const String& filename, co
     TEST_EQUAL(exp == exp_original,true)
   }
 
+  //test precursors with unset drift time unit (warning is issued from the parallel writers)
+  {
+    PeakMap exp_original;
+    for (Size i = 0; i < 200; ++i)
+    {
+      Precursor prec;
+      prec.setMZ(400.0 + i);
+      prec.setDriftTime(1.5 + i);
+      MSSpectrum spec;
+      spec.setRT(double(i));
+      spec.setMSLevel(2);
+      spec.setNativeID("spectrum=" + String(i));
+      spec.getPrecursors().push_back(prec);
+      spec.push_back(Peak1D(200.0 + i, 100.0f));
+      exp_original.addSpectrum(spec);
+      MSChromatogram chrom;
+      chrom.setNativeID("chromatogram=" + String(i));
+      chrom.setPrecursor(prec);
+      chrom.push_back(ChromatogramPeak(double(i), 100.0));
+      exp_original.addChromatogram(chrom);
+    }
+    std::string tmp_filename;
+    NEW_TMP_FILE(tmp_filename);
+    MzMLFile().store(tmp_filename, exp_original);
+    PeakMap exp;
+    MzMLFile().load(tmp_filename, exp);
+    TEST_EQUAL(exp.size(), 200)
+    TEST_EQUAL(exp.getChromatograms().size(), 200)
+    ABORT_IF(exp.size() != 200 || exp.getChromatograms().size() != 200)
+    for (Size i = 0; i < 200; ++i)
+    {
+      TEST_EQUAL(exp[i].getPrecursors().size(), 1)
+      TEST_REAL_SIMILAR(exp[i].getPrecursors()[0].getDriftTime(), 1.5 + i)
+      TEST_EQUAL(exp[i].getPrecursors()[0].getDriftTimeUnit() == DriftTimeUnit::MILLISECOND, true)
+      TEST_REAL_SIMILAR(exp.getChromatograms()[i].getPrecursor().getDriftTime(), 1.5 + i)
+      TEST_EQUAL(exp.getChromatograms()[i].getPrecursor().getDriftTimeUnit() == DriftTimeUnit::MILLISECOND, true)
+    }
+  }
+
 }
 END_SECTION
 
@@ -0,0 +1,259 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/NativeBinaryFile.h>
+///////////////////////////
+
+#include <OpenMS/FORMAT/ConsensusXMLFile.h>
+#include <OpenMS/FORMAT/FeatureXMLFile.h>
+#include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+
+#include <cstdint>
+#include <fstream>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(NativeBinaryFile, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+NativeBinaryFile* ptr = nullptr;
+NativeBinaryFile* null_ptr = nullptr;
+START_SECTION(NativeBinaryFile())
+{
+  ptr = new NativeBinaryFile();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->getCompression(), false)
+}
+END_SECTION
+
+START_SECTION(~NativeBinaryFile())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(void setCompression(bool compress))
+{
+  NativeBinaryFile f;
+  f.setCompression(true);
+  TEST_EQUAL(f.getCompression(), true)
+}
+END_SECTION
+
+START_SECTION(bool getCompression() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(void store(const String& filename, const FeatureMap& map))
+{
+  NOT_TESTABLE // tested with load
+}
+END_SECTION
+
+START_SECTION(void load(const String& filename, FeatureMap& map))
+{
+  FeatureMap fm;
+  FeatureXMLFile().load(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML"), fm);
+
+  for (bool compress : {false, true})
+  {
+    NativeBinaryFile f;
+    f.setCompression(compress);
+    String tmp_filename;
+    NEW_TMP_FILE(tmp_filename)
+    f.store(tmp_filename, fm);
+
+    FeatureMap fm2;
+    f.load(tmp_filename, fm2);
+    TEST_EQUAL(fm2.size(), fm.size())
+    ABORT_IF(fm2.size() != fm.size())
+    for (Size i = 0; i < fm.size(); ++i)
+    {
+      TEST_EQUAL(fm2[i] == fm[i], true)
+    }
+    TEST_EQUAL(fm2.getIdentifier(), fm.getIdentifier())
+    TEST_EQUAL(fm2.getUniqueId(), fm.getUniqueId())
+    TEST_EQUAL(fm2.getDataProcessing() == fm.getDataProcessing(), true)
+    TEST_EQUAL(fm2.getProteinIdentifications().size(), fm.getProteinIdentifications().size())
+    TEST_EQUAL(fm2.getUnassignedPeptideIdentifications() == fm.getUnassignedPeptideIdentifications(), true)
+    vector<String> keys, keys2;
+    fm.getKeys(keys);
+    fm2.getKeys(keys2);
+    TEST_EQUAL(ListUtils::concatenate(keys2, ","), ListUtils::concatenate(keys, ","))
+
+    // wrong content type
+    ConsensusMap cm;
+    TEST_EXCEPTION(Exception::ParseError, f.load(tmp_filename, cm))
+  }
+
+  NativeBinaryFile f;
+  TEST_EXCEPTION(Exception::FileNotFound, f.load("does_not_exist.featureBin", fm))
+  TEST_EXCEPTION(Exception::ParseError, f.load(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML"), fm))
+}
+END_SECTION
+
+START_SECTION(void store(const String& filename, const ConsensusMap& map))
+{
+  NOT_TESTABLE // tested with load
+}
+END_SECTION
+
+START_SECTION(void load(const String& filename, ConsensusMap& map))
+{
+  ConsensusMap cm;
+  ConsensusXMLFile().load(OPENMS_GET_TEST_DATA_PATH("ConsensusXMLFile_1.consensusXML"), cm);
+
+  NativeBinaryFile f;
+  f.setCompression(true);
+  String tmp_filename;
+  NEW_TMP_FILE(tmp_filename)
+  f.store(tmp_filename, cm);
+
+  ConsensusMap cm2;
+  f.load(tmp_filename, cm2);
+  TEST_EQUAL(cm2.size(), cm.size())
+  ABORT_IF(cm2.size() != cm.size())
+  for (Size i = 0; i < cm.size(); ++i)
+  {
+    TEST_EQUAL(cm2[i] == cm[i], true)
+  }
+  TEST_EQUAL(cm2.getColumnHeaders().size(), cm.getColumnHeaders().size())
+  TEST_EQUAL(cm2.getColumnHeaders().begin()->second.filename, cm.getColumnHeaders().begin()->second.filename)
+  TEST_EQUAL(cm2.getExperimentType(), cm.getExperimentType())
+  TEST_EQUAL(cm2.getUnassignedPeptideIdentifications() == cm.getUnassignedPeptideIdentifications(), true)
+}
+END_SECTION
+
+START_SECTION(void store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids))
+{
+  NOT_TESTABLE // tested with load
+}
+END_SECTION
+
+START_SECTION(void load(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids))
+{
+  vector<ProteinIdentification> protein_ids, protein_ids2;
+  vector<PeptideIdentification> peptide_ids, peptide_ids2;
+  IdXMLFile().load(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), protein_ids, peptide_ids);
+
+  NativeBinaryFile f;
+  String tmp_filename;
+  NEW_TMP_FILE(tmp_filename)
+  f.store(tmp_filename, protein_ids, peptide_ids);
+  f.load(tmp_filename, protein_ids2, peptide_ids2);
+
+  TEST_EQUAL(protein_ids2.size(), protein_ids.size())
+  ABORT_IF(protein_ids2.size() != protein_ids.size())
+  for (Size i = 0; i < protein_ids.size(); ++i)
+  {
+    TEST_EQUAL(protein_ids2[i].getIdentifier(), protein_ids[i].getIdentifier())
+    TEST_EQUAL(protein_ids2[i].getSearchEngine(), protein_ids[i].getSearchEngine())
+    TEST_EQUAL(protein_ids2[i].getSearchParameters().db, protein_ids[i].getSearchParameters().db)
+    TEST_EQUAL(protein_ids2[i].getSearchParameters().digestion_enzyme.getName(), protein_ids[i].getSearchParameters().digestion_enzyme.getName())
+    TEST_EQUAL(protein_ids2[i].getHits() == protein_ids[i].getHits(), true)
+    TEST_EQUAL(protein_ids2[i].getProteinGroups() == protein_ids[i].getProteinGroups(), true)
+  }
+  TEST_EQUAL(peptide_ids2 == peptide_ids, true)
+}
+END_SECTION
+
+START_SECTION(static FileTypes::Type getContentType(const String& filename))
+{
+  FeatureMap fm;
+  NativeBinaryFile f;
+  String tmp_filename;
+  NEW_TMP_FILE(tmp_filename)
+  f.store(tmp_filename, fm);
+  TEST_EQUAL(NativeBinaryFile::getContentType(tmp_filename), FileTypes::FEATUREBIN)
+
+  vector<ProteinIdentification> protein_ids;
+  vector<PeptideIdentification> peptide_ids;
+  NEW_TMP_FILE(tmp_filename)
+  f.store(tmp_filename, protein_ids, peptide_ids);
+  TEST_EQUAL(NativeBinaryFile::getContentType(tmp_filename), FileTypes::IDBIN)
+
+  TEST_EQUAL(NativeBinaryFile::getContentType(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML")), FileTypes::UNKNOWN)
+  TEST_EQUAL(NativeBinaryFile::getContentType("does_not_exist.featureBin"), FileTypes::UNKNOWN)
+}
+END_SECTION
+
+START_SECTION([EXTRA] header layout does not depend on FileTypes::Type)
+{
+  // magic (8 bytes), version (4 bytes), content tag (1 byte)
+  auto readHeader = [](const String& filename, UInt32& version, int& tag)
+  {
+    std::ifstream ifs(filename.c_str(), std::ios::binary);
+    char magic[8];
+    std::uint8_t content = 0;
+    ifs.read(magic, sizeof(magic));
+    ifs.read(reinterpret_cast<char*>(&version), sizeof(version));
+    ifs.read(reinterpret_cast<char*>(&content), sizeof(content));
+    tag = content;
+  };
+  NativeBinaryFile f;
+  UInt32 version = 0;
+  int tag = 0;
+  String tmp_filename;
+
+  NEW_TMP_FILE(tmp_filename)
+  f.store(tmp_filename, FeatureMap());
+  readHeader(tmp_filename, version, tag);
+  TEST_EQUAL(version, NativeBinaryFile::VERSION)
+  TEST_EQUAL(tag, 1)
+
+  NEW_TMP_FILE(tmp_filename)
+  f.store(tmp_filename, ConsensusMap());
+  readHeader(tmp_filename, version, tag);
+  TEST_EQUAL(tag, 2)
+
+  NEW_TMP_FILE(tmp_filename)
+  f.store(tmp_filename, vector<ProteinIdentification>(), vector<PeptideIdentification>());
+  readHeader(tmp_filename, version, tag);
+  TEST_EQUAL(tag, 3)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
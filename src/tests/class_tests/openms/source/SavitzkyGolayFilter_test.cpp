@@ -39,6 +39,9 @@
 
 #include <OpenMS/FILTERING/SMOOTHING/SavitzkyGolayFilter.h>
 #include <OpenMS/KERNEL/Peak2D.h>
+#include <OpenMS/SYSTEM/StopWatch.h>
+
+#include <cmath>
 
 ///////////////////////////
 
@@ -94,6 +97,91 @@ START_SECTION((template < typename PeakType > void filter(MSSpectrum &spectrum))
 END_SECTION 
 
 
+START_SECTION((void filterIntensities(const std::vector<double>& input, std::vector<double>& output) const))
+  Param p;
+  p.setValue("polynomial_order", 4);
+  p.setValue("frame_length", 11);
+  SavitzkyGolayFilter sgolay;
+  sgolay.setParameters(p);
+
+  MSSpectrum spectrum;
+  std::vector<double> input;
+  for (Size i = 0; i < 100; ++i)
+  {
+    Peak1D peak(400.0 + 0.01 * i, (i * 37) % 101 + 0.5f * (i % 7));
+    spectrum.push_back(peak);
+    input.push_back(peak.getIntensity());
+  }
+
+  // the contiguous version gives the same result as the iterator version
+  MSSpectrum expected = spectrum;
+  sgolay.filter(spectrum.begin(), spectrum.end(), expected.begin());
+  std::vector<double> output;
+  sgolay.filterIntensities(input, output);
+  TEST_EQUAL(output.size(), input.size())
+  for (Size i = 0; i < output.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(output[i], expected[i].getIntensity())
+  }
+
+  // input shorter than the frame length is not modified
+  std::vector<double> short_input(input.begin(), input.begin() + 5);
+  sgolay.filterIntensities(short_input, output);
+  TEST_EQUAL(output == short_input, true)
+END_SECTION
+
+START_SECTION([EXTRA] benchmark filter(MSSpectrum&) vs. iterator version)
+{
+  Param p;
+  p.setValue("polynomial_order", 4);
+  p.setValue("frame_length", 11);
+  SavitzkyGolayFilter sgolay;
+  sgolay.setParameters(p);
+
+  // profile spectrum: a gaussian peak every 50 data points
+  MSSpectrum spectrum;
+  for (Size i = 0; i < 100000; ++i)
+  {
+    const double d = double(i % 50) - 25.0;
+    spectrum.push_back(Peak1D(400.0 + 0.001 * i, 1000.0 * std::exp(-d * d / 32.0) + (i % 7)));
+  }
+  const Size n = 50;
+
+  StopWatch sw;
+  sw.start();
+  MSSpectrum old_result;
+  for (Size i = 0; i != n; ++i)
+  {
+    // what filter(MSSpectrum&) did before: copy including meta data, smooth via iterators, swap back
+    MSSpectrum s = spectrum;
+    MSSpectrum output = s;
+    sgolay.filter(s.begin(), s.end(), output.begin());
+    std::swap(s, output);
+    old_result = s;
+  }
+  sw.stop();
+  STATUS("iterator version: " << sw.getClockTime() << " s")
+
+  sw.reset();
+  sw.start();
+  MSSpectrum new_result;
+  for (Size i = 0; i != n; ++i)
+  {
+    MSSpectrum s = spectrum;
+    sgolay.filter(s);
+    new_result = s;
+  }
+  sw.stop();
+  STATUS("filter(MSSpectrum&): " << sw.getClockTime() << " s")
+
+  ABORT_IF(new_result.size() != old_result.size())
+  for (Size i = 0; i < new_result.size(); i += 1000)
+  {
+    TEST_REAL_SIMILAR(new_result[i].getIntensity(), old_result[i].getIntensity())
+  }
+}
+END_SECTION
+
 START_SECTION((template <typename PeakType> void filterExperiment(MSExperiment<PeakType>& map)))
 	TOLERANCE_ABSOLUTE(0.01)
 
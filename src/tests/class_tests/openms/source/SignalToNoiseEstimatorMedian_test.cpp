@@ -114,6 +114,39 @@ START_SECTION([EXTRA](virtual void init(const Container& c)))
 
 END_SECTION
 
+START_SECTION((std::vector<std::vector<double> > estimateBatch(const std::vector<Container>& containers) const))
+  MSSpectrum raw_data;
+  DTAFile().load(OPENMS_GET_TEST_DATA_PATH("SignalToNoiseEstimator_test.dta"), raw_data);
+  MSSpectrum half_data = raw_data;
+  half_data.resize(raw_data.size() / 2);
+
+  std::vector<MSSpectrum> spectra;
+  spectra.push_back(raw_data);
+  spectra.push_back(MSSpectrum());
+  spectra.push_back(half_data);
+  spectra.push_back(raw_data);
+
+  SignalToNoiseEstimatorMedian< MSSpectrum > sne;
+  Param p;
+  p.setValue("win_len", 40.0);
+  p.setValue("noise_for_empty_window", 2.0);
+  p.setValue("min_required_elements", 10);
+  sne.setParameters(p);
+
+  std::vector<std::vector<double> > result = sne.estimateBatch(spectra);
+  TEST_EQUAL(result.size(), 4)
+  TEST_EQUAL(result[1].size(), 0)
+  for (Size s = 0; s < spectra.size(); ++s)
+  {
+    if (spectra[s].empty()) continue;
+    TEST_EQUAL(result[s].size(), spectra[s].size())
+    sne.init(spectra[s]);
+    for (Size i = 0; i < spectra[s].size(); ++i)
+    {
+      TEST_REAL_SIMILAR(result[s][i], sne.getSignalToNoise(i))
+    }
+  }
+END_SECTION
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
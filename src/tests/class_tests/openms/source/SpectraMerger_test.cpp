@@ -146,6 +146,43 @@ START_SECTION((template < typename MapType > void mergeSpectraPrecursors(MapType
 
 END_SECTION
 
+START_SECTION(([EXTRA] template < typename MapType > void mergeSpectraPrecursors(MapType &exp) uses single linkage))
+  // precursors 0-1 and 1-2 are within the tolerances but 0-2 are not; 3 is separated by RT, 4 by m/z
+  double mzs[] = {500.0, 500.00008, 500.00016, 500.0, 600.0};
+  double rts[] = {100.0, 101.0, 102.0, 200.0, 100.0};
+  PeakMap exp;
+  for (Size i = 0; i < 5; ++i)
+  {
+    MSSpectrum spec;
+    spec.setMSLevel(2);
+    spec.setRT(rts[i]);
+    std::vector<Precursor> pcs(1);
+    pcs[0].setMZ(mzs[i]);
+    spec.setPrecursors(pcs);
+    spec.push_back(Peak1D(100.0 + i, 10.0f));
+    exp.addSpectrum(spec);
+  }
+
+  SpectraMerger merger;
+  Param p;
+  p.setValue("mz_binning_width", 0.3);
+  p.setValue("mz_binning_width_unit", "Da");
+  p.setValue("precursor_method:mz_tolerance", 10e-5);
+  p.setValue("precursor_method:rt_tolerance", 5.0);
+  merger.setParameters(p);
+  merger.mergeSpectraPrecursors(exp);
+
+  TEST_EQUAL(exp.size(), 3)
+  ABORT_IF(exp.size() != 3)
+  // sorted by RT: the merged block (average RT 101), the m/z outlier (RT 100 comes first) and the RT outlier
+  TEST_REAL_SIMILAR(exp[0].getRT(), 100.0)
+  TEST_EQUAL(exp[0].size(), 1)
+  TEST_REAL_SIMILAR(exp[1].getRT(), 101.0)
+  TEST_EQUAL(exp[1].size(), 3)
+  TEST_REAL_SIMILAR(exp[2].getRT(), 200.0)
+  TEST_EQUAL(exp[2].size(), 1)
+END_SECTION
+
 START_SECTION((template < typename MapType > void averageGaussian(MapType &exp)))
 	PeakMap exp;
 	MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("SpectraMerger_input_3.mzML"), exp);    // profile mode
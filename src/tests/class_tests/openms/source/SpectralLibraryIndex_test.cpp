@@ -0,0 +1,228 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/ID/SpectralLibraryIndex.h>
+///////////////////////////
+
+#include <OpenMS/SYSTEM/File.h>
+
+#include <fstream>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(SpectralLibraryIndex, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+// three library spectra (one without precursor)
+PeakMap library;
+for (double precursor_mz : {300.0, 100.0, 200.0, -1.0})
+{
+  MSSpectrum spectrum;
+  if (precursor_mz > 0)
+  {
+    Precursor precursor;
+    precursor.setMZ(precursor_mz);
+    precursor.setCharge(precursor_mz == 200.0 ? -1 : 1);
+    spectrum.getPrecursors().push_back(precursor);
+  }
+  spectrum.setName("spectrum " + String(precursor_mz));
+  spectrum.setMetaValue("Metabolite_Name", "compound " + String(precursor_mz));
+  for (double mz : {precursor_mz / 4, precursor_mz / 3, precursor_mz / 2, precursor_mz / 2 + 0.1})
+  {
+    spectrum.push_back(Peak1D(mz, 10.0f));
+  }
+  library.addSpectrum(spectrum);
+}
+
+SpectralLibraryIndex* ptr = nullptr;
+SpectralLibraryIndex* null_ptr = nullptr;
+START_SECTION(SpectralLibraryIndex(double bin_width = 0.5))
+{
+  ptr = new SpectralLibraryIndex();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_REAL_SIMILAR(ptr->getBinWidth(), 0.5)
+  TEST_EXCEPTION(Exception::InvalidValue, SpectralLibraryIndex(0.0))
+}
+END_SECTION
+
+START_SECTION(~SpectralLibraryIndex())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(void build(const PeakMap& library))
+{
+  SpectralLibraryIndex index;
+  index.build(library);
+  TEST_EQUAL(index.size(), 3)
+  TEST_REAL_SIMILAR(index.getPrecursorMZ(0), 100.0)
+  TEST_REAL_SIMILAR(index.getPrecursorMZ(1), 200.0)
+  TEST_REAL_SIMILAR(index.getPrecursorMZ(2), 300.0)
+  TEST_EQUAL(index.getPrecursorCharge(1), -1)
+  TEST_EQUAL(index.getSpectrum(2).getMetaValue("Metabolite_Name"), "compound " + String(300.0))
+  TEST_EQUAL(index.getSpectrum(0).size(), 4)
+}
+END_SECTION
+
+START_SECTION((std::pair<Size, Size> getPrecursorRange(double mz_lower, double mz_upper) const))
+{
+  SpectralLibraryIndex index;
+  index.build(library);
+  TEST_EQUAL(index.getPrecursorRange(150.0, 350.0).first, 1)
+  TEST_EQUAL(index.getPrecursorRange(150.0, 350.0).second, 3)
+  TEST_EQUAL(index.getPrecursorRange(100.0, 100.0).first, 0)
+  TEST_EQUAL(index.getPrecursorRange(100.0, 100.0).second, 1)
+  TEST_EQUAL(index.getPrecursorRange(101.0, 199.0).first, index.getPrecursorRange(101.0, 199.0).second)
+}
+END_SECTION
+
+START_SECTION(void getQueryBins(const MSSpectrum& spectrum, double fragment_mass_error, bool fragment_mass_tolerance_unit_ppm, std::vector<UInt32>& bins) const)
+{
+  SpectralLibraryIndex index(1.0);
+  MSSpectrum query;
+  query.push_back(Peak1D(50.2, 1.0f));
+  query.push_back(Peak1D(50.4, 1.0f));
+  query.push_back(Peak1D(99.95, 1.0f));
+  vector<UInt32> bins;
+  index.getQueryBins(query, 0.1, false, bins);
+  TEST_EQUAL(bins.size(), 3)
+  TEST_EQUAL(bins[0], 50)
+  TEST_EQUAL(bins[1], 99)
+  TEST_EQUAL(bins[2], 100)
+  index.getQueryBins(query, 100.0, true, bins); // 0.01 Da at m/z 100
+  TEST_EQUAL(bins.size(), 2)
+}
+END_SECTION
+
+START_SECTION(Size countMatchingPeaks(Size index, const std::vector<UInt32>& query_bins) const)
+{
+  SpectralLibraryIndex index;
+  index.build(library);
+  // peaks of the first spectrum (precursor 100): 25, 33.3, 50, 50.1
+  MSSpectrum query;
+  query.push_back(Peak1D(25.0, 1.0f));
+  query.push_back(Peak1D(50.05, 1.0f));
+  vector<UInt32> bins;
+  index.getQueryBins(query, 0.1, false, bins);
+  TEST_EQUAL(index.countMatchingPeaks(0, bins), 3)
+  TEST_EQUAL(index.countMatchingPeaks(1, bins), 1) // peak at 50
+  TEST_EQUAL(index.countMatchingPeaks(2, bins), 0)
+  bins.clear();
+  TEST_EQUAL(index.countMatchingPeaks(0, bins), 0)
+}
+END_SECTION
+
+START_SECTION((void store(const String& filename) const, void load(const String& filename)))
+{
+  SpectralLibraryIndex index(0.25);
+  index.build(library);
+  String filename;
+  NEW_TMP_FILE(filename)
+  index.store(filename);
+
+  SpectralLibraryIndex loaded;
+  loaded.load(filename);
+  TEST_EQUAL(loaded.size(), 3)
+  TEST_REAL_SIMILAR(loaded.getBinWidth(), 0.25)
+  for (Size i = 0; i < loaded.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(loaded.getPrecursorMZ(i), index.getPrecursorMZ(i))
+    TEST_EQUAL(loaded.getPrecursorCharge(i), index.getPrecursorCharge(i))
+    TEST_EQUAL(loaded.getSpectrum(i).getName(), index.getSpectrum(i).getName())
+    TEST_EQUAL(loaded.getSpectrum(i).getMetaValue("Metabolite_Name"), index.getSpectrum(i).getMetaValue("Metabolite_Name"))
+    ABORT_IF(loaded.getSpectrum(i).size() != index.getSpectrum(i).size())
+    for (Size p = 0; p < loaded.getSpectrum(i).size(); ++p)
+    {
+      TEST_REAL_SIMILAR(loaded.getSpectrum(i)[p].getMZ(), index.getSpectrum(i)[p].getMZ())
+      TEST_REAL_SIMILAR(loaded.getSpectrum(i)[p].getIntensity(), index.getSpectrum(i)[p].getIntensity())
+    }
+  }
+
+  TEST_EXCEPTION(Exception::FileNotFound, loaded.load("this_file_does_not_exist.idx"))
+  String invalid;
+  NEW_TMP_FILE(invalid)
+  ofstream(invalid.c_str()) << "not a spectral library";
+  TEST_EXCEPTION(Exception::ParseError, loaded.load(invalid))
+}
+END_SECTION
+
+START_SECTION(void loadMSP(const String& filename, const String& cache_filename = ""))
+{
+  String msp;
+  NEW_TMP_FILE(msp)
+  {
+    ofstream ofs(msp.c_str());
+    ofs << "Name: Alanine\nPrecursorMZ: 90.055\nPrecursor_type: [M+H]+\nFormula: C3H7NO2\nNum Peaks: 4\n"
+        << "44.05 100; 45.03 20; 72.04 50; 90.05 10;\n\n"
+        << "Name: Glycine\nPrecursorMZ: 74.024\nIon_mode: N\nNum Peaks: 3\n"
+        << "30.03 100; 56.01 20; 74.02 10;\n\n"
+        << "Name: Unknown\nNum Peaks: 3\n"
+        << "30.03 100; 56.01 20; 74.02 10;\n";
+  }
+  String cache;
+  NEW_TMP_FILE(cache)
+
+  for (Size pass = 0; pass < 2; ++pass) // first pass creates the cache, second pass reads it
+  {
+    SpectralLibraryIndex index;
+    index.loadMSP(msp, cache);
+    TEST_EQUAL(index.size(), 2)
+    TEST_REAL_SIMILAR(index.getPrecursorMZ(0), 74.024)
+    TEST_EQUAL(index.getPrecursorCharge(0), -1)
+    TEST_EQUAL(index.getSpectrum(0).getMetaValue("Metabolite_Name"), "Glycine")
+    TEST_REAL_SIMILAR(index.getPrecursorMZ(1), 90.055)
+    TEST_EQUAL(index.getPrecursorCharge(1), 1)
+    TEST_EQUAL(index.getSpectrum(1).getMetaValue("Sum_Formula"), "C3H7NO2")
+    TEST_EQUAL(index.getSpectrum(1).getMetaValue("Precursor_Ion"), "[M+H]+")
+    TEST_EQUAL(index.getSpectrum(1).size(), 4)
+  }
+  TEST_EQUAL(File::exists(cache), true)
+
+  SpectralLibraryIndex index;
+  TEST_EXCEPTION(Exception::FileNotFound, index.loadMSP("this_file_does_not_exist.msp"))
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -506,9 +506,50 @@ START_SECTION((void unify(const SpectrumSettings &rhs)))
 }
 END_SECTION
 
+START_SECTION((void shareSettings(SharedSettingsPool& pool)))
+{
+  InstrumentSettings is;
+  is.setPolarity(IonSource::POSITIVE);
+  SourceFile sf;
+  sf.setNameOfFile("run.raw");
+
+  SpectrumSettings::SharedSettingsPool pool;
+  SpectrumSettings s1, s2, s3;
+  s1.setInstrumentSettings(is);
+  s2.setInstrumentSettings(is);
+  s1.setSourceFile(sf);
+  s2.setSourceFile(sf);
+  s3.getInstrumentSettings().setPolarity(IonSource::NEGATIVE);
+
+  s1.shareSettings(pool);
+  s2.shareSettings(pool);
+  s3.shareSettings(pool);
+  const SpectrumSettings& c1 = s1;
+  const SpectrumSettings& c2 = s2;
+  const SpectrumSettings& c3 = s3;
+  TEST_EQUAL(&c1.getInstrumentSettings() == &c2.getInstrumentSettings(), true)
+  TEST_EQUAL(&c1.getSourceFile() == &c2.getSourceFile(), true)
+  TEST_EQUAL(&c1.getInstrumentSettings() == &c3.getInstrumentSettings(), false)
+  TEST_EQUAL(c3.getInstrumentSettings().getPolarity(), IonSource::NEGATIVE)
+  TEST_EQUAL(s1 == s2, true)
+
+  // modification of a shared instance affects only the modified spectrum (copy-on-write)
+  s2.getInstrumentSettings().setPolarity(IonSource::NEGATIVE);
+  s2.getSourceFile().setNameOfFile("other.raw");
+  TEST_EQUAL(c1.getInstrumentSettings().getPolarity(), IonSource::POSITIVE)
+  TEST_EQUAL(c2.getInstrumentSettings().getPolarity(), IonSource::NEGATIVE)
+  TEST_EQUAL(c1.getSourceFile().getNameOfFile(), "run.raw")
+  TEST_EQUAL(c2.getSourceFile().getNameOfFile(), "other.raw")
+
+  // copies share as well, moved-from settings stay usable
+  SpectrumSettings copy(s1);
+  TEST_EQUAL(&static_cast<const SpectrumSettings&>(copy).getInstrumentSettings() == &c1.getInstrumentSettings(), true)
+  SpectrumSettings moved(std::move(copy));
+  TEST_EQUAL(moved.getInstrumentSettings().getPolarity(), IonSource::POSITIVE)
+  TEST_EQUAL(copy.getInstrumentSettings().getPolarity(), IonSource::POSITIVE)
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
-
-
-
@@ -45,6 +45,7 @@
 #include <OpenMS/KERNEL/MSSpectrum.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/CONCEPT/Constants.h>
+#include <OpenMS/SYSTEM/StopWatch.h>
 
 ///////////////////////////
 
@@ -474,6 +475,83 @@ START_SECTION(void getSpectrum(PeakSpectrum& spec, const AASequence& peptide, In
 
 END_SECTION
 
+START_SECTION(void getFragmentMZs(std::vector<double>& mzs, const AASequence& peptide, Int min_charge, Int max_charge) const)
+{
+  TheoreticalSpectrumGenerator tsg;
+  vector<double> mzs;
+  tsg.getFragmentMZs(mzs, AASequence(), 1, 2);
+  TEST_EQUAL(mzs.size(), 0)
+
+  // same m/z values as getSpectrum() for all ion types, modifications and charges
+  Param param = tsg.getParameters();
+  for (const String& ion : {"a", "c", "x", "z"})
+  {
+    param.setValue("add_" + ion + "_ions", "true");
+  }
+  for (const String& first_prefix : {"false", "true"})
+  {
+    param.setValue("add_first_prefix_ion", first_prefix);
+    tsg.setParameters(param);
+    for (const String& seq : {"PEPTIDEK", "(Acetyl)PEPTM(Oxidation)IDEK(Amidated)", "HFYLWCP"})
+    {
+      AASequence peptide = AASequence::fromString(seq);
+      PeakSpectrum spec;
+      tsg.getSpectrum(spec, peptide, 1, 3);
+      tsg.getFragmentMZs(mzs, peptide, 1, 3);
+      ABORT_IF(mzs.size() != spec.size())
+      for (Size i = 0; i < mzs.size(); ++i)
+      {
+        TEST_REAL_SIMILAR(mzs[i], spec[i].getMZ())
+      }
+    }
+  }
+
+  // buffer is reused: 6 prefix and 6 suffix ions for each of the six ion types
+  tsg.getFragmentMZs(mzs, AASequence::fromString("PEPTIDE"), 1, 1);
+  TEST_EQUAL(mzs.size(), 6 * 6)
+  TEST_EQUAL(is_sorted(mzs.begin(), mzs.end()), true)
+
+  TEST_EXCEPTION(Exception::InvalidSize, tsg.getFragmentMZs(mzs, AASequence::fromString("P"), 1, 1))
+}
+END_SECTION
+
+START_SECTION([EXTRA] benchmark getFragmentMZs vs. getSpectrum)
+{
+  TheoreticalSpectrumGenerator tsg;
+  Param param = tsg.getParameters();
+  param.setValue("add_first_prefix_ion", "true");
+  tsg.setParameters(param);
+  const AASequence peptide = AASequence::fromString("PEPTIDEPEPTIDEPEPTIDEK");
+  const Size n = 10000;
+
+  StopWatch sw;
+  sw.start();
+  Size n_peaks(0);
+  for (Size i = 0; i != n; ++i)
+  {
+    PeakSpectrum spec;
+    tsg.getSpectrum(spec, peptide, 1, 2);
+    n_peaks += spec.size();
+  }
+  sw.stop();
+  STATUS("getSpectrum: " << sw.getClockTime() << " s")
+
+  sw.reset();
+  sw.start();
+  Size n_mzs(0);
+  vector<double> mzs;
+  for (Size i = 0; i != n; ++i)
+  {
+    tsg.getFragmentMZs(mzs, peptide, 1, 2);
+    n_mzs += mzs.size();
+  }
+  sw.stop();
+  STATUS("getFragmentMZs: " << sw.getClockTime() << " s")
+
+  TEST_EQUAL(n_mzs, n_peaks)
+}
+END_SECTION
+
 START_SECTION(static MSSpectrum generateSpectrum(const Precursor::ActivationMethod& fm, const AASequence& seq, int precursor_charge))
   MSSpectrum spec;
   Precursor prec;
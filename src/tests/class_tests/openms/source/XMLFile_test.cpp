@@ -51,6 +51,14 @@ using namespace OpenMS;
 using namespace OpenMS::Internal;
 using namespace std;
 
+class XMLFileTest :
+  public XMLFile
+{
+public:
+  using XMLFile::ElementList;
+  using XMLFile::scanElementLists_;
+};
+
 XMLFile* ptr = nullptr;
 XMLFile* nullPointer = nullptr;
 
@@ -77,6 +85,40 @@ START_SECTION(const String& getVersion() const)
 	TEST_EQUAL( f.getVersion(),"1.567")
 END_SECTION
 
+START_SECTION((static bool scanElementLists_(const char* data, Size size, const String& list_tag, const String& element_tag, std::vector<ElementList>& lists)))
+  String doc = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+               "<!-- <run> in a comment -->\n"
+               "<root a=\"x>y\">\n"
+               "  <run>\n"
+               "    <head/>\n"
+               "    <item id='1'><item/></item>\n"
+               "    <item id='>'/>\n"
+               "  </run>\n"
+               "  <run/>\n"
+               "</root>\n";
+  std::vector<XMLFileTest::ElementList> lists;
+  TEST_EQUAL(XMLFileTest::scanElementLists_(doc.c_str(), doc.size(), "run", "item", lists), true)
+  TEST_EQUAL(lists.size(), 2)
+  ABORT_IF(lists.size() != 2)
+  TEST_EQUAL(lists[0].head_tags.size(), 1)
+  TEST_EQUAL(lists[0].head_tags[0], "head")
+  TEST_EQUAL(lists[0].element_begin.size(), 2)
+  TEST_EQUAL(doc.substr(lists[0].element_begin[0], 15), "<item id='1'><i")
+  TEST_EQUAL(doc.substr(lists[0].element_begin[1], 14), "<item id='>'/>")
+  TEST_EQUAL(doc.substr(lists[0].content_end, 6), "</run>")
+  TEST_EQUAL(lists[1].content_begin, lists[1].content_end)
+  TEST_EQUAL(lists[1].element_begin.size(), 0)
+
+  // other children after the first list element
+  String mixed = "<root><run><item/><head/></run></root>";
+  TEST_EQUAL(XMLFileTest::scanElementLists_(mixed.c_str(), mixed.size(), "run", "item", lists), false)
+  // malformed
+  String malformed = "<root><run><item/></root>";
+  TEST_EQUAL(XMLFileTest::scanElementLists_(malformed.c_str(), malformed.size(), "run", "item", lists), false)
+  // document type declaration
+  String dtd = "<!DOCTYPE root [<!ENTITY e \"<item/>\">]><root><run>&e;</run></root>";
+  TEST_EQUAL(XMLFileTest::scanElementLists_(dtd.c_str(), dtd.size(), "run", "item", lists), false)
+END_SECTION
 
 START_SECTION(([EXTRA] String writeXMLEscape(const String& to_escape)))
   String s1("nothing_to_escape. Just a regular string...");
@@ -0,0 +1,168 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+
+///////////////////////////
+
+#include <OpenMS/VISUAL/IntensityPyramid.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(IntensityPyramid, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+// four MS1 spectra (RT 0-3) with peaks at m/z 100, 150 and 200, and an MS2 spectrum which is ignored
+PeakMap map;
+for (Size i = 0; i < 4; ++i)
+{
+  MSSpectrum spec;
+  spec.setRT(i);
+  spec.setMSLevel(1);
+  spec.push_back(Peak1D(100.0, i + 1.0f));
+  spec.push_back(Peak1D(150.0, 10.0f * (i + 1)));
+  spec.push_back(Peak1D(200.0, 5.0f));
+  map.addSpectrum(spec);
+}
+MSSpectrum ms2;
+ms2.setRT(1.5);
+ms2.setMSLevel(2);
+ms2.push_back(Peak1D(120.0, 1000.0f));
+map.addSpectrum(ms2);
+map.sortSpectra();
+
+IntensityPyramid* ptr = nullptr;
+IntensityPyramid* null_ptr = nullptr;
+START_SECTION((IntensityPyramid()))
+  ptr = new IntensityPyramid();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_EQUAL(ptr->size(), 0)
+  delete ptr;
+END_SECTION
+
+START_SECTION((IntensityPyramid(const PeakMap& map, Size max_cells = Size(1) << 24, bool coarser_levels = true)))
+  IntensityPyramid pyramid(map, 16);
+  TEST_EQUAL(pyramid.empty(), false)
+  TEST_REAL_SIMILAR(pyramid.getRTMin(), 0.0)
+  TEST_REAL_SIMILAR(pyramid.getMZMin(), 100.0)
+  TEST_EQUAL(pyramid.size(), 3)
+  ABORT_IF(pyramid.size() != 3)
+
+  const IntensityPyramid::Level& level0 = pyramid.getLevel(0);
+  TEST_EQUAL(level0.rt_bins, 4)
+  TEST_EQUAL(level0.mz_bins, 4)
+  TEST_REAL_SIMILAR(level0.rt_bin_width, 0.75)
+  TEST_REAL_SIMILAR(level0.mz_bin_width, 25.0)
+  TEST_REAL_SIMILAR(level0.getMaxIntensity(0, 0), 1.0)
+  TEST_REAL_SIMILAR(level0.getMaxIntensity(0, 1), -1.0)
+  TEST_REAL_SIMILAR(level0.getMaxIntensity(0, 2), 10.0)
+  TEST_REAL_SIMILAR(level0.getMaxIntensity(3, 2), 40.0)
+  TEST_REAL_SIMILAR(level0.getMaxIntensity(3, 3), 5.0)
+
+  const IntensityPyramid::Level& level1 = pyramid.getLevel(1);
+  TEST_EQUAL(level1.rt_bins, 2)
+  TEST_EQUAL(level1.mz_bins, 2)
+  TEST_REAL_SIMILAR(level1.rt_bin_width, 1.5)
+  TEST_REAL_SIMILAR(level1.getMaxIntensity(0, 0), 2.0)
+  TEST_REAL_SIMILAR(level1.getMaxIntensity(1, 1), 40.0)
+
+  const IntensityPyramid::Level& level2 = pyramid.getLevel(2);
+  TEST_EQUAL(level2.rt_bins, 1)
+  TEST_EQUAL(level2.mz_bins, 1)
+  TEST_REAL_SIMILAR(level2.getMaxIntensity(0, 0), 40.0)
+
+  IntensityPyramid empty_pyramid((PeakMap()));
+  TEST_EQUAL(empty_pyramid.empty(), true)
+END_SECTION
+
+START_SECTION((void addCoarserLevels()))
+  IntensityPyramid full(map, 16);
+  IntensityPyramid pyramid(map, 16, false);
+  TEST_EQUAL(pyramid.size(), 1)
+  pyramid.addCoarserLevels();
+  TEST_EQUAL(pyramid.size(), full.size())
+  ABORT_IF(pyramid.size() != full.size())
+  for (Size l = 0; l < full.size(); ++l)
+  {
+    TEST_EQUAL(pyramid.getLevel(l).rt_bins, full.getLevel(l).rt_bins)
+    TEST_EQUAL(pyramid.getLevel(l).mz_bins, full.getLevel(l).mz_bins)
+    TEST_EQUAL(pyramid.getLevel(l).max_intensity == full.getLevel(l).max_intensity, true)
+  }
+  // calling it again changes nothing
+  pyramid.addCoarserLevels();
+  TEST_EQUAL(pyramid.size(), full.size())
+
+  IntensityPyramid empty_pyramid(PeakMap(), 16, false);
+  empty_pyramid.addCoarserLevels();
+  TEST_EQUAL(empty_pyramid.empty(), true)
+END_SECTION
+
+START_SECTION((Size findLevel(double rt_bin_width, double mz_bin_width) const))
+  IntensityPyramid pyramid(map, 16);
+  TEST_EQUAL(pyramid.findLevel(0.75, 25.0), 0)
+  TEST_EQUAL(pyramid.findLevel(2.0, 60.0), 1)
+  TEST_EQUAL(pyramid.findLevel(100.0, 100.0), 2)
+  // level 0 is too coarse
+  TEST_EQUAL(pyramid.findLevel(0.5, 100.0), 3)
+END_SECTION
+
+START_SECTION((bool empty() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((Size size() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((const Level& getLevel(Size level) const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((double getRTMin() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((double getMZMin() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -36,6 +36,7 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataParallelTransformingConsumer.h>
 #include <OpenMS/FILTERING/BASELINE/MorphologicalFilter.h>
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 
@@ -155,16 +156,20 @@ protected:
     //-------------------------------------------------------------
     // calculations
     //-------------------------------------------------------------
-    MorphologicalFilter morph_filter;
-    morph_filter.setLogType(log_type_);
-
     Param parameters;
     parameters.setValue("struc_elem_length", getDoubleOption_("struc_elem_length"));
     parameters.setValue("struc_elem_unit", getStringOption_("struc_elem_unit"));
     parameters.setValue("method", getStringOption_("method"));
 
-    morph_filter.setParameters(parameters);
-    morph_filter.filterExperiment(ms_exp);
+    // spectra are independent: filter them in parallel (one filter per thread)
+    MSDataParallelTransformingConsumer parallel_filter(nullptr);
+    parallel_filter.setSpectraProcessingFactory([&parameters]()
+    {
+      auto morph_filter = std::make_shared<MorphologicalFilter>();
+      morph_filter->setParameters(parameters);
+      return MSDataParallelTransformingConsumer::SpectrumProcessingFunc([morph_filter](MSSpectrum& s) { morph_filter->filter(s); });
+    });
+    parallel_filter.processExperiment(ms_exp);
 
     //-------------------------------------------------------------
     // writing output
@@ -49,6 +49,7 @@
 #include <OpenMS/FORMAT/MzDataFile.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FORMAT/MzXMLFile.h>
+#include <OpenMS/FORMAT/NativeBinaryFile.h>
 #include <OpenMS/FORMAT/SqMassFile.h>
 #include <OpenMS/FORMAT/TextFile.h>
 #include <OpenMS/IONMOBILITY/IMTypes.h>
@@ -118,6 +119,8 @@ using namespace std;
   @ref OpenMS::DTAFile "dta"
   @ref OpenMS::FeatureXMLFile "featureXML"
   @ref OpenMS::ConsensusXMLFile "consensusXML"
+  @ref OpenMS::NativeBinaryFile "featureBin"
+  @ref OpenMS::NativeBinaryFile "consensusBin"
   @ref OpenMS::MS2File "ms2"
   @ref OpenMS::XMassFile "fid/XMASS"
   @ref OpenMS::MsInspectFile "tsv"
@@ -168,7 +171,7 @@ protected:
   {
     registerInputFile_("in", "<file>", "", "Input file to convert.");
     registerStringOption_("in_type", "<type>", "", "Input file type -- default: determined from file extension or content\n", false, true); // for TOPPAS
-    vector<String> input_formats = {"mzML", "mzXML", "mgf", "raw", "cachedMzML", "mzData", "dta", "dta2d", "featureXML", "consensusXML", "ms2", "fid", "tsv", "peplist", "kroenik", "edta"};
+    vector<String> input_formats = {"mzML", "mzXML", "mgf", "raw", "cachedMzML", "mzData", "dta", "dta2d", "featureXML", "featureBin", "consensusXML", "consensusBin", "ms2", "fid", "tsv", "peplist", "kroenik", "edta"};
     setValidFormats_("in", input_formats);
     setValidStrings_("in_type", input_formats);
     
@@ -176,7 +179,7 @@ protected:
     String method("none,ensure,reassign");
     setValidStrings_("UID_postprocessing", ListUtils::create<String>(method));
 
-    vector<String> output_formats = {"mzML", "mzXML", "cachedMzML", "mgf", "featureXML", "consensusXML", "edta", "mzData", "dta2d", "csv", "sqmass"};
+    vector<String> output_formats = {"mzML", "mzXML", "cachedMzML", "mgf", "featureXML", "featureBin", "consensusXML", "consensusBin", "edta", "mzData", "dta2d", "csv", "sqmass"};
     registerOutputFile_("out", "<file>", "", "Output file");
     setValidFormats_("out", output_formats);
     registerStringOption_("out_type", "<type>", "", "Output file type -- default: determined from file extension or content\nNote: that not all conversion paths work or make sense.", false, true);
@@ -276,12 +279,12 @@ protected:
 
     writeDebug_(String("Loading input file"), 1);
 
-    if (in_type == FileTypes::CONSENSUSXML)
+    if (in_type == FileTypes::CONSENSUSXML || in_type == FileTypes::CONSENSUSBIN)
     {
-      ConsensusXMLFile().load(in, cm);
+      fh.loadConsensusFeatures(in, cm, in_type);
       cm.sortByPosition();
-      if ((out_type != FileTypes::FEATUREXML) &&
-          (out_type != FileTypes::CONSENSUSXML))
+      if ((out_type != FileTypes::FEATUREXML) && (out_type != FileTypes::FEATUREBIN) &&
+          (out_type != FileTypes::CONSENSUSXML) && (out_type != FileTypes::CONSENSUSBIN))
       {
         // You you will lose information and waste memory. Enough reasons to issue a warning!
         writeLog_("Warning: Converting consensus features to peaks. You will lose information!");
@@ -323,8 +326,8 @@ protected:
     {
       EDTAFile().load(in, cm);
       cm.sortByPosition();
-      if ((out_type != FileTypes::FEATUREXML) &&
-          (out_type != FileTypes::CONSENSUSXML))
+      if ((out_type != FileTypes::FEATUREXML) && (out_type != FileTypes::FEATUREBIN) &&
+          (out_type != FileTypes::CONSENSUSXML) && (out_type != FileTypes::CONSENSUSBIN))
       {
         // You you will lose information and waste memory. Enough reasons to issue a warning!
         writeLog_("Warning: Converting consensus features to peaks. You will lose information!");
@@ -332,14 +335,15 @@ protected:
       }
     }
     else if (in_type == FileTypes::FEATUREXML ||
+             in_type == FileTypes::FEATUREBIN ||
              in_type == FileTypes::TSV ||
              in_type == FileTypes::PEPLIST ||
              in_type == FileTypes::KROENIK)
     {
       fh.loadFeatures(in, fm, in_type);
       fm.sortByPosition();
-      if ((out_type != FileTypes::FEATUREXML) &&
-          (out_type != FileTypes::CONSENSUSXML))
+      if ((out_type != FileTypes::FEATUREXML) && (out_type != FileTypes::FEATUREBIN) &&
+          (out_type != FileTypes::CONSENSUSXML) && (out_type != FileTypes::CONSENSUSBIN))
       {
         // You will lose information and waste memory. Enough reasons to issue a warning!
         writeLog_("Warning: Converting features to peaks. You will lose information! Mass traces are added, if present as 'num_of_masstraces' and 'masstrace_intensity' (X>=0) meta values.");
@@ -574,9 +578,9 @@ protected:
       f.setLogType(log_type_);
       f.store(out, exp, getFlag_("MGF_compact"));
     }
-    else if (out_type == FileTypes::FEATUREXML)
+    else if (out_type == FileTypes::FEATUREXML || out_type == FileTypes::FEATUREBIN)
     {
-      if ((in_type == FileTypes::FEATUREXML) || (in_type == FileTypes::TSV) ||
+      if ((in_type == FileTypes::FEATUREXML) || (in_type == FileTypes::FEATUREBIN) || (in_type == FileTypes::TSV) ||
           (in_type == FileTypes::PEPLIST) || (in_type == FileTypes::KROENIK))
       {
         if (uid_postprocessing == "ensure")
@@ -588,7 +592,7 @@ protected:
           fm.applyMemberFunction(&UniqueIdInterface::setUniqueId);
         }
       }
-      else if (in_type == FileTypes::CONSENSUSXML || in_type == FileTypes::EDTA)
+      else if (in_type == FileTypes::CONSENSUSXML || in_type == FileTypes::CONSENSUSBIN || in_type == FileTypes::EDTA)
       {
         MapConversion::convert(cm, true, fm);
       }
@@ -625,11 +629,18 @@ protected:
 
       addDataProcessing_(fm, getProcessingInfo_(DataProcessing::
                                                 FORMAT_CONVERSION));
-      FeatureXMLFile().store(out, fm);
+      if (out_type == FileTypes::FEATUREBIN)
+      {
+        NativeBinaryFile().store(out, fm);
+      }
+      else
+      {
+        FeatureXMLFile().store(out, fm);
+      }
     }
-    else if (out_type == FileTypes::CONSENSUSXML)
+    else if (out_type == FileTypes::CONSENSUSXML || out_type == FileTypes::CONSENSUSBIN)
     {
-      if ((in_type == FileTypes::FEATUREXML) || (in_type == FileTypes::TSV) ||
+      if ((in_type == FileTypes::FEATUREXML) || (in_type == FileTypes::FEATUREBIN) || (in_type == FileTypes::TSV) ||
           (in_type == FileTypes::PEPLIST) || (in_type == FileTypes::KROENIK))
       {
         if (uid_postprocessing == "ensure")
@@ -643,7 +654,7 @@ protected:
         MapConversion::convert(0, fm, cm);
       }
       // nothing to do for consensus input
-      else if (in_type == FileTypes::CONSENSUSXML || in_type == FileTypes::EDTA)
+      else if (in_type == FileTypes::CONSENSUSXML || in_type == FileTypes::CONSENSUSBIN || in_type == FileTypes::EDTA)
       {
       }
       else // experimental data
@@ -657,7 +668,14 @@ protected:
 
       addDataProcessing_(cm, getProcessingInfo_(DataProcessing::
                                                 FORMAT_CONVERSION));
-      ConsensusXMLFile().store(out, cm);
+      if (out_type == FileTypes::CONSENSUSBIN)
+      {
+        NativeBinaryFile().store(out, cm);
+      }
+      else
+      {
+        ConsensusXMLFile().store(out, cm);
+      }
     }
     else if (out_type == FileTypes::EDTA)
     {
@@ -686,7 +704,7 @@ protected:
       // conversion is requested
 
       // IBSpectra selected as output type
-      if (in_type != FileTypes::CONSENSUSXML)
+      if (in_type != FileTypes::CONSENSUSXML && in_type != FileTypes::CONSENSUSBIN)
       {
         OPENMS_LOG_ERROR << "Incompatible input data: FileConverter can only convert consensusXML files to ibspectra format.";
         return INCOMPATIBLE_INPUT_DATA;
@@ -45,6 +45,7 @@
 #include <OpenMS/FORMAT/MascotXMLFile.h>
 #include <OpenMS/FORMAT/MzIdentMLFile.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FORMAT/NativeBinaryFile.h>
 #include <OpenMS/FORMAT/OMSSAXMLFile.h>
 #include <OpenMS/FORMAT/PepXMLFile.h>
 #include <OpenMS/FORMAT/PercolatorOutfile.h>
@@ -130,6 +131,7 @@ For Percolator tab-delimited output, information is extracted from the "PSMId" c
 Some information about the supported input types:
 @li @ref OpenMS::MzIdentMLFile "mzIdentML"
 @li @ref OpenMS::IdXMLFile "idXML"
+@li @ref OpenMS::NativeBinaryFile "idBin"
 @li @ref OpenMS::PepXMLFile "pepXML"
 @li @ref OpenMS::ProtXMLFile "protXML"
 @li @ref OpenMS::MascotXMLFile "Mascot XML"
@@ -230,10 +232,10 @@ protected:
                        "- a single file in fasta format (can only be used to generate a theoretical mzML),\n"
                        "- a single text file (tab separated) with one line for all peptide sequences matching a spectrum (top N hits),\n"
                        "- for Sequest results, a directory containing .out files.\n");
-    setValidFormats_("in", ListUtils::create<String>("pepXML,protXML,mascotXML,omssaXML,xml,psms,tsv,idXML,mzid,xquest.xml,fasta"));
+    setValidFormats_("in", ListUtils::create<String>("pepXML,protXML,mascotXML,omssaXML,xml,psms,tsv,idXML,idBin,mzid,xquest.xml,fasta"));
 
     registerOutputFile_("out", "<file>", "", "Output file", true);
-    String formats("idXML,mzid,pepXML,FASTA,xquest.xml,mzML");
+    String formats("idXML,idBin,mzid,pepXML,FASTA,xquest.xml,mzML");
     setValidFormats_("out", ListUtils::create<String>(formats));
     registerStringOption_("out_type", "<type>", "", "Output file type (default: determined from file extension)", false);
     setValidStrings_("out_type", ListUtils::create<String>(formats));
@@ -422,9 +424,9 @@ protected:
         }
       }
 
-      else if (in_type == FileTypes::IDXML)
+      else if (in_type == FileTypes::IDXML || in_type == FileTypes::IDBIN)
       {
-        IdXMLFile().load(in, protein_identifications, peptide_identifications);
+        fh.loadIdentifications(in, protein_identifications, peptide_identifications, in_type);
         // get spectrum_references from the mz data, if necessary:
         if (!mz_file.empty())
         {
@@ -701,6 +703,11 @@ protected:
       IdXMLFile().store(out, protein_identifications, peptide_identifications);
     }
 
+    else if (out_type == FileTypes::IDBIN)
+    {
+      NativeBinaryFile().store(out, protein_identifications, peptide_identifications);
+    }
+
     else if (out_type == FileTypes::MZIDENTML)
     {
       MzIdentMLFile().store(out, protein_identifications,
@@ -40,6 +40,7 @@
 #include <OpenMS/FORMAT/FASTAFile.h>
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/FORMAT/DATAACCESS/IdentificationFilteringConsumer.h>
 #include <OpenMS/ANALYSIS/ID/IDRipper.h>
 #include <OpenMS/FORMAT/ConsensusXMLFile.h>
 #include <OpenMS/FILTERING/ID/IDFilter.h>
@@ -253,10 +254,53 @@ protected:
     ConsensusMap cmap;
     unordered_map<UInt64, ConsensusFeature*> id_to_featureref;
 
+    Size n_prot_ids = 0, n_prot_hits = 0, n_pep_ids = 0, n_pep_hits = 0;
+
     const auto& infiletype = FileHandler::getType(inputfile_name);
     if (infiletype == FileTypes::IDXML)
     {
-      IdXMLFile().load(inputfile_name, proteins, peptides);
+      // apply filters that only depend on a single peptide ID already while
+      // loading, so IDs that are removed anyway are never held in memory
+      // (the filters are applied again below, which is a no-op):
+      IdentificationFilteringConsumer consumer(proteins, peptides);
+      consumer.addProteinFilter([&](ProteinIdentification& protein)
+                                {
+                                  ++n_prot_ids;
+                                  n_prot_hits += protein.getHits().size();
+                                });
+      consumer.addPeptideFilter([&](PeptideIdentification& peptide)
+                                {
+                                  n_pep_hits += peptide.getHits().size();
+                                  return true;
+                                });
+      double rt_high = numeric_limits<double>::infinity(), rt_low = -rt_high;
+      if (parseRange_(getStringOption_("precursor:rt"), rt_low, rt_high))
+      {
+        consumer.filterPeptidesByRT(rt_low, rt_high);
+      }
+      double mz_high = numeric_limits<double>::infinity(), mz_low = -mz_high;
+      if (parseRange_(getStringOption_("precursor:mz"), mz_low, mz_high))
+      {
+        consumer.filterPeptidesByMZ(mz_low, mz_high);
+      }
+      // hit-level filters commute with all filters applied before them,
+      // except for "best:strict" (which depends on the other hits):
+      if (!getFlag_("best:strict"))
+      {
+        double pep_score = getDoubleOption_("score:pep");
+        if (pep_score != 0)
+        {
+          consumer.filterPeptideHitsByScore(pep_score);
+        }
+        Int min_charge = numeric_limits<Int>::min(), max_charge =
+          numeric_limits<Int>::max();
+        if (parseRange_(getStringOption_("precursor:charge"), min_charge, max_charge))
+        {
+          consumer.filterPeptidesByCharge(min_charge, max_charge);
+        }
+      }
+      IdXMLFile().load(inputfile_name, &consumer);
+      n_pep_ids = consumer.getNumberOfConsumedPeptideIdentifications();
     }
     else if (infiletype == FileTypes::CONSENSUSXML)
     {
@@ -280,13 +324,12 @@ protected:
       unassigned.clear();
 
       std::swap(proteins, cmap.getProteinIdentifications());
-    }
-
 
-    Size n_prot_ids = proteins.size();
-    Size n_prot_hits = IDFilter::countHits(proteins);
-    Size n_pep_ids = peptides.size();
-    Size n_pep_hits = IDFilter::countHits(peptides);
+      n_prot_ids = proteins.size();
+      n_prot_hits = IDFilter::countHits(proteins);
+      n_pep_ids = peptides.size();
+      n_pep_hits = IDFilter::countHits(peptides);
+    }
 
     // handle remove_meta
     StringList meta_info = getStringList_("remove_peptide_hits_by_metavalue");
@@ -39,6 +39,7 @@
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 #include <OpenMS/DATASTRUCTURES/StringListUtils.h>
 
+#include <OpenMS/FORMAT/DATAACCESS/MSDataParallelTransformingConsumer.h>
 #include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
 
 using namespace OpenMS;
@@ -98,34 +99,12 @@ public:
   {
   }
 
-  /**
-    @brief Helper class for the Low Memory Noise filtering
-  */
-  class NFGaussMzMLConsumer :
-    public MSDataWritingConsumer 
+  /// Filters spectra and chromatograms in parallel, with one copy of the filter per thread
+  static void setFilterFactories_(MSDataParallelTransformingConsumer& consumer, const GaussFilter& filter)
   {
-
-  public:
-
-    NFGaussMzMLConsumer(const String& filename, const GaussFilter& gf) :
-      MSDataWritingConsumer(filename) 
-    {
-      gf_ = gf;
-    }
-
-    void processSpectrum_(MapType::SpectrumType& s) override
-    {
-      gf_.filter(s);
-    }
-
-    void processChromatogram_(MapType::ChromatogramType& c) override 
-    {
-      gf_.filter(c);
-    }
-
-  private:
-    GaussFilter gf_;
-  };
+    consumer.setSpectraProcessingFactory(MSDataParallelTransformingConsumer::copyPerThread<GaussFilter, MSSpectrum>(filter, &GaussFilter::filter));
+    consumer.setChromatogramProcessingFactory(MSDataParallelTransformingConsumer::copyPerThread<GaussFilter, MSChromatogram>(filter, &GaussFilter::filter));
+  }
 
   void registerOptionsAndFlags_() override
   {
@@ -148,10 +127,13 @@ public:
   ExitCodes doLowMemAlgorithm(const GaussFilter& gauss)
   {
     ///////////////////////////////////
-    // Create the consumer object, add data processing
+    // Create the consumer objects, add data processing:
+    // blocks of spectra are filtered in parallel and written in input order
     ///////////////////////////////////
-    NFGaussMzMLConsumer gaussConsumer(out, gauss);
-    gaussConsumer.addDataProcessing(getProcessingInfo_(DataProcessing::SMOOTHING));
+    PlainMSDataWritingConsumer writingConsumer(out);
+    writingConsumer.addDataProcessing(getProcessingInfo_(DataProcessing::SMOOTHING));
+    MSDataParallelTransformingConsumer gaussConsumer(&writingConsumer);
+    setFilterFactories_(gaussConsumer, gauss);
 
     ///////////////////////////////////
     // Create new MSDataReader and set our consumer
@@ -159,6 +141,7 @@ public:
     MzMLFile mz_data_file;
     mz_data_file.setLogType(log_type_);
     mz_data_file.transform(in, &gaussConsumer);
+    gaussConsumer.flush();
 
     return EXECUTION_OK;
   }
@@ -229,7 +212,9 @@ public:
     //-------------------------------------------------------------
     try
     {
-      gauss.filterExperiment(exp);
+      MSDataParallelTransformingConsumer parallel_filter(nullptr);
+      setFilterFactories_(parallel_filter, gauss);
+      parallel_filter.processExperiment(exp);
     }
     catch (Exception::IllegalArgument & e)
     {
@@ -38,6 +38,7 @@
 #include <OpenMS/DATASTRUCTURES/StringListUtils.h>
 #include <OpenMS/FILTERING/SMOOTHING/SavitzkyGolayFilter.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataParallelTransformingConsumer.h>
 #include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 
@@ -101,34 +102,12 @@ public:
   {
   }
 
-  /**
-    @brief Helper class for the Low Memory Noise filtering
-  */
-  class NFSGolayMzMLConsumer :
-    public MSDataWritingConsumer 
+  /// Filters spectra and chromatograms in parallel, with one copy of the filter per thread
+  static void setFilterFactories_(MSDataParallelTransformingConsumer& consumer, const SavitzkyGolayFilter& filter)
   {
-
-  public:
-
-    NFSGolayMzMLConsumer(const String& filename, const SavitzkyGolayFilter& sgf) :
-      MSDataWritingConsumer(filename) 
-    {
-      sgf_ = sgf;
-    }
-
-    void processSpectrum_(MapType::SpectrumType& s) override
-    {
-      sgf_.filter(s);
-    }
-
-    void processChromatogram_(MapType::ChromatogramType& c) override 
-    {
-      sgf_.filter(c);
-    }
-
-  private:
-    SavitzkyGolayFilter sgf_;
-  };
+    consumer.setSpectraProcessingFactory(MSDataParallelTransformingConsumer::copyPerThread<SavitzkyGolayFilter, MSSpectrum>(filter, &SavitzkyGolayFilter::filter));
+    consumer.setChromatogramProcessingFactory(MSDataParallelTransformingConsumer::copyPerThread<SavitzkyGolayFilter, MSChromatogram>(filter, &SavitzkyGolayFilter::filter));
+  }
 
   void registerOptionsAndFlags_() override
   {
@@ -151,10 +130,13 @@ public:
   ExitCodes doLowMemAlgorithm(const SavitzkyGolayFilter& sgolay)
   {
     ///////////////////////////////////
-    // Create the consumer object, add data processing
+    // Create the consumer objects, add data processing:
+    // blocks of spectra are filtered in parallel and written in input order
     ///////////////////////////////////
-    NFSGolayMzMLConsumer sgolayConsumer(out, sgolay);
-    sgolayConsumer.addDataProcessing(getProcessingInfo_(DataProcessing::SMOOTHING));
+    PlainMSDataWritingConsumer writingConsumer(out);
+    writingConsumer.addDataProcessing(getProcessingInfo_(DataProcessing::SMOOTHING));
+    MSDataParallelTransformingConsumer sgolayConsumer(&writingConsumer);
+    setFilterFactories_(sgolayConsumer, sgolay);
 
     ///////////////////////////////////
     // Create new MSDataReader and set our consumer
@@ -162,6 +144,7 @@ public:
     MzMLFile mz_data_file;
     mz_data_file.setLogType(log_type_);
     mz_data_file.transform(in, &sgolayConsumer);
+    sgolayConsumer.flush();
 
     return EXECUTION_OK;
   }
@@ -230,7 +213,9 @@ public:
     //-------------------------------------------------------------
     // calculations
     //-------------------------------------------------------------
-    sgolay.filterExperiment(exp);
+    MSDataParallelTransformingConsumer parallel_filter(nullptr);
+    setFilterFactories_(parallel_filter, sgolay);
+    parallel_filter.processExperiment(exp);
 
     //-------------------------------------------------------------
     // writing output
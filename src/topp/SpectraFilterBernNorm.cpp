@@ -37,6 +37,7 @@
 
 #include <OpenMS/FILTERING/TRANSFORMERS/BernNorm.h>
 
+#include <OpenMS/FORMAT/DATAACCESS/MSDataParallelTransformingConsumer.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 
@@ -137,7 +138,11 @@ protected:
 
     BernNorm filter;
     filter.setParameters(filter_param);
-    filter.filterPeakMap(exp);
+
+    // spectra are independent: filter them in parallel (one copy of the filter per thread)
+    MSDataParallelTransformingConsumer parallel_filter(nullptr);
+    parallel_filter.setSpectraProcessingFactory(MSDataParallelTransformingConsumer::copyPerThread(filter, &BernNorm::filterPeakSpectrum));
+    parallel_filter.processExperiment(exp);
 
     //-------------------------------------------------------------
     // writing output
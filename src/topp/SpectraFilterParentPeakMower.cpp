@@ -37,6 +37,7 @@
 
 #include <OpenMS/FILTERING/TRANSFORMERS/ParentPeakMower.h>
 
+#include <OpenMS/FORMAT/DATAACCESS/MSDataParallelTransformingConsumer.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 
 #include <typeinfo>
@@ -136,7 +137,11 @@ protected:
 
     ParentPeakMower filter;
     filter.setParameters(filter_param);
-    filter.filterPeakMap(exp);
+
+    // spectra are independent: filter them in parallel (one copy of the filter per thread)
+    MSDataParallelTransformingConsumer parallel_filter(nullptr);
+    parallel_filter.setSpectraProcessingFactory(MSDataParallelTransformingConsumer::copyPerThread(filter, &ParentPeakMower::filterPeakSpectrum));
+    parallel_filter.processExperiment(exp);
 
     //-------------------------------------------------------------
     // writing output
@@ -40,6 +40,7 @@
 #include <OpenMS/FORMAT/FileTypes.h>
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
 #include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/INTERFACES/IIdentificationConsumer.h>
 #include <OpenMS/KERNEL/ConsensusMap.h>
 #include <OpenMS/FORMAT/ConsensusXMLFile.h>
 #include <OpenMS/FORMAT/SVOutStream.h>
@@ -521,6 +522,37 @@ namespace OpenMS
     }
   }
 
+  // writes identifications as they are read from an idXML file (no meta value columns), so the file never needs to be held in memory completely
+  class IdentificationWritingConsumer :
+    public Interfaces::IIdentificationConsumer
+  {
+  public:
+    IdentificationWritingConsumer(SVOutStream& out, bool proteins_only, bool peptides_only, bool groups, bool first_dim_rt) :
+      out_(out), proteins_only_(proteins_only), peptides_only_(peptides_only), groups_(groups), first_dim_rt_(first_dim_rt)
+    {
+    }
+
+    void consumeProteinIdentification(ProteinIdentification& pid) override
+    {
+      if (peptides_only_) return;
+      if (groups_)
+      {
+        writeProteinGroups(out_, pid.getIndistinguishableProteins());
+      }
+      writeProteinId(out_, pid, StringList());
+    }
+
+    void consumePeptideIdentification(PeptideIdentification& pid) override
+    {
+      if (proteins_only_) return;
+      writePeptideId(out_, pid, peptides_only_ ? "" : "PEPTIDE", true, true, first_dim_rt_);
+    }
+
+  protected:
+    SVOutStream& out_;
+    bool proteins_only_, peptides_only_, groups_, first_dim_rt_;
+  };
+
   class TOPPTextExporter :
     public TOPPBase
   {
@@ -1259,7 +1291,12 @@ protected:
         vector<ProteinIdentification> prot_ids;
         vector<PeptideIdentification> pep_ids;
         String document_id;
-        IdXMLFile().load(in, prot_ids, pep_ids, document_id);
+        // meta value columns depend on all identifications - without them, the output can be written while reading:
+        bool streaming = (add_id_metavalues < 0) && (add_hit_metavalues < 0) && (add_protein_hit_metavalues < 0);
+        if (!streaming)
+        {
+          IdXMLFile().load(in, prot_ids, pep_ids, document_id);
+        }
         StringList peptide_id_meta_keys;
         StringList peptide_hit_meta_keys;
         StringList protein_hit_meta_keys;
@@ -1323,6 +1360,12 @@ protected:
           output << nl;
         }
 
+        if (streaming)
+        {
+          IdentificationWritingConsumer consumer(output, proteins_only, peptides_only, groups, first_dim_rt);
+          IdXMLFile().load(in, &consumer);
+        }
+
         for (vector<ProteinIdentification>::const_iterator it =
                prot_ids.begin(); it != prot_ids.end(); ++it)
         {
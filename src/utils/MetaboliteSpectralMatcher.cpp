@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
+#include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/KERNEL/FeatureMap.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
@@ -41,6 +42,7 @@
 #include <OpenMS/SYSTEM/File.h>
 
 #include <OpenMS/ANALYSIS/ID/MetaboliteSpectralMatching.h>
+#include <OpenMS/ANALYSIS/ID/SpectralLibraryIndex.h>
 
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 
@@ -97,7 +99,8 @@ protected:
     registerInputFile_("in", "<file>", "", "Input spectra.");
     setValidFormats_("in", ListUtils::create<String>("mzML"));
     registerInputFile_("database", "<file>", "", "Default spectral database.", true);
-    setValidFormats_("database", ListUtils::create<String>("mzML"));
+    setValidFormats_("database", ListUtils::create<String>("mzML,msp"));
+    registerStringOption_("database_cache", "<file>", "", "Binary index of an MSP database, created if missing or outdated (speeds up loading large libraries).", false, true);
     registerOutputFile_("out", "<file>", "", "mzTab file");
     setValidFormats_("out", ListUtils::create<String>("mzTab"));
 
@@ -160,21 +163,41 @@ protected:
     // load database
     //-------------------------------------------------------------
 
-    PeakMap spec_db;
-    mz_file.load(spec_db_filename, spec_db);
+    MetaboliteSpectralMatching ams;
+    ams.setParameters(ams_param);
 
-    if (spec_db.empty())
+    if (FileHandler::getTypeByFileName(spec_db_filename) == FileTypes::MSP)
     {
-      OPENMS_LOG_WARN << "The spectral library does not contain any spectra.";
-      return INCOMPATIBLE_INPUT_DATA;
+      SpectralLibraryIndex library;
+      library.loadMSP(spec_db_filename, getStringOption_("database_cache"));
+
+      if (library.empty())
+      {
+        OPENMS_LOG_WARN << "The spectral library does not contain any spectra with precursor information.";
+        return INCOMPATIBLE_INPUT_DATA;
+      }
+
+      //-------------------------------------------------------------
+      // run spectral library search
+      //-------------------------------------------------------------
+      ams.run(ms_peakmap, library, mztab_output);
+    }
+    else
+    {
+      PeakMap spec_db;
+      mz_file.load(spec_db_filename, spec_db);
+
+      if (spec_db.empty())
+      {
+        OPENMS_LOG_WARN << "The spectral library does not contain any spectra.";
+        return INCOMPATIBLE_INPUT_DATA;
+      }
+
+      //-------------------------------------------------------------
+      // run spectral library search
+      //-------------------------------------------------------------
+      ams.run(ms_peakmap, spec_db, mztab_output);
     }
-
-    //-------------------------------------------------------------
-    // run spectral library search
-    //-------------------------------------------------------------
-    MetaboliteSpectralMatching ams;
-    ams.setParameters(ams_param);
-    ams.run(ms_peakmap, spec_db, mztab_output);
 
     //-------------------------------------------------------------
     // store results